@@ -0,0 +1,310 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "ngraph/codegen/code_cache.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/log.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// A key is the hex encoding of a SHA1 digest
+static const size_t s_key_length = 40;
+
+static bool is_key(const string& s)
+{
+    return s.size() == s_key_length &&
+           all_of(s.begin(), s.end(), [](char c) { return isxdigit(c) != 0; });
+}
+
+class codegen::CodeCache::ObjectCacheImpl : public llvm::ObjectCache
+{
+public:
+    ObjectCacheImpl(CodeCache& cache)
+        : m_cache(cache)
+    {
+    }
+
+    void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef obj) override
+    {
+        const string& key = module->getModuleIdentifier();
+        if (is_key(key))
+        {
+            m_cache.write_entry(key, "o", obj.getBufferStart(), obj.getBufferSize());
+        }
+    }
+
+    unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override
+    {
+        const string& key = module->getModuleIdentifier();
+        string data;
+        if (!is_key(key) || !m_cache.read_entry(key, "o", data))
+        {
+            return nullptr;
+        }
+        NGRAPH_DEBUG << "codegen cache: object hit for " << key;
+        m_cache.m_hit_count++;
+        return llvm::MemoryBuffer::getMemBufferCopy(data, key);
+    }
+
+private:
+    CodeCache& m_cache;
+};
+
+codegen::CodeCache* codegen::CodeCache::get_instance()
+{
+    // Caches are never destroyed because execution engines keep pointers to their object
+    // caches. The environment is read on every call so that the directory can be changed
+    // between compilations.
+    static mutex s_mutex;
+    static vector<unique_ptr<CodeCache>> s_caches;
+
+    const char* dir = getenv("NGRAPH_CODEGEN_CACHE_DIR");
+    if (dir == nullptr || *dir == 0)
+    {
+        return nullptr;
+    }
+
+    lock_guard<mutex> lock(s_mutex);
+    for (auto& cache : s_caches)
+    {
+        if (cache->m_dir == dir)
+        {
+            return cache.get();
+        }
+    }
+    size_t max_mb = 1024;
+    if (const char* size = getenv("NGRAPH_CODEGEN_CACHE_SIZE"))
+    {
+        // strtoul skips blanks, accepts a sign and returns 0 when nothing is parsed
+        char* end = nullptr;
+        unsigned long value = strtoul(size, &end, 10);
+        if (isdigit(static_cast<unsigned char>(*size)) && *end == 0)
+        {
+            max_mb = value;
+        }
+        else
+        {
+            NGRAPH_WARN << "codegen cache: ignoring NGRAPH_CODEGEN_CACHE_SIZE=" << size
+                        << ", expected a size in MB";
+        }
+    }
+    file_util::make_directory(dir);
+    s_caches.emplace_back(new CodeCache(dir, max_mb * 1024 * 1024));
+    return s_caches.back().get();
+}
+
+codegen::CodeCache::CodeCache(const string& dir, size_t max_bytes)
+    : m_dir(dir)
+    , m_max_bytes(max_bytes)
+    , m_object_cache(new ObjectCacheImpl(*this))
+{
+}
+
+codegen::CodeCache::~CodeCache()
+{
+}
+
+string codegen::CodeCache::make_key(const string& source, const vector<string>& config) const
+{
+    llvm::SHA1 sha;
+    // Separate the fields so that moving text between adjacent fields changes the key
+    auto add = [&sha](const string& s) {
+        sha.update(s);
+        sha.update(llvm::StringRef("\0", 1));
+    };
+    add(NGRAPH_VERSION);
+    add(LLVM_VERSION_STRING);
+    add(llvm::sys::getHostCPUName().str());
+    for (const string& s : config)
+    {
+        add(s);
+    }
+    add(source);
+    return llvm::toHex(sha.final());
+}
+
+llvm::ObjectCache* codegen::CodeCache::get_object_cache()
+{
+    return m_object_cache.get();
+}
+
+unique_ptr<llvm::Module> codegen::CodeCache::load_module(const string& key,
+                                                         llvm::LLVMContext& context)
+{
+    unique_ptr<llvm::Module> module;
+    string data;
+    if (read_entry(key, "bc", data))
+    {
+        llvm::MemoryBufferRef buffer(data, key);
+        auto result = llvm::parseBitcodeFile(buffer, context);
+        if (result)
+        {
+            module = move(*result);
+            NGRAPH_DEBUG << "codegen cache: bitcode hit for " << key;
+            m_hit_count++;
+        }
+        else
+        {
+            llvm::consumeError(result.takeError());
+            NGRAPH_WARN << "codegen cache: ignoring corrupt entry " << entry_path(key, "bc");
+        }
+    }
+    return module;
+}
+
+void codegen::CodeCache::store_module(const string& key, const llvm::Module& module)
+{
+    string data;
+    llvm::raw_string_ostream out(data);
+    llvm::WriteBitcodeToFile(&module, out);
+    out.flush();
+    write_entry(key, "bc", data.data(), data.size());
+}
+
+string codegen::CodeCache::entry_path(const string& key, const string& ext) const
+{
+    return file_util::path_join(m_dir, key + "." + ext);
+}
+
+bool codegen::CodeCache::read_entry(const string& key, const string& ext, string& data)
+{
+    string path = entry_path(key, ext);
+    ifstream in(path, ios::binary);
+    if (!in)
+    {
+        return false;
+    }
+    stringstream ss;
+    ss << in.rdbuf();
+    if (!in)
+    {
+        return false;
+    }
+    data = ss.str();
+    // Refresh the modification time so that eviction is least-recently-used
+    utime(path.c_str(), nullptr);
+    return true;
+}
+
+void codegen::CodeCache::write_entry(const string& key,
+                                     const string& ext,
+                                     const char* data,
+                                     size_t n)
+{
+    lock_guard<mutex> lock(m_mutex);
+    // Write to a private file and rename it into place so that concurrent readers only
+    // ever see complete entries
+    string path = entry_path(key, ext);
+    string tmp = path + ".tmp." + to_string(getpid());
+    {
+        ofstream out(tmp, ios::binary);
+        out.write(data, n);
+        if (!out)
+        {
+            NGRAPH_WARN << "codegen cache: failed to write " << tmp;
+            out.close();
+            file_util::remove_file(tmp);
+            return;
+        }
+    }
+    if (rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        file_util::remove_file(tmp);
+        return;
+    }
+    evict();
+}
+
+void codegen::CodeCache::evict()
+{
+    // Serialize eviction between processes sharing the directory
+    string lock_path = file_util::path_join(m_dir, ".lock");
+    int fd = open(lock_path.c_str(), O_RDWR | O_CREAT, 0666);
+    if (fd < 0 || flock(fd, LOCK_EX) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return;
+    }
+
+    struct Entry
+    {
+        string path;
+        size_t size;
+        time_t mtime;
+    };
+    vector<Entry> entries;
+    size_t total = 0;
+    file_util::iterate_files(m_dir,
+                             [&](const string& file, bool is_dir) {
+                                 string name = file_util::get_file_name(file);
+                                 size_t dot = name.find('.');
+                                 struct stat st;
+                                 if (!is_dir && dot != string::npos &&
+                                     is_key(name.substr(0, dot)) &&
+                                     stat(file.c_str(), &st) == 0)
+                                 {
+                                     entries.push_back({file, size_t(st.st_size), st.st_mtime});
+                                     total += st.st_size;
+                                 }
+                             },
+                             false);
+    if (total > m_max_bytes)
+    {
+        sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.mtime < b.mtime;
+        });
+        for (const Entry& e : entries)
+        {
+            if (total <= m_max_bytes)
+            {
+                break;
+            }
+            file_util::remove_file(e.path);
+            total -= e.size;
+        }
+    }
+
+    flock(fd, LOCK_UN);
+    close(fd);
+}
@@ -0,0 +1,95 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ngraph
+{
+    namespace codegen
+    {
+        class CodeCache;
+    }
+}
+
+namespace llvm
+{
+    class LLVMContext;
+    class Module;
+    class ObjectCache;
+}
+
+/// \brief On-disk cache of codegen output shared by all processes on a host.
+///
+/// The cache is enabled by setting NGRAPH_CODEGEN_CACHE_DIR to a writable directory.
+/// For every compiled source it stores the LLVM bitcode (`<key>.bc`), which lets a later
+/// run skip the clang frontend, and the MCJIT object code (`<key>.o`), which lets it skip
+/// LLVM optimization and code generation as well. The key is a SHA1 over the nGraph and
+/// LLVM versions, the host CPU, the compiler configuration and the source text, so stale
+/// entries are never reused; they simply age out. The total size of the directory is
+/// bounded by NGRAPH_CODEGEN_CACHE_SIZE (in MB, default 1024; values that are not a number are
+/// ignored) and the least recently used entries are evicted first. Any I/O or parse failure is
+/// treated as a miss.
+class ngraph::codegen::CodeCache
+{
+public:
+    /// \brief Returns the cache for the current NGRAPH_CODEGEN_CACHE_DIR, or nullptr if unset.
+    static CodeCache* get_instance();
+
+    ~CodeCache();
+
+    /// \brief Computes the cache key for a source and everything that affects its compilation.
+    std::string make_key(const std::string& source, const std::vector<std::string>& config) const;
+
+    /// \brief Loads the bitcode stored for key into context.
+    /// \return The module, or nullptr if there is no usable entry.
+    std::unique_ptr<llvm::Module> load_module(const std::string& key,
+                                              llvm::LLVMContext& context);
+
+    /// \brief Stores the bitcode of module under key.
+    void store_module(const std::string& key, const llvm::Module& module);
+
+    /// \brief Returns the MCJIT object cache backed by this directory. Modules are looked up
+    /// by their module identifier, which must be a key returned by make_key.
+    llvm::ObjectCache* get_object_cache();
+
+    /// \brief Returns the number of bitcode and object entries loaded from the cache.
+    size_t get_hit_count() const { return m_hit_count; }
+
+private:
+    class ObjectCacheImpl;
+
+    CodeCache(const std::string& dir, size_t max_bytes);
+    CodeCache(const CodeCache&) = delete;
+    CodeCache& operator=(const CodeCache&) = delete;
+
+    std::string entry_path(const std::string& key, const std::string& ext) const;
+    bool read_entry(const std::string& key, const std::string& ext, std::string& data);
+    void write_entry(const std::string& key, const std::string& ext, const char* data, size_t n);
+    void evict();
+
+    std::string m_dir;
+    size_t m_max_bytes;
+    std::mutex m_mutex;
+    std::unique_ptr<ObjectCacheImpl> m_object_cache;
+    std::atomic<size_t> m_hit_count{0};
+};
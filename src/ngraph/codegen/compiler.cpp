@@ -35,6 +35,7 @@
 #include <clang/Lex/PreprocessorOptions.h>
 #include <llvm/ADT/Statistic.h>
 #include <llvm/ExecutionEngine/MCJIT.h> // forces JIT to link in
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/LinkAllPasses.h>
 #include <llvm/Option/Arg.h>
@@ -48,6 +49,7 @@
 #include <llvm/Support/raw_ostream.h>
 
 #include "header_resource.hpp"
+#include "ngraph/codegen/code_cache.hpp"
 #include "ngraph/codegen/compiler.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/log.hpp"
@@ -118,6 +120,7 @@ codegen::Compiler::~Compiler()
 {
     m_compiler_action = nullptr;
     m_compiler_core = nullptr;
+    m_context = nullptr;
 }
 
 void codegen::Compiler::set_precompiled_header_source(const std::string& source)
@@ -132,6 +135,28 @@ void codegen::Compiler::add_header_search_path(const std::string& path)
 
 std::unique_ptr<codegen::Module> codegen::Compiler::compile(const std::string& source)
 {
+    // Check the code cache before touching clang so that a hit avoids creating a compiler
+    CodeCache* cache = CodeCache::get_instance();
+    std::string key;
+    if (cache)
+    {
+        vector<std::string> config = m_header_search_paths;
+        config.push_back(m_precompiled_header_source);
+        config.push_back(std::getenv("NGRAPH_COMPILER_DEBUGINFO_ENABLE") ? "debug" : "");
+        key = cache->make_key(source, config);
+
+        if (!m_context)
+        {
+            m_context.reset(new llvm::LLVMContext());
+        }
+        std::unique_ptr<llvm::Module> module = cache->load_module(key, *m_context);
+        if (module)
+        {
+            module->setModuleIdentifier(key);
+            return std::unique_ptr<codegen::Module>(new codegen::Module(move(module)));
+        }
+    }
+
     // lock_guard<mutex> lock(m_mutex);
     CompilerInfo& compiler_info = s_compiler_info[m_precompiled_header_source];
     if (!compiler_info.compiler)
@@ -144,6 +169,14 @@ std::unique_ptr<codegen::Module> codegen::Compiler::compile(const std::string& s
         compiler_info.compiler->set_precompiled_header_source(m_precompiled_header_source);
     }
     auto rc = compiler_info.compiler->compile(m_compiler_action, source);
+    if (rc && cache)
+    {
+        // The identifier is also the key the execution engine uses for the object cache
+        std::unique_ptr<llvm::Module> module = rc->take_module();
+        module->setModuleIdentifier(key);
+        cache->store_module(key, *module);
+        rc.reset(new codegen::Module(move(module)));
+    }
     return rc;
 }
 
@@ -38,6 +38,7 @@ namespace clang
 
 namespace llvm
 {
+    class LLVMContext;
     class Module;
 }
 
@@ -63,6 +64,8 @@ public:
     std::unique_ptr<clang::CodeGenAction>& get_compiler_action() { return m_compiler_action; }
 private:
     std::unique_ptr<clang::CodeGenAction> m_compiler_action;
+    // Owns modules loaded from the code cache, which have no compiler action
+    std::unique_ptr<llvm::LLVMContext> m_context;
     std::shared_ptr<CompilerCore> m_compiler_core;
     std::string m_precompiled_header_source;
     std::vector<std::string> m_header_search_paths;
@@ -16,6 +16,7 @@
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 
+#include "ngraph/codegen/code_cache.hpp"
 #include "ngraph/codegen/execution_engine.hpp"
 
 using namespace ngraph;
@@ -51,6 +52,11 @@ bool codegen::ExecutionEngine::add_module(std::unique_ptr<ngraph::codegen::Modul
             {
                 return false;
             }
+
+            if (CodeCache* cache = CodeCache::get_instance())
+            {
+                m_execution_engine->setObjectCache(cache->get_object_cache());
+            }
         }
     }
     else
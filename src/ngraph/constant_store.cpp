@@ -0,0 +1,358 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/constant_store.hpp"
+#include "ngraph/except.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static const size_t s_constant_alignment = 64;
+
+// FNV-1a over 64 bit words, with the tail folded in byte by byte
+static uint64_t hash_data(const void* data, size_t size)
+{
+    const uint64_t prime = 1099511628211ULL;
+    uint64_t hash = 14695981039346656037ULL;
+    const char* p = static_cast<const char*>(data);
+    size_t words = size / sizeof(uint64_t);
+    for (size_t i = 0; i < words; i++)
+    {
+        uint64_t word;
+        memcpy(&word, p + i * sizeof(uint64_t), sizeof(word));
+        hash = (hash ^ word) * prime;
+    }
+    for (size_t i = words * sizeof(uint64_t); i < size; i++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(p[i])) * prime;
+    }
+    return (hash ^ size) * prime;
+}
+
+ConstantBuffer::ConstantBuffer(void* data, size_t size)
+    : m_data(data)
+    , m_size(size)
+    , m_materialized(true)
+{
+}
+
+ConstantBuffer::ConstantBuffer(size_t size, Generator generator)
+    : m_data(nullptr)
+    , m_size(size)
+    , m_generator(generator)
+    , m_materialized(false)
+{
+}
+
+ConstantBuffer::ConstantBuffer(const void* data, size_t size, shared_ptr<const void> owner)
+    : m_data(const_cast<void*>(data))
+    , m_size(size)
+    , m_materialized(true)
+    , m_owner(owner)
+{
+}
+
+ConstantBuffer::~ConstantBuffer()
+{
+    if (m_data && !m_owner)
+    {
+        aligned_free(m_data);
+    }
+}
+
+const void* ConstantBuffer::get_data_ptr() const
+{
+    if (!m_materialized)
+    {
+        materialize();
+    }
+    return m_data;
+}
+
+bool ConstantBuffer::is_materialized() const
+{
+    return m_materialized;
+}
+
+void ConstantBuffer::materialize() const
+{
+    call_once(m_materialize_flag, [this]() {
+        void* data = aligned_alloc(s_constant_alignment, m_size);
+        try
+        {
+            m_generator(data, m_size);
+        }
+        catch (...)
+        {
+            aligned_free(data);
+            throw;
+        }
+        m_data = data;
+        m_generator = nullptr;
+        m_materialized = true;
+    });
+}
+
+ConstantStore& ConstantStore::get()
+{
+    static ConstantStore s_store;
+    return s_store;
+}
+
+shared_ptr<ConstantBuffer> ConstantStore::intern(const void* data, size_t size)
+{
+    return find_or_insert(const_cast<void*>(data), size, false);
+}
+
+shared_ptr<ConstantBuffer> ConstantStore::adopt(void* data, size_t size)
+{
+    return find_or_insert(data, size, true);
+}
+
+shared_ptr<ConstantBuffer> ConstantStore::find_or_insert(void* data, size_t size, bool owned)
+{
+    uint64_t hash = hash_data(data, size);
+    lock_guard<mutex> lock(m_mutex);
+    auto range = m_content_buffers.equal_range(hash);
+    for (auto it = range.first; it != range.second;)
+    {
+        shared_ptr<ConstantBuffer> buffer = it->second.lock();
+        if (!buffer)
+        {
+            it = m_content_buffers.erase(it);
+            continue;
+        }
+        if (buffer->size() == size && memcmp(buffer->m_data, data, size) == 0)
+        {
+            if (owned)
+            {
+                aligned_free(data);
+            }
+            return buffer;
+        }
+        ++it;
+    }
+
+    if (!owned)
+    {
+        void* copy = aligned_alloc(s_constant_alignment, size);
+        memcpy(copy, data, size);
+        data = copy;
+    }
+    shared_ptr<ConstantBuffer> buffer(new ConstantBuffer(data, size));
+    m_content_buffers.insert({hash, buffer});
+    return buffer;
+}
+
+shared_ptr<ConstantBuffer> ConstantStore::from_file(const string& path, size_t offset, size_t size)
+{
+    string key = "file:" + path + ":" + to_string(offset) + ":" + to_string(size);
+    return find_or_insert_lazy(key, size, [path, offset](void* target, size_t n) {
+        ifstream in(path, ios_base::binary | ios_base::in);
+        in.seekg(offset, ios_base::beg);
+        in.read(static_cast<char*>(target), n);
+        if (!in)
+        {
+            throw ngraph_error("Unable to read constant data from '" + path + "'");
+        }
+    });
+}
+
+#ifndef _WIN32
+namespace
+{
+    // A read-only private mapping of a whole file
+    class MappedFile
+    {
+    public:
+        MappedFile(const string& path)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw ngraph_error("Unable to open '" + path + "' for mapping");
+            }
+            struct stat st;
+            if (fstat(fd, &st) != 0)
+            {
+                close(fd);
+                throw ngraph_error("Unable to stat '" + path + "'");
+            }
+            m_size = static_cast<size_t>(st.st_size);
+            if (m_size > 0)
+            {
+                void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data == MAP_FAILED)
+                {
+                    close(fd);
+                    throw ngraph_error("Unable to map '" + path + "'");
+                }
+                m_data = data;
+            }
+            close(fd);
+        }
+        ~MappedFile()
+        {
+            if (m_data)
+            {
+                munmap(m_data, m_size);
+            }
+        }
+        const char* data() const { return static_cast<const char*>(m_data); }
+        size_t size() const { return m_size; }
+    private:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        void* m_data{nullptr};
+        size_t m_size{0};
+    };
+}
+#endif
+
+shared_ptr<ConstantBuffer>
+    ConstantStore::from_mapped_file(const string& path, size_t offset, size_t size)
+{
+#ifndef _WIN32
+    {
+        string key = "mmap:" + path + ":" + to_string(offset) + ":" + to_string(size);
+        lock_guard<mutex> lock(m_mutex);
+        auto it = m_lazy_buffers.find(key);
+        if (it != m_lazy_buffers.end())
+        {
+            if (shared_ptr<ConstantBuffer> buffer = it->second.lock())
+            {
+                return buffer;
+            }
+        }
+
+        shared_ptr<const MappedFile> file =
+            static_pointer_cast<const MappedFile>(m_mapped_files[path].lock());
+        if (!file)
+        {
+            file = make_shared<MappedFile>(path);
+            m_mapped_files[path] = file;
+        }
+        if (offset > file->size() || size > file->size() - offset)
+        {
+            throw ngraph_error("Constant data at offset " + to_string(offset) + " with size " +
+                               to_string(size) + " exceeds the size of '" + path + "'");
+        }
+        const char* data = file->data() + offset;
+        if (size == 0 || reinterpret_cast<uintptr_t>(data) % s_constant_alignment == 0)
+        {
+            shared_ptr<ConstantBuffer> buffer(new ConstantBuffer(data, size, file));
+            m_lazy_buffers[key] = buffer;
+            return buffer;
+        }
+    }
+#endif
+    return from_file(path, offset, size);
+}
+
+shared_ptr<ConstantBuffer> ConstantStore::from_generator(const string& key,
+                                                         size_t size,
+                                                         ConstantBuffer::Generator generator)
+{
+    return find_or_insert_lazy("generator:" + key, size, generator);
+}
+
+shared_ptr<ConstantBuffer> ConstantStore::find_or_insert_lazy(const string& key,
+                                                              size_t size,
+                                                              ConstantBuffer::Generator generator)
+{
+    lock_guard<mutex> lock(m_mutex);
+    auto it = m_lazy_buffers.find(key);
+    if (it != m_lazy_buffers.end())
+    {
+        if (shared_ptr<ConstantBuffer> buffer = it->second.lock())
+        {
+            if (buffer->size() != size)
+            {
+                throw ngraph_error("Constant buffer '" + key + "' requested with size " +
+                                   to_string(size) + " but has size " +
+                                   to_string(buffer->size()));
+            }
+            return buffer;
+        }
+    }
+    shared_ptr<ConstantBuffer> buffer(new ConstantBuffer(size, generator));
+    m_lazy_buffers[key] = buffer;
+    return buffer;
+}
+
+size_t ConstantStore::get_buffer_count()
+{
+    size_t count = 0;
+    lock_guard<mutex> lock(m_mutex);
+    for (auto it = m_content_buffers.begin(); it != m_content_buffers.end();)
+    {
+        if (it->second.expired())
+        {
+            it = m_content_buffers.erase(it);
+        }
+        else
+        {
+            count++;
+            ++it;
+        }
+    }
+    for (auto it = m_lazy_buffers.begin(); it != m_lazy_buffers.end();)
+    {
+        if (it->second.expired())
+        {
+            it = m_lazy_buffers.erase(it);
+        }
+        else
+        {
+            count++;
+            ++it;
+        }
+    }
+    return count;
+}
+
+size_t ConstantStore::get_total_bytes()
+{
+    size_t bytes = 0;
+    lock_guard<mutex> lock(m_mutex);
+    for (auto& p : m_content_buffers)
+    {
+        if (shared_ptr<ConstantBuffer> buffer = p.second.lock())
+        {
+            bytes += buffer->size();
+        }
+    }
+    for (auto& p : m_lazy_buffers)
+    {
+        if (shared_ptr<ConstantBuffer> buffer = p.second.lock())
+        {
+            bytes += buffer->size();
+        }
+    }
+    return bytes;
+}
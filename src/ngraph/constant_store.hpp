@@ -0,0 +1,126 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ngraph
+{
+    class ConstantBuffer;
+    class ConstantStore;
+}
+
+/// \brief An immutable, reference counted block of constant data.
+///
+/// Buffers are created by the ConstantStore and shared by every op::Constant holding the same
+/// data, including copies made by clone_function. A buffer may be lazy, in which case its data
+/// is read from a file or produced by a generator the first time get_data_ptr() is called.
+class ngraph::ConstantBuffer
+{
+public:
+    using Generator = std::function<void(void* target, size_t size)>;
+
+    ~ConstantBuffer();
+
+    /// \brief Returns the data, materializing the buffer if it is lazy. Thread safe.
+    const void* get_data_ptr() const;
+    size_t size() const { return m_size; }
+    bool is_materialized() const;
+
+private:
+    friend class ConstantStore;
+
+    ConstantBuffer(void* data, size_t size);
+    ConstantBuffer(size_t size, Generator generator);
+    // Refers to data kept alive by owner, such as a memory mapped file
+    ConstantBuffer(const void* data, size_t size, std::shared_ptr<const void> owner);
+    ConstantBuffer(const ConstantBuffer&) = delete;
+    ConstantBuffer& operator=(const ConstantBuffer&) = delete;
+
+    void materialize() const;
+
+    mutable void* m_data;
+    size_t m_size;
+    mutable Generator m_generator;
+    mutable std::once_flag m_materialize_flag;
+    mutable std::atomic<bool> m_materialized;
+    std::shared_ptr<const void> m_owner;
+};
+
+/// \brief Process wide, content addressed store of constant data.
+///
+/// Eager buffers are keyed by a hash of their content, so constants with identical data share
+/// one allocation no matter where they were created. Lazy buffers are keyed by their source,
+/// a file region or a caller supplied generator key, and are not merged with eager buffers.
+/// The store only holds weak references; a buffer is freed when the last Constant using it
+/// is destroyed.
+class ngraph::ConstantStore
+{
+public:
+    static ConstantStore& get();
+
+    /// \brief Returns a buffer holding a copy of size bytes at data.
+    std::shared_ptr<ConstantBuffer> intern(const void* data, size_t size);
+
+    /// \brief Like intern but takes ownership of data, which must have been allocated with
+    ///        ngraph::aligned_alloc. data is freed if an identical buffer already exists.
+    std::shared_ptr<ConstantBuffer> adopt(void* data, size_t size);
+
+    /// \brief Returns a buffer that reads size bytes at offset of the file at path when it is
+    ///        first accessed.
+    std::shared_ptr<ConstantBuffer>
+        from_file(const std::string& path, size_t offset, size_t size);
+
+    /// \brief Returns a buffer that refers directly to size bytes at offset of the file at
+    ///        path, which is memory mapped read-only and shared by all buffers of the file.
+    ///        Falls back to from_file when the data is not suitably aligned or the platform
+    ///        has no mmap. The file must not be modified while the buffer is alive.
+    std::shared_ptr<ConstantBuffer>
+        from_mapped_file(const std::string& path, size_t offset, size_t size);
+
+    /// \brief Returns a buffer filled by generator when it is first accessed. Buffers with the
+    ///        same key are shared, so key must identify the generated content.
+    std::shared_ptr<ConstantBuffer> from_generator(const std::string& key,
+                                                   size_t size,
+                                                   ConstantBuffer::Generator generator);
+
+    /// \brief Number of live buffers in the store
+    size_t get_buffer_count();
+    /// \brief Total size in bytes of all live buffers, including lazy buffers not yet read
+    size_t get_total_bytes();
+
+private:
+    ConstantStore() = default;
+
+    std::shared_ptr<ConstantBuffer> find_or_insert(void* data, size_t size, bool owned);
+    std::shared_ptr<ConstantBuffer> find_or_insert_lazy(const std::string& key,
+                                                        size_t size,
+                                                        ConstantBuffer::Generator generator);
+
+    std::mutex m_mutex;
+    std::unordered_multimap<uint64_t, std::weak_ptr<ConstantBuffer>> m_content_buffers;
+    std::unordered_map<std::string, std::weak_ptr<ConstantBuffer>> m_lazy_buffers;
+    std::unordered_map<std::string, std::weak_ptr<const void>> m_mapped_files;
+};
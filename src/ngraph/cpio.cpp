@@ -14,12 +14,76 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <limits>
+#include <sstream>
+
 #include "ngraph/cpio.hpp"
 #include "ngraph/log.hpp"
 
 using namespace ngraph;
 using namespace std;
 
+namespace
+{
+    // Reads the bytes [offset, offset + size) of a stream in chunks. Each refill seeks to
+    // where the previous one stopped, so the stream may be used for other reads in between.
+    class RecordBuffer : public streambuf
+    {
+    public:
+        RecordBuffer(istream& in, size_t offset, size_t size)
+            : m_stream(in)
+            , m_position(offset)
+            , m_end(offset + size)
+        {
+        }
+
+    protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr())
+            {
+                return traits_type::to_int_type(*gptr());
+            }
+            size_t count = min(m_buffer.size(), m_end - m_position);
+            if (count == 0)
+            {
+                return traits_type::eof();
+            }
+            m_stream.clear();
+            m_stream.seekg(m_position, ios_base::beg);
+            m_stream.read(m_buffer.data(), count);
+            count = static_cast<size_t>(m_stream.gcount());
+            if (count == 0)
+            {
+                return traits_type::eof();
+            }
+            m_position += count;
+            setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + count);
+            return traits_type::to_int_type(*gptr());
+        }
+
+    private:
+        istream& m_stream;
+        size_t m_position;
+        size_t m_end;
+        vector<char> m_buffer = vector<char>(64 * 1024);
+    };
+
+    class RecordStream : public istream
+    {
+    public:
+        RecordStream(istream& in, size_t offset, size_t size)
+            : istream(nullptr)
+            , m_buffer(in, offset, size)
+        {
+            rdbuf(&m_buffer);
+        }
+
+    private:
+        RecordBuffer m_buffer;
+    };
+}
+
 static uint16_t read_u16(istream& stream, bool big_endian = false)
 {
     uint8_t ch[2];
@@ -188,6 +252,48 @@ void cpio::Writer::write(const string& record_name, const void* data, uint32_t s
     }
 }
 
+void cpio::Writer::write(const string& record_name, const function<void(ostream&)>& write_data)
+{
+    if (!m_stream)
+    {
+        throw runtime_error("cpio writer output not set");
+    }
+
+    streampos header_position = m_stream->tellp();
+    if (header_position == streampos(-1))
+    {
+        // The output can not seek, so the file is sized in memory before it is written
+        stringstream buffer;
+        write_data(buffer);
+        string data = buffer.str();
+        if (data.size() > numeric_limits<uint32_t>::max())
+        {
+            throw runtime_error("cpio file " + record_name + " is larger than 4GB");
+        }
+        write(record_name, data.data(), static_cast<uint32_t>(data.size()));
+        return;
+    }
+
+    // Write the header with a placeholder size, stream the data, then patch the size
+    Header::write(*m_stream, record_name, 0);
+    streampos data_position = m_stream->tellp();
+    write_data(*m_stream);
+    streampos end_position = m_stream->tellp();
+    size_t size = static_cast<size_t>(end_position - data_position);
+    if (size > numeric_limits<uint32_t>::max())
+    {
+        throw runtime_error("cpio file " + record_name + " is larger than 4GB");
+    }
+    m_stream->seekp(header_position);
+    Header::write(*m_stream, record_name, static_cast<uint32_t>(size));
+    m_stream->seekp(end_position);
+    if (size % 2)
+    {
+        char ch = 0;
+        m_stream->write(&ch, 1);
+    }
+}
+
 cpio::Reader::Reader()
     : m_stream(nullptr)
 {
@@ -269,17 +375,27 @@ void cpio::Reader::read(const string& file_name, void* data, size_t size_in_byte
     {
         if (info.get_name() == file_name)
         {
-            if (size_in_bytes != info.get_size())
-            {
-                throw runtime_error("Buffer size does not match file size");
-            }
-            m_stream->seekg(info.get_offset(), ios_base::beg);
-            m_stream->read(reinterpret_cast<char*>(data), size_in_bytes);
+            read(info, data, size_in_bytes);
             break;
         }
     }
 }
 
+void cpio::Reader::read(const FileInfo& info, void* data, size_t size_in_bytes)
+{
+    if (size_in_bytes != info.get_size())
+    {
+        throw runtime_error("Buffer size does not match file size");
+    }
+    m_stream->seekg(info.get_offset(), ios_base::beg);
+    m_stream->read(reinterpret_cast<char*>(data), size_in_bytes);
+}
+
+unique_ptr<istream> cpio::Reader::open_stream(const FileInfo& info)
+{
+    return unique_ptr<istream>(new RecordStream(*m_stream, info.get_offset(), info.get_size()));
+}
+
 bool cpio::is_cpio(const string& path)
 {
     ifstream in(path, ios_base::binary | ios_base::in);
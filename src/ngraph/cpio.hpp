@@ -17,7 +17,9 @@
 #pragma once
 
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -89,6 +91,12 @@ public:
     void open(std::ostream& out);
     void open(const std::string& filename);
     void write(const std::string& file_name, const void* data, uint32_t size_in_bytes);
+    /// \brief Writes a file whose contents write_data streams straight to the archive.
+    ///
+    /// write_data is called once. The size in the header is patched after the data is
+    /// written, or, when the output can not seek, the data is buffered to size it first.
+    void write(const std::string& file_name,
+               const std::function<void(std::ostream&)>& write_data);
 
 private:
     std::ostream* m_stream;
@@ -108,6 +116,10 @@ public:
     void close();
     const std::vector<FileInfo>& get_file_info();
     void read(const std::string& file_name, void* data, size_t size_in_bytes);
+    void read(const FileInfo& info, void* data, size_t size_in_bytes);
+    /// \brief Returns a stream that reads the file in chunks. Other reads from this archive
+    /// may be interleaved with reads from the returned stream.
+    std::unique_ptr<std::istream> open_stream(const FileInfo& info);
 
 private:
     std::istream* m_stream;
@@ -47,6 +47,7 @@ void Input::replace_output(Output& new_output)
         // if a new input violates one of the type checks in the c-tor.
         (this->m_node->copy_with_new_args(this->m_node->get_arguments()));
     }
+    m_node->notify_graph_changed();
 }
 
 void Input::replace_output(std::shared_ptr<Node> node, size_t i)
@@ -46,6 +46,8 @@ namespace ngraph
             Node* get_raw_pointer_node() const { return m_node; }
             /// \return the position within all supplied tensors of this input
             size_t get_index() const { return m_index; }
+            /// \return the node that owns the connected output
+            const std::shared_ptr<Node>& get_source_node() const { return m_src_node; }
             /// \return the connected output
             const Output& get_output() const { return *m_output; }
             /// \return the connected output
@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <cassert>
+#include <cstdlib>
 #ifdef _WIN32
 #include <windows.h>
 #else
@@ -379,3 +380,24 @@ bool file_util::exists(const string& filename)
     struct stat buffer;
     return (stat(filename.c_str(), &buffer) == 0);
 }
+
+string file_util::get_canonical_path(const string& path)
+{
+#ifdef _WIN32
+    char resolved[MAX_PATH];
+    if (_fullpath(resolved, path.c_str(), MAX_PATH) == nullptr || !exists(resolved))
+    {
+        return string();
+    }
+    return resolved;
+#else
+    char* resolved = realpath(path.c_str(), nullptr);
+    if (resolved == nullptr)
+    {
+        return string();
+    }
+    string rc = resolved;
+    free(resolved);
+    return rc;
+#endif
+}
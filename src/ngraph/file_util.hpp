@@ -95,5 +95,10 @@ namespace ngraph
         /// \param path The path to test
         /// \return true if the path exists, false otherwise
         bool exists(const std::string& path);
+
+        /// \brief Resolve a path to an absolute path without symbolic links or . and .. segments
+        /// \param path The path of an existing file or directory
+        /// \return The resolved path, or an empty string if the path does not exist
+        std::string get_canonical_path(const std::string& path);
     }
 }
@@ -16,10 +16,15 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <onnx-ml.pb.h>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "ngraph/constant_store.hpp"
+#include "ngraph/file_util.hpp"
 #include "ngraph/op/constant.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/type/element_type.hpp"
@@ -91,6 +96,25 @@ namespace ngraph
                     }
                 };
 
+                struct invalid_external_data : ngraph_error
+                {
+                    explicit invalid_external_data(const std::string& tensor_name)
+                        : ngraph_error{"tensor " + tensor_name +
+                                       " has external data without a location"}
+                    {
+                    }
+                };
+
+                struct invalid_external_data_location : ngraph_error
+                {
+                    invalid_external_data_location(const std::string& tensor_name,
+                                                   const std::string& location)
+                        : ngraph_error{"tensor " + tensor_name + " has external data at " +
+                                       location + ", which is outside the model directory"}
+                    {
+                    }
+                };
+
             } // namespace tensor
 
         } // namespace error
@@ -124,6 +148,56 @@ namespace ngraph
                     throw error::tensor::unsupported_data_type{tensor.data_type()};
                 }
 
+                // IEEE 754 half precision bits to float
+                inline float half_to_float(std::uint16_t half)
+                {
+                    std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000) << 16;
+                    std::uint32_t exponent = (half >> 10) & 0x1f;
+                    std::uint32_t mantissa = half & 0x3ff;
+                    std::uint32_t bits;
+                    if (exponent == 0x1f)
+                    {
+                        // Infinity or NaN
+                        bits = sign | 0x7f800000 | (mantissa << 13);
+                    }
+                    else if (exponent != 0)
+                    {
+                        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+                    }
+                    else if (mantissa == 0)
+                    {
+                        bits = sign;
+                    }
+                    else
+                    {
+                        // Subnormal half, normal float
+                        exponent = 113;
+                        while ((mantissa & 0x400) == 0)
+                        {
+                            mantissa <<= 1;
+                            exponent--;
+                        }
+                        bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+                    }
+                    float value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    return value;
+                }
+
+                // Widens count packed float16 values to T
+                template <typename T>
+                inline std::vector<T> get_float16_data(const void* data, std::size_t count)
+                {
+                    std::vector<T> values(count);
+                    for (std::size_t i = 0; i < count; i++)
+                    {
+                        std::uint16_t half;
+                        std::memcpy(&half, static_cast<const char*>(data) + 2 * i, 2);
+                        values[i] = static_cast<T>(half_to_float(half));
+                    }
+                    return values;
+                }
+
                 template <>
                 inline std::vector<double> get_data(const onnx::TensorProto& tensor)
                 {
@@ -320,9 +394,12 @@ namespace ngraph
             };
 
             Tensor() = delete;
-            explicit Tensor(const onnx::TensorProto& tensor)
+            /// \param tensor     The tensor protobuf representation object.
+            /// \param model_dir  Directory that locations of external data are relative to.
+            explicit Tensor(const onnx::TensorProto& tensor, const std::string& model_dir = "")
                 : m_tensor_proto{&tensor}
                 , m_shape{std::begin(tensor.dims()), std::end(tensor.dims())}
+                , m_model_dir{model_dir}
             {
             }
 
@@ -340,9 +417,38 @@ namespace ngraph
                 {
                     throw error::tensor::segments_unsupported{};
                 }
+                // Raw and external float16 data holds packed halves, widened element by element
+                bool is_float16 =
+                    m_tensor_proto->data_type() == onnx::TensorProto_DataType_FLOAT16;
+                if (has_external_data())
+                {
+                    std::shared_ptr<ConstantBuffer> buffer = get_external_data();
+                    if (is_float16)
+                    {
+                        return detail::tensor::get_float16_data<T>(buffer->get_data_ptr(),
+                                                                   buffer->size() / 2);
+                    }
+                    auto it = static_cast<const T*>(buffer->get_data_ptr());
+                    return {it, it + (buffer->size() / sizeof(T))};
+                }
+                if (is_float16 && m_tensor_proto->has_raw_data())
+                {
+                    const std::string& raw_data = m_tensor_proto->raw_data();
+                    return detail::tensor::get_float16_data<T>(raw_data.data(),
+                                                               raw_data.size() / 2);
+                }
                 return detail::tensor::get_data<T>(*m_tensor_proto);
             }
 
+            /// \brief Check whether the tensor data is stored in a file next to the model,
+            ///        as described by its external_data entries.
+            bool has_external_data() const
+            {
+                return m_tensor_proto->has_data_location() &&
+                       m_tensor_proto->data_location() ==
+                           onnx::TensorProto_DataLocation::TensorProto_DataLocation_EXTERNAL;
+            }
+
             const std::string& get_name() const
             {
                 if (!m_tensor_proto->has_name())
@@ -423,11 +529,108 @@ namespace ngraph
             template <typename T>
             std::shared_ptr<ngraph::op::Constant> make_ng_constant(const element::Type& type) const
             {
+                // Except for float16, which is widened to f32, raw and external data are laid
+                // out exactly like the Constant's buffer and are handed over without first
+                // being converted to a vector.
+                if (m_tensor_proto->data_type() != onnx::TensorProto_DataType_FLOAT16 &&
+                    !m_tensor_proto->has_segment())
+                {
+                    if (has_external_data())
+                    {
+                        return std::make_shared<ngraph::op::Constant>(
+                            type, m_shape, get_external_data());
+                    }
+                    if (m_tensor_proto->has_raw_data() &&
+                        m_tensor_proto->raw_data().size() == shape_size(m_shape) * type.size())
+                    {
+                        return std::make_shared<ngraph::op::Constant>(
+                            type, m_shape, m_tensor_proto->raw_data().data());
+                    }
+                }
                 return std::make_shared<ngraph::op::Constant>(type, m_shape, get_data<T>());
             }
 
+            // Maps the file region named by the external_data entries. Without a length entry
+            // the region holds exactly the tensor's elements.
+            std::shared_ptr<ConstantBuffer> get_external_data() const
+            {
+                std::string location;
+                std::size_t offset{0};
+                std::size_t element_size{
+                    m_tensor_proto->data_type() == onnx::TensorProto_DataType_FLOAT16
+                        ? 2
+                        : get_ng_type().size()};
+                std::size_t length{shape_size(m_shape) * element_size};
+                for (const auto& entry : m_tensor_proto->external_data())
+                {
+                    if (entry.key() == "location")
+                    {
+                        location = entry.value();
+                    }
+                    else if (entry.key() == "offset")
+                    {
+                        offset = std::stoull(entry.value());
+                    }
+                    else if (entry.key() == "length")
+                    {
+                        length = std::stoull(entry.value());
+                    }
+                }
+                if (location.empty())
+                {
+                    throw error::tensor::invalid_external_data{m_tensor_proto->name()};
+                }
+                std::string path =
+                    m_model_dir.empty() ? location : file_util::path_join(m_model_dir, location);
+                if (!is_inside_model_dir(location, path))
+                {
+                    throw error::tensor::invalid_external_data_location{m_tensor_proto->name(),
+                                                                        location};
+                }
+                return ConstantStore::get().from_mapped_file(path, offset, length);
+            }
+
+            // A location must be a relative path, with no root, drive or .. segment, and must not
+            // lead out of the model directory through a symbolic link either.
+            bool is_inside_model_dir(const std::string& location, const std::string& path) const
+            {
+                if (location.front() == '/' || location.front() == '\\' ||
+                    location.find(':') != std::string::npos)
+                {
+                    return false;
+                }
+                std::size_t begin = 0;
+                while (begin <= location.size())
+                {
+                    std::size_t end = location.find_first_of("/\\", begin);
+                    if (end == std::string::npos)
+                    {
+                        end = location.size();
+                    }
+                    if (location.compare(begin, end - begin, "..") == 0)
+                    {
+                        return false;
+                    }
+                    begin = end + 1;
+                }
+
+                // A missing file is reported when it is mapped
+                std::string real_path = file_util::get_canonical_path(path);
+                if (real_path.empty())
+                {
+                    return true;
+                }
+                std::string real_dir =
+                    file_util::get_canonical_path(m_model_dir.empty() ? "." : m_model_dir);
+                return real_path.size() > real_dir.size() &&
+                       real_path.compare(0, real_dir.size(), real_dir) == 0 &&
+                       (real_path[real_dir.size()] == '/' || real_path[real_dir.size()] == '\\' ||
+                        real_dir.back() == '/' || real_dir.back() == '\\');
+            }
+
             const onnx::TensorProto* m_tensor_proto;
             Shape m_shape;
+            std::string m_model_dir;
         };
 
         inline std::ostream& operator<<(std::ostream& outs, const Tensor& tensor)
@@ -49,24 +49,41 @@ namespace ngraph
                 };
 
             } // namespace error
-        }     // namespace detail
 
-        std::shared_ptr<Function> import_onnx_model(std::istream& sin, const Weights& weights)
-        {
-            onnx::ModelProto model_proto;
-            if (!model_proto.ParseFromIstream(&sin))
+            static std::string get_model_dir(const std::string& path)
             {
-                throw detail::error::stream_parse{sin};
+                auto pos = path.find_last_of("/\\");
+                return pos == std::string::npos ? std::string{} : path.substr(0, pos);
             }
-            Model model{model_proto};
-            Graph graph{model_proto.graph(), model, weights};
-            auto function = std::make_shared<Function>(
-                graph.get_ng_outputs(), graph.get_ng_parameters(), graph.get_name());
-            for (std::size_t i{0}; i < function->get_output_size(); ++i)
+
+            // The protobuf, including any tensor data embedded in it, is released as soon as
+            // the graph has been converted. Tensors with external data are memory mapped and
+            // never copied.
+            std::shared_ptr<Function> import_onnx_model(std::istream& sin,
+                                                        const std::string& model_dir,
+                                                        const Weights& weights)
             {
-                function->get_output_op(i)->set_friendly_name(graph.get_outputs().at(i).get_name());
+                onnx::ModelProto model_proto;
+                if (!model_proto.ParseFromIstream(&sin))
+                {
+                    throw error::stream_parse{sin};
+                }
+                Model model{model_proto, model_dir};
+                Graph graph{model_proto.graph(), model, weights};
+                auto function = std::make_shared<Function>(
+                    graph.get_ng_outputs(), graph.get_ng_parameters(), graph.get_name());
+                for (std::size_t i{0}; i < function->get_output_size(); ++i)
+                {
+                    function->get_output_op(i)->set_friendly_name(
+                        graph.get_outputs().at(i).get_name());
+                }
+                return function;
             }
-            return function;
+        } // namespace detail
+
+        std::shared_ptr<Function> import_onnx_model(std::istream& sin, const Weights& weights)
+        {
+            return detail::import_onnx_model(sin, "", weights);
         }
 
         std::shared_ptr<Function> import_onnx_model(const std::string& path, const Weights& weights)
@@ -76,7 +93,7 @@ namespace ngraph
             {
                 throw detail::error::file_open{path};
             }
-            return import_onnx_model(ifs, weights);
+            return detail::import_onnx_model(ifs, detail::get_model_dir(path), weights);
         }
 
         void register_operator(const std::string& name,
@@ -66,7 +66,8 @@ namespace ngraph
 
         /// \brief Convert an ONNX model to nGraph function
         /// The function translated serialized ONNX model to nGraph function. The serialized
-        /// ONNX model is read from input stream.
+        /// ONNX model is read from input stream. Tensors whose data is stored in external files
+        /// are located relative to the current working directory.
         /// \param sin       input stream (e.g. file stream, memory stream, etc),
         /// \param weights  weights associated with the model. If weights are embedded into
         ///                   the model this parameter shall be empty. Having weights in a model
@@ -77,7 +78,8 @@ namespace ngraph
 
         /// \brief Convert an ONNX model to nGraph functions
         /// The function translated serialized ONNX model to nGraph functions. The ONNX model
-        /// is read from ONNX file.
+        /// is read from ONNX file. Tensors whose data is stored in external files are located
+        /// relative to the directory of the model file and are memory mapped.
         /// \param filename  file name (relative or absolute path name),
         /// \param weights  weights associated with the model. If weights are embedded into
         ///                   the model this parameter shall be empty. Having weights in a model
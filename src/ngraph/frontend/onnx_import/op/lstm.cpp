@@ -138,8 +138,6 @@ namespace ngraph
                         const auto& ng_inputs = node.get_ng_inputs();
                         // We have input, output, forget and cell gates
                         constexpr std::size_t gates_count{4};
-                        // Peepholes add additional connections to input, output and forget gates.
-                        constexpr std::size_t peepholes_count{3};
 
                         // ----- Mandatory inputs ------
                         // Packed input sequences. Shape: [seq_length, batch_size, input_size]
@@ -203,16 +201,15 @@ namespace ngraph
                                 element::f32, {num_directions, batch_size, hidden_size}, {0.f});
                         }
                         // The weight tensor for peepholes. Shape [num_directions, 3*hidde_size]
+                        // Without peepholes the gates have no cell state terms at all, so no
+                        // zero weights are made up for them.
                         if (ng_inputs.size() > 7 && !ng_inputs.at(7)->is_null())
                         {
                             m_map[LSTMInput::LSTM_INPUT_P] = ng_inputs.at(7);
                         }
                         else
                         {
-                            m_map[LSTMInput::LSTM_INPUT_P] = common::make_constant_node<float>(
-                                element::f32,
-                                {num_directions, peepholes_count * hidden_size},
-                                {0.f});
+                            m_map[LSTMInput::LSTM_INPUT_P] = nullptr;
                         }
                     }
 
@@ -300,7 +297,7 @@ namespace ngraph
                         , m_W{reshape::squeeze(W)}
                         , m_R{reshape::squeeze(R)}
                         , m_B{reshape::squeeze(B)}
-                        , m_P{reshape::squeeze(P)}
+                        , m_P{P ? reshape::squeeze(P) : nullptr}
                         , m_initial_h{reshape::squeeze(initial_h)}
                         , m_initial_c{reshape::squeeze(initial_c)}
                         , m_seq_lengths{seq_lengths}
@@ -344,14 +341,27 @@ namespace ngraph
                         // C_t     - Cell state vector at current time step.
                         // h_list  - The list of hidden states at all processed time steps.
                         //
+                        // X_W     - Input sequence multiplied by weights tensor at all time steps.
                         // Xt_W    - Input sequence multiplied by weights tensor at current time
                         //           step.
                         // Ht_R    - Hidden state multiplied by weights tensor at current time step.
 
-                        NodeVector p_iof = reshape::split(m_P, 3);
-                        const auto& p_i = p_iof.at(0);
-                        const auto& p_o = p_iof.at(1);
-                        const auto& p_f = p_iof.at(2);
+                        // Peephole connections are only added when the P input is given.
+                        std::shared_ptr<ngraph::Node> p_i;
+                        std::shared_ptr<ngraph::Node> p_o;
+                        std::shared_ptr<ngraph::Node> p_f;
+                        if (m_P)
+                        {
+                            NodeVector p_iof = reshape::split(m_P, 3);
+                            p_i = p_iof.at(0);
+                            p_o = p_iof.at(1);
+                            p_f = p_iof.at(2);
+                        }
+                        auto peephole = [](const std::shared_ptr<ngraph::Node>& gate,
+                                           const std::shared_ptr<ngraph::Node>& p,
+                                           const std::shared_ptr<ngraph::Node>& C) {
+                            return p ? add(gate, mul(p, C)) : gate;
+                        };
                         NodeVector h_list;
 
                         NodeVector b_W_R = reshape::split(m_B, 2);
@@ -364,33 +374,33 @@ namespace ngraph
                             m_X = std::make_shared<ngraph::op::Reverse>(m_X, AxisSet{0});
                         }
 
+                        // The input projection does not depend on the recurrence, so it is done
+                        // for all the time steps in a single GEMM and sliced per step.
+                        // X*(W^T) -- for [iofc] gates. [seq_length*batch_size, 4*hidden_size]
+                        const Shape& x_shape = m_X->get_shape();
+                        const std::size_t seq_length = x_shape.at(0);
+                        auto X_W = std::make_shared<ngraph::op::Dot>(
+                            reshape::reshape(
+                                m_X, Shape{seq_length * x_shape.at(1), x_shape.at(2)}),
+                            reshape::transpose(m_W));
                         NodeVector in_seqs{};
-                        if (m_X->get_shape().at(0) != 1)
+                        if (seq_length != 1)
                         {
-                            in_seqs = reshape::split(m_X, m_X->get_shape().at(0));
+                            in_seqs = reshape::split(X_W, seq_length);
                         }
                         else
                         {
-                            in_seqs = NodeVector{m_X};
+                            in_seqs = NodeVector{X_W};
                         }
+                        auto R_T = reshape::transpose(m_R);
 
-                        for (auto& in_x : in_seqs)
-                        {
-                            // remove first empty dim, after above split.
-                            in_x = reshape::squeeze(in_x);
-                        }
-
-                        for (const auto& in_x : in_seqs)
+                        for (const auto& Xt_W : in_seqs)
                         {
                             // (.) - Denotes element-wise multiplication.
                             // *   - Denotes dot product.
 
-                            // Xt*(W^T) -- for [iofc] gates.
-                            auto Xt_W =
-                                std::make_shared<ngraph::op::Dot>(in_x, reshape::transpose(m_W));
                             // Ht-1*(R^T)  -- for [iofc] gates.
-                            auto Ht_R =
-                                std::make_shared<ngraph::op::Dot>(H_t, reshape::transpose(m_R));
+                            auto Ht_R = std::make_shared<ngraph::op::Dot>(H_t, R_T);
                             // Xt*(W^T) + Ht-1*(R^T) + Wb + Rb  -- for [iofc] gates.
                             auto gates = add(Xt_W, add(Ht_R, bias));
 
@@ -401,7 +411,7 @@ namespace ngraph
                             auto c = split_gates.at(3);
 
                             // f(Xt*(Wi^T) + Ht-1*(Ri^T) + Pi (.) Ct-1 + Wbi + Rbi)
-                            i = m_activation_f(clip(add(i, mul(p_i, C_t)), m_clip_threshold));
+                            i = m_activation_f(clip(peephole(i, p_i, C_t), m_clip_threshold));
                             if (m_input_forget)
                             {
                                 // Couple input with forget gate: 1 - i
@@ -414,13 +424,13 @@ namespace ngraph
                             else
                             {
                                 // f(Xt*(Wf^T) + Ht-1*(Rf^T) + Pf (.) Ct-1 + Wbf + Rbf)
-                                f = m_activation_f(clip(add(f, mul(p_f, C_t)), m_clip_threshold));
+                                f = m_activation_f(clip(peephole(f, p_f, C_t), m_clip_threshold));
                             }
                             // ft (.) Ct-1 + it (.) ct
                             auto C =
                                 add(mul(f, C_t), mul(i, m_activation_g(clip(c, m_clip_threshold))));
                             // f(Xt*(Wo^T) + Ht-1*(Ro^T) + Po (.) Ct + Wbo + Rbo)
-                            o = m_activation_f(clip(add(o, mul(p_o, C)), m_clip_threshold));
+                            o = m_activation_f(clip(peephole(o, p_o, C), m_clip_threshold));
                             // ot (.) h(Ct)
                             auto H = mul(o, m_activation_h(C));
                             h_list.push_back(H);
@@ -516,7 +526,11 @@ namespace ngraph
                         NodeVector W{reshape::split(input_map.at(LSTMInput::LSTM_INPUT_W), 2)};
                         NodeVector R{reshape::split(input_map.at(LSTMInput::LSTM_INPUT_R), 2)};
                         NodeVector B{reshape::split(input_map.at(LSTMInput::LSTM_INPUT_B), 2)};
-                        NodeVector P{reshape::split(input_map.at(LSTMInput::LSTM_INPUT_P), 2)};
+                        NodeVector P{nullptr, nullptr};
+                        if (input_map.at(LSTMInput::LSTM_INPUT_P))
+                        {
+                            P = reshape::split(input_map.at(LSTMInput::LSTM_INPUT_P), 2);
+                        }
                         NodeVector H{reshape::split(input_map.at(LSTMInput::LSTM_INPUT_INIT_H), 2)};
                         NodeVector C{reshape::split(input_map.at(LSTMInput::LSTM_INPUT_INIT_C), 2)};
 
@@ -548,7 +562,7 @@ namespace ngraph
                                                   attributes.m_clip_threshold);
 
                         NodeVector fwd_results{lstm_fwd.run()};
-                        NodeVector rev_results{lstm_fwd.run(true)};
+                        NodeVector rev_results{lstm_reversed.run(true)};
 
                         // Stack together respective outputs from both forward and reverse passess.
                         std::shared_ptr<ngraph::Node> Y{std::make_shared<ngraph::op::Concat>(
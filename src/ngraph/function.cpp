@@ -17,6 +17,8 @@
 #include <algorithm>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
@@ -28,6 +30,26 @@ using namespace ngraph;
 
 atomic<size_t> Function::m_next_instance_id(0);
 
+class Function::OrderCache : public GraphListener
+{
+public:
+    void on_graph_changed() override { clear(); }
+    void clear()
+    {
+        // Released after unlocking, dropping the last reference to an op destroys it
+        OrderCacheEntry entries[2];
+        {
+            lock_guard<mutex> lock(m_mutex);
+            swap(entries[0], m_entries[0]);
+            swap(entries[1], m_entries[1]);
+        }
+    }
+
+    mutex m_mutex;
+    // Indexed by include_control_deps
+    OrderCacheEntry m_entries[2];
+};
+
 Function::Function(const ResultVector& results,
                    const ParameterVector& parameters,
                    const std::string& name)
@@ -83,6 +105,7 @@ void Function::validate_nodes_and_infer_types()
 
 void Function::init()
 {
+    m_order_cache = make_shared<OrderCache>();
     validate_nodes_and_infer_types();
 
     traverse_nodes(this,
@@ -99,9 +122,120 @@ void Function::init()
                    true /*include control dependencies*/);
 }
 
-std::list<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_deps) const
+// Returns true if order contains exactly the nodes in ops and every node comes after its
+// arguments and, if include_control_deps is set, its control dependencies
+static bool is_topological_order(const list<shared_ptr<Node>>& order,
+                                 const list<shared_ptr<Node>>& ops,
+                                 bool include_control_deps)
+{
+    if (order.size() != ops.size())
+    {
+        return false;
+    }
+    unordered_set<Node*> all_ops;
+    for (const shared_ptr<Node>& node : ops)
+    {
+        all_ops.insert(node.get());
+    }
+    unordered_set<Node*> seen;
+    for (const shared_ptr<Node>& node : order)
+    {
+        if (all_ops.count(node.get()) == 0)
+        {
+            return false;
+        }
+        for (const shared_ptr<Node>& arg : node->get_argument_range())
+        {
+            if (seen.count(arg.get()) == 0)
+            {
+                return false;
+            }
+        }
+        if (include_control_deps)
+        {
+            for (const shared_ptr<Node>& dep : node->get_control_dependencies())
+            {
+                if (seen.count(dep.get()) == 0)
+                {
+                    return false;
+                }
+            }
+        }
+        seen.insert(node.get());
+    }
+    return true;
+}
+
+Function::OrderCacheEntry& Function::get_order_cache(bool include_control_deps) const
+{
+    OrderCacheEntry& cache = m_order_cache->m_entries[include_control_deps ? 1 : 0];
+    if (!cache.m_order)
+    {
+        list<shared_ptr<Node>> ops = get_ops(include_control_deps);
+        shared_ptr<list<shared_ptr<Node>>> order;
+        if (!m_pinned_order.empty() &&
+            is_topological_order(m_pinned_order, ops, include_control_deps))
+        {
+            order = make_shared<list<shared_ptr<Node>>>(m_pinned_order);
+        }
+        else
+        {
+            if (include_control_deps)
+            {
+                // The pinned order no longer matches the graph, don't keep its ops alive
+                m_pinned_order.clear();
+            }
+            order =
+                make_shared<list<shared_ptr<Node>>>(topological_sort(ops, include_control_deps));
+        }
+        // Any rewiring of a cached op can change the order
+        for (const shared_ptr<Node>& op : *order)
+        {
+            op->add_graph_listener(m_order_cache);
+        }
+        cache.m_order = order;
+        cache.m_index.clear();
+    }
+    return cache;
+}
+
+OrderedOps Function::get_ordered_ops(bool include_control_deps) const
 {
-    return topological_sort(get_ops(include_control_deps), include_control_deps);
+    lock_guard<mutex> lock(m_order_cache->m_mutex);
+    return OrderedOps(get_order_cache(include_control_deps).m_order);
+}
+
+size_t Function::get_ordered_op_index(const Node* node, bool include_control_deps) const
+{
+    lock_guard<mutex> lock(m_order_cache->m_mutex);
+    OrderCacheEntry& cache = get_order_cache(include_control_deps);
+    if (cache.m_index.empty())
+    {
+        size_t index = 0;
+        for (const shared_ptr<Node>& op : *cache.m_order)
+        {
+            cache.m_index[op.get()] = index++;
+        }
+    }
+    auto it = cache.m_index.find(node);
+    if (it == cache.m_index.end())
+    {
+        throw ngraph_error("Node is not an op of function " + get_name());
+    }
+    return it->second;
+}
+
+void Function::set_ordered_ops(const list<shared_ptr<Node>>& ops)
+{
+    if (!is_topological_order(ops, get_ops(true), true))
+    {
+        throw ngraph_error("Function op order must be a topological order of all its ops");
+    }
+    {
+        lock_guard<mutex> lock(m_order_cache->m_mutex);
+        m_pinned_order = ops;
+    }
+    m_order_cache->clear();
 }
 
 const std::string& Function::get_friendly_name() const
@@ -192,6 +326,15 @@ void Function::replace_node(std::shared_ptr<Node> old, std::shared_ptr<Node> rep
     ngraph::replace_node(old, repl);
 }
 
+void Function::remove_result(size_t i)
+{
+    shared_ptr<op::Result> result = m_results.at(i);
+    m_results.erase(m_results.begin() + i);
+    descriptor::Input& input = result->get_inputs().at(0);
+    input.get_output().remove_input(&input);
+    m_order_cache->clear();
+}
+
 size_t Function::get_graph_size() const
 {
     size_t total_size = 0;
@@ -21,6 +21,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ngraph/node.hpp"
@@ -29,6 +30,31 @@
 
 namespace ngraph
 {
+    /// \brief Read-only view of the op order cached by a function. The view shares the cached
+    ///        list rather than copying it. It stays valid while the function is modified but
+    ///        does not see the modification, and keeps its ops alive until it is destroyed.
+    class OrderedOps
+    {
+    public:
+        using const_iterator = std::list<std::shared_ptr<Node>>::const_iterator;
+        using iterator = const_iterator;
+
+        OrderedOps(const std::shared_ptr<const std::list<std::shared_ptr<Node>>>& ops)
+            : m_ops(ops)
+        {
+        }
+        const_iterator begin() const { return m_ops->begin(); }
+        const_iterator end() const { return m_ops->end(); }
+        size_t size() const { return m_ops->size(); }
+        bool empty() const { return m_ops->empty(); }
+        const std::shared_ptr<Node>& front() const { return m_ops->front(); }
+        const std::shared_ptr<Node>& back() const { return m_ops->back(); }
+        operator const std::list<std::shared_ptr<Node>>&() const { return *m_ops; }
+
+    private:
+        std::shared_ptr<const std::list<std::shared_ptr<Node>>> m_ops;
+    };
+
     /// A user-defined function.
     class Function
     {
@@ -87,7 +113,22 @@ namespace ngraph
         const std::string& get_friendly_name() const;
 
         std::list<std::shared_ptr<Node>> get_ops(bool include_control_deps = true) const;
-        std::list<std::shared_ptr<Node>> get_ordered_ops(bool include_control_deps = true) const;
+        /// \brief Returns the ops of the function in topological order. The order is cached and
+        ///        only recomputed after a node of the function has been rewired, see
+        ///        Node::notify_graph_changed.
+        OrderedOps get_ordered_ops(bool include_control_deps = true) const;
+
+        /// \brief Returns the position of node in get_ordered_ops(include_control_deps), usable
+        ///        as a dense index for per-op side tables.
+        /// \throws ngraph_error if node is not an op of the function.
+        size_t get_ordered_op_index(const Node* node, bool include_control_deps = true) const;
+
+        /// \brief Pins the order returned by get_ordered_ops. Used by scheduling passes so that
+        ///        liveness, memory assignment and execution all see the same order. The pinned
+        ///        order is ignored once the graph is modified so that it no longer matches.
+        /// \param ops A topological order of all ops of the function, including control
+        ///        dependencies.
+        void set_ordered_ops(const std::list<std::shared_ptr<Node>>& ops);
         friend std::ostream& operator<<(std::ostream&, const Function&);
         size_t get_instance_id() { return m_instance_id; }
         size_t get_temporary_pool_size();
@@ -95,6 +136,10 @@ namespace ngraph
         // updates graph and m_results list
         void replace_node(std::shared_ptr<Node> old, std::shared_ptr<Node> repl);
 
+        /// \brief Removes output i from the function. The result is disconnected from its
+        ///        argument, so ops only it used are no longer part of the function.
+        void remove_result(size_t i);
+
         void validate_nodes_and_infer_types();
 
         /// \brief Returns the sum of the size of all nodes in the graph plus the size of
@@ -120,5 +165,17 @@ namespace ngraph
         std::string m_name;
         const std::string m_unique_name;
         size_t m_placement{0};
+        mutable std::list<std::shared_ptr<Node>> m_pinned_order;
+
+        // Cached orders, dropped as soon as one of the cached ops is rewired
+        class OrderCache;
+        struct OrderCacheEntry
+        {
+            std::shared_ptr<const std::list<std::shared_ptr<Node>>> m_order;
+            std::unordered_map<const Node*, size_t> m_index;
+        };
+        // Must be called with the cache mutex held
+        OrderCacheEntry& get_order_cache(bool include_control_deps) const;
+        std::shared_ptr<OrderCache> m_order_cache;
     };
 }
@@ -89,7 +89,7 @@ void ngraph::traverse_nodes(const NodeVector& io_nodes,
             f(n);
         }
         stack.pop_front();
-        for (auto arg : n->get_arguments())
+        for (const std::shared_ptr<Node>& arg : n->get_argument_range())
         {
             if (instances_seen.count(arg) == 0)
             {
@@ -14,10 +14,13 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <typeindex>
 #include <typeinfo>
+#include <unordered_set>
 
 #include "ngraph/autodiff/adjoints.hpp"
 #include "ngraph/descriptor/layout/tensor_layout.hpp"
@@ -31,12 +34,32 @@ using namespace std;
 using namespace ngraph;
 
 atomic<size_t> Node::m_next_instance_id(0);
+// Guards the graph listeners of all nodes, the graph of a function may be traversed while
+// another function sharing some of its nodes is traversed on a different thread
+static mutex s_graph_listeners_mutex;
+
+// Node type names are shared by every node of the type, so each distinct name is stored once
+static const string* intern_node_type(const string& node_type)
+{
+    static mutex intern_mutex;
+    static unordered_set<string> node_types;
+    lock_guard<mutex> lock(intern_mutex);
+    return &*node_types.insert(node_type).first;
+}
 
 Node::Node(const std::string& node_type, const NodeVector& arguments, size_t output_size)
-    : m_node_type(node_type)
+    : m_node_type(intern_node_type(node_type))
     , m_instance_id(m_next_instance_id.fetch_add(1))
     , m_unique_name(description() + "_" + to_string(m_instance_id))
 {
+    size_t input_count = 0;
+    for (auto& arg : arguments)
+    {
+        input_count += arg->get_output_size();
+    }
+    m_inputs.reserve(input_count);
+    m_outputs.reserve(output_size);
+
     // Add this node as a user of each argument.
     size_t i = 0;
     for (auto arg : arguments)
@@ -72,6 +95,7 @@ void Node::delayed_validate_and_infer_types()
 void Node::set_output_size(size_t n)
 {
     NGRAPH_ASSERT(n >= m_outputs.size()) << "shrinking " << m_outputs.size() << " to " << n;
+    m_outputs.reserve(n);
     for (size_t i = m_outputs.size(); i < n; ++i)
     {
         auto tensor_descriptor = make_shared<descriptor::Tensor>(
@@ -89,12 +113,12 @@ void Node::set_output_type(size_t i, const element::Type& element_type, const Pa
     m_outputs.at(i).get_tensor_ptr()->set_tensor_type(element_type, pshape);
 }
 
-std::deque<descriptor::Output>& Node::get_outputs()
+StableVector<descriptor::Output>& Node::get_outputs()
 {
     return m_outputs;
 }
 
-const std::deque<descriptor::Output>& Node::get_outputs() const
+const StableVector<descriptor::Output>& Node::get_outputs() const
 {
     return m_outputs;
 }
@@ -116,7 +140,7 @@ bool Node::is_constant() const
 
 const std::string& Node::description() const
 {
-    return m_node_type;
+    return *m_node_type;
 }
 
 const std::string& Node::get_friendly_name() const
@@ -203,6 +227,44 @@ const std::set<std::shared_ptr<Node>>& Node::get_control_dependencies() const
 void Node::add_control_dependency(std::shared_ptr<Node> node)
 {
     m_control_dependencies.insert(node);
+    notify_graph_changed();
+}
+
+void Node::add_graph_listener(const std::shared_ptr<GraphListener>& listener)
+{
+    lock_guard<mutex> lock(s_graph_listeners_mutex);
+    m_graph_listeners.erase(remove_if(m_graph_listeners.begin(),
+                                      m_graph_listeners.end(),
+                                      [](const weak_ptr<GraphListener>& l) { return l.expired(); }),
+                            m_graph_listeners.end());
+    for (const weak_ptr<GraphListener>& l : m_graph_listeners)
+    {
+        if (l.lock() == listener)
+        {
+            return;
+        }
+    }
+    m_graph_listeners.push_back(listener);
+}
+
+void Node::notify_graph_changed()
+{
+    // Listeners are called without the lock held since they may register with other nodes
+    vector<shared_ptr<GraphListener>> listeners;
+    {
+        lock_guard<mutex> lock(s_graph_listeners_mutex);
+        for (const weak_ptr<GraphListener>& l : m_graph_listeners)
+        {
+            if (auto listener = l.lock())
+            {
+                listeners.push_back(listener);
+            }
+        }
+    }
+    for (const shared_ptr<GraphListener>& listener : listeners)
+    {
+        listener->on_graph_changed();
+    }
 }
 
 std::vector<std::shared_ptr<Function>> Node::get_functions() const
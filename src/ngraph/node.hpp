@@ -19,6 +19,7 @@
 #include <atomic>
 #include <deque>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <set>
 #include <string>
@@ -36,6 +37,7 @@
 #include "ngraph/descriptor/tensor.hpp"
 #include "ngraph/node_vector.hpp"
 #include "ngraph/placement.hpp"
+#include "ngraph/stable_vector.hpp"
 
 namespace ngraph
 {
@@ -70,6 +72,136 @@ namespace ngraph
                                                          size_t i);
     const NodeVector& check_single_output_args(const NodeVector& args);
 
+    /// \brief Notified when an input of a node is rewired or a control dependency is added or
+    ///        removed. Owners of cached traversals, such as Function::get_ordered_ops, register
+    ///        with the nodes they traversed to learn that the cache is stale.
+    class GraphListener
+    {
+    public:
+        virtual ~GraphListener() {}
+        virtual void on_graph_changed() = 0;
+    };
+
+    /// \brief Allocation-free view of the nodes connected to a node's inputs, in input order.
+    ///        Yields the same nodes as Node::get_arguments() without building a NodeVector.
+    class NodeArgumentRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::shared_ptr<Node>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::shared_ptr<Node>*;
+            using reference = const std::shared_ptr<Node>&;
+
+            explicit iterator(StableVector<descriptor::Input>::const_iterator input)
+                : m_input(input)
+            {
+            }
+            reference operator*() const { return m_input->get_source_node(); }
+            pointer operator->() const { return &m_input->get_source_node(); }
+            iterator& operator++()
+            {
+                ++m_input;
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator result = *this;
+                ++m_input;
+                return result;
+            }
+            bool operator==(const iterator& other) const { return m_input == other.m_input; }
+            bool operator!=(const iterator& other) const { return m_input != other.m_input; }
+        private:
+            StableVector<descriptor::Input>::const_iterator m_input;
+        };
+
+        explicit NodeArgumentRange(const StableVector<descriptor::Input>& inputs)
+            : m_inputs(inputs)
+        {
+        }
+        iterator begin() const { return iterator(m_inputs.begin()); }
+        iterator end() const { return iterator(m_inputs.end()); }
+        size_t size() const { return m_inputs.size(); }
+        bool empty() const { return m_inputs.empty(); }
+    private:
+        const StableVector<descriptor::Input>& m_inputs;
+    };
+
+    /// \brief Allocation-free view of the nodes consuming a node's outputs. As with
+    ///        Node::get_users(), a user appears once per input connected to the node.
+    class NodeUserRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Node*;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Node* const*;
+            using reference = Node*;
+
+            iterator(StableVector<descriptor::Output>::const_iterator output,
+                     StableVector<descriptor::Output>::const_iterator output_end)
+                : m_output(output)
+                , m_output_end(output_end)
+            {
+                skip_unused_outputs();
+            }
+            reference operator*() const { return (*m_input)->get_raw_pointer_node(); }
+            iterator& operator++()
+            {
+                if (++m_input == m_output->get_inputs().end())
+                {
+                    ++m_output;
+                    skip_unused_outputs();
+                }
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator result = *this;
+                ++*this;
+                return result;
+            }
+            bool operator==(const iterator& other) const
+            {
+                return m_output == other.m_output &&
+                       (m_output == m_output_end || m_input == other.m_input);
+            }
+            bool operator!=(const iterator& other) const { return !(*this == other); }
+        private:
+            void skip_unused_outputs()
+            {
+                while (m_output != m_output_end && m_output->get_inputs().empty())
+                {
+                    ++m_output;
+                }
+                if (m_output != m_output_end)
+                {
+                    m_input = m_output->get_inputs().begin();
+                }
+            }
+
+            StableVector<descriptor::Output>::const_iterator m_output;
+            StableVector<descriptor::Output>::const_iterator m_output_end;
+            std::set<descriptor::Input*>::const_iterator m_input;
+        };
+
+        explicit NodeUserRange(const StableVector<descriptor::Output>& outputs)
+            : m_outputs(outputs)
+        {
+        }
+        iterator begin() const { return iterator(m_outputs.begin(), m_outputs.end()); }
+        iterator end() const { return iterator(m_outputs.end(), m_outputs.end()); }
+    private:
+        const StableVector<descriptor::Output>& m_outputs;
+    };
+
     /// Nodes are the backbone of the graph of Value dataflow. Every node has
     /// zero or more nodes as arguments and one value, which is either a tensor
     /// or a (possibly empty) tuple of values.
@@ -148,21 +280,23 @@ namespace ngraph
         virtual bool is_null() const { return false; }
         virtual bool is_op() const { return false; }
         virtual bool is_commutative() { return false; }
+        /// \return false if the node may produce different outputs for the same inputs
+        virtual bool is_deterministic() const { return true; }
         size_t get_instance_id() const { return m_instance_id; }
         friend std::ostream& operator<<(std::ostream&, const Node&);
         virtual std::ostream& write_short_description(std::ostream&) const;
         virtual std::ostream& write_long_description(std::ostream&) const;
 
         // TODO: Deprecate
-        std::deque<descriptor::Input>& get_inputs() { return m_inputs; }
+        StableVector<descriptor::Input>& get_inputs() { return m_inputs; }
         // TODO: Deprecate
-        const std::deque<descriptor::Input>& get_inputs() const { return m_inputs; }
+        const StableVector<descriptor::Input>& get_inputs() const { return m_inputs; }
         // Deprecated
         // TODO: Remove from unit tests.
-        std::deque<descriptor::Output>& get_outputs();
+        StableVector<descriptor::Output>& get_outputs();
         // Deprecated
         // TODO: Remove from unit tests.
-        const std::deque<descriptor::Output>& get_outputs() const;
+        const StableVector<descriptor::Output>& get_outputs() const;
 
         /// Get control dependencies registered on the node
         const std::set<std::shared_ptr<Node>>& get_control_dependencies() const;
@@ -172,8 +306,17 @@ namespace ngraph
         void remove_control_dependency(std::shared_ptr<Node> node)
         {
             m_control_dependencies.erase(node);
+            notify_graph_changed();
         }
 
+        /// \brief Registers listener to be notified when this node changes. The listener is held
+        ///        weakly and registering it again has no effect.
+        void add_graph_listener(const std::shared_ptr<GraphListener>& listener);
+        /// \brief Notifies the graph listeners of this node that an input was rewired or a
+        ///        control dependency changed. The node may be destroyed by a listener, so it
+        ///        must not be used after this call unless the caller holds a reference to it.
+        void notify_graph_changed();
+
         /// Returns the number of outputs on the for the node.
         size_t get_output_size() const;
 
@@ -224,6 +367,11 @@ namespace ngraph
 
         virtual NodeVector get_arguments() const;
 
+        /// \brief Same nodes as get_arguments(), without allocating a NodeVector.
+        NodeArgumentRange get_argument_range() const { return NodeArgumentRange(m_inputs); }
+        /// \brief Same nodes as get_users(), without allocating a NodeVector.
+        NodeUserRange get_user_range() const { return NodeUserRange(m_outputs); }
+
         std::shared_ptr<Node> get_argument(size_t index) const;
 
         virtual std::shared_ptr<Node> copy_with_new_args(const NodeVector& new_args) const = 0;
@@ -263,15 +411,16 @@ namespace ngraph
         std::set<std::shared_ptr<Node>> m_control_dependencies;
         void set_output_size(size_t n);
 
-        const std::string m_node_type;
+        // Interned, shared by all nodes of the same type
+        const std::string* m_node_type;
         size_t m_instance_id;
         std::string m_friendly_name;
         const std::string m_unique_name;
         static std::atomic<size_t> m_next_instance_id;
-        std::deque<descriptor::Input> m_inputs;
-        std::deque<descriptor::Output> m_outputs;
-        std::unordered_map<Node*, autodiff::Adjoints> m_adjoint_map;
+        StableVector<descriptor::Input> m_inputs;
+        StableVector<descriptor::Output> m_outputs;
         Placement m_placement = Placement::DEFAULT;
+        std::vector<std::weak_ptr<GraphListener>> m_graph_listeners;
         size_t m_placement_index = placement_invalid;
     };
 
@@ -19,6 +19,7 @@
 #include <cstring>
 #include <sstream>
 
+#include "ngraph/constant_store.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/node.hpp"
 #include "ngraph/type/bfloat16.hpp"
@@ -44,8 +45,6 @@ namespace ngraph
                 : Node("Constant", {})
                 , m_element_type(type)
                 , m_shape(shape)
-                , m_data(ngraph::aligned_alloc(m_element_type.size(),
-                                               shape_size(m_shape) * m_element_type.size()))
             {
                 NODE_VALIDATION_CHECK(
                     this,
@@ -80,8 +79,6 @@ namespace ngraph
                 : Node("Constant", {})
                 , m_element_type(type)
                 , m_shape(shape)
-                , m_data(ngraph::aligned_alloc(m_element_type.size(),
-                                               shape_size(m_shape) * m_element_type.size()))
             {
                 NODE_VALIDATION_CHECK(
                     this,
@@ -109,11 +106,35 @@ namespace ngraph
                 : Node("Constant", {})
                 , m_element_type(type)
                 , m_shape(shape)
-                , m_data(nullptr)
+                , m_buffer(ConstantStore::get().intern(
+                      data, shape_size(m_shape) * m_element_type.size()))
             {
-                size_t size = shape_size(m_shape) * m_element_type.size();
-                m_data = ngraph::aligned_alloc(m_element_type.size(), size);
-                std::memcpy(m_data, data, size);
+                constructor_validate_and_infer_types();
+            }
+
+            /// \brief Constructs a tensor constant sharing data held by the ConstantStore.
+            ///        The buffer is not read until the data is first accessed.
+            ///
+            /// \param type The element type of the tensor constant.
+            /// \param shape The shape of the tensor constant.
+            /// \param buffer The constant data. Its size must match type and shape.
+            Constant(const element::Type& type,
+                     const Shape& shape,
+                     const std::shared_ptr<ConstantBuffer>& buffer)
+                : Node("Constant", {})
+                , m_element_type(type)
+                , m_shape(shape)
+                , m_buffer(buffer)
+            {
+                NODE_VALIDATION_CHECK(this,
+                                      m_buffer != nullptr &&
+                                          m_buffer->size() ==
+                                              shape_size(m_shape) * m_element_type.size(),
+                                      "Constant buffer does not match a constant of type ",
+                                      m_element_type,
+                                      " and shape ",
+                                      m_shape,
+                                      ".");
                 constructor_validate_and_infer_types();
             }
 
@@ -168,7 +189,7 @@ namespace ngraph
                 }
 
                 std::vector<T> rc;
-                const T* p = reinterpret_cast<const T*>(m_data);
+                const T* p = get_data_ptr<T>();
                 for (size_t i = 0; i < shape_size(m_shape); i++)
                 {
                     rc.push_back(p[i]);
@@ -176,13 +197,19 @@ namespace ngraph
                 return rc;
             }
 
-            const void* get_data_ptr() const { return m_data; }
+            const void* get_data_ptr() const
+            {
+                return m_buffer ? m_buffer->get_data_ptr() : nullptr;
+            }
             template <typename T>
             const T* get_data_ptr() const
             {
-                return reinterpret_cast<T*>(m_data);
+                return reinterpret_cast<const T*>(get_data_ptr());
             }
 
+            /// \return The shared buffer holding the constant data.
+            const std::shared_ptr<ConstantBuffer>& get_buffer() const { return m_buffer; }
+
             bool is_constant() const override { return true; }
         protected:
             Constant(const std::string& name, const NodeVector& args)
@@ -195,7 +222,18 @@ namespace ngraph
             template <typename T>
             void write_values(const std::vector<T>& values)
             {
-                write_to_buffer(m_element_type, m_shape, values, m_data, shape_size(m_shape));
+                size_t size = shape_size(m_shape) * m_element_type.size();
+                void* data = ngraph::aligned_alloc(m_element_type.size(), size);
+                try
+                {
+                    write_to_buffer(m_element_type, m_shape, values, data, shape_size(m_shape));
+                }
+                catch (...)
+                {
+                    ngraph::aligned_free(data);
+                    throw;
+                }
+                m_buffer = ConstantStore::get().adopt(data, size);
             }
 
             template <typename T, typename U>
@@ -275,7 +313,7 @@ namespace ngraph
 
             element::Type m_element_type;
             Shape m_shape{};
-            void* m_data{nullptr};
+            std::shared_ptr<ConstantBuffer> m_buffer;
             Constant(const Constant&) = delete;
             Constant operator=(const Constant&) = delete;
         };
@@ -44,6 +44,7 @@ namespace ngraph
             double get_probability() const { return m_probability; }
             /// \brief Returns the seed value supplied to a random generator
             unsigned int get_seed() const { return m_seed; }
+            bool is_deterministic() const override { return false; }
         protected:
             virtual void generate_adjoints(autodiff::Adjoints& adjoints,
                                            const NodeVector& deltas) override
@@ -0,0 +1,247 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <unordered_set>
+#include <vector>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/pass/constant_evaluation.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/tensor.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+pass::ConstantEvaluation::ConstantEvaluation(size_t max_folded_bytes,
+                                             const string& backend_name)
+    : m_max_folded_bytes(max_folded_bytes)
+    , m_backend_name(backend_name)
+{
+}
+
+// Set while a constant subgraph is evaluated. The evaluating backend may run this pass when it
+// compiles the subgraph, which must not evaluate it again.
+static thread_local bool s_evaluating = false;
+
+// Returns the nodes of subgraph that nodes depend on, in the order of subgraph
+static list<shared_ptr<Node>> get_ancestors(const list<shared_ptr<Node>>& subgraph,
+                                            const NodeVector& nodes)
+{
+    unordered_set<Node*> ancestors;
+    vector<Node*> stack;
+    for (const shared_ptr<Node>& node : nodes)
+    {
+        stack.push_back(node.get());
+    }
+    while (!stack.empty())
+    {
+        Node* node = stack.back();
+        stack.pop_back();
+        if (ancestors.insert(node).second)
+        {
+            for (const shared_ptr<Node>& arg : node->get_arguments())
+            {
+                stack.push_back(arg.get());
+            }
+        }
+    }
+
+    list<shared_ptr<Node>> result;
+    for (const shared_ptr<Node>& node : subgraph)
+    {
+        if (ancestors.count(node.get()) != 0)
+        {
+            result.push_back(node);
+        }
+    }
+    return result;
+}
+
+// Evaluates nodes, which must only depend on constants in subgraph, and returns a constant
+// holding the value of each of them
+static vector<shared_ptr<op::Constant>> evaluate(runtime::Backend& backend,
+                                                 const list<shared_ptr<Node>>& subgraph,
+                                                 const NodeVector& nodes)
+{
+    NodeMap node_map;
+    clone_nodes(get_ancestors(subgraph, nodes), node_map);
+    NodeVector results;
+    for (const shared_ptr<Node>& node : nodes)
+    {
+        results.push_back(node_map.get(node));
+    }
+    auto function = make_shared<Function>(results, ParameterVector{});
+
+    vector<shared_ptr<runtime::Tensor>> outputs;
+    for (const shared_ptr<Node>& node : nodes)
+    {
+        outputs.push_back(backend.create_tensor(node->get_element_type(), node->get_shape()));
+    }
+    struct EvaluatingGuard
+    {
+        EvaluatingGuard() { s_evaluating = true; }
+        ~EvaluatingGuard() { s_evaluating = false; }
+    } guard;
+    auto executable = backend.compile(function);
+    executable->call(outputs, {});
+    backend.remove_compiled_function(executable);
+
+    vector<shared_ptr<op::Constant>> constants;
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        const shared_ptr<Node>& node = nodes[i];
+        size_t size = shape_size(node->get_shape()) * node->get_element_type().size();
+        vector<char> data(size);
+        outputs[i]->read(data.data(), 0, size);
+        constants.push_back(
+            make_shared<op::Constant>(node->get_element_type(), node->get_shape(), data.data()));
+    }
+    return constants;
+}
+
+// Evaluates nodes in one batch. When the batch fails, each half is evaluated on its own, so a
+// node the backend cannot evaluate costs a logarithmic number of retries and the other nodes
+// are still folded. The nodes that were evaluated are appended to folded, and their values to
+// constants.
+static void evaluate_batch(runtime::Backend& backend,
+                           const list<shared_ptr<Node>>& subgraph,
+                           const NodeVector& nodes,
+                           NodeVector& folded,
+                           vector<shared_ptr<op::Constant>>& constants)
+{
+    try
+    {
+        vector<shared_ptr<op::Constant>> values = evaluate(backend, subgraph, nodes);
+        folded.insert(folded.end(), nodes.begin(), nodes.end());
+        constants.insert(constants.end(), values.begin(), values.end());
+    }
+    catch (const exception& e)
+    {
+        if (nodes.size() == 1)
+        {
+            NGRAPH_DEBUG << "ConstantEvaluation: cannot evaluate " << nodes[0]->get_name() << ", "
+                         << e.what();
+            return;
+        }
+        auto middle = nodes.begin() + nodes.size() / 2;
+        NodeVector first(vector<shared_ptr<Node>>(nodes.begin(), middle));
+        NodeVector second(vector<shared_ptr<Node>>(middle, nodes.end()));
+        evaluate_batch(backend, subgraph, first, folded, constants);
+        evaluate_batch(backend, subgraph, second, folded, constants);
+    }
+}
+
+bool pass::ConstantEvaluation::run_on_function(shared_ptr<Function> function)
+{
+    if (s_evaluating)
+    {
+        return false;
+    }
+    list<shared_ptr<Node>> ops = function->get_ordered_ops();
+
+    // Single pass in topological order: a node is constant when all its arguments are
+    unique_ptr<runtime::Backend> backend;
+    unordered_set<Node*> constant;
+    list<shared_ptr<Node>> subgraph;
+    for (const shared_ptr<Node>& node : ops)
+    {
+        if (node->is_constant())
+        {
+            constant.insert(node.get());
+            subgraph.push_back(node);
+            continue;
+        }
+        if (node->is_parameter() || node->is_output() || node->get_arguments().empty() ||
+            !node->get_control_dependencies().empty() || !node->is_deterministic())
+        {
+            continue;
+        }
+        bool all_constant = true;
+        for (const shared_ptr<Node>& arg : node->get_arguments())
+        {
+            all_constant &= constant.count(arg.get()) != 0;
+        }
+        if (!all_constant)
+        {
+            continue;
+        }
+        bool fits = true;
+        for (size_t i = 0; i < node->get_output_size(); i++)
+        {
+            fits &= node->get_output_partial_shape(i).is_static() &&
+                    shape_size(node->get_output_shape(i)) *
+                            node->get_output_element_type(i).size() <=
+                        m_max_folded_bytes;
+        }
+        if (!fits)
+        {
+            continue;
+        }
+        if (!backend)
+        {
+            try
+            {
+                backend = runtime::Backend::create(m_backend_name);
+            }
+            catch (const exception& e)
+            {
+                NGRAPH_DEBUG << "ConstantEvaluation: " << m_backend_name
+                             << " backend not available, " << e.what();
+                return false;
+            }
+        }
+        if (backend->is_supported(*node))
+        {
+            constant.insert(node.get());
+            subgraph.push_back(node);
+        }
+    }
+
+    // Fold the constant nodes that are read by something that is not constant
+    NodeVector boundary;
+    for (const shared_ptr<Node>& node : subgraph)
+    {
+        if (node->is_constant() || node->get_output_size() != 1)
+        {
+            continue;
+        }
+        for (const shared_ptr<Node>& user : node->get_users())
+        {
+            if (constant.count(user.get()) == 0)
+            {
+                boundary.push_back(node);
+                break;
+            }
+        }
+    }
+    if (boundary.empty())
+    {
+        return false;
+    }
+
+    NodeVector folded;
+    vector<shared_ptr<op::Constant>> constants;
+    evaluate_batch(*backend, subgraph, boundary, folded, constants);
+
+    for (size_t i = 0; i < folded.size(); i++)
+    {
+        NGRAPH_DEBUG << "ConstantEvaluation: folding " << folded[i]->get_name();
+        replace_node(folded[i], constants[i]);
+    }
+    return !folded.empty();
+}
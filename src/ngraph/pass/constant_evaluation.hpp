@@ -0,0 +1,56 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <string>
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class ConstantEvaluation;
+    }
+}
+
+/// \brief Folds every op whose inputs are all constants, whatever its type.
+///
+/// Unlike ConstantFolding, which matches a fixed set of ops, the constant subgraphs are found
+/// in one traversal and evaluated together on a backend (INTERPRETER by default). Each op at
+/// the boundary of a constant subgraph is then replaced by an op::Constant holding its value.
+/// Ops producing more than max_folded_bytes, nondeterministic ops, ops with control
+/// dependencies and ops the backend does not support are left alone, as is the whole function
+/// when the backend is not available.
+///
+/// Only the ops a boundary op depends on are cloned for evaluation. When a batch fails, it is
+/// split in halves, so an op the backend cannot evaluate is found in a logarithmic number of
+/// compiles without blocking the others. The pass does nothing while it is evaluating, since
+/// the backend may run it again when compiling the constant subgraph.
+class ngraph::pass::ConstantEvaluation : public FunctionPass
+{
+public:
+    /// \param max_folded_bytes Largest output, in bytes, an op may have to be folded
+    /// \param backend_name Backend the constant subgraphs are evaluated on
+    ConstantEvaluation(size_t max_folded_bytes = 16 * 1024 * 1024,
+                       const std::string& backend_name = "INTERPRETER");
+    bool run_on_function(std::shared_ptr<ngraph::Function>) override;
+
+private:
+    size_t m_max_folded_bytes;
+    std::string m_backend_name;
+};
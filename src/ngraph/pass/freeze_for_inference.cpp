@@ -0,0 +1,357 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <limits>
+#include <set>
+#include <unordered_set>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/add.hpp"
+#include "ngraph/op/batch_norm.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/convolution.hpp"
+#include "ngraph/op/divide.hpp"
+#include "ngraph/op/dot.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/multiply.hpp"
+#include "ngraph/op/sqrt.hpp"
+#include "ngraph/op/subtract.hpp"
+#include "ngraph/pass/constant_evaluation.hpp"
+#include "ngraph/pass/freeze_for_inference.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+pass::FreezeForInference::FreezeForInference(const map<string, Statistics>& statistics,
+                                             const NodeVector& inference_outputs)
+    : m_statistics(statistics)
+    , m_inference_outputs(inference_outputs)
+{
+}
+
+static bool is_backprop(const Node* node)
+{
+    static const set<string> backprop_ops{"AvgPoolBackprop",
+                                          "BatchNormTrainingBackprop",
+                                          "ConvolutionBackpropFilters",
+                                          "MaxPoolBackprop",
+                                          "ReluBackprop",
+                                          "SigmoidBackprop"};
+    return backprop_ops.count(node->description()) != 0;
+}
+
+// The batch mean or variance output of a BatchNormTraining
+static bool is_batch_statistic(const Node* node)
+{
+    if (auto goe = dynamic_cast<const op::GetOutputElement*>(node))
+    {
+        // get_argument() rejects multi-output arguments
+        const Node* arg = goe->get_inputs().at(0).get_output().get_node().get();
+        return goe->get_n() != 0 && arg->description() == "BatchNormTraining";
+    }
+    return false;
+}
+
+void pass::FreezeForInference::prune_results(shared_ptr<Function> function) const
+{
+    unordered_set<const Node*> outputs;
+    for (const shared_ptr<Node>& node : m_inference_outputs)
+    {
+        outputs.insert(node.get());
+    }
+    unordered_set<const Node*> training_only;
+    if (outputs.empty())
+    {
+        for (const shared_ptr<Node>& node : function->get_ordered_ops())
+        {
+            bool is_training_only = is_backprop(node.get()) || is_batch_statistic(node.get());
+            for (const shared_ptr<Node>& arg : node->get_arguments())
+            {
+                is_training_only |= training_only.count(arg.get()) != 0;
+            }
+            if (is_training_only)
+            {
+                training_only.insert(node.get());
+            }
+        }
+    }
+
+    vector<size_t> removed;
+    const ResultVector& results = function->get_results();
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Node* arg = results[i]->get_argument(0).get();
+        bool keep = outputs.empty()
+                        ? training_only.count(arg) == 0
+                        : outputs.count(arg) != 0 || outputs.count(results[i].get()) != 0;
+        if (!keep)
+        {
+            removed.push_back(i);
+        }
+    }
+    if (removed.size() == results.size())
+    {
+        throw ngraph_error("FreezeForInference would remove every result of " +
+                           function->get_name());
+    }
+    for (auto it = removed.rbegin(); it != removed.rend(); ++it)
+    {
+        NGRAPH_DEBUG << "FreezeForInference: removing output " << *it;
+        function->remove_result(*it);
+    }
+}
+
+// Replaces x * mask by x for every dropout multiply of a GenerateMask, whose inference mask
+// is all ones, and the mask itself by a broadcast one for any other user
+static void remove_dropout(const shared_ptr<Node>& mask)
+{
+    bool other_users = false;
+    for (const shared_ptr<Node>& user : mask->get_users(true))
+    {
+        if (user->description() == "Multiply")
+        {
+            auto other = user->get_argument(user->get_argument(0) == mask ? 1 : 0);
+            replace_node(user, other);
+        }
+        else
+        {
+            other_users = true;
+        }
+    }
+    if (other_users)
+    {
+        AxisSet axes;
+        for (size_t i = 0; i < mask->get_shape().size(); i++)
+        {
+            axes.insert(i);
+        }
+        auto one = op::Constant::create(mask->get_element_type(), Shape{}, {1});
+        replace_node(mask, make_shared<op::Broadcast>(one, mask->get_shape(), axes));
+    }
+}
+
+namespace
+{
+    // A BatchNormInference over producer(x, weights) [+ broadcast bias] and the folded values
+    // that replace it
+    struct Fold
+    {
+        shared_ptr<Node> batch_norm;
+        shared_ptr<Node> producer;
+        shared_ptr<Node> weights;
+        shared_ptr<Node> shift;
+    };
+}
+
+// All axes of shape except axis
+static AxisSet all_axes_but(const Shape& shape, size_t axis)
+{
+    AxisSet axes;
+    for (size_t i = 0; i < shape.size(); i++)
+    {
+        if (i != axis)
+        {
+            axes.insert(i);
+        }
+    }
+    return axes;
+}
+
+static bool make_fold(const shared_ptr<Node>& batch_norm, Fold& fold)
+{
+    auto bn = static_pointer_cast<op::BatchNormInference>(batch_norm);
+    auto gamma = bn->get_argument(0);
+    auto beta = bn->get_argument(1);
+    auto input = bn->get_argument(2);
+    auto mean = bn->get_argument(3);
+    auto variance = bn->get_argument(4);
+    for (const shared_ptr<Node>& stat : {gamma, beta, mean, variance})
+    {
+        if (!stat->is_constant())
+        {
+            return false;
+        }
+    }
+    const Shape& shape = bn->get_shape();
+    AxisSet bias_axes = all_axes_but(shape, 1);
+
+    // Look through a per-channel bias. Replaced ops may still hold their arguments, so only
+    // users that reach a result count.
+    shared_ptr<Node> producer = input;
+    shared_ptr<Node> bias;
+    if (input->description() == "Add")
+    {
+        for (size_t i = 0; i < 2 && !bias; i++)
+        {
+            auto broadcast = dynamic_pointer_cast<op::Broadcast>(input->get_argument(1 - i));
+            if (broadcast && broadcast->get_broadcast_axes() == bias_axes &&
+                broadcast->get_users(true).size() == 1)
+            {
+                producer = input->get_argument(i);
+                bias = broadcast->get_argument(0);
+            }
+        }
+        // The bias is scaled into the folded shift, which must be a constant
+        if (!bias || !bias->is_constant() || input->get_users(true).size() != 1)
+        {
+            return false;
+        }
+    }
+    if (producer->get_users(true).size() != 1 || producer->get_arguments().size() != 2)
+    {
+        return false;
+    }
+
+    auto weights = producer->get_argument(1);
+    if (!weights->is_constant())
+    {
+        return false;
+    }
+    AxisSet scale_axes;
+    if (dynamic_pointer_cast<op::Convolution>(producer))
+    {
+        // Filters are [C_out, C_in, ...]
+        scale_axes = all_axes_but(weights->get_shape(), 0);
+    }
+    else if (auto dot = dynamic_pointer_cast<op::Dot>(producer))
+    {
+        // [N, K] . [K, C]
+        if (dot->get_reduction_axes_count() != 1 || weights->get_shape().size() != 2 ||
+            shape.size() != 2)
+        {
+            return false;
+        }
+        scale_axes = AxisSet{0};
+    }
+    else
+    {
+        return false;
+    }
+
+    // y = gamma * (x - mean) / sqrt(variance + eps) + beta = x * scale + shift
+    size_t channels = shape.at(1);
+    auto eps = op::Constant::create(
+        bn->get_element_type(), Shape{channels}, vector<double>{bn->get_eps_value()});
+    auto scale = gamma / make_shared<op::Sqrt>(variance + eps);
+    auto shift = beta - mean * scale;
+    if (bias)
+    {
+        shift = shift + bias * scale;
+    }
+
+    fold.batch_norm = batch_norm;
+    fold.producer = producer;
+    fold.weights = weights * make_shared<op::Broadcast>(scale, weights->get_shape(), scale_axes);
+    fold.shift = shift;
+    return true;
+}
+
+bool pass::FreezeForInference::run_on_function(shared_ptr<Function> function)
+{
+    m_folded_count = 0;
+    size_t output_count = function->get_output_size();
+    prune_results(function);
+    bool modified = function->get_output_size() != output_count;
+
+    for (const shared_ptr<Node>& node : function->get_ordered_ops())
+    {
+        if (node->description() == "StopGradient")
+        {
+            replace_node(node, node->get_argument(0));
+            modified = true;
+        }
+        else if (node->description() == "GenerateMask")
+        {
+            remove_dropout(node);
+            modified = true;
+        }
+        else if (node->description() == "BatchNormTraining")
+        {
+            auto it = m_statistics.find(node->get_friendly_name());
+            if (it == m_statistics.end())
+            {
+                NGRAPH_DEBUG << "FreezeForInference: no running statistics for "
+                             << node->get_friendly_name();
+                continue;
+            }
+            auto bn = static_pointer_cast<op::BatchNormTraining>(node);
+            auto inference = make_shared<op::BatchNormInference>(bn->get_argument(2),
+                                                                 bn->get_argument(0),
+                                                                 bn->get_argument(1),
+                                                                 it->second.mean,
+                                                                 it->second.variance,
+                                                                 bn->get_eps_value());
+            // A GetOutputElement reads every output of its argument, so it is a user of each
+            set<descriptor::Input*> inputs = node->get_output_inputs(0);
+            for (descriptor::Input* input : inputs)
+            {
+                auto goe = dynamic_pointer_cast<op::GetOutputElement>(input->get_node());
+                if (goe && goe->get_n() == 0)
+                {
+                    replace_node(goe, inference);
+                    modified = true;
+                }
+            }
+        }
+    }
+
+    vector<Fold> folds;
+    for (const shared_ptr<Node>& node : function->get_ordered_ops())
+    {
+        Fold fold;
+        if (node->description() == "BatchNormInference" && make_fold(node, fold))
+        {
+            folds.push_back(fold);
+        }
+    }
+    if (folds.empty())
+    {
+        return modified;
+    }
+
+    // Evaluate the folded weights and shifts together, apart from the function so that
+    // nothing else in it is folded
+    NodeVector values;
+    for (const Fold& fold : folds)
+    {
+        values.push_back(fold.weights);
+        values.push_back(fold.shift);
+    }
+    {
+        auto constants = make_shared<Function>(values, ParameterVector{});
+        ConstantEvaluation(numeric_limits<size_t>::max()).run_on_function(constants);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = constants->get_results().at(i)->get_argument(0);
+        }
+    }
+
+    for (size_t i = 0; i < folds.size(); i++)
+    {
+        const Fold& fold = folds[i];
+        const Shape& shape = fold.batch_norm->get_shape();
+        auto producer = fold.producer->copy_with_new_args(
+            NodeVector{fold.producer->get_argument(0), values[2 * i]});
+        auto shift = make_shared<op::Broadcast>(values[2 * i + 1], shape, all_axes_but(shape, 1));
+        NGRAPH_DEBUG << "FreezeForInference: folding " << fold.batch_norm->get_name() << " into "
+                     << fold.producer->get_name();
+        replace_node(fold.batch_norm, producer + shift);
+        m_folded_count++;
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class FreezeForInference;
+    }
+}
+
+/// \brief Turns a function exported from training into an inference function.
+///
+/// - Results that are not inference outputs are removed, along with the ops only they used.
+/// - StopGradient is removed and GenerateMask produces its inference mask of ones, so
+///   dropout multiplies disappear.
+/// - BatchNormTraining with known running statistics becomes BatchNormInference.
+/// - BatchNormInference over a Convolution or Dot with constant weights, optionally followed
+///   by a constant per-channel bias, is folded into the weights and a bias. The folded weights
+///   and biases are computed by ConstantEvaluation on a separate function, so nothing else in
+///   the function is folded.
+///
+/// The function's outputs change when results are removed; its parameters do not.
+class ngraph::pass::FreezeForInference : public FunctionPass
+{
+public:
+    /// \brief Running statistics of a batch norm
+    struct Statistics
+    {
+        std::shared_ptr<Node> mean;
+        std::shared_ptr<Node> variance;
+    };
+
+    /// \param statistics Running statistics of the BatchNormTraining ops, by friendly name.
+    ///        A BatchNormTraining without an entry keeps normalizing with batch statistics.
+    /// \param inference_outputs The values inference needs. Results of other values are
+    ///        removed. When empty, the results removed are those computed from batch
+    ///        statistics or from backprop ops.
+    FreezeForInference(const std::map<std::string, Statistics>& statistics =
+                           std::map<std::string, Statistics>{},
+                       const NodeVector& inference_outputs = NodeVector{});
+    bool run_on_function(std::shared_ptr<ngraph::Function>) override;
+
+    /// \brief Number of batch norms folded into weights by the last run
+    size_t get_folded_count() const { return m_folded_count; }
+
+private:
+    void prune_results(std::shared_ptr<Function> function) const;
+
+    std::map<std::string, Statistics> m_statistics;
+    NodeVector m_inference_outputs;
+    size_t m_folded_count{0};
+};
@@ -14,8 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <exception>
+#include <map>
+#include <numeric>
 #include <sstream>
+#include <unordered_map>
 
 #include "ngraph/log.hpp"
 #include "ngraph/log.hpp"
@@ -30,6 +34,68 @@
 using namespace std;
 using namespace ngraph;
 
+namespace
+{
+    // Buffers indexed by lifetime. Each buffer is kept at the O(log steps) segment tree nodes
+    // that tile its lifetime, so the buffers live at a step are the ones on that step's leaf
+    // to root path. Buffers that start later in a queried lifetime are found through
+    // by_first. A query costs O(log steps) plus the number of buffers it returns.
+    class LifetimeIndex
+    {
+    public:
+        LifetimeIndex(size_t steps)
+            : m_leaves(1)
+        {
+            while (m_leaves < steps)
+            {
+                m_leaves *= 2;
+            }
+            m_nodes.resize(2 * m_leaves);
+        }
+
+        void insert(size_t id, size_t first, size_t last)
+        {
+            for (size_t lo = first + m_leaves, hi = last + m_leaves + 1; lo < hi;
+                 lo /= 2, hi /= 2)
+            {
+                if (lo & 1)
+                {
+                    m_nodes[lo++].push_back(id);
+                }
+                if (hi & 1)
+                {
+                    m_nodes[--hi].push_back(id);
+                }
+            }
+            m_by_first.insert({first, id});
+        }
+
+        // Calls f for each buffer whose lifetime overlaps [first, last], once per buffer
+        template <typename F>
+        void for_each_overlapping(size_t first, size_t last, F f) const
+        {
+            for (size_t node = first + m_leaves; node > 0; node /= 2)
+            {
+                for (size_t id : m_nodes[node])
+                {
+                    f(id);
+                }
+            }
+            for (auto it = m_by_first.upper_bound(first);
+                 it != m_by_first.end() && it->first <= last;
+                 ++it)
+            {
+                f(it->second);
+            }
+        }
+
+    private:
+        size_t m_leaves;
+        vector<vector<size_t>> m_nodes;
+        multimap<size_t, size_t> m_by_first;
+    };
+}
+
 pass::MemoryLayout::MemoryLayout(size_t alignment, bool disable_memory_sharing)
     : m_alignment(alignment)
     , m_disable_memory_sharing(disable_memory_sharing)
@@ -42,11 +108,14 @@ pass::MemoryLayout::MemoryLayout(size_t alignment, bool disable_memory_sharing)
 
 bool pass::MemoryLayout::run_on_function(shared_ptr<Function> function)
 {
-    MemoryManager mm(m_alignment, m_disable_memory_sharing);
+    // Tensors sharing memory in place map to the same packer buffer. Lifetimes are recorded in
+    // op order and the buffers are placed once every lifetime is known.
+    MemoryPacker packer(m_alignment);
+    unordered_map<descriptor::Tensor*, size_t> buffer_ids;
+    size_t step = 0;
     for (shared_ptr<Node> node : function->get_ordered_ops())
     {
         std::map<descriptor::Tensor*, descriptor::Tensor*> in_place_outputs;
-        std::set<const descriptor::Tensor*> reused_inputs;
 
         if (node->is_op())
         {
@@ -70,13 +139,13 @@ bool pass::MemoryLayout::run_on_function(shared_ptr<Function> function)
                              std::dynamic_pointer_cast<op::GetOutputElement>(node) ||
                              (m_disable_memory_sharing && !oi_pair.destructive &&
                               !input_node->is_parameter() && !input_node->is_constant())) &&
-                            node->liveness_new_list.count(output) != 0)
+                            node->liveness_new_list.count(output) != 0 &&
+                            buffer_ids.count(input) != 0)
 
                         {
                             NGRAPH_DEBUG << "Reusing " << input->get_name() << " for "
                                          << output->get_name();
                             in_place_outputs.insert({output, input});
-                            reused_inputs.insert(input);
                         }
                     }
                 }
@@ -85,24 +154,42 @@ bool pass::MemoryLayout::run_on_function(shared_ptr<Function> function)
 
         for (descriptor::Tensor* tensor : node->liveness_new_list)
         {
-            size_t offset = in_place_outputs.count(tensor)
-                                ? in_place_outputs.at(tensor)->get_pool_offset()
-                                : mm.allocate(tensor->size());
-            tensor->set_pool_offset(offset);
+            auto in_place = in_place_outputs.find(tensor);
+            if (in_place != in_place_outputs.end())
+            {
+                size_t id = buffer_ids.at(in_place->second);
+                packer.share_buffer(id, tensor->size());
+                buffer_ids[tensor] = id;
+            }
+            else
+            {
+                buffer_ids[tensor] = packer.add_buffer(tensor->size(), step);
+            }
         }
 
+        // Without memory sharing nothing is released and every buffer gets its own memory
         if (!m_disable_memory_sharing)
         {
-            for (const descriptor::Tensor* tensor : node->liveness_free_list)
+            for (descriptor::Tensor* tensor : node->liveness_free_list)
             {
-                if (reused_inputs.count(tensor) == 0)
+                auto id = buffer_ids.find(tensor);
+                if (id != buffer_ids.end())
                 {
-                    mm.free(tensor->get_pool_offset());
+                    packer.release_buffer(id->second, step);
                 }
             }
         }
+        step++;
     }
-    function->set_temporary_pool_size(mm.max_allocated());
+
+    packer.pack();
+    for (auto& tensor_id : buffer_ids)
+    {
+        tensor_id.first->set_pool_offset(packer.get_offset(tensor_id.second));
+    }
+    NGRAPH_DEBUG << "MemoryLayout: pool size " << packer.max_allocated() << ", lower bound "
+                 << packer.lower_bound();
+    function->set_temporary_pool_size(packer.max_allocated());
 
     return false;
 }
@@ -292,3 +379,177 @@ size_t pass::MemoryManager::align(size_t size, size_t alignment)
     }
     return size;
 }
+
+pass::MemoryPacker::MemoryPacker(size_t alignment)
+    : m_alignment{alignment}
+    , m_max_allocated{0}
+{
+    if (m_alignment == 0)
+    {
+        throw invalid_argument("Memory alignment must be > 0");
+    }
+}
+
+size_t pass::MemoryPacker::add_buffer(size_t size, size_t first)
+{
+    m_buffers.push_back(buffer{MemoryManager::align(size, m_alignment), first, first, 1});
+    return m_buffers.size() - 1;
+}
+
+void pass::MemoryPacker::share_buffer(size_t id, size_t size)
+{
+    buffer& b = m_buffers.at(id);
+    b.size = max(b.size, MemoryManager::align(size, m_alignment));
+    b.references++;
+}
+
+void pass::MemoryPacker::release_buffer(size_t id, size_t last)
+{
+    buffer& b = m_buffers.at(id);
+    if (b.references == 0)
+    {
+        throw runtime_error("bad release");
+    }
+    b.references--;
+    b.last = max(b.last, last);
+}
+
+size_t pass::MemoryPacker::get_offset(size_t id) const
+{
+    if (id >= m_offsets.size())
+    {
+        throw runtime_error("buffer has not been packed");
+    }
+    return m_offsets[id];
+}
+
+size_t pass::MemoryPacker::last_step() const
+{
+    size_t last = 0;
+    for (const buffer& b : m_buffers)
+    {
+        last = max(last, max(b.first, b.last));
+    }
+    return last;
+}
+
+size_t pass::MemoryPacker::place(const vector<size_t>& order,
+                                 bool best_fit,
+                                 vector<size_t>& offsets) const
+{
+    const size_t unplaced = numeric_limits<size_t>::max();
+    offsets.assign(m_buffers.size(), unplaced);
+    LifetimeIndex placed(last_step() + 1);
+    vector<pair<size_t, size_t>> conflicts;
+    size_t pool_size = 0;
+    for (size_t id : order)
+    {
+        const buffer& b = m_buffers[id];
+
+        // (offset, end) of every placed buffer live at the same time as b, by offset
+        conflicts.clear();
+        placed.for_each_overlapping(b.first, b.last, [&](size_t other) {
+            conflicts.push_back({offsets[other], offsets[other] + m_buffers[other].size});
+        });
+        sort(conflicts.begin(), conflicts.end());
+
+        // Best (or first) fitting gap between conflicting buffers, else on top of them
+        size_t best_offset = unplaced;
+        size_t best_gap = numeric_limits<size_t>::max();
+        size_t gap_start = 0;
+        for (const pair<size_t, size_t>& conflict : conflicts)
+        {
+            if (conflict.first > gap_start)
+            {
+                size_t gap = conflict.first - gap_start;
+                if (gap >= b.size && gap < best_gap)
+                {
+                    best_gap = gap;
+                    best_offset = gap_start;
+                    if (!best_fit)
+                    {
+                        break;
+                    }
+                }
+            }
+            gap_start = max(gap_start, conflict.second);
+        }
+        if (best_offset == unplaced)
+        {
+            best_offset = gap_start;
+        }
+
+        offsets[id] = best_offset;
+        placed.insert(id, b.first, b.last);
+        pool_size = max(pool_size, best_offset + b.size);
+    }
+    return pool_size;
+}
+
+size_t pass::MemoryPacker::pack()
+{
+    vector<size_t> by_start(m_buffers.size());
+    iota(by_start.begin(), by_start.end(), 0);
+
+    // Buffers still referenced at the end are live through the last step
+    size_t last = last_step();
+    for (buffer& b : m_buffers)
+    {
+        if (b.references > 0)
+        {
+            b.last = last;
+        }
+    }
+
+    auto lifetime = [this](size_t id) { return m_buffers[id].last - m_buffers[id].first + 1; };
+    vector<size_t> by_size = by_start;
+    stable_sort(by_size.begin(), by_size.end(), [this, &lifetime](size_t a, size_t b) {
+        return m_buffers[a].size > m_buffers[b].size ||
+               (m_buffers[a].size == m_buffers[b].size && lifetime(a) > lifetime(b));
+    });
+    vector<size_t> by_area = by_start;
+    stable_sort(by_area.begin(), by_area.end(), [this, &lifetime](size_t a, size_t b) {
+        return m_buffers[a].size * lifetime(a) > m_buffers[b].size * lifetime(b);
+    });
+    vector<size_t> by_lifetime = by_start;
+    stable_sort(by_lifetime.begin(), by_lifetime.end(), [this, &lifetime](size_t a, size_t b) {
+        return lifetime(a) > lifetime(b) ||
+               (lifetime(a) == lifetime(b) && m_buffers[a].size > m_buffers[b].size);
+    });
+
+    // First fit in allocation order reproduces MemoryManager's online placement
+    m_max_allocated = place(by_start, false, m_offsets);
+    vector<size_t> offsets;
+    for (const vector<size_t>* order : {&by_size, &by_area, &by_lifetime})
+    {
+        size_t pool_size = place(*order, true, offsets);
+        if (pool_size < m_max_allocated)
+        {
+            m_max_allocated = pool_size;
+            m_offsets = offsets;
+        }
+    }
+    return m_max_allocated;
+}
+
+size_t pass::MemoryPacker::lower_bound() const
+{
+    // Sweep the lifetime boundaries, ending buffers before starting new ones at the same step
+    size_t last = last_step();
+    vector<pair<size_t, ptrdiff_t>> events;
+    for (const buffer& b : m_buffers)
+    {
+        events.push_back({2 * b.first + 1, static_cast<ptrdiff_t>(b.size)});
+        events.push_back({2 * (b.references > 0 ? last : b.last) + 2,
+                          -static_cast<ptrdiff_t>(b.size)});
+    }
+    sort(events.begin(), events.end());
+    ptrdiff_t live = 0;
+    ptrdiff_t peak = 0;
+    for (const pair<size_t, ptrdiff_t>& event : events)
+    {
+        live += event.second;
+        peak = max(peak, live);
+    }
+    return static_cast<size_t>(peak);
+}
@@ -19,6 +19,7 @@
 #include <limits>
 #include <list>
 #include <sstream>
+#include <vector>
 
 #include "ngraph/pass/pass.hpp"
 
@@ -29,6 +30,7 @@ namespace ngraph
         class MemoryLayout;
         class MemoryNode;
         class MemoryManager;
+        class MemoryPacker;
     }
 }
 
@@ -95,3 +97,57 @@ private:
     allocation_scheme m_scheme;
     size_t m_max_allocated;
 };
+
+/// \brief Offline placement of buffers whose lifetimes are all known up front.
+///
+/// Unlike MemoryManager, which places each buffer when it is allocated, the packer sees every
+/// lifetime before choosing offsets. Each buffer is placed at the best fitting gap left by the
+/// already placed buffers it is live together with. Several placement orders are tried
+/// (largest first, by lifetime area, by start step) and the smallest pool is kept, so the
+/// result is never larger than placing the buffers first-fit in allocation order.
+class ngraph::pass::MemoryPacker
+{
+public:
+    MemoryPacker(size_t alignment = 1);
+
+    /// \brief Adds a buffer that becomes live at step first.
+    /// \returns The id of the new buffer
+    size_t add_buffer(size_t size, size_t first);
+
+    /// \brief Lets one more tensor alias buffer id, growing the buffer to size if needed.
+    void share_buffer(size_t id, size_t size);
+
+    /// \brief Drops one alias of buffer id at step last. The buffer stays live until every
+    ///        alias has been released; buffers never fully released stay live to the end.
+    void release_buffer(size_t id, size_t last);
+
+    /// \brief Assigns an offset to every buffer.
+    /// \returns The size of the pool
+    size_t pack();
+
+    size_t get_offset(size_t id) const;
+    size_t get_buffer_count() const { return m_buffers.size(); }
+    size_t max_allocated() const { return m_max_allocated; }
+    /// \returns The largest total size of buffers live at the same step, a lower bound for
+    ///          the pool size of any placement
+    size_t lower_bound() const;
+
+private:
+    struct buffer
+    {
+        size_t size;
+        size_t first;
+        size_t last;
+        size_t references;
+    };
+
+    size_t last_step() const;
+    size_t place(const std::vector<size_t>& order,
+                 bool best_fit,
+                 std::vector<size_t>& offsets) const;
+
+    std::vector<buffer> m_buffers;
+    std::vector<size_t> m_offsets;
+    size_t m_alignment;
+    size_t m_max_allocated;
+};
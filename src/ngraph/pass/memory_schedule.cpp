@@ -0,0 +1,349 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ngraph/function.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/node.hpp"
+#include "ngraph/pass/memory_schedule.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // Dependence graph and tensor sizes of a function, with ops numbered in their
+    // current order
+    struct ScheduleGraph
+    {
+        vector<shared_ptr<Node>> nodes;
+        // Ops that must run before each op
+        vector<vector<size_t>> deps;
+        // Ops that depend on each op
+        vector<vector<size_t>> users;
+        // Intermediate tensors produced and read by each op
+        vector<vector<size_t>> outputs;
+        vector<vector<size_t>> inputs;
+        vector<size_t> tensor_size;
+        // Number of distinct ops reading each tensor
+        vector<size_t> tensor_consumers;
+        vector<vector<size_t>> tensor_readers;
+    };
+
+    ScheduleGraph build_graph(const list<shared_ptr<Node>>& ops)
+    {
+        ScheduleGraph g;
+        unordered_map<Node*, size_t> node_index;
+        for (const shared_ptr<Node>& node : ops)
+        {
+            node_index[node.get()] = g.nodes.size();
+            g.nodes.push_back(node);
+        }
+        size_t n = g.nodes.size();
+        g.deps.resize(n);
+        g.users.resize(n);
+        g.outputs.resize(n);
+        g.inputs.resize(n);
+
+        // Parameters, constants and results live outside the intermediate pool
+        unordered_map<descriptor::Tensor*, size_t> tensor_index;
+        for (size_t i = 0; i < n; i++)
+        {
+            const shared_ptr<Node>& node = g.nodes[i];
+            if (node->is_parameter() || node->is_constant() || node->is_output())
+            {
+                continue;
+            }
+            for (size_t j = 0; j < node->get_output_size(); j++)
+            {
+                descriptor::Tensor& tensor = node->get_output_tensor(j);
+                tensor_index[&tensor] = g.tensor_size.size();
+                g.outputs[i].push_back(g.tensor_size.size());
+                g.tensor_size.push_back(tensor.size());
+            }
+        }
+        g.tensor_consumers.resize(g.tensor_size.size(), 0);
+        g.tensor_readers.resize(g.tensor_size.size());
+
+        for (size_t i = 0; i < n; i++)
+        {
+            const shared_ptr<Node>& node = g.nodes[i];
+            unordered_set<size_t> deps;
+            for (const shared_ptr<Node>& arg : node->get_arguments())
+            {
+                deps.insert(node_index.at(arg.get()));
+            }
+            for (const shared_ptr<Node>& dep : node->get_control_dependencies())
+            {
+                deps.insert(node_index.at(dep.get()));
+            }
+            g.deps[i].assign(deps.begin(), deps.end());
+            sort(g.deps[i].begin(), g.deps[i].end());
+            for (size_t dep : g.deps[i])
+            {
+                g.users[dep].push_back(i);
+            }
+
+            unordered_set<size_t> inputs;
+            for (descriptor::Input& input : node->get_inputs())
+            {
+                auto it = tensor_index.find(&input.get_tensor());
+                if (it != tensor_index.end() && inputs.insert(it->second).second)
+                {
+                    g.inputs[i].push_back(it->second);
+                    g.tensor_consumers[it->second]++;
+                    g.tensor_readers[it->second].push_back(i);
+                }
+            }
+        }
+        return g;
+    }
+
+    // Peak of live intermediate bytes when running the ops in order. An op's outputs are
+    // allocated before its inputs are released.
+    size_t simulate_peak(const ScheduleGraph& g, const vector<size_t>& order)
+    {
+        vector<size_t> remaining = g.tensor_consumers;
+        size_t live = 0;
+        size_t peak = 0;
+        for (size_t i : order)
+        {
+            for (size_t t : g.outputs[i])
+            {
+                live += g.tensor_size[t];
+            }
+            peak = max(peak, live);
+            for (size_t t : g.outputs[i])
+            {
+                if (remaining[t] == 0)
+                {
+                    live -= g.tensor_size[t];
+                }
+            }
+            for (size_t t : g.inputs[i])
+            {
+                if (--remaining[t] == 0)
+                {
+                    live -= g.tensor_size[t];
+                }
+            }
+        }
+        return peak;
+    }
+
+    // List scheduling that runs the ready op with the smallest growth in live bytes. Ties go
+    // to the op that came first in the original order.
+    vector<size_t> greedy_order(const ScheduleGraph& g)
+    {
+        size_t n = g.nodes.size();
+        vector<size_t> remaining = g.tensor_consumers;
+        vector<size_t> pending_deps(n);
+        vector<bool> ready(n, false);
+        vector<int64_t> score(n, 0);
+        set<pair<int64_t, size_t>> ready_set;
+
+        auto compute_score = [&](size_t i) {
+            int64_t s = 0;
+            for (size_t t : g.outputs[i])
+            {
+                s += static_cast<int64_t>(g.tensor_size[t]);
+            }
+            for (size_t t : g.inputs[i])
+            {
+                if (remaining[t] == 1)
+                {
+                    s -= static_cast<int64_t>(g.tensor_size[t]);
+                }
+            }
+            return s;
+        };
+        auto make_ready = [&](size_t i) {
+            ready[i] = true;
+            score[i] = compute_score(i);
+            ready_set.insert({score[i], i});
+        };
+
+        for (size_t i = 0; i < n; i++)
+        {
+            pending_deps[i] = g.deps[i].size();
+            if (pending_deps[i] == 0)
+            {
+                make_ready(i);
+            }
+        }
+
+        vector<size_t> order;
+        order.reserve(n);
+        vector<bool> scheduled(n, false);
+        while (!ready_set.empty())
+        {
+            size_t i = ready_set.begin()->second;
+            ready_set.erase(ready_set.begin());
+            scheduled[i] = true;
+            order.push_back(i);
+
+            for (size_t t : g.inputs[i])
+            {
+                if (--remaining[t] == 1)
+                {
+                    // The last reader of t would now free it
+                    for (size_t reader : g.tensor_readers[t])
+                    {
+                        if (!scheduled[reader] && ready[reader])
+                        {
+                            ready_set.erase({score[reader], reader});
+                            score[reader] = compute_score(reader);
+                            ready_set.insert({score[reader], reader});
+                        }
+                    }
+                }
+            }
+            for (size_t user : g.users[i])
+            {
+                if (--pending_deps[user] == 0)
+                {
+                    make_ready(user);
+                }
+            }
+        }
+        return order;
+    }
+
+    // Depth first post-order from the results. The inputs of each op are visited in
+    // decreasing order of their estimated peak, so the most expensive subgraph is evaluated
+    // while the fewest other results are held.
+    vector<size_t> dfs_order(const ScheduleGraph& g)
+    {
+        size_t n = g.nodes.size();
+        vector<size_t> out_bytes(n, 0);
+        for (size_t i = 0; i < n; i++)
+        {
+            for (size_t t : g.outputs[i])
+            {
+                out_bytes[i] += g.tensor_size[t];
+            }
+        }
+
+        // Estimate ignores sharing between subgraphs. The ops are already topologically
+        // sorted so dependencies are estimated first.
+        vector<size_t> estimate(n, 0);
+        vector<vector<size_t>> children(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            children[i] = g.deps[i];
+            stable_sort(children[i].begin(), children[i].end(), [&](size_t a, size_t b) {
+                return estimate[a] - min(estimate[a], out_bytes[a]) >
+                       estimate[b] - min(estimate[b], out_bytes[b]);
+            });
+            size_t held = 0;
+            size_t peak = 0;
+            for (size_t c : children[i])
+            {
+                peak = max(peak, held + estimate[c]);
+                held += out_bytes[c];
+            }
+            estimate[i] = max(peak, held + out_bytes[i]);
+        }
+
+        vector<size_t> order;
+        order.reserve(n);
+        vector<bool> visited(n, false);
+        vector<pair<size_t, size_t>> stack;
+        auto visit = [&](size_t root) {
+            if (visited[root])
+            {
+                return;
+            }
+            visited[root] = true;
+            stack.push_back({root, 0});
+            while (!stack.empty())
+            {
+                size_t node = stack.back().first;
+                size_t& next = stack.back().second;
+                if (next < children[node].size())
+                {
+                    size_t child = children[node][next++];
+                    if (!visited[child])
+                    {
+                        visited[child] = true;
+                        stack.push_back({child, 0});
+                    }
+                }
+                else
+                {
+                    order.push_back(node);
+                    stack.pop_back();
+                }
+            }
+        };
+        for (size_t i = 0; i < n; i++)
+        {
+            if (g.nodes[i]->is_output())
+            {
+                visit(i);
+            }
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            visit(i);
+        }
+        return order;
+    }
+}
+
+bool pass::MemorySchedule::run_on_function(shared_ptr<Function> function)
+{
+    list<shared_ptr<Node>> ops = function->get_ordered_ops();
+    ScheduleGraph g = build_graph(ops);
+
+    vector<size_t> original(g.nodes.size());
+    for (size_t i = 0; i < original.size(); i++)
+    {
+        original[i] = i;
+    }
+    m_peak_before = simulate_peak(g, original);
+    m_peak_after = m_peak_before;
+
+    vector<size_t> best;
+    for (const vector<size_t>& candidate : {greedy_order(g), dfs_order(g)})
+    {
+        size_t peak = simulate_peak(g, candidate);
+        if (candidate.size() == original.size() && peak < m_peak_after)
+        {
+            m_peak_after = peak;
+            best = candidate;
+        }
+    }
+
+    NGRAPH_DEBUG << "MemorySchedule: " << function->get_name() << " predicted peak "
+                 << m_peak_before << " bytes before, " << m_peak_after << " bytes after";
+
+    if (!best.empty())
+    {
+        list<shared_ptr<Node>> order;
+        for (size_t i : best)
+        {
+            order.push_back(g.nodes[i]);
+        }
+        function->set_ordered_ops(order);
+    }
+    return false;
+}
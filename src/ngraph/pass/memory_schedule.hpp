@@ -0,0 +1,49 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class MemorySchedule;
+    }
+}
+
+/// \brief Reorders ops to reduce the peak size of live intermediate tensors.
+///
+/// Candidate orders are built with a greedy list scheduler, which at each step runs the ready
+/// op that grows live memory the least, and with a depth first traversal that evaluates the
+/// most memory hungry inputs of each op first. The candidate with the lowest predicted peak is
+/// pinned on the function with Function::set_ordered_ops, but only if it beats the existing
+/// order. Run it after all graph rewrites and before Liveness and memory assignment.
+class ngraph::pass::MemorySchedule : public FunctionPass
+{
+public:
+    bool run_on_function(std::shared_ptr<ngraph::Function>) override;
+
+    /// \brief Predicted peak live intermediate bytes of the order the function had before
+    ///        the last run
+    size_t get_peak_before() const { return m_peak_before; }
+    /// \brief Predicted peak live intermediate bytes of the order chosen by the last run
+    size_t get_peak_after() const { return m_peak_after; }
+private:
+    size_t m_peak_before{0};
+    size_t m_peak_after{0};
+};
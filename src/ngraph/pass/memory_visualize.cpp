@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -87,6 +88,8 @@ bool pass::MemoryVisualize::run_on_module(vector<shared_ptr<Function>>& function
             // file << "<hr>\n";
             // draw_op_influence(file);
             file << "<hr>\n";
+            draw_fragmentation(file, f, nodes);
+            file << "<hr>\n";
             draw_histogram(file, nodes);
             // file << "<hr>\n";
             file << "</body>\n</html>\n";
@@ -236,6 +239,63 @@ void pass::MemoryVisualize::draw_op_influence(ostream& file, const list<shared_p
     }
 }
 
+void pass::MemoryVisualize::draw_fragmentation(ostream& file,
+                                               shared_ptr<Function> f,
+                                               const list<shared_ptr<Node>>& nodes)
+{
+    // At every op compare the bytes actually live with the extent of the pool they occupy.
+    // Tensors sharing memory in place are counted once per pool offset.
+    unordered_set<const descriptor::Tensor*> live;
+    size_t peak_live = 0;
+    size_t worst_waste = 0;
+    size_t worst_span = 0;
+    string worst_op;
+    for (shared_ptr<Node> node : nodes)
+    {
+        live.insert(node->liveness_new_list.begin(), node->liveness_new_list.end());
+        map<size_t, size_t> blocks;
+        for (const descriptor::Tensor* tensor : live)
+        {
+            size_t& size = blocks[tensor->get_pool_offset()];
+            size = max(size, tensor->size());
+        }
+        size_t live_bytes = 0;
+        size_t span = 0;
+        for (const pair<size_t, size_t>& block : blocks)
+        {
+            live_bytes += block.second;
+            span = max(span, block.first + block.second);
+        }
+        peak_live = max(peak_live, live_bytes);
+        if (span - live_bytes > worst_waste)
+        {
+            worst_waste = span - live_bytes;
+            worst_span = span;
+            worst_op = node->get_name();
+        }
+        for (const descriptor::Tensor* tensor : node->liveness_free_list)
+        {
+            live.erase(tensor);
+        }
+    }
+
+    size_t pool_size = f->get_temporary_pool_size();
+    float fragmentation =
+        pool_size == 0 ? 0.0f : 100.0f * float(pool_size - min(pool_size, peak_live)) / pool_size;
+    file << "<table>\n";
+    file << "    <tr><td>Temporary pool size</td><td align=\"right\">" << pool_size
+         << "</td></tr>\n";
+    file << "    <tr><td>Peak live bytes</td><td align=\"right\">" << peak_live << "</td></tr>\n";
+    file << "    <tr><td>Fragmentation</td><td align=\"right\">" << fragmentation
+         << "%</td></tr>\n";
+    if (!worst_op.empty())
+    {
+        file << "    <tr><td>Largest gap at</td><td align=\"right\">" << worst_op << " ("
+             << worst_waste << " of " << worst_span << " bytes unused)</td></tr>\n";
+    }
+    file << "</table>\n";
+}
+
 int pass::MemoryVisualize::compute_op_weight(const shared_ptr<Node> exop)
 {
     int mass = 0;
@@ -42,6 +42,9 @@ private:
     void draw_tensor_weight(std::ostream& file, const std::list<std::shared_ptr<Node>>& nodes);
     void draw_histogram(std::ostream& file, const std::list<std::shared_ptr<Node>>& nodes);
     void draw_op_influence(std::ostream& file, const std::list<std::shared_ptr<Node>>& nodes);
+    void draw_fragmentation(std::ostream& file,
+                            std::shared_ptr<Function> f,
+                            const std::list<std::shared_ptr<Node>>& nodes);
     int compute_op_weight(std::shared_ptr<Node> exop);
 
     static size_t memory_usage(std::shared_ptr<Node>);
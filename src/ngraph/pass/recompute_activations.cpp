@@ -0,0 +1,734 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/convert.hpp"
+#include "ngraph/op/reshape.hpp"
+#include "ngraph/op/util/binary_elementwise_arithmetic.hpp"
+#include "ngraph/op/util/unary_elementwise_arithmetic.hpp"
+#include "ngraph/pass/liveness.hpp"
+#include "ngraph/pass/recompute_activations.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // Live bytes at every step, with range updates and the peak in O(log steps)
+    class LiveProfile
+    {
+    public:
+        LiveProfile(size_t steps)
+            : m_leaves(1)
+        {
+            while (m_leaves < steps)
+            {
+                m_leaves *= 2;
+            }
+            m_max.assign(2 * m_leaves, 0);
+            m_add.assign(2 * m_leaves, 0);
+        }
+
+        void add(size_t first, size_t last, int64_t bytes)
+        {
+            add(1, 0, m_leaves - 1, first, last, bytes);
+        }
+        int64_t peak() const { return m_max[1]; }
+    private:
+        void add(size_t node, size_t lo, size_t hi, size_t first, size_t last, int64_t bytes)
+        {
+            if (last < lo || hi < first)
+            {
+                return;
+            }
+            if (first <= lo && hi <= last)
+            {
+                m_add[node] += bytes;
+                m_max[node] += bytes;
+                return;
+            }
+            size_t mid = lo + (hi - lo) / 2;
+            add(2 * node, lo, mid, first, last, bytes);
+            add(2 * node + 1, mid + 1, hi, first, last, bytes);
+            m_max[node] = m_add[node] + max(m_max[2 * node], m_max[2 * node + 1]);
+        }
+
+        size_t m_leaves;
+        vector<int64_t> m_max;
+        vector<int64_t> m_add;
+    };
+
+    // Predicts the live peak as activations are picked for recomputation. Picking one only
+    // changes the lifetimes of the activation, its clone, its arguments, the backward ops that
+    // now read the clone and the clones that must run earlier, so only those are updated
+    // instead of rewriting and re-analysing a copy of the function. Steps are twice the op
+    // positions. A clone runs at the odd step just before the first seed dependent op that
+    // needs it, and the seed independent backward ops reading it move there with it.
+    class PeakModel
+    {
+    public:
+        // Liveness must have run on the function ops come from
+        PeakModel(const list<shared_ptr<Node>>& ops,
+                  const set<shared_ptr<Node>>& forward,
+                  const set<shared_ptr<Node>>& seeded)
+            : m_profile(2 * ops.size() + 1)
+        {
+            size_t position = 0;
+            unordered_map<const descriptor::Tensor*, size_t> first;
+            for (const shared_ptr<Node>& node : ops)
+            {
+                m_position[node.get()] = position;
+                if (forward.count(node) != 0)
+                {
+                    m_forward.insert(node.get());
+                }
+                if (seeded.count(node) != 0)
+                {
+                    m_seeded.insert(node.get());
+                }
+                for (const descriptor::Tensor* tensor : node->liveness_new_list)
+                {
+                    first[tensor] = 2 * position;
+                }
+                for (const descriptor::Tensor* tensor : node->liveness_free_list)
+                {
+                    m_freed[tensor] = 2 * position;
+                }
+                position++;
+            }
+
+            // Where seed independent backward ops land once they read a clone
+            for (auto it = ops.rbegin(); it != ops.rend(); ++it)
+            {
+                Node* node = it->get();
+                if (m_forward.count(node) != 0 || m_seeded.count(node) != 0 || node->is_output())
+                {
+                    continue;
+                }
+                size_t step = numeric_limits<size_t>::max();
+                for (const shared_ptr<Node>& user : get_users(node))
+                {
+                    step = min(step, get_anchor(user.get()));
+                }
+                if (step != numeric_limits<size_t>::max())
+                {
+                    m_lazy_step[node] = step;
+                }
+            }
+
+            // Single output ops are modelled from their users, other tensors keep the
+            // lifetime Liveness found
+            for (const shared_ptr<Node>& node : ops)
+            {
+                if (node->get_output_size() == 1 &&
+                    first.erase(&node->get_output_tensor()) != 0)
+                {
+                    m_bytes[node.get()] = node->get_output_tensor().size();
+                    update(node.get());
+                }
+            }
+            for (const auto& tensor : first)
+            {
+                auto freed = m_freed.find(tensor.first);
+                size_t last = freed != m_freed.end() ? freed->second : 2 * ops.size();
+                m_profile.add(tensor.second, last, tensor.first->size());
+            }
+        }
+
+        size_t peak() const { return static_cast<size_t>(m_profile.peak()); }
+        // Picks node for recomputation if that lowers the predicted peak
+        bool try_recompute(Node* node)
+        {
+            int64_t before = m_profile.peak();
+            map<Node*, size_t> old_steps;
+            vector<Node*> moved;
+            set<Node*> touched{node};
+
+            m_recomputed.insert(node);
+            m_clone_step[node] = get_clone_step(node);
+            deque<Node*> pending;
+            for (const shared_ptr<Node>& arg : node->get_arguments())
+            {
+                touched.insert(arg.get());
+                pending.push_back(arg.get());
+            }
+            // Recomputed arguments must be cloned before node's clone
+            while (!pending.empty())
+            {
+                Node* arg = pending.front();
+                pending.pop_front();
+                if (m_recomputed.count(arg) == 0)
+                {
+                    continue;
+                }
+                size_t step = get_clone_step(arg);
+                if (step != m_clone_step[arg])
+                {
+                    old_steps.insert({arg, m_clone_step[arg]});
+                    m_clone_step[arg] = step;
+                    for (const shared_ptr<Node>& next : arg->get_arguments())
+                    {
+                        touched.insert(next.get());
+                        pending.push_back(next.get());
+                    }
+                }
+            }
+            // Backward ops reading the clone are no longer held back by the forward pass
+            pending.push_back(node);
+            while (!pending.empty())
+            {
+                Node* source = pending.front();
+                pending.pop_front();
+                for (const shared_ptr<Node>& user : get_users(source))
+                {
+                    if (m_lazy_step.count(user.get()) != 0 && m_moved.insert(user.get()).second)
+                    {
+                        moved.push_back(user.get());
+                        touched.insert(user.get());
+                        for (const shared_ptr<Node>& arg : user->get_arguments())
+                        {
+                            touched.insert(arg.get());
+                        }
+                        pending.push_back(user.get());
+                    }
+                }
+            }
+
+            map<Node*, pair<Lifetime, Lifetime>> old_lifetimes;
+            for (Node* n : touched)
+            {
+                old_lifetimes.insert({n, m_lifetimes[n]});
+                update(n);
+            }
+            if (m_profile.peak() < before)
+            {
+                return true;
+            }
+
+            m_recomputed.erase(node);
+            m_clone_step.erase(node);
+            for (const auto& step : old_steps)
+            {
+                m_clone_step[step.first] = step.second;
+            }
+            for (Node* n : moved)
+            {
+                m_moved.erase(n);
+            }
+            for (const auto& lifetimes : old_lifetimes)
+            {
+                set_lifetimes(lifetimes.first, lifetimes.second);
+            }
+            return false;
+        }
+
+    private:
+        struct Lifetime
+        {
+            bool live;
+            size_t first;
+            size_t last;
+        };
+
+        // Users scheduled in the function
+        NodeVector get_users(Node* node) const
+        {
+            NodeVector users;
+            for (const shared_ptr<Node>& user : node->get_users())
+            {
+                if (m_position.count(user.get()) != 0)
+                {
+                    users.push_back(user);
+                }
+            }
+            return users;
+        }
+
+        size_t get_step(Node* node) const
+        {
+            return m_moved.count(node) != 0 ? m_lazy_step.at(node) : 2 * m_position.at(node);
+        }
+
+        // Step a clone read by backward op node runs at
+        size_t get_anchor(Node* node) const
+        {
+            auto lazy = m_lazy_step.find(node);
+            return lazy != m_lazy_step.end() ? lazy->second : 2 * m_position.at(node) - 1;
+        }
+
+        size_t get_clone_step(Node* node) const
+        {
+            size_t step = numeric_limits<size_t>::max();
+            for (const shared_ptr<Node>& user : get_users(node))
+            {
+                if (m_forward.count(user.get()) == 0)
+                {
+                    step = min(step, get_anchor(user.get()));
+                }
+                else if (m_recomputed.count(user.get()) != 0)
+                {
+                    step = min(step, m_clone_step.at(user.get()));
+                }
+            }
+            return step;
+        }
+
+        Lifetime get_original_lifetime(Node* node) const
+        {
+            size_t first = get_step(node);
+            Lifetime rc{true, first, first};
+            bool recomputed = m_recomputed.count(node) != 0;
+            for (const shared_ptr<Node>& user : get_users(node))
+            {
+                if (m_forward.count(user.get()) != 0)
+                {
+                    rc.last = max(rc.last, 2 * m_position.at(user.get()));
+                    if (!recomputed && m_recomputed.count(user.get()) != 0)
+                    {
+                        rc.last = max(rc.last, m_clone_step.at(user.get()));
+                    }
+                }
+                else if (!recomputed)
+                {
+                    rc.last = max(rc.last, get_step(user.get()));
+                }
+            }
+            return rc;
+        }
+
+        Lifetime get_clone_lifetime(Node* node) const
+        {
+            if (m_recomputed.count(node) == 0)
+            {
+                return Lifetime{false, 0, 0};
+            }
+            size_t first = m_clone_step.at(node);
+            Lifetime rc{true, first, first};
+            for (const shared_ptr<Node>& user : get_users(node))
+            {
+                if (m_forward.count(user.get()) == 0)
+                {
+                    rc.last = max(rc.last, get_step(user.get()));
+                }
+                else if (m_recomputed.count(user.get()) != 0)
+                {
+                    rc.last = max(rc.last, m_clone_step.at(user.get()));
+                }
+            }
+            return rc;
+        }
+
+        void update(Node* node)
+        {
+            if (m_bytes.count(node) != 0)
+            {
+                set_lifetimes(node, {get_original_lifetime(node), get_clone_lifetime(node)});
+            }
+        }
+
+        void set_lifetimes(Node* node, const pair<Lifetime, Lifetime>& lifetimes)
+        {
+            auto bytes = m_bytes.find(node);
+            if (bytes == m_bytes.end())
+            {
+                return;
+            }
+            int64_t size = static_cast<int64_t>(bytes->second);
+            pair<Lifetime, Lifetime>& current = m_lifetimes[node];
+            for (const Lifetime& lifetime : {current.first, current.second})
+            {
+                if (lifetime.live)
+                {
+                    m_profile.add(lifetime.first, lifetime.last, -size);
+                }
+            }
+            current = lifetimes;
+            for (const Lifetime& lifetime : {current.first, current.second})
+            {
+                if (lifetime.live)
+                {
+                    m_profile.add(lifetime.first, lifetime.last, size);
+                }
+            }
+        }
+
+        LiveProfile m_profile;
+        unordered_map<Node*, size_t> m_position;
+        unordered_set<Node*> m_forward;
+        unordered_set<Node*> m_seeded;
+        unordered_map<Node*, size_t> m_lazy_step;
+        unordered_map<const descriptor::Tensor*, size_t> m_freed;
+        unordered_map<Node*, size_t> m_bytes;
+        unordered_set<Node*> m_recomputed;
+        unordered_set<Node*> m_moved;
+        unordered_map<Node*, size_t> m_clone_step;
+        unordered_map<Node*, pair<Lifetime, Lifetime>> m_lifetimes;
+    };
+}
+
+pass::RecomputeActivations::RecomputeActivations(const NodeVector& y,
+                                                 const NodeVector& c,
+                                                 checkpoint_policy policy,
+                                                 size_t value)
+    : m_y(y)
+    , m_c(c)
+    , m_policy(policy)
+    , m_value(value)
+{
+    if (m_policy == checkpoint_policy::EVERY_K && m_value == 0)
+    {
+        throw invalid_argument("Checkpoint interval must be > 0");
+    }
+}
+
+size_t pass::RecomputeActivations::get_live_peak(shared_ptr<Function> function)
+{
+    Liveness liveness;
+    liveness.run_on_function(function);
+
+    size_t live = 0;
+    size_t peak = 0;
+    for (const shared_ptr<Node>& node : function->get_ordered_ops())
+    {
+        for (const descriptor::Tensor* tensor : node->liveness_new_list)
+        {
+            live += tensor->size();
+        }
+        peak = max(peak, live);
+        for (const descriptor::Tensor* tensor : node->liveness_free_list)
+        {
+            live -= tensor->size();
+        }
+    }
+    return peak;
+}
+
+// Nodes of ops reachable from roots, following arguments (upstream) or users (downstream)
+static set<shared_ptr<Node>>
+    get_reachable(const list<shared_ptr<Node>>& ops, const NodeVector& roots, bool upstream)
+{
+    set<shared_ptr<Node>> in_function(ops.begin(), ops.end());
+    set<shared_ptr<Node>> reached;
+    deque<shared_ptr<Node>> pending;
+    for (const shared_ptr<Node>& root : roots)
+    {
+        if (in_function.count(root) != 0 && reached.insert(root).second)
+        {
+            pending.push_back(root);
+        }
+    }
+    while (!pending.empty())
+    {
+        shared_ptr<Node> node = pending.front();
+        pending.pop_front();
+        for (const shared_ptr<Node>& next : upstream ? node->get_arguments() : node->get_users())
+        {
+            if (in_function.count(next) != 0 && reached.insert(next).second)
+            {
+                pending.push_back(next);
+            }
+        }
+    }
+    return reached;
+}
+
+static bool is_cheap_to_recompute(const shared_ptr<Node>& node)
+{
+    return dynamic_pointer_cast<op::util::UnaryElementwiseArithmetic>(node) ||
+           dynamic_pointer_cast<op::util::BinaryElementwiseArithmetic>(node) ||
+           dynamic_pointer_cast<op::Broadcast>(node) || dynamic_pointer_cast<op::Reshape>(node) ||
+           dynamic_pointer_cast<op::Convert>(node);
+}
+
+vector<shared_ptr<Node>>
+    pass::RecomputeActivations::get_candidates(const list<shared_ptr<Node>>& ops,
+                                               const set<shared_ptr<Node>>& forward) const
+{
+    vector<shared_ptr<Node>> candidates;
+    for (const shared_ptr<Node>& node : ops)
+    {
+        if (forward.count(node) == 0 || !is_cheap_to_recompute(node) ||
+            node->get_output_size() != 1 || !node->get_control_dependencies().empty())
+        {
+            continue;
+        }
+        bool read_by_backward = false;
+        bool is_function_output = false;
+        for (const shared_ptr<Node>& user : node->get_users())
+        {
+            read_by_backward |= forward.count(user) == 0 && !user->is_output();
+            is_function_output |= user->is_output();
+        }
+        // A function output stays live anyway, recomputing it saves nothing
+        if (read_by_backward && !is_function_output)
+        {
+            candidates.push_back(node);
+        }
+    }
+    return candidates;
+}
+
+void pass::RecomputeActivations::recompute(shared_ptr<Function> function,
+                                           const NodeVector& y,
+                                           const NodeVector& c,
+                                           const vector<shared_ptr<Node>>& activations) const
+{
+    list<shared_ptr<Node>> ops = function->get_ordered_ops();
+    set<shared_ptr<Node>> forward = get_reachable(ops, y, true);
+    set<shared_ptr<Node>> seeded = get_reachable(ops, c, false);
+    vector<shared_ptr<Node>> order(ops.begin(), ops.end());
+    unordered_map<Node*, size_t> position;
+    map<shared_ptr<Node>, NodeVector> control_users;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        position[order[i].get()] = i;
+        for (const shared_ptr<Node>& dependency : order[i]->get_control_dependencies())
+        {
+            control_users[dependency].push_back(order[i]);
+        }
+    }
+
+    // Clone in forward order so that a clone reads the clones of recomputed arguments, and
+    // move the backward users of each activation over to its clone.
+    vector<shared_ptr<Node>> sorted = activations;
+    sort(sorted.begin(),
+         sorted.end(),
+         [&position](const shared_ptr<Node>& a, const shared_ptr<Node>& b) {
+             return position.at(a.get()) < position.at(b.get());
+         });
+    map<shared_ptr<Node>, shared_ptr<Node>> clones;
+    map<shared_ptr<Node>, size_t> first_use;
+    for (const shared_ptr<Node>& activation : sorted)
+    {
+        NodeVector args;
+        for (const shared_ptr<Node>& arg : activation->get_arguments())
+        {
+            auto clone = clones.find(arg);
+            args.push_back(clone != clones.end() ? clone->second : arg);
+        }
+        shared_ptr<Node> clone = activation->copy_with_new_args(args);
+        clones[activation] = clone;
+        first_use[clone] = order.size();
+
+        descriptor::Output& output = activation->get_outputs().at(0);
+        set<descriptor::Input*> inputs = output.get_inputs();
+        for (descriptor::Input* input : inputs)
+        {
+            shared_ptr<Node> user = input->get_node();
+            if (forward.count(user) == 0 && !user->is_output())
+            {
+                first_use[clone] = min(first_use[clone], position.at(user.get()));
+                input->replace_output(clone, 0);
+            }
+        }
+    }
+    for (auto it = sorted.rbegin(); it != sorted.rend(); ++it)
+    {
+        shared_ptr<Node> clone = clones.at(*it);
+        for (const shared_ptr<Node>& arg : clone->get_arguments())
+        {
+            auto arg_use = first_use.find(arg);
+            if (arg_use != first_use.end())
+            {
+                arg_use->second = min(arg_use->second, first_use.at(clone));
+            }
+        }
+    }
+
+    for (const shared_ptr<Node>& activation : sorted)
+    {
+        shared_ptr<Node> clone = clones.at(activation);
+
+        // Everything downstream of the clone, through data and control edges
+        set<shared_ptr<Node>> descendants{clone};
+        deque<shared_ptr<Node>> pending{clone};
+        // Seed dependent ops the clone reaches first, the backward pass of its layer
+        set<shared_ptr<Node>> consumers;
+        while (!pending.empty())
+        {
+            shared_ptr<Node> node = pending.front();
+            pending.pop_front();
+            NodeVector next = node->get_users();
+            auto control = control_users.find(node);
+            if (control != control_users.end())
+            {
+                next.insert(next.end(), control->second.begin(), control->second.end());
+            }
+            for (const shared_ptr<Node>& user : next)
+            {
+                if (descendants.insert(user).second)
+                {
+                    pending.push_back(user);
+                }
+            }
+        }
+        for (const shared_ptr<Node>& descendant : descendants)
+        {
+            if (seeded.count(descendant) == 0)
+            {
+                continue;
+            }
+            bool first = true;
+            for (const shared_ptr<Node>& arg : descendant->get_arguments())
+            {
+                first &= seeded.count(arg) == 0 || descendants.count(arg) == 0;
+            }
+            if (first)
+            {
+                consumers.insert(descendant);
+            }
+        }
+
+        // Run the clone once the seed dependent inputs of those ops are ready. Without seed
+        // dependent inputs fall back to the op scheduled just before the first use, which
+        // cannot be a descendant of the clone.
+        NodeVector anchors;
+        for (const shared_ptr<Node>& consumer : consumers)
+        {
+            for (const shared_ptr<Node>& arg : consumer->get_arguments())
+            {
+                if (seeded.count(arg) != 0 && descendants.count(arg) == 0 &&
+                    !arg->is_parameter() && !arg->is_constant())
+                {
+                    anchors.push_back(arg);
+                }
+            }
+        }
+        size_t use = first_use.at(clone);
+        while (anchors.empty() && use > 0)
+        {
+            const shared_ptr<Node>& anchor = order[--use];
+            if (!anchor->is_parameter() && !anchor->is_constant())
+            {
+                anchors.push_back(anchor);
+            }
+        }
+        for (const shared_ptr<Node>& anchor : anchors)
+        {
+            clone->add_control_dependency(anchor);
+            control_users[anchor].push_back(clone);
+        }
+        NGRAPH_DEBUG << "RecomputeActivations: " << activation->get_name() << " recomputed as "
+                     << clone->get_name();
+    }
+}
+
+size_t pass::RecomputeActivations::get_trial_peak(
+    const shared_ptr<Function>& function, const vector<shared_ptr<Node>>& activations) const
+{
+    NodeMap node_map;
+    shared_ptr<Function> trial = clone_function(*function, node_map);
+    NodeVector trial_y;
+    NodeVector trial_c;
+    for (const shared_ptr<Node>& node : m_y)
+    {
+        if (node_map.exists(node))
+        {
+            trial_y.push_back(node_map.get(node));
+        }
+    }
+    for (const shared_ptr<Node>& node : m_c)
+    {
+        if (node_map.exists(node))
+        {
+            trial_c.push_back(node_map.get(node));
+        }
+    }
+    vector<shared_ptr<Node>> trial_activations;
+    for (const shared_ptr<Node>& activation : activations)
+    {
+        trial_activations.push_back(node_map.get(activation));
+    }
+    recompute(trial, trial_y, trial_c, trial_activations);
+    return get_live_peak(trial);
+}
+
+bool pass::RecomputeActivations::run_on_function(shared_ptr<Function> function)
+{
+    list<shared_ptr<Node>> ops = function->get_ordered_ops();
+    vector<shared_ptr<Node>> candidates = get_candidates(ops, get_reachable(ops, m_y, true));
+    m_peak_before = get_live_peak(function);
+    m_peak_after = m_peak_before;
+    m_recomputed_count = 0;
+
+    vector<shared_ptr<Node>> activations;
+    if (m_policy == checkpoint_policy::EVERY_K)
+    {
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            if ((i + 1) % m_value != 0)
+            {
+                activations.push_back(candidates[i]);
+            }
+        }
+    }
+    else
+    {
+        // Activations are picked against a model of the peak that is updated incrementally.
+        // The model does not see where recompute() anchors each clone, so when the rewrite
+        // still misses the budget the target is lowered by the error and more are picked.
+        stable_sort(candidates.begin(),
+                    candidates.end(),
+                    [](const shared_ptr<Node>& a, const shared_ptr<Node>& b) {
+                        return shape_size(a->get_shape()) * a->get_element_type().size() >
+                               shape_size(b->get_shape()) * b->get_element_type().size();
+                    });
+        PeakModel model(ops, get_reachable(ops, m_y, true), get_reachable(ops, m_c, false));
+        size_t target = m_value;
+        size_t next = 0;
+        while (true)
+        {
+            for (; next < candidates.size() && model.peak() > target; next++)
+            {
+                if (model.try_recompute(candidates[next].get()))
+                {
+                    activations.push_back(candidates[next]);
+                }
+            }
+            if (activations.empty() || next == candidates.size())
+            {
+                break;
+            }
+            size_t peak = get_trial_peak(function, activations);
+            if (peak <= m_value || peak <= model.peak())
+            {
+                break;
+            }
+            size_t error = peak - model.peak();
+            target = error < target ? target - error : 0;
+        }
+    }
+
+    if (activations.empty())
+    {
+        return false;
+    }
+    recompute(function, m_y, m_c, activations);
+    m_peak_after = get_live_peak(function);
+    m_recomputed_count = activations.size();
+    NGRAPH_DEBUG << "RecomputeActivations: recomputed " << m_recomputed_count
+                 << " activations, peak live bytes " << m_peak_before << " -> " << m_peak_after;
+    return true;
+}
@@ -0,0 +1,91 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <set>
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class RecomputeActivations;
+    }
+}
+
+/// \brief Gradient checkpointing for training graphs built with autodiff::Adjoints.
+///
+/// The forward region is everything the differentiated values y are computed from, the rest
+/// of the function is the backward region. Cheap forward ops (elementwise arithmetic,
+/// Broadcast, Reshape, Convert) whose outputs are read by the backward region are candidate
+/// activations. A candidate that is not kept as a checkpoint is cloned for its backward users,
+/// recomputing it from the nearest checkpoints, so the forward activation dies with its last
+/// forward use. Each clone gets control dependencies on the seed dependent arguments of the
+/// first seed dependent op that consumes it, which keeps the recomputation late. Run it before
+/// Liveness and memory assignment.
+class ngraph::pass::RecomputeActivations : public FunctionPass
+{
+public:
+    enum class checkpoint_policy
+    {
+        /// Keep every k-th candidate activation in forward order, recompute the rest
+        EVERY_K,
+        /// Recompute the largest candidates first, as long as that lowers the peak of live
+        /// intermediate bytes, until the peak fits in the memory budget
+        MEMORY_BUDGET
+    };
+
+    /// \param y The differentiated values, as passed to autodiff::Adjoints
+    /// \param c The adjoint seeds, as passed to autodiff::Adjoints
+    /// \param policy How checkpoints are chosen
+    /// \param value k for EVERY_K, the budget in bytes for MEMORY_BUDGET
+    RecomputeActivations(const NodeVector& y,
+                         const NodeVector& c,
+                         checkpoint_policy policy,
+                         size_t value);
+    bool run_on_function(std::shared_ptr<ngraph::Function>) override;
+
+    /// \brief Predicted peak live intermediate bytes before the last run
+    size_t get_peak_before() const { return m_peak_before; }
+    /// \brief Predicted peak live intermediate bytes after the last run
+    size_t get_peak_after() const { return m_peak_after; }
+    /// \brief Number of forward activations recomputed by the last run
+    size_t get_recomputed_count() const { return m_recomputed_count; }
+    /// \brief Predicted peak live intermediate bytes of a function, from pass::Liveness
+    static size_t get_live_peak(std::shared_ptr<Function> function);
+
+private:
+    std::vector<std::shared_ptr<Node>>
+        get_candidates(const std::list<std::shared_ptr<Node>>& ops,
+                       const std::set<std::shared_ptr<Node>>& forward) const;
+    void recompute(std::shared_ptr<Function> function,
+                   const NodeVector& y,
+                   const NodeVector& c,
+                   const std::vector<std::shared_ptr<Node>>& activations) const;
+    /// Peak of a copy of function with activations recomputed
+    size_t get_trial_peak(const std::shared_ptr<Function>& function,
+                          const std::vector<std::shared_ptr<Node>>& activations) const;
+
+    NodeVector m_y;
+    NodeVector m_c;
+    checkpoint_policy m_policy;
+    size_t m_value;
+    size_t m_peak_before{0};
+    size_t m_peak_after{0};
+    size_t m_recomputed_count{0};
+};
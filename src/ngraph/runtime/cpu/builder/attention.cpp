@@ -0,0 +1,131 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/op/attention.hpp"
+#include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::Attention)
+            {
+                auto& functors = external_function->get_functors();
+
+                auto& q_tensor = external_function->get_tensor_data(args[0].get_name());
+                auto& k_tensor = external_function->get_tensor_data(args[1].get_name());
+                auto& v_tensor = external_function->get_tensor_data(args[2].get_name());
+                auto& out_tensor = external_function->get_tensor_data(out[0].get_name());
+
+                const auto* attention = static_cast<const ngraph::op::Attention*>(node);
+                const Shape& q_shape = args[0].get_shape();
+                const Shape& out_shape = out[0].get_shape();
+                size_t batch = q_shape[0];
+                size_t queries = q_shape[1];
+                size_t head_size = q_shape[2];
+                size_t keys = attention->get_is_k_transposed() ? args[1].get_shape()[2]
+                                                               : args[1].get_shape()[1];
+                size_t value_size = out_shape[2];
+                bool transpose_k = attention->get_is_k_transposed();
+                bool transpose_v = attention->get_is_v_transposed();
+                float scale = attention->get_scale();
+
+                if (!attention->has_mask())
+                {
+                    auto functor = [&,
+                                    batch,
+                                    queries,
+                                    keys,
+                                    head_size,
+                                    value_size,
+                                    transpose_k,
+                                    transpose_v,
+                                    scale](CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                        runtime::cpu::kernel::attention_float32(static_cast<float*>(q_tensor),
+                                                                static_cast<float*>(k_tensor),
+                                                                static_cast<float*>(v_tensor),
+                                                                nullptr,
+                                                                static_cast<float*>(out_tensor),
+                                                                batch,
+                                                                queries,
+                                                                keys,
+                                                                head_size,
+                                                                value_size,
+                                                                transpose_k,
+                                                                transpose_v,
+                                                                scale,
+                                                                Strides{0, 0, 0},
+                                                                ectx->arena);
+                    };
+                    functors.emplace_back(functor);
+                    return;
+                }
+
+                // The mask is read in place, with a zero stride along its broadcast axes
+                auto& mask_tensor = external_function->get_tensor_data(args[3].get_name());
+                const AxisSet& broadcast_axes = attention->get_mask_broadcast_axes();
+                Shape scores_shape{batch, queries, keys};
+                Strides mask_strides(scores_shape.size(), 0);
+                size_t stride = 1;
+                for (size_t i = scores_shape.size(); i-- > 0;)
+                {
+                    if (broadcast_axes.count(i) == 0)
+                    {
+                        mask_strides[i] = stride;
+                        stride *= scores_shape[i];
+                    }
+                }
+
+                auto functor = [&,
+                                batch,
+                                queries,
+                                keys,
+                                head_size,
+                                value_size,
+                                transpose_k,
+                                transpose_v,
+                                scale,
+                                mask_strides](CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                    runtime::cpu::kernel::attention_float32(static_cast<float*>(q_tensor),
+                                                            static_cast<float*>(k_tensor),
+                                                            static_cast<float*>(v_tensor),
+                                                            static_cast<float*>(mask_tensor),
+                                                            static_cast<float*>(out_tensor),
+                                                            batch,
+                                                            queries,
+                                                            keys,
+                                                            head_size,
+                                                            value_size,
+                                                            transpose_k,
+                                                            transpose_v,
+                                                            scale,
+                                                            mask_strides,
+                                                            ectx->arena);
+                };
+                functors.emplace_back(functor);
+            }
+
+            REGISTER_OP_BUILDER(Attention);
+        }
+    }
+}
@@ -17,7 +17,9 @@
 #include "ngraph/runtime/cpu/op/matmul_bias.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
 #include "ngraph/runtime/cpu/cpu_kernels.hpp"
+#include "ngraph/runtime/cpu/kernel/matmul_epilogue.hpp"
 #include "ngraph/runtime/cpu/op/batch_dot.hpp"
+#include "ngraph/runtime/cpu/op/matmul_epilogue.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -177,6 +179,80 @@ namespace ngraph
                 functors.emplace_back(functor);
             }
 
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::MatmulEpilogue)
+            {
+                auto& functors = external_function->get_functors();
+
+                auto& arg0_tensor = external_function->get_tensor_data(args[0].get_name());
+                auto& arg1_tensor = external_function->get_tensor_data(args[1].get_name());
+                auto& out0_tensor = external_function->get_tensor_data(out[0].get_name());
+
+                const auto* mm = static_cast<const ngraph::op::MatmulEpilogue*>(node);
+
+                const auto& arg0_shape = mm->get_a_shape();
+                const auto& arg1_shape = mm->get_b_shape();
+                const auto& out_shape = out[0].get_shape();
+
+                auto m = out_shape[0];
+                auto n = out_shape[1];
+                auto k = mm->get_is_a_transposed() ? arg0_shape[0] : arg0_shape[1];
+                auto lda = arg0_shape[1];
+                auto ldb = arg1_shape[1];
+                bool transpose_A = mm->get_is_a_transposed();
+                bool transpose_B = mm->get_is_b_transposed();
+
+                vector<runtime::cpu::kernel::EpilogueStep> steps;
+                vector<void**> operand_tensors;
+                for (const auto& step : mm->get_steps())
+                {
+                    runtime::cpu::kernel::EpilogueStep kernel_step{
+                        step.kind, step.alpha, operand_tensors.size(), 0, 0};
+                    if (ngraph::op::MatmulEpilogue::takes_operand(step.kind))
+                    {
+                        const AxisSet& axes = step.broadcast_axes;
+                        kernel_step.row_stride = axes.count(0) ? 0 : (axes.count(1) ? 1 : n);
+                        kernel_step.col_stride = axes.count(1) ? 0 : 1;
+                        operand_tensors.push_back(&external_function->get_tensor_data(
+                            args[2 + operand_tensors.size()].get_name()));
+                    }
+                    steps.push_back(kernel_step);
+                }
+                vector<void*> operands(operand_tensors.size());
+
+                auto functor = [&,
+                                m,
+                                n,
+                                k,
+                                lda,
+                                ldb,
+                                transpose_A,
+                                transpose_B,
+                                steps,
+                                operand_tensors,
+                                operands](CPURuntimeContext* ctx,
+                                          CPUExecutionContext* ectx) mutable {
+                    for (size_t i = 0; i < operand_tensors.size(); i++)
+                    {
+                        operands[i] = *operand_tensors[i];
+                    }
+                    runtime::cpu::kernel::matmul_epilogue(arg0_tensor,
+                                                          arg1_tensor,
+                                                          out0_tensor,
+                                                          m,
+                                                          n,
+                                                          k,
+                                                          lda,
+                                                          ldb,
+                                                          transpose_A,
+                                                          transpose_B,
+                                                          steps,
+                                                          operands.data(),
+                                                          ectx->arena);
+                };
+                functors.emplace_back(functor);
+            }
+
             struct CblasGemmOptions
             {
                 CblasGemmOptions(void*& da, void*& db, void*& dc)
@@ -350,6 +426,7 @@ namespace ngraph
             }
 
             REGISTER_OP_BUILDER(MatmulBias);
+            REGISTER_OP_BUILDER(MatmulEpilogue);
             REGISTER_OP_BUILDER(BatchDot);
         }
     }
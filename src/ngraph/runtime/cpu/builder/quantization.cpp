@@ -21,10 +21,10 @@
 #include "ngraph/op/quantize.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
 #include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/kernel/quantization.hpp"
 #include "ngraph/runtime/cpu/mkldnn_invoke.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
-#include "ngraph/runtime/reference/dequantize.hpp"
-#include "ngraph/runtime/reference/quantize.hpp"
+#include "ngraph/runtime/cpu/op/quantized_lookup.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -120,28 +120,30 @@ namespace ngraph
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::dequantize<int8_t>(
-                                    static_cast<int8_t*>(arg0_tensor),
-                                    static_cast<float*>(arg1_tensor),
-                                    static_cast<int8_t*>(arg2_tensor),
-                                    static_cast<float*>(out_tensor),
+                                runtime::cpu::kernel::dequantize<int8_t, float>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
-                                    daxes);
+                                    daxes,
+                                    ectx->arena);
                             };
                         }
                         else if (out[0].get_element_type() == element::f64)
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::dequantize<int8_t>(
-                                    static_cast<int8_t*>(arg0_tensor),
-                                    static_cast<double*>(arg1_tensor),
-                                    static_cast<int8_t*>(arg2_tensor),
-                                    static_cast<double*>(out_tensor),
+                                runtime::cpu::kernel::dequantize<int8_t, double>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
-                                    daxes);
+                                    daxes,
+                                    ectx->arena);
                             };
                         }
                         else
@@ -155,28 +157,30 @@ namespace ngraph
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::dequantize<uint8_t>(
-                                    static_cast<uint8_t*>(arg0_tensor),
-                                    static_cast<float*>(arg1_tensor),
-                                    static_cast<uint8_t*>(arg2_tensor),
-                                    static_cast<float*>(out_tensor),
+                                runtime::cpu::kernel::dequantize<uint8_t, float>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
-                                    daxes);
+                                    daxes,
+                                    ectx->arena);
                             };
                         }
                         else if (out[0].get_element_type() == element::f64)
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::dequantize<uint8_t>(
-                                    static_cast<uint8_t*>(arg0_tensor),
-                                    static_cast<double*>(arg1_tensor),
-                                    static_cast<uint8_t*>(arg2_tensor),
-                                    static_cast<double*>(out_tensor),
+                                runtime::cpu::kernel::dequantize<uint8_t, double>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
-                                    daxes);
+                                    daxes,
+                                    ectx->arena);
                             };
                         }
                         else
@@ -190,28 +194,30 @@ namespace ngraph
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::dequantize<int32_t>(
-                                    static_cast<int32_t*>(arg0_tensor),
-                                    static_cast<float*>(arg1_tensor),
-                                    static_cast<int32_t*>(arg2_tensor),
-                                    static_cast<float*>(out_tensor),
+                                runtime::cpu::kernel::dequantize<int32_t, float>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
-                                    daxes);
+                                    daxes,
+                                    ectx->arena);
                             };
                         }
                         else if (out[0].get_element_type() == element::f64)
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::dequantize<int32_t>(
-                                    static_cast<int32_t*>(arg0_tensor),
-                                    static_cast<double*>(arg1_tensor),
-                                    static_cast<int32_t*>(arg2_tensor),
-                                    static_cast<double*>(out_tensor),
+                                runtime::cpu::kernel::dequantize<int32_t, double>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
-                                    daxes);
+                                    daxes,
+                                    ectx->arena);
                             };
                         }
                         else
@@ -321,45 +327,48 @@ namespace ngraph
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes, round_mode](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::quantize<float>(
-                                    static_cast<float*>(arg0_tensor),
-                                    static_cast<float*>(arg1_tensor),
-                                    static_cast<int8_t*>(arg2_tensor),
-                                    static_cast<int8_t*>(out_tensor),
+                                runtime::cpu::kernel::quantize<float, int8_t>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
                                     daxes,
-                                    round_mode);
+                                    round_mode,
+                                    ectx->arena);
                             };
                         }
                         else if (out[0].get_element_type() == element::u8)
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes, round_mode](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::quantize<float>(
-                                    static_cast<float*>(arg0_tensor),
-                                    static_cast<float*>(arg1_tensor),
-                                    static_cast<uint8_t*>(arg2_tensor),
-                                    static_cast<uint8_t*>(out_tensor),
+                                runtime::cpu::kernel::quantize<float, uint8_t>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
                                     daxes,
-                                    round_mode);
+                                    round_mode,
+                                    ectx->arena);
                             };
                         }
                         else if (out[0].get_element_type() == element::i32)
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes, round_mode](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::quantize<float>(
-                                    static_cast<float*>(arg0_tensor),
-                                    static_cast<float*>(arg1_tensor),
-                                    static_cast<int32_t*>(arg2_tensor),
-                                    static_cast<int32_t*>(out_tensor),
+                                runtime::cpu::kernel::quantize<float, int32_t>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
                                     daxes,
-                                    round_mode);
+                                    round_mode,
+                                    ectx->arena);
                             };
                         }
                         else
@@ -373,45 +382,48 @@ namespace ngraph
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes, round_mode](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::quantize<double>(
-                                    static_cast<double*>(arg0_tensor),
-                                    static_cast<double*>(arg1_tensor),
-                                    static_cast<int8_t*>(arg2_tensor),
-                                    static_cast<int8_t*>(out_tensor),
+                                runtime::cpu::kernel::quantize<double, int8_t>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
                                     daxes,
-                                    round_mode);
+                                    round_mode,
+                                    ectx->arena);
                             };
                         }
                         else if (out[0].get_element_type() == element::u8)
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes, round_mode](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::quantize<double>(
-                                    static_cast<double*>(arg0_tensor),
-                                    static_cast<double*>(arg1_tensor),
-                                    static_cast<uint8_t*>(arg2_tensor),
-                                    static_cast<uint8_t*>(out_tensor),
+                                runtime::cpu::kernel::quantize<double, uint8_t>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
                                     daxes,
-                                    round_mode);
+                                    round_mode,
+                                    ectx->arena);
                             };
                         }
                         else if (out[0].get_element_type() == element::i32)
                         {
                             functor = [&, arg0_shape, arg1_shape, daxes, round_mode](
                                 CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                                ngraph::runtime::reference::quantize<double>(
-                                    static_cast<double*>(arg0_tensor),
-                                    static_cast<double*>(arg1_tensor),
-                                    static_cast<int32_t*>(arg2_tensor),
-                                    static_cast<int32_t*>(out_tensor),
+                                runtime::cpu::kernel::quantize<double, int32_t>(
+                                    arg0_tensor,
+                                    arg1_tensor,
+                                    arg2_tensor,
+                                    out_tensor,
                                     arg0_shape,
                                     arg1_shape,
                                     daxes,
-                                    round_mode);
+                                    round_mode,
+                                    ectx->arena);
                             };
                         }
                         else
@@ -428,8 +440,48 @@ namespace ngraph
                 }
             }
 
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::QuantizedLookup)
+            {
+                auto& functors = external_function->get_functors();
+                auto& arg0_tensor = external_function->get_tensor_data(args[0].get_name());
+                auto& arg1_tensor = external_function->get_tensor_data(args[1].get_name());
+                auto& out_tensor = external_function->get_tensor_data(out[0].get_name());
+                auto count = out[0].get_size();
+                bool is_signed = args[0].get_element_type() == element::i8;
+                auto out_type = out[0].get_element_type();
+
+                std::function<void(void*, void*, void*, size_t, int)> kernel;
+                if (out_type == element::i8)
+                {
+                    kernel = is_signed ? runtime::cpu::kernel::quantized_lookup<int8_t, int8_t>
+                                       : runtime::cpu::kernel::quantized_lookup<uint8_t, int8_t>;
+                }
+                else if (out_type == element::u8)
+                {
+                    kernel = is_signed ? runtime::cpu::kernel::quantized_lookup<int8_t, uint8_t>
+                                       : runtime::cpu::kernel::quantized_lookup<uint8_t, uint8_t>;
+                }
+                else if (out_type == element::i32)
+                {
+                    kernel = is_signed ? runtime::cpu::kernel::quantized_lookup<int8_t, int32_t>
+                                       : runtime::cpu::kernel::quantized_lookup<uint8_t, int32_t>;
+                }
+                else
+                {
+                    throw ngraph_error("Unsupported output element type for QuantizedLookup");
+                }
+
+                auto functor = [&, kernel, count](CPURuntimeContext* ctx,
+                                                  CPUExecutionContext* ectx) {
+                    kernel(arg0_tensor, arg1_tensor, out_tensor, count, ectx->arena);
+                };
+                functors.emplace_back(functor);
+            }
+
             REGISTER_OP_BUILDER(Dequantize);
             REGISTER_OP_BUILDER(Quantize);
+            REGISTER_OP_BUILDER(QuantizedLookup);
         }
     }
 }
@@ -68,10 +68,8 @@ namespace ngraph
                 }
 
                 auto arg_shape = args[0].get_shape();
-                auto arg_rank = arg_shape.size();
 
                 auto result_shape = out[0].get_shape();
-                auto result_rank = result_shape.size();
                 auto& result_element_type = out[0].get_element_type();
 
                 auto input_order = reshape->get_input_order();
@@ -90,46 +88,8 @@ namespace ngraph
                     return;
                 }
 
-                std::function<decltype(runtime::cpu::kernel::reshape_1d<float, 2>)> kernel;
-                if (arg_rank == 1)
-                {
-                    SELECT_KERNEL_BY_RANK(
-                        kernel, result_element_type, result_rank, runtime::cpu::kernel::reshape_1d);
-                }
-                else if (arg_rank == 2)
-                {
-                    SELECT_KERNEL_BY_RANK(
-                        kernel, result_element_type, result_rank, runtime::cpu::kernel::reshape_2d);
-                }
-                else if (arg_rank == 3)
-                {
-                    SELECT_KERNEL_BY_RANK(
-                        kernel, result_element_type, result_rank, runtime::cpu::kernel::reshape_3d);
-                }
-                else if (arg_rank == 4)
-                {
-                    SELECT_KERNEL_BY_RANK(
-                        kernel, result_element_type, result_rank, runtime::cpu::kernel::reshape_4d);
-                }
-                else
-                {
-                    std::function<decltype(runtime::cpu::kernel::reshape_ref<float>)> ref_kernel;
-
-                    SELECT_KERNEL(
-                        ref_kernel, result_element_type, runtime::cpu::kernel::reshape_ref);
-
-                    auto functor = [&, ref_kernel, arg_shape, input_order, result_shape](
-                        CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                        ref_kernel(arg_tensor,
-                                   out_tensor,
-                                   arg_shape,
-                                   input_order,
-                                   result_shape,
-                                   ectx->arena);
-                    };
-                    functors.emplace_back(functor);
-                    return;
-                }
+                std::function<decltype(runtime::cpu::kernel::reshape<float>)> kernel;
+                SELECT_KERNEL(kernel, result_element_type, runtime::cpu::kernel::reshape);
 
                 auto functor = [&, kernel, arg_shape, input_order, result_shape](
                     CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
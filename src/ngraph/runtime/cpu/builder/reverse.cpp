@@ -47,7 +47,12 @@ namespace ngraph
 
                 auto functor = [&, kernel, arg_shape, result_shape, reversed_axes](
                     CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
-                    kernel(arg_tensor, out_tensor, arg_shape, result_shape, reversed_axes);
+                    kernel(arg_tensor,
+                           out_tensor,
+                           arg_shape,
+                           result_shape,
+                           reversed_axes,
+                           ectx->arena);
                 };
                 functors.emplace_back(functor);
             }
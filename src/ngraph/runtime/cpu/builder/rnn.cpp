@@ -16,6 +16,7 @@
 
 #include "ngraph/runtime/cpu/op/rnn.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
 #include "ngraph/runtime/cpu/mkldnn_invoke.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 
@@ -31,13 +32,6 @@ namespace ngraph
             template <>
             void Builder::BUILDER_DECL(ngraph::op::Rnn)
             {
-                if (!runtime::cpu::mkldnn_utils::use_mkldnn_kernel(node))
-                {
-                    throw ngraph_error(
-                        "Rnn is supported only through MKLDNN and doesnt have reference "
-                        "INTERPRETER implementation");
-                }
-
                 auto& functors = external_function->get_functors();
 
                 auto& src_layer_tensor = external_function->get_tensor_data(args[0].get_name());
@@ -48,6 +42,40 @@ namespace ngraph
                 auto& dst_layer_tensor = external_function->get_tensor_data(out[0].get_name());
                 auto& dst_iter_tensor = external_function->get_tensor_data(out[1].get_name());
 
+                if (!runtime::cpu::mkldnn_utils::use_mkldnn_kernel(node))
+                {
+                    const auto* rnn = static_cast<const ngraph::op::Rnn*>(node);
+                    if (!rnn->is_single_lstm_layer() || args[0].get_element_type() != element::f32)
+                    {
+                        throw ngraph_error(
+                            "Rnn is supported only through MKLDNN, except for a single forward "
+                            "f32 LSTM layer");
+                    }
+
+                    size_t seq_length = rnn->get_src_sequence_length();
+                    size_t batch = rnn->get_batch_size();
+                    size_t input_size = rnn->get_src_layer_feature_size();
+                    size_t hidden_size = rnn->get_src_iter_feature_size();
+                    auto functor = [&, seq_length, batch, input_size, hidden_size](
+                        CPURuntimeContext* ctx, CPUExecutionContext* ectx) {
+                        runtime::cpu::kernel::lstm_forward_float32(
+                            static_cast<float*>(src_layer_tensor),
+                            static_cast<float*>(src_iter_tensor),
+                            static_cast<float*>(weights_layer_tensor),
+                            static_cast<float*>(weights_iter_tensor),
+                            static_cast<float*>(bias_tensor),
+                            static_cast<float*>(dst_layer_tensor),
+                            static_cast<float*>(dst_iter_tensor),
+                            seq_length,
+                            batch,
+                            input_size,
+                            hidden_size,
+                            ectx->arena);
+                    };
+                    functors.emplace_back(functor);
+                    return;
+                }
+
                 auto& mkldnn_emitter = external_function->get_mkldnn_emitter();
                 auto rnn_desc =
                     mkldnn_emitter->get_rnn_forward_desc<ngraph::op::Rnn>(node, args, out);
@@ -16,7 +16,7 @@
 
 #include "ngraph/op/experimental/generate_mask.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
-#include "ngraph/runtime/reference/generate_mask.hpp"
+#include "ngraph/runtime/cpu/kernel/generate_mask.hpp"
 #include "ngraph/state/rng_state.hpp"
 
 using namespace std;
@@ -49,10 +49,12 @@ namespace ngraph
                     functor = [&, index, element_count](CPURuntimeContext* ctx,
                                                         CPUExecutionContext* ectx) {
                         bool training = static_cast<bool>(static_cast<float*>(arg_tensor)[0]);
-                        reference::generate_mask(static_cast<float*>(out_tensor),
-                                                 element_count,
-                                                 static_cast<RNGState*>(ctx->states[index]),
-                                                 training);
+                        runtime::cpu::kernel::generate_mask<float>(
+                            out_tensor,
+                            element_count,
+                            static_cast<RNGState*>(ctx->states[index]),
+                            training,
+                            ectx->arena);
                     };
                 }
                 else if (args[0].get_element_type() == element::f64)
@@ -60,10 +62,12 @@ namespace ngraph
                     functor = [&, index, element_count](CPURuntimeContext* ctx,
                                                         CPUExecutionContext* ectx) {
                         bool training = static_cast<bool>(static_cast<double*>(arg_tensor)[0]);
-                        reference::generate_mask(static_cast<double*>(out_tensor),
-                                                 element_count,
-                                                 static_cast<RNGState*>(ctx->states[index]),
-                                                 training);
+                        runtime::cpu::kernel::generate_mask<double>(
+                            out_tensor,
+                            element_count,
+                            static_cast<RNGState*>(ctx->states[index]),
+                            training,
+                            ectx->arena);
                     };
                 }
                 else
@@ -201,6 +201,8 @@
         throw ngraph_error("Unsupported element type " + ET.c_type_string() + " for kernel " #K);  \
     }
 
+// Elementwise functors recompute only the stale rows of their output
+// once the first iteration has filled it in completely
 #define BUILD_UNARY_ELEMWISE_FUNCTOR(OP)                                                           \
     auto& functors = external_function->get_functors();                                            \
     std::function<void(void*, void*, size_t, int)> kernel;                                         \
@@ -208,11 +210,31 @@
     SELECT_KERNEL(kernel, args[0].get_element_type(), OP);                                         \
                                                                                                    \
     auto element_count = out[0].get_size();                                                        \
+    auto row_count = out[0].get_shape().empty() ? 1 : out[0].get_shape()[0];                       \
+    auto row_size = row_count == 0 ? 0 : element_count / row_count;                                \
+    auto arg0_element_size = args[0].get_element_type().size();                                    \
+    auto out0_element_size = out[0].get_element_type().size();                                     \
     auto& arg0_tensor = external_function->get_tensor_data(args[0].get_name());                    \
     auto& out0_tensor = external_function->get_tensor_data(out[0].get_name());                     \
+    auto& out0_stale_rows = external_function->get_tensor_stale_rows(out[0].get_name());           \
                                                                                                    \
-    auto functor = [&, kernel, element_count](CPURuntimeContext* ctx, CPUExecutionContext* ectx) { \
-        kernel(arg0_tensor, out0_tensor, element_count, ectx->arena);                              \
+    auto functor = [&,                                                                             \
+                    kernel,                                                                        \
+                    element_count,                                                                 \
+                    row_size,                                                                      \
+                    arg0_element_size,                                                             \
+                    out0_element_size](CPURuntimeContext* ctx, CPUExecutionContext* ectx) {        \
+        size_t offset = 0;                                                                         \
+        size_t count = element_count;                                                              \
+        if (!ctx->first_iteration)                                                                 \
+        {                                                                                          \
+            offset = out0_stale_rows.first * row_size;                                             \
+            count = (out0_stale_rows.second - out0_stale_rows.first) * row_size;                   \
+        }                                                                                          \
+        kernel(static_cast<char*>(arg0_tensor) + offset * arg0_element_size,                       \
+               static_cast<char*>(out0_tensor) + offset * out0_element_size,                       \
+               count,                                                                              \
+               ectx->arena);                                                                       \
     };                                                                                             \
     functors.emplace_back(functor);
 
@@ -223,12 +245,33 @@
     SELECT_KERNEL(kernel, args[0].get_element_type(), OP);                                         \
                                                                                                    \
     auto element_count = out[0].get_size();                                                        \
+    auto row_count = out[0].get_shape().empty() ? 1 : out[0].get_shape()[0];                       \
+    auto row_size = row_count == 0 ? 0 : element_count / row_count;                                \
+    auto arg_element_size = args[0].get_element_type().size();                                     \
+    auto out0_element_size = out[0].get_element_type().size();                                     \
     auto& arg0_tensor = external_function->get_tensor_data(args[0].get_name());                    \
     auto& arg1_tensor = external_function->get_tensor_data(args[1].get_name());                    \
     auto& out0_tensor = external_function->get_tensor_data(out[0].get_name());                     \
+    auto& out0_stale_rows = external_function->get_tensor_stale_rows(out[0].get_name());           \
                                                                                                    \
-    auto functor = [&, kernel, element_count](CPURuntimeContext* ctx, CPUExecutionContext* ectx) { \
-        kernel(arg0_tensor, arg1_tensor, out0_tensor, element_count, ectx->arena);                 \
+    auto functor = [&,                                                                             \
+                    kernel,                                                                        \
+                    element_count,                                                                 \
+                    row_size,                                                                      \
+                    arg_element_size,                                                              \
+                    out0_element_size](CPURuntimeContext* ctx, CPUExecutionContext* ectx) {        \
+        size_t offset = 0;                                                                         \
+        size_t count = element_count;                                                              \
+        if (!ctx->first_iteration)                                                                 \
+        {                                                                                          \
+            offset = out0_stale_rows.first * row_size;                                             \
+            count = (out0_stale_rows.second - out0_stale_rows.first) * row_size;                   \
+        }                                                                                          \
+        kernel(static_cast<char*>(arg0_tensor) + offset * arg_element_size,                        \
+               static_cast<char*>(arg1_tensor) + offset * arg_element_size,                        \
+               static_cast<char*>(out0_tensor) + offset * out0_element_size,                       \
+               count,                                                                              \
+               ectx->arena);                                                                       \
     };                                                                                             \
     functors.emplace_back(functor);
 
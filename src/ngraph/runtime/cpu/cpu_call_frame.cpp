@@ -19,6 +19,7 @@
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_resource_manager.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
 
@@ -49,6 +50,7 @@ runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction>
 
 runtime::cpu::CPU_CallFrame::~CPU_CallFrame()
 {
+    GetCPUResourceManager().unregister_call_frame(this);
     if (!m_external_function->is_direct_execution())
     {
         NGRAPH_ASSERT(m_compiled_destroy_ctx_func) << "compiled_destroy_ctx_func cannot be null.";
@@ -63,11 +65,29 @@ void runtime::cpu::CPU_CallFrame::inner_call(
     vector<void*> inputs;
     vector<void*> outputs;
 
+    auto& resource_manager = GetCPUResourceManager();
+    ctx->memory_buffers_changed = resource_manager.acquire_buffers(
+        this,
+        m_external_function->get_memory_buffer_sizes(),
+        runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment);
+    ctx->arena = resource_manager.get_thread_pool(this);
+
     for (size_t i = 0; i < input_tvs.size(); i++)
     {
         shared_ptr<runtime::cpu::CPUTensorView> tv =
             static_pointer_cast<runtime::cpu::CPUTensorView>(input_tvs[i]);
-        ctx->p_en[i] = tv->get_stale();
+        // Intermediates that lived in lost buffers have to be recomputed from scratch
+        if (ctx->memory_buffers_changed)
+        {
+            const Shape& shape = tv->get_shape();
+            ctx->p_en[i] = true;
+            ctx->p_stale_rows[i] = make_pair(size_t(0), shape.empty() ? size_t(1) : shape[0]);
+        }
+        else
+        {
+            ctx->p_en[i] = tv->get_stale();
+            ctx->p_stale_rows[i] = tv->get_stale_rows();
+        }
         inputs.push_back(tv->get_data_ptr());
     }
     for (size_t i = 0; i < output_tvs.size(); i++)
@@ -101,7 +121,20 @@ void runtime::cpu::CPU_CallFrame::call(
 {
     ctx->pc = 0;
     propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
-    inner_call(output_tvs, input_tvs);
+    auto start_ts = cpu::Clock::now();
+    try
+    {
+        inner_call(output_tvs, input_tvs);
+    }
+    catch (...)
+    {
+        GetCPUResourceManager().release_buffers(this);
+        throw;
+    }
+    auto duration = chrono::duration_cast<chrono::microseconds>(cpu::Clock::now() - start_ts);
+    auto& resource_manager = GetCPUResourceManager();
+    resource_manager.record_call(this, duration.count());
+    resource_manager.release_buffers(this);
 }
 
 void runtime::cpu::CPU_CallFrame::propagate_layouts(
@@ -135,16 +168,17 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context()
         ctx->op_durations = new int64_t[m_external_function->get_op_attrs().size()];
     }
     ctx->p_en = new bool[m_external_function->get_parameter_layout_descriptors().size()];
+    ctx->p_stale_rows = new std::pair<size_t, size_t>[
+        m_external_function->get_parameter_layout_descriptors().size()];
 
     ctx->first_iteration = true;
 
-    // Create temporary buffer pools
-    size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
-    for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
-    {
-        auto buffer = new AlignedBuffer(buffer_size, alignment);
-        ctx->memory_buffers.push_back(buffer);
-    }
+    // Temporary buffer pools are allocated by the resource manager when a call needs them
+    ctx->memory_buffers.assign(m_external_function->get_memory_buffer_sizes().size(), nullptr);
+    ctx->memory_buffers_changed = false;
+    ctx->arena = 0;
+    GetCPUResourceManager().register_call_frame(
+        this, m_external_function->get_function_name(), &ctx->memory_buffers);
     const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
     ctx->mkldnn_primitives = mkldnn_emitter->get_mkldnn_primitives().data();
     ctx->mkldnn_workspaces = mkldnn_emitter->get_mkldnn_workspaces().data();
@@ -173,10 +207,7 @@ void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
 {
     delete[] ctx->op_durations;
     delete[] ctx->p_en;
-    for (auto buffer : ctx->memory_buffers)
-    {
-        delete buffer;
-    }
+    delete[] ctx->p_stale_rows;
     if (m_external_function->is_direct_execution() && std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
     {
         // For codegen mode, graph and global control are now part of a code generated
@@ -17,7 +17,9 @@
 #include "ngraph/runtime/cpu/cpu_emitter.hpp"
 #include <algorithm>
 #include <cmath>
+#include <iomanip>
 #include <numeric>
+#include <sstream>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
@@ -101,8 +103,10 @@
 #include "ngraph/op/topk.hpp"
 #include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_kernel_emitters.hpp"
+#include "ngraph/runtime/cpu/kernel/matmul_epilogue.hpp"
 #include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/attention.hpp"
 #include "ngraph/runtime/cpu/op/batch_dot.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
 #include "ngraph/runtime/cpu/op/bounded_relu.hpp"
@@ -116,7 +120,9 @@
 #include "ngraph/runtime/cpu/op/loop_kernel.hpp"
 #include "ngraph/runtime/cpu/op/lstm.hpp"
 #include "ngraph/runtime/cpu/op/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/op/matmul_epilogue.hpp"
 #include "ngraph/runtime/cpu/op/max_pool_with_indices.hpp"
+#include "ngraph/runtime/cpu/op/quantized_lookup.hpp"
 #include "ngraph/runtime/cpu/op/rnn.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
@@ -513,6 +519,139 @@ namespace ngraph
                 }
             }
 
+            template <>
+            void CPU_Emitter::EMITTER_DECL(ngraph::op::MatmulEpilogue)
+            {
+                using Kind = ngraph::op::MatmulEpilogue::Kind;
+                const auto* mm = static_cast<const ngraph::op::MatmulEpilogue*>(node);
+
+                const Shape& arg0_shape = mm->get_a_shape();
+                const Shape& arg1_shape = mm->get_b_shape();
+                const Shape& out_shape = out[0].get_shape();
+                size_t m = out_shape[0];
+                size_t n = out_shape[1];
+                size_t k = mm->get_is_a_transposed() ? arg0_shape[0] : arg0_shape[1];
+
+                // One SGEMM per panel of rows, each followed by its epilogue while the panel is
+                // in cache, as in the matmul_epilogue kernel
+                size_t panel_rows =
+                    mm->get_steps().empty()
+                        ? max(1UL, m)
+                        : runtime::cpu::kernel::matmul_epilogue_panel_rows(m, n);
+                size_t lda = max(1UL, arg0_shape[1]);
+                writer.block_begin();
+                writer << "for (size_t panel = 0; panel < " << m << "; panel += " << panel_rows
+                       << ")\n";
+                writer.block_begin();
+                writer << "size_t rows = std::min<size_t>(" << panel_rows << ", " << m
+                       << " - panel);\n";
+                writer << "cblas::cblas_sgemm(cblas::Layout::RowMajor, "
+                       << (mm->get_is_a_transposed() ? "cblas::Transpose::Transpose, "
+                                                     : "cblas::Transpose::None, ")
+                       << (mm->get_is_b_transposed() ? "cblas::Transpose::Transpose, "
+                                                     : "cblas::Transpose::None, ")
+                       << "rows, " << n << ", " << k << ",\n"
+                       << "        1.0f, " << args[0].get_name() << " + panel"
+                       << (mm->get_is_a_transposed() ? "" : " * " + to_string(lda)) << ", "
+                       << lda << ", " << args[1].get_name() << ", "
+                       << max(1UL, arg1_shape[1]) << ", 0.0f,\n"
+                       << "        " << out[0].get_name() << " + panel * " << n << ", "
+                       << max(1UL, n) << ");\n";
+
+                if (!mm->get_steps().empty())
+                {
+                    writer << "#pragma omp parallel for\n";
+                    writer << "for (size_t r = panel; r < panel + rows; r++)\n";
+                    writer.block_begin();
+                    writer << "float* row = " << out[0].get_name() << " + r * " << n << ";\n";
+                    writer << "for (size_t j = 0; j < " << n << "; j++)\n";
+                    writer.block_begin();
+                    writer << "float v = row[j];\n";
+                    size_t operand = 2;
+                    for (const auto& step : mm->get_steps())
+                    {
+                        string x;
+                        if (ngraph::op::MatmulEpilogue::takes_operand(step.kind))
+                        {
+                            const AxisSet& axes = step.broadcast_axes;
+                            size_t row_stride = axes.count(0) ? 0 : (axes.count(1) ? 1 : n);
+                            size_t col_stride = axes.count(1) ? 0 : 1;
+                            x = args[operand++].get_name() + "[r * " + to_string(row_stride) +
+                                " + j * " + to_string(col_stride) + "]";
+                        }
+                        switch (step.kind)
+                        {
+                        case Kind::Add: writer << "v = v + " << x << ";\n"; break;
+                        case Kind::Multiply: writer << "v = v * " << x << ";\n"; break;
+                        case Kind::Minimum:
+                            writer << "v = v < " << x << " ? v : " << x << ";\n";
+                            break;
+                        case Kind::Maximum:
+                            writer << "v = v > " << x << " ? v : " << x << ";\n";
+                            break;
+                        case Kind::Relu: writer << "v = v > 0.0f ? v : 0.0f;\n"; break;
+                        case Kind::BoundedRelu:
+                            writer << "v = v > 0.0f ? v : 0.0f;\n";
+                            writer << "v = v < " << step.alpha << " ? v : " << step.alpha
+                                   << ";\n";
+                            break;
+                        case Kind::Sigmoid: writer << "v = 1.0f / (1.0f + std::exp(-v));\n"; break;
+                        case Kind::Tanh: writer << "v = std::tanh(v);\n"; break;
+                        }
+                    }
+                    writer << "row[j] = v;\n";
+                    writer.block_end();
+                    writer.block_end();
+                }
+                writer.block_end();
+                writer.block_end();
+            }
+
+            template <>
+            void CPU_Emitter::EMITTER_DECL(ngraph::op::Attention)
+            {
+                const auto* attention = static_cast<const ngraph::op::Attention*>(node);
+                const Shape& q_shape = args[0].get_shape();
+                size_t keys = attention->get_is_k_transposed() ? args[1].get_shape()[2]
+                                                               : args[1].get_shape()[1];
+
+                Strides mask_strides{0, 0, 0};
+                if (attention->has_mask())
+                {
+                    Shape scores_shape{q_shape[0], q_shape[1], keys};
+                    size_t stride = 1;
+                    for (size_t i = scores_shape.size(); i-- > 0;)
+                    {
+                        if (attention->get_mask_broadcast_axes().count(i) == 0)
+                        {
+                            mask_strides[i] = stride;
+                            stride *= scores_shape[i];
+                        }
+                    }
+                }
+                // Keep every bit of the scale
+                stringstream scale;
+                scale << setprecision(9) << attention->get_scale() << "f";
+
+                writer << "cpu::kernel::attention_float32(" << args[0].get_name() << ",\n"
+                       << "                               " << args[1].get_name() << ",\n"
+                       << "                               " << args[2].get_name() << ",\n"
+                       << "                               "
+                       << (attention->has_mask() ? args[3].get_name() : "nullptr") << ",\n"
+                       << "                               " << out[0].get_name() << ",\n"
+                       << "                               " << q_shape[0] << ", " << q_shape[1]
+                       << ", " << keys << ", " << q_shape[2] << ", "
+                       << out[0].get_shape()[2] << ",\n"
+                       << "                               "
+                       << ngraph::to_cplusplus_sourcecode_literal(
+                              attention->get_is_k_transposed())
+                       << ", "
+                       << ngraph::to_cplusplus_sourcecode_literal(
+                              attention->get_is_v_transposed())
+                       << ", " << scale.str() << ",\n"
+                       << "                               {" << join(mask_strides) << "}, 0);\n";
+            }
+
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::op::BatchDot)
             {
@@ -562,6 +701,29 @@ namespace ngraph
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::op::Rnn)
             {
+                if (!runtime::cpu::mkldnn_utils::use_mkldnn_kernel(node))
+                {
+                    const auto* rnn = static_cast<const ngraph::op::Rnn*>(node);
+                    if (!rnn->is_single_lstm_layer() || args[0].get_element_type() != element::f32)
+                    {
+                        throw ngraph_error(
+                            "Rnn is supported only through MKLDNN, except for a single forward "
+                            "f32 LSTM layer");
+                    }
+                    writer << "cpu::kernel::lstm_forward_float32(" << args[0].get_name() << ",\n"
+                           << "                                  " << args[1].get_name() << ",\n"
+                           << "                                  " << args[2].get_name() << ",\n"
+                           << "                                  " << args[3].get_name() << ",\n"
+                           << "                                  " << args[4].get_name() << ",\n"
+                           << "                                  " << out[0].get_name() << ",\n"
+                           << "                                  " << out[1].get_name() << ",\n"
+                           << "                                  "
+                           << rnn->get_src_sequence_length() << ", " << rnn->get_batch_size()
+                           << ", " << rnn->get_src_layer_feature_size() << ", "
+                           << rnn->get_src_iter_feature_size() << ", 0);\n";
+                    return;
+                }
+
                 auto& mkldnn_emitter = external_function->get_mkldnn_emitter();
                 auto rnn_index = mkldnn_emitter->build_rnn<ngraph::op::Rnn>(node, args, out);
                 auto& deps = mkldnn_emitter->get_primitive_deps(rnn_index);
@@ -1385,18 +1547,32 @@ namespace ngraph
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::op::Convert)
             {
+                auto& arg_element_type = args[0].get_element_type();
                 auto& result_element_type = out[0].get_element_type();
 
-                writer << "if ((void*)" << out[0].get_name() << " != (void*)" << args[0].get_name()
-                       << ") \n";
-                writer.block_begin();
+                // An in-place i8 <-> u8 conversion leaves the bits unchanged and can be skipped.
+                // Other in-place conversions are between types of the same width and convert
+                // each element where it is.
+                bool bitwise = (arg_element_type == element::i8 ||
+                                arg_element_type == element::u8) &&
+                               (result_element_type == element::i8 ||
+                                result_element_type == element::u8);
+                if (bitwise)
+                {
+                    writer << "if ((void*)" << out[0].get_name() << " != (void*)"
+                           << args[0].get_name() << ") \n";
+                    writer.block_begin();
+                }
                 writer << "#pragma omp parallel for\n";
                 writer << "for (size_t i = 0; i < " << out[0].get_size() << "; i++)\n";
                 writer.block_begin();
                 writer << out[0].get_name() << "[i] = (" << result_element_type.c_type_string()
                        << ")(" << args[0].get_name() << "[i]);\n";
                 writer.block_end();
-                writer.block_end();
+                if (bitwise)
+                {
+                    writer.block_end();
+                }
             }
 
             template <>
@@ -4041,6 +4217,20 @@ namespace ngraph
                 }
             }
 
+            template <>
+            void CPU_Emitter::EMITTER_DECL(ngraph::op::QuantizedLookup)
+            {
+                // Table entry 0 holds the result for the lowest input value
+                int bias = args[0].get_element_type() == element::i8 ? 128 : 0;
+                writer << "#pragma omp parallel for\n";
+                writer << "for (size_t i = 0; i < " << out[0].get_size() << "; i++)\n";
+                writer.block_begin();
+                writer << out[0].get_name() << "[i] = " << args[1].get_name()
+                       << "[static_cast<int>(" << args[0].get_name() << "[i]) + " << bias
+                       << "];\n";
+                writer.block_end();
+            }
+
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::op::QuantizedConcat)
             {
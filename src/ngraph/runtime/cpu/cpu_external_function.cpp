@@ -116,8 +116,13 @@
 #include "ngraph/op/tan.hpp"
 #include "ngraph/op/tanh.hpp"
 #include "ngraph/op/topk.hpp"
+#include "ngraph/op/util/binary_elementwise_arithmetic.hpp"
+#include "ngraph/op/util/binary_elementwise_comparison.hpp"
+#include "ngraph/op/util/binary_elementwise_logical.hpp"
+#include "ngraph/op/util/unary_elementwise_arithmetic.hpp"
 #include "ngraph/pass/algebraic_simplification.hpp"
 #include "ngraph/pass/common_function_collection.hpp"
+#include "ngraph/pass/constant_evaluation.hpp"
 #include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/core_fusion.hpp"
 #include "ngraph/pass/cse.hpp"
@@ -127,6 +132,7 @@
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
+#include "ngraph/pass/memory_schedule.hpp"
 #include "ngraph/pass/nop_elimination.hpp"
 #include "ngraph/pass/propagate_cacheability.hpp"
 #include "ngraph/pass/reshape_elimination.hpp"
@@ -145,6 +151,7 @@
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
 #include "ngraph/runtime/cpu/cpu_visualize_tree.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/attention.hpp"
 #include "ngraph/runtime/cpu/op/batch_dot.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
 #include "ngraph/runtime/cpu/op/bounded_relu.hpp"
@@ -158,7 +165,9 @@
 #include "ngraph/runtime/cpu/op/loop_kernel.hpp"
 #include "ngraph/runtime/cpu/op/lstm.hpp"
 #include "ngraph/runtime/cpu/op/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/op/matmul_epilogue.hpp"
 #include "ngraph/runtime/cpu/op/max_pool_with_indices.hpp"
+#include "ngraph/runtime/cpu/op/quantized_lookup.hpp"
 #include "ngraph/runtime/cpu/op/rnn.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
@@ -168,6 +177,7 @@
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_horizontal_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_layout.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_lstm_sequence_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_mat_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_memory_assignment.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_memory_optimization.hpp"
@@ -290,6 +300,7 @@ static const runtime::cpu::OpMap dispatcher{
     {TI(ngraph::op::AllReduce), &runtime::cpu::CPU_Emitter::emit<op::AllReduce>},
 #endif
     {TI(ngraph::op::MatmulBias), &runtime::cpu::CPU_Emitter::emit<op::MatmulBias>},
+    {TI(ngraph::op::MatmulEpilogue), &runtime::cpu::CPU_Emitter::emit<op::MatmulEpilogue>},
     {TI(ngraph::op::Dot), &runtime::cpu::CPU_Emitter::emit<op::Dot>},
     {TI(ngraph::op::Multiply), &runtime::cpu::CPU_Emitter::emit<op::Multiply>},
     {TI(ngraph::op::Parameter), &runtime::cpu::CPU_Emitter::nop},
@@ -297,6 +308,7 @@ static const runtime::cpu::OpMap dispatcher{
     {TI(ngraph::op::Any), &runtime::cpu::CPU_Emitter::emit<op::Any>},
     {TI(ngraph::op::All), &runtime::cpu::CPU_Emitter::emit<op::All>},
     {TI(ngraph::op::BatchDot), &runtime::cpu::CPU_Emitter::emit<op::BatchDot>},
+    {TI(ngraph::op::Attention), &runtime::cpu::CPU_Emitter::emit<op::Attention>},
     {TI(ngraph::op::Concat), &runtime::cpu::CPU_Emitter::emit<op::Concat>},
     {TI(ngraph::op::Divide), &runtime::cpu::CPU_Emitter::emit<op::Divide>},
     {TI(ngraph::op::Equal), &runtime::cpu::CPU_Emitter::emit<op::Equal>},
@@ -413,6 +425,7 @@ static const runtime::cpu::OpMap dispatcher{
     {TI(ngraph::op::GroupConvolutionBias),
      &runtime::cpu::CPU_Emitter::emit<op::GroupConvolutionBias>},
     {TI(ngraph::op::QuantizedConcat), &runtime::cpu::CPU_Emitter::emit<op::QuantizedConcat>},
+    {TI(ngraph::op::QuantizedLookup), &runtime::cpu::CPU_Emitter::emit<op::QuantizedLookup>},
 };
 
 static void
@@ -624,8 +637,9 @@ using namespace ngraph::runtime;
                 m_active_constants.push_back(node);
                 shared_ptr<descriptor::Tensor> tv = node->get_outputs()[0].get_tensor_ptr();
                 string type = tv->get_element_type().c_type_string();
-                writer << "static " << type << "* " << tv->get_name() << " = ((" << type << "*)("
-                       << c->get_data_ptr() << "));\n";
+                // Constants are bound at load time by set_constant_pointers so that the
+                // generated source does not depend on this process's addresses
+                writer << "static " << type << "* " << tv->get_name() << ";\n";
 
                 auto output_tensor = &node->get_output_tensor();
                 auto tensor_set = get_tensor_set(output_tensor);
@@ -640,6 +654,20 @@ using namespace ngraph::runtime;
         }
     }
 
+    writer << "extern \"C\" void set_constant_pointers(void** constants)\n";
+    writer << "{\n";
+    writer.indent++;
+    for (size_t i = 0; i < m_active_constants.size(); i++)
+    {
+        shared_ptr<descriptor::Tensor> tv =
+            m_active_constants[i]->get_outputs()[0].get_tensor_ptr();
+        string type = tv->get_element_type().c_type_string();
+        writer << tv->get_name() << " = static_cast<" << type << "*>(constants[" << i
+               << "]);\n";
+    }
+    writer.indent--;
+    writer << "}\n\n";
+
     generate_class_declarations(writer);
 
     const char* func_params =
@@ -876,7 +904,7 @@ using namespace ngraph::runtime;
             // Op Control
             if (!node->is_parameter() && !node->is_constant())
             {
-                writer << "if (ctx->first_iteration ";
+                writer << "if (ctx->first_iteration || ctx->memory_buffers_changed ";
                 for (const descriptor::Input& input : node->get_inputs())
                 {
                     const descriptor::Output& output = input.get_output();
@@ -1039,6 +1067,20 @@ using namespace ngraph::runtime;
     m_execution_engine->add_module(codegen_module);
     m_execution_engine->finalize();
 
+    auto set_constant_pointers =
+        m_execution_engine->find_function<void(void**)>("set_constant_pointers");
+    if (set_constant_pointers == nullptr)
+    {
+        throw runtime_error("could not find compiled set constant pointers function");
+    }
+    vector<void*> constant_pointers;
+    for (auto& node : m_active_constants)
+    {
+        constant_pointers.push_back(
+            const_cast<void*>(static_pointer_cast<ngraph::op::Constant>(node)->get_data_ptr()));
+    }
+    set_constant_pointers(constant_pointers.data());
+
     m_compiled_init_ctx_func = m_execution_engine->find_function<InitContextFuncTy>("init_cg_ctx");
 
     if (m_compiled_init_ctx_func == nullptr)
@@ -1114,6 +1156,7 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     REGISTER_KNOBBED_PASS(LikeReplacement, true, ngraph::pass);
     REGISTER_KNOBBED_PASS(NopElimination, true, ngraph::pass);
     REGISTER_KNOBBED_PASS(ZeroDimTensorElimination, true, ngraph::pass);
+    REGISTER_KNOBBED_PASS(LSTMSequenceFusion, true, runtime::cpu::pass);
     REGISTER_KNOBBED_PASS(LSTMFusion, true, runtime::cpu::pass);
     REGISTER_KNOBBED_PASS(RNNFusion, true, runtime::cpu::pass);
     REGISTER_KNOBBED_PASS(AlgebraicSimplification, true, ngraph::pass);
@@ -1126,11 +1169,18 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     REGISTER_KNOBBED_PASS(CoreFusion, true, ngraph::pass);
     REGISTER_KNOBBED_PASS(CPUFusion, true, runtime::cpu::pass);
     REGISTER_KNOBBED_PASS(CPUQuantFusion, true, runtime::cpu::pass);
+    // Before CPUMatmulEpilogueFusion, which turns MatmulBias nodes with elementwise users into
+    // MatmulEpilogue nodes that can not be fused horizontally
     REGISTER_KNOBBED_PASS(CPUHorizontalFusion, true, runtime::cpu::pass);
+    REGISTER_KNOBBED_PASS(CPUMatmulEpilogueFusion, true, runtime::cpu::pass);
     REGISTER_KNOBBED_PASS(CPUCollapseDims, true, runtime::cpu::pass);
 #if defined(NGRAPH_HALIDE)
     REGISTER_KNOBBED_PASS(HalideSubgraphExtraction, true, ngraph::runtime::cpu::pass);
 #endif
+    // After the fusions, so they match the graph as it was built, and evaluated on this backend,
+    // so the folded ops still run the CPU kernels
+    REGISTER_KNOBBED_PASS_WITH_ARGS(
+        ConstantEvaluation, true, ngraph::pass, 16 * 1024 * 1024, "CPU");
 
     NodeVector nv_cwi; // We dont need CPUWorkspaceInsertion to return list of indices
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPUWorkspaceInsertion, true, runtime::cpu::pass, nv_cwi, false);
@@ -1144,6 +1194,7 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     REGISTER_KNOBBED_PASS(GetOutputElementElimination, false, ngraph::pass);
     REGISTER_KNOBBED_PASS_WITH_ARGS(
         PropagateCacheability, true, ngraph::pass, runtime::cpu::get_annotations_factory());
+    REGISTER_KNOBBED_PASS(MemorySchedule, true, ngraph::pass);
     bool reuse_memory = pass_config.get_pass_attribute("CPUMemoryAssignment::ReuseMemory") ||
                         pass_config.get_pass_attribute("ReuseMemory");
     pass_manager.register_pass<runtime::cpu::pass::CPUMemoryAssignment>(
@@ -1165,6 +1216,38 @@ bool runtime::cpu::CPU_ExternalFunction::computes_result(Node* node)
     return false;
 }
 
+bool runtime::cpu::CPU_ExternalFunction::is_row_wise(Node* node)
+{
+    // Row i of the output depends only on row i of each input
+    if (!dynamic_cast<ngraph::op::util::UnaryElementwiseArithmetic*>(node) &&
+        !dynamic_cast<ngraph::op::util::BinaryElementwiseArithmetic*>(node) &&
+        !dynamic_cast<ngraph::op::util::BinaryElementwiseComparison*>(node) &&
+        !dynamic_cast<ngraph::op::util::BinaryElementwiseLogical*>(node))
+    {
+        return false;
+    }
+    if (node->get_output_size() != 1 || node->get_output_shape(0).size() == 0)
+    {
+        return false;
+    }
+
+    // Blocked layouts do not keep rows contiguous
+    auto is_row_major = [](const descriptor::Tensor& tv) {
+        auto layout =
+            std::dynamic_pointer_cast<runtime::cpu::LayoutDescriptor>(tv.get_tensor_layout());
+        return layout && !layout->is_mkldnn_layout();
+    };
+    for (const descriptor::Input& input : node->get_inputs())
+    {
+        if (input.get_shape() != node->get_output_shape(0) ||
+            !is_row_major(input.get_output().get_tensor()))
+        {
+            return false;
+        }
+    }
+    return is_row_major(node->get_output_tensor(0));
+}
+
 void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_config)
 {
     if (m_is_built)
@@ -1271,6 +1354,8 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
             auto tensor_set = get_tensor_set(output_tensor);
 
             auto stale = tensor_stale[output_tensor->get_name()];
+            function_input_stale_rows.emplace_back(tensor_stale_rows[output_tensor->get_name()],
+                                                   arg_index);
             // process all tensors in the set containing the output tensor of the parameter
             for (auto& ele_t : tensor_set)
             {
@@ -1346,37 +1431,77 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
             !cacheable || computes_result(node.get()) || possibly_overwritten(node.get());
 
         vector<reference_wrapper<bool>> in_stale, out_stale;
+        vector<reference_wrapper<pair<size_t, size_t>>> in_stale_rows, out_stale_rows;
         for (const auto& name : in_names)
         {
             if (tensor_alias.count(name))
             {
                 in_stale.emplace_back(tensor_stale[tensor_alias[name]]);
+                in_stale_rows.emplace_back(tensor_stale_rows[tensor_alias[name]]);
             }
             else
             {
                 in_stale.emplace_back(tensor_stale[name]);
+                in_stale_rows.emplace_back(tensor_stale_rows[name]);
             }
         }
-        for (const auto& name : out_names)
+        vector<size_t> out_rows;
+        for (size_t i = 0; i < out_names.size(); i++)
         {
+            // Consumers look outputs up through their alias, so update that tensor's state
+            const string& name =
+                tensor_alias.count(out_names[i]) ? tensor_alias[out_names[i]] : out_names[i];
             out_stale.emplace_back(tensor_stale[name]);
+            out_stale_rows.emplace_back(tensor_stale_rows[name]);
+            const Shape& shape = out[i].get_shape();
+            out_rows.push_back(shape.empty() ? 1 : shape[0]);
         }
 
         function<bool(CPURuntimeContext*)> enable;
         if (disable_caching)
         {
-            enable = [in_stale, out_stale](CPURuntimeContext* ctx) -> bool {
-                for (auto& stale : out_stale)
+            enable = [in_stale, out_stale, out_stale_rows, out_rows](
+                CPURuntimeContext* ctx) -> bool {
+                for (size_t i = 0; i < out_stale.size(); i++)
                 {
-                    stale.get() = true;
+                    out_stale[i].get() = true;
+                    out_stale_rows[i].get() = make_pair(size_t(0), out_rows[i]);
                 }
                 return true;
             };
         }
+        else if (is_row_wise(node.get()))
+        {
+            // Only the rows that changed in some input need to be recomputed
+            enable = [in_stale, in_stale_rows, out_stale, out_stale_rows, out_rows](
+                CPURuntimeContext* ctx) -> bool {
+                // Outputs that lived in lost buffers are recomputed whole, even from constants
+                bool en = ctx->memory_buffers_changed;
+                pair<size_t, size_t> rows(0, en ? out_rows[0] : 0);
+                for (size_t i = 0; i < in_stale.size(); i++)
+                {
+                    const auto& in_rows = in_stale_rows[i].get();
+                    if (in_stale[i] && in_rows.first < in_rows.second)
+                    {
+                        rows = en ? make_pair(min(rows.first, in_rows.first),
+                                              max(rows.second, in_rows.second))
+                                  : in_rows;
+                        en = true;
+                    }
+                }
+                for (size_t i = 0; i < out_stale.size(); i++)
+                {
+                    out_stale[i].get() = en;
+                    out_stale_rows[i].get() = rows;
+                }
+                return en;
+            };
+        }
         else
         {
-            enable = [in_stale, out_stale](CPURuntimeContext* ctx) -> bool {
-                bool en = false;
+            enable = [in_stale, out_stale, out_stale_rows, out_rows](
+                CPURuntimeContext* ctx) -> bool {
+                bool en = ctx->memory_buffers_changed;
                 for (const auto& stale : in_stale)
                 {
                     if (stale)
@@ -1385,9 +1510,10 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                         break;
                     }
                 }
-                for (auto& stale : out_stale)
+                for (size_t i = 0; i < out_stale.size(); i++)
                 {
-                    stale.get() = en;
+                    out_stale[i].get() = en;
+                    out_stale_rows[i].get() = make_pair(size_t(0), en ? out_rows[i] : 0);
                 }
                 return en;
             };
@@ -1466,7 +1592,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         cpu::Timestamp start_ts, end_ts;
         int profiler_count = 0;
 
-        if (ctx->first_iteration)
+        if (ctx->first_iteration || ctx->memory_buffers_changed)
         {
             for (auto& p : intermediates_offsets)
             {
@@ -1480,6 +1606,11 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
             get<3>(p).get() = ctx->p_en[get<1>(p)];
         }
 
+        for (const auto& p : function_input_stale_rows)
+        {
+            p.first.get() = ctx->p_stale_rows[p.second];
+        }
+
         for (const auto& p : function_output_index_offset)
         {
             get<0>(p).get() = static_cast<uint8_t*>(outputs[get<1>(p)]) + get<2>(p);
@@ -1503,13 +1634,14 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                     tbb::flow::continue_node<tbb::flow::continue_msg>* flowgraph_node =
                         new tbb::flow::continue_node<tbb::flow::continue_msg>(
                             *(ctx->G), [&, functor, index](const tbb::flow::continue_msg& msg) {
-                                if (p(ctx) || ctx->first_iteration)
+                                if (p(ctx) || ctx->first_iteration ||
+                                    ctx->memory_buffers_changed)
                                 {
                                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                                     {
                                         start_ts = cpu::Clock::now();
                                     }
-                                    CPUExecutionContext ectx{0};
+                                    CPUExecutionContext ectx{ctx->arena};
                                     executor::GetCPUExecutor().execute(*functor, ctx, &ectx, true);
                                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                                     {
@@ -1623,7 +1755,8 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
             for (; ctx->pc < functors.size(); ctx->pc++)
             {
                 auto index = profiler_count++;
-                if ((enables.at(ctx->pc))(ctx) || ctx->first_iteration)
+                if ((enables.at(ctx->pc))(ctx) || ctx->first_iteration ||
+                    ctx->memory_buffers_changed)
                 {
                     // Each Op will have exactly one functor, start the clock before the exceution of functor
                     // and collect the profiler_count once the execution complets
@@ -1631,7 +1764,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                     {
                         start_ts = cpu::Clock::now();
                     }
-                    CPUExecutionContext ectx{0};
+                    CPUExecutionContext ectx{ctx->arena};
                     executor::GetCPUExecutor().execute(functors.at(ctx->pc), ctx, &ectx);
                     if (ctx->breakpoints.count(ctx->pc + 1))
                     {
@@ -1700,6 +1833,19 @@ void*& runtime::cpu::CPU_ExternalFunction::get_tensor_data(const std::string& na
     }
 }
 
+std::pair<size_t, size_t>&
+    runtime::cpu::CPU_ExternalFunction::get_tensor_stale_rows(const std::string& name)
+{
+    if (tensor_alias.count(name))
+    {
+        return tensor_stale_rows[tensor_alias[name]];
+    }
+    else
+    {
+        return tensor_stale_rows[name];
+    }
+}
+
 shared_ptr<ngraph::runtime::cpu::CPU_CallFrame>
     runtime::cpu::CPU_ExternalFunction::make_call_frame(ngraph::pass::PassConfig& pass_config)
 {
@@ -127,6 +127,9 @@ namespace ngraph
 
                 std::vector<CPUKernelFunctor>& get_functors() { return functors; }
                 void*& get_tensor_data(const std::string& name);
+                /// \brief Rows of a tensor, along its leading axis, that changed since the
+                /// previous call. Functors of row-wise ops may limit their work to this range.
+                std::pair<size_t, size_t>& get_tensor_stale_rows(const std::string& name);
                 std::function<void(CPURuntimeContext*, std::vector<void*>&, std::vector<void*>&)>&
                     get_executor()
                 {
@@ -181,6 +184,7 @@ namespace ngraph
                                             ngraph::pass::PassConfig& pass_config);
 
                 bool computes_result(Node* node);
+                bool is_row_wise(Node* node);
                 void release_function() { m_function = nullptr; }
 #if !defined(NGRAPH_DEX_ONLY)
                 void emit_debug_function_entry(CodeWriter& writer,
@@ -259,6 +263,7 @@ namespace ngraph
                     executor;
                 std::unordered_map<std::string, void*> tensor_data;
                 std::unordered_map<std::string, bool> tensor_stale;
+                std::unordered_map<std::string, std::pair<size_t, size_t>> tensor_stale_rows;
                 // Each tensor is put into one buffer set.
                 // All the tensors in the same buffer set share the same memory buffer.
                 // bufferID_to_tensorSets maps bufferID to the pair of CPUTensorRole and buffer set.
@@ -282,6 +287,9 @@ namespace ngraph
                                      size_t,
                                      std::reference_wrapper<bool>>>
                     function_input_index_offset;
+                // changed row range of an input tensor and the input index it is read from
+                std::list<std::pair<std::reference_wrapper<std::pair<size_t, size_t>>, size_t>>
+                    function_input_stale_rows;
                 // tensor pointer, output index, and offset into the output
                 // used to calculate the correct address at runtime
                 std::list<std::tuple<std::reference_wrapper<void*>, size_t, size_t>>
@@ -198,6 +198,35 @@ namespace ngraph
                                            const Shape& output_shape,
                                            int arena);
 
+                void attention_float32(const float* q,
+                                       const float* k,
+                                       const float* v,
+                                       const float* mask,
+                                       float* out,
+                                       size_t batch,
+                                       size_t queries,
+                                       size_t keys,
+                                       size_t head_size,
+                                       size_t value_size,
+                                       bool transpose_k,
+                                       bool transpose_v,
+                                       float scale,
+                                       const Strides& mask_strides,
+                                       int arena);
+
+                void lstm_forward_float32(const float* src_layer,
+                                          const float* src_iter,
+                                          const float* weights_layer,
+                                          const float* weights_iter,
+                                          const float* bias,
+                                          float* dst_layer,
+                                          float* dst_iter,
+                                          size_t seq_length,
+                                          size_t batch,
+                                          size_t input_size,
+                                          size_t hidden_size,
+                                          int arena);
+
                 template <typename ElementType, unsigned int Rank>
                 void update_slice(void* input0,
                                   void* input1,
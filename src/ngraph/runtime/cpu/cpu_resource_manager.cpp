@@ -0,0 +1,349 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "ngraph/except.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_resource_manager.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static bool env_flag(const char* name)
+{
+    const char* value = getenv(name);
+    return value != nullptr && strcmp(value, "0") != 0;
+}
+
+runtime::cpu::CPUResourceManager::CPUResourceManager()
+{
+    if (const char* budget = getenv("NGRAPH_CPU_MEMORY_BUDGET"))
+    {
+        m_memory_budget = strtoull(budget, nullptr, 10);
+    }
+    m_share_intermediates = env_flag("NGRAPH_CPU_SHARE_INTERMEDIATES");
+    m_partition_thread_pools = env_flag("NGRAPH_CPU_PARTITION_THREAD_POOLS");
+}
+
+runtime::cpu::CPUResourceManager::~CPUResourceManager()
+{
+    for (auto& free_buffer : m_free_buffers)
+    {
+        delete free_buffer.m_buffer;
+    }
+}
+
+void runtime::cpu::CPUResourceManager::set_memory_budget(size_t bytes)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_memory_budget = bytes;
+    make_room(0, nullptr);
+}
+
+size_t runtime::cpu::CPUResourceManager::get_memory_budget() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_memory_budget;
+}
+
+size_t runtime::cpu::CPUResourceManager::get_resident_bytes() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_resident_bytes;
+}
+
+void runtime::cpu::CPUResourceManager::set_share_intermediates(bool share)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_share_intermediates = share;
+    if (!share)
+    {
+        for (auto& free_buffer : m_free_buffers)
+        {
+            m_resident_bytes -= free_buffer.m_buffer->size();
+            delete free_buffer.m_buffer;
+        }
+        m_free_buffers.clear();
+    }
+}
+
+bool runtime::cpu::CPUResourceManager::get_share_intermediates() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_share_intermediates;
+}
+
+void runtime::cpu::CPUResourceManager::set_partition_thread_pools(bool partition)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_partition_thread_pools = partition;
+}
+
+void runtime::cpu::CPUResourceManager::set_thread_pool(const CPU_CallFrame* call_frame, int pool)
+{
+    if (pool < 0 || pool >= executor::GetCPUExecutor().get_num_thread_pools())
+    {
+        throw ngraph_error("Thread pool " + to_string(pool) + " does not exist");
+    }
+    lock_guard<mutex> lock(m_mutex);
+    get_entry(call_frame).m_usage.m_thread_pool = pool;
+}
+
+int runtime::cpu::CPUResourceManager::get_thread_pool(const CPU_CallFrame* call_frame) const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return get_entry(call_frame).m_usage.m_thread_pool;
+}
+
+runtime::cpu::CPUModelUsage
+    runtime::cpu::CPUResourceManager::get_usage(const CPU_CallFrame* call_frame) const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return get_entry(call_frame).m_usage;
+}
+
+vector<runtime::cpu::CPUModelUsage> runtime::cpu::CPUResourceManager::get_usage() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    vector<CPUModelUsage> usage;
+    for (const auto& entry : m_entries)
+    {
+        usage.push_back(entry.second.m_usage);
+    }
+    return usage;
+}
+
+void runtime::cpu::CPUResourceManager::register_call_frame(const CPU_CallFrame* call_frame,
+                                                           const string& name,
+                                                           vector<AlignedBuffer*>* buffers)
+{
+    int num_thread_pools = executor::GetCPUExecutor().get_num_thread_pools();
+    lock_guard<mutex> lock(m_mutex);
+    Entry& entry = m_entries[call_frame];
+    entry.m_usage.m_name = name;
+    entry.m_buffers = buffers;
+    if (m_partition_thread_pools)
+    {
+        entry.m_usage.m_thread_pool = m_next_thread_pool++ % num_thread_pools;
+    }
+    entry.m_lru_position = m_lru.insert(m_lru.end(), call_frame);
+}
+
+void runtime::cpu::CPUResourceManager::unregister_call_frame(const CPU_CallFrame* call_frame)
+{
+    lock_guard<mutex> lock(m_mutex);
+    auto it = m_entries.find(call_frame);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+    free_buffers(it->second);
+    // Another call frame may later be created at the same address
+    for (auto& free_buffer : m_free_buffers)
+    {
+        if (free_buffer.m_owner == call_frame)
+        {
+            free_buffer.m_owner = nullptr;
+        }
+    }
+    if (!it->second.m_running)
+    {
+        m_lru.erase(it->second.m_lru_position);
+    }
+    m_entries.erase(it);
+}
+
+bool runtime::cpu::CPUResourceManager::acquire_buffers(const CPU_CallFrame* call_frame,
+                                                       const vector<size_t>& sizes,
+                                                       size_t alignment)
+{
+    lock_guard<mutex> lock(m_mutex);
+    Entry& entry = get_entry(call_frame);
+    if (!entry.m_running)
+    {
+        m_lru.erase(entry.m_lru_position);
+        entry.m_running = true;
+    }
+
+    auto& buffers = *entry.m_buffers;
+    bool changed = false;
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        if (buffers[i] != nullptr)
+        {
+            continue;
+        }
+        // A shared buffer nobody took since this call frame released it is still intact
+        auto parked = find_if(m_free_buffers.begin(),
+                              m_free_buffers.end(),
+                              [call_frame, i](const FreeBuffer& free_buffer) {
+                                  return free_buffer.m_owner == call_frame &&
+                                         free_buffer.m_index == i;
+                              });
+        if (parked != m_free_buffers.end())
+        {
+            buffers[i] = parked->m_buffer;
+            m_free_buffers.erase(parked);
+        }
+        else
+        {
+            buffers[i] = allocate(sizes[i], alignment, call_frame);
+            changed = true;
+        }
+        entry.m_usage.m_resident_bytes += buffers[i]->size();
+    }
+    return changed;
+}
+
+void runtime::cpu::CPUResourceManager::record_call(const CPU_CallFrame* call_frame,
+                                                   int64_t microseconds)
+{
+    lock_guard<mutex> lock(m_mutex);
+    auto& usage = get_entry(call_frame).m_usage;
+    usage.m_call_count++;
+    usage.m_total_microseconds += microseconds;
+    usage.m_thread_microseconds +=
+        microseconds * executor::GetCPUExecutor().get_device(usage.m_thread_pool).numThreads();
+}
+
+void runtime::cpu::CPUResourceManager::release_buffers(const CPU_CallFrame* call_frame)
+{
+    lock_guard<mutex> lock(m_mutex);
+    Entry& entry = get_entry(call_frame);
+    auto& usage = entry.m_usage;
+    if (entry.m_running)
+    {
+        entry.m_running = false;
+        entry.m_lru_position = m_lru.insert(m_lru.end(), call_frame);
+    }
+    if (m_share_intermediates)
+    {
+        auto& buffers = *entry.m_buffers;
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            if (buffers[i] != nullptr)
+            {
+                m_free_buffers.push_back(FreeBuffer{buffers[i], call_frame, i});
+                buffers[i] = nullptr;
+            }
+        }
+        usage.m_resident_bytes = 0;
+        make_room(0, nullptr);
+    }
+}
+
+runtime::AlignedBuffer* runtime::cpu::CPUResourceManager::allocate(size_t size,
+                                                                   size_t alignment,
+                                                                   const CPU_CallFrame* owner)
+{
+    if (m_share_intermediates)
+    {
+        // Best fit among the released buffers
+        auto best = m_free_buffers.end();
+        for (auto it = m_free_buffers.begin(); it != m_free_buffers.end(); ++it)
+        {
+            AlignedBuffer* buffer = it->m_buffer;
+            bool fits = buffer->size() >= size &&
+                        reinterpret_cast<size_t>(buffer->get_ptr()) % alignment == 0;
+            if (fits &&
+                (best == m_free_buffers.end() || buffer->size() < best->m_buffer->size()))
+            {
+                best = it;
+            }
+        }
+        if (best != m_free_buffers.end())
+        {
+            AlignedBuffer* buffer = best->m_buffer;
+            m_free_buffers.erase(best);
+            return buffer;
+        }
+    }
+    make_room(size, owner);
+    m_resident_bytes += size;
+    return new AlignedBuffer(size, alignment);
+}
+
+void runtime::cpu::CPUResourceManager::make_room(size_t size, const CPU_CallFrame* owner)
+{
+    if (m_memory_budget == 0)
+    {
+        return;
+    }
+    while (m_resident_bytes + size > m_memory_budget && !m_free_buffers.empty())
+    {
+        m_resident_bytes -= m_free_buffers.back().m_buffer->size();
+        delete m_free_buffers.back().m_buffer;
+        m_free_buffers.pop_back();
+    }
+    for (auto it = m_lru.begin(); it != m_lru.end() && m_resident_bytes + size > m_memory_budget;
+         ++it)
+    {
+        Entry& entry = get_entry(*it);
+        if (*it != owner && entry.m_usage.m_resident_bytes > 0)
+        {
+            NGRAPH_DEBUG << "Evicting intermediate buffers of " << entry.m_usage.m_name;
+            free_buffers(entry);
+            entry.m_usage.m_evictions++;
+        }
+    }
+}
+
+void runtime::cpu::CPUResourceManager::free_buffers(Entry& entry)
+{
+    for (auto& buffer : *entry.m_buffers)
+    {
+        if (buffer != nullptr)
+        {
+            m_resident_bytes -= buffer->size();
+            delete buffer;
+            buffer = nullptr;
+        }
+    }
+    entry.m_usage.m_resident_bytes = 0;
+}
+
+runtime::cpu::CPUResourceManager::Entry&
+    runtime::cpu::CPUResourceManager::get_entry(const CPU_CallFrame* call_frame)
+{
+    auto it = m_entries.find(call_frame);
+    if (it == m_entries.end())
+    {
+        throw ngraph_error("Call frame is not registered with the CPU resource manager");
+    }
+    return it->second;
+}
+
+const runtime::cpu::CPUResourceManager::Entry&
+    runtime::cpu::CPUResourceManager::get_entry(const CPU_CallFrame* call_frame) const
+{
+    auto it = m_entries.find(call_frame);
+    if (it == m_entries.end())
+    {
+        throw ngraph_error("Call frame is not registered with the CPU resource manager");
+    }
+    return it->second;
+}
+
+runtime::cpu::CPUResourceManager& runtime::cpu::GetCPUResourceManager()
+{
+    static CPUResourceManager* manager = new CPUResourceManager();
+    return *manager;
+}
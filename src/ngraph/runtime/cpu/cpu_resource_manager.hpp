@@ -0,0 +1,142 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class AlignedBuffer;
+
+        namespace cpu
+        {
+            class CPU_CallFrame;
+
+            /// \brief Resource usage of one call frame, as accounted by CPUResourceManager.
+            struct CPUModelUsage
+            {
+                std::string m_name;
+                size_t m_call_count = 0;
+                /// Wall time spent inside CPU_CallFrame::call
+                int64_t m_total_microseconds = 0;
+                /// Wall time multiplied by the threads of the pool the calls ran on
+                int64_t m_thread_microseconds = 0;
+                size_t m_resident_bytes = 0;
+                size_t m_evictions = 0;
+                int m_thread_pool = 0;
+            };
+
+            /// \brief Shares memory and threads between the call frames of one process.
+            ///
+            /// Call frames acquire their intermediate buffers from the manager at the start of
+            /// a call and release them at the end. While a memory budget is set, buffers of idle
+            /// call frames are evicted, least recently used first, to make room for a call that
+            /// needs memory. With intermediate sharing enabled, released buffers go back to a
+            /// common pool and are reused by whichever call frame runs next.
+            ///
+            /// Defaults come from NGRAPH_CPU_MEMORY_BUDGET (bytes),
+            /// NGRAPH_CPU_SHARE_INTERMEDIATES and NGRAPH_CPU_PARTITION_THREAD_POOLS.
+            class CPUResourceManager
+            {
+            public:
+                CPUResourceManager();
+                ~CPUResourceManager();
+
+                /// \brief Limits the bytes held in intermediate buffers; 0 disables the limit.
+                ///
+                /// The limit is exceeded only when every resident buffer belongs to a call frame
+                /// that is currently running.
+                void set_memory_budget(size_t bytes);
+                size_t get_memory_budget() const;
+                size_t get_resident_bytes() const;
+
+                void set_share_intermediates(bool share);
+                bool get_share_intermediates() const;
+
+                /// \brief Assigns call frames registered from now on to the executor's thread
+                ///        pools round robin instead of all to pool 0.
+                void set_partition_thread_pools(bool partition);
+                void set_thread_pool(const CPU_CallFrame* call_frame, int pool);
+                int get_thread_pool(const CPU_CallFrame* call_frame) const;
+
+                CPUModelUsage get_usage(const CPU_CallFrame* call_frame) const;
+                std::vector<CPUModelUsage> get_usage() const;
+
+                void register_call_frame(const CPU_CallFrame* call_frame,
+                                         const std::string& name,
+                                         std::vector<AlignedBuffer*>* buffers);
+                void unregister_call_frame(const CPU_CallFrame* call_frame);
+
+                /// \brief Makes every buffer of the call frame resident.
+                /// \return true if any buffer is not the one the call frame released last, i.e.
+                ///         its address changed or its contents are lost
+                bool acquire_buffers(const CPU_CallFrame* call_frame,
+                                     const std::vector<size_t>& sizes,
+                                     size_t alignment);
+                void release_buffers(const CPU_CallFrame* call_frame);
+                /// \brief Accounts a call that completed
+                void record_call(const CPU_CallFrame* call_frame, int64_t microseconds);
+
+            private:
+                struct Entry
+                {
+                    CPUModelUsage m_usage;
+                    std::vector<AlignedBuffer*>* m_buffers;
+                    std::list<const CPU_CallFrame*>::iterator m_lru_position;
+                    bool m_running = false;
+                };
+                /// A released buffer, still holding the contents of the call frame buffer it
+                /// was released from until another call frame takes it
+                struct FreeBuffer
+                {
+                    AlignedBuffer* m_buffer;
+                    const CPU_CallFrame* m_owner;
+                    size_t m_index;
+                };
+
+                AlignedBuffer* allocate(size_t size, size_t alignment, const CPU_CallFrame* owner);
+                void make_room(size_t size, const CPU_CallFrame* owner);
+                void free_buffers(Entry& entry);
+                Entry& get_entry(const CPU_CallFrame* call_frame);
+                const Entry& get_entry(const CPU_CallFrame* call_frame) const;
+
+                mutable std::mutex m_mutex;
+                std::unordered_map<const CPU_CallFrame*, Entry> m_entries;
+                /// Idle call frames, least recently used first
+                std::list<const CPU_CallFrame*> m_lru;
+                std::vector<FreeBuffer> m_free_buffers;
+                size_t m_memory_budget = 0;
+                size_t m_resident_bytes = 0;
+                bool m_share_intermediates = false;
+                bool m_partition_thread_pools = false;
+                int m_next_thread_pool = 0;
+            };
+
+            /// \brief The process-wide manager. It is never destroyed, so call frames held in
+            ///        static objects can still unregister during exit.
+            CPUResourceManager& GetCPUResourceManager();
+        }
+    }
+}
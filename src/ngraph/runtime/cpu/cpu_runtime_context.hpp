@@ -19,6 +19,7 @@
 #include <chrono>
 #include <cstdint>
 #include <set>
+#include <utility>
 
 #define TBB_PREVIEW_GLOBAL_CONTROL 1
 #define TBB_PREVIEW_FLOW_GRAPH_TRACE 1
@@ -60,15 +61,18 @@ namespace ngraph
             {
                 int64_t* op_durations;
                 bool* p_en;
+                std::pair<size_t, size_t>* p_stale_rows;
                 bool first_iteration;
                 mkldnn::primitive* const* mkldnn_primitives;
                 std::vector<AlignedBuffer*> memory_buffers;
+                bool memory_buffers_changed;
                 char* const* mkldnn_workspaces;
                 tbb::flow::graph* G;
                 tbb::global_control* c;
                 State* const* states;
                 std::set<size_t> breakpoints;
                 size_t pc;
+                int arena;
 #ifdef NGRAPH_DISTRIBUTED_MLSL_ENABLE
                 MLSL::Environment* mlsl_env;
                 MLSL::Distribution* mlsl_dist;
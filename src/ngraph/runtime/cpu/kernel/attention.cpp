@@ -0,0 +1,206 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
+#include "ngraph/strides.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // Query rows per task, and keys per tile. Each tile of k and v is reused by all
+                // the query rows of a task while it is in cache.
+                static const size_t s_attention_query_block = 16;
+                static const size_t s_attention_key_block = 64;
+
+                void attention_float32(const float* q,
+                                       const float* k,
+                                       const float* v,
+                                       const float* mask,
+                                       float* out,
+                                       size_t batch,
+                                       size_t queries,
+                                       size_t keys,
+                                       size_t head_size,
+                                       size_t value_size,
+                                       bool transpose_k,
+                                       bool transpose_v,
+                                       float scale,
+                                       const Strides& mask_strides,
+                                       int arena)
+                {
+                    size_t query_blocks =
+                        (queries + s_attention_query_block - 1) / s_attention_query_block;
+
+                    // Every query row keeps the running maximum and sum of its softmax and
+                    // accumulates the weighted values in its output row. When a later tile
+                    // raises the maximum, what was accumulated so far is rescaled.
+                    auto compute = [&](Eigen::Index first, Eigen::Index last) {
+                        std::vector<float> scores(s_attention_key_block);
+                        std::vector<float> row_max(s_attention_query_block);
+                        std::vector<float> row_sum(s_attention_query_block);
+                        for (Eigen::Index task = first; task < last; task++)
+                        {
+                            size_t b = task / query_blocks;
+                            size_t i0 = (task % query_blocks) * s_attention_query_block;
+                            size_t rows = std::min(s_attention_query_block, queries - i0);
+                            const float* q_block = q + (b * queries + i0) * head_size;
+                            const float* k_batch = k + b * keys * head_size;
+                            const float* v_batch = v + b * keys * value_size;
+                            float* out_block = out + (b * queries + i0) * value_size;
+
+                            std::fill(out_block, out_block + rows * value_size, 0.0f);
+                            std::fill(row_max.begin(),
+                                      row_max.end(),
+                                      -std::numeric_limits<float>::infinity());
+                            std::fill(row_sum.begin(), row_sum.end(), 0.0f);
+
+                            for (size_t j0 = 0; j0 < keys; j0 += s_attention_key_block)
+                            {
+                                size_t cols = std::min(s_attention_key_block, keys - j0);
+                                for (size_t i = 0; i < rows; i++)
+                                {
+                                    const float* q_row = q_block + i * head_size;
+                                    float* s = scores.data();
+                                    if (transpose_k)
+                                    {
+                                        std::fill(s, s + cols, 0.0f);
+                                        for (size_t d = 0; d < head_size; d++)
+                                        {
+                                            const float* k_row = k_batch + d * keys + j0;
+                                            float q_d = q_row[d];
+                                            for (size_t j = 0; j < cols; j++)
+                                            {
+                                                s[j] += q_d * k_row[j];
+                                            }
+                                        }
+                                        for (size_t j = 0; j < cols; j++)
+                                        {
+                                            s[j] *= scale;
+                                        }
+                                    }
+                                    else
+                                    {
+                                        for (size_t j = 0; j < cols; j++)
+                                        {
+                                            const float* k_row = k_batch + (j0 + j) * head_size;
+                                            float dot = 0.0f;
+                                            for (size_t d = 0; d < head_size; d++)
+                                            {
+                                                dot += q_row[d] * k_row[d];
+                                            }
+                                            s[j] = dot * scale;
+                                        }
+                                    }
+                                    if (mask != nullptr)
+                                    {
+                                        const float* mask_row = mask + b * mask_strides[0] +
+                                                                (i0 + i) * mask_strides[1] +
+                                                                j0 * mask_strides[2];
+                                        for (size_t j = 0; j < cols; j++)
+                                        {
+                                            s[j] += mask_row[j * mask_strides[2]];
+                                        }
+                                    }
+
+                                    float new_max =
+                                        std::max(row_max[i], *std::max_element(s, s + cols));
+                                    if (std::isinf(new_max) && new_max < 0)
+                                    {
+                                        // Every key seen so far is masked out
+                                        continue;
+                                    }
+                                    float correction = std::exp(row_max[i] - new_max);
+                                    row_max[i] = new_max;
+                                    float sum = 0.0f;
+                                    for (size_t j = 0; j < cols; j++)
+                                    {
+                                        s[j] = std::exp(s[j] - new_max);
+                                        sum += s[j];
+                                    }
+                                    row_sum[i] = row_sum[i] * correction + sum;
+
+                                    float* out_row = out_block + i * value_size;
+                                    for (size_t e = 0; e < value_size; e++)
+                                    {
+                                        out_row[e] *= correction;
+                                    }
+                                    if (transpose_v)
+                                    {
+                                        for (size_t e = 0; e < value_size; e++)
+                                        {
+                                            const float* v_row = v_batch + e * keys + j0;
+                                            float acc = 0.0f;
+                                            for (size_t j = 0; j < cols; j++)
+                                            {
+                                                acc += s[j] * v_row[j];
+                                            }
+                                            out_row[e] += acc;
+                                        }
+                                    }
+                                    else
+                                    {
+                                        for (size_t j = 0; j < cols; j++)
+                                        {
+                                            const float* v_row = v_batch + (j0 + j) * value_size;
+                                            float p = s[j];
+                                            for (size_t e = 0; e < value_size; e++)
+                                            {
+                                                out_row[e] += p * v_row[e];
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+
+                            for (size_t i = 0; i < rows; i++)
+                            {
+                                float* out_row = out_block + i * value_size;
+                                float inverse = 1.0f / row_sum[i];
+                                for (size_t e = 0; e < value_size; e++)
+                                {
+                                    out_row[e] *= inverse;
+                                }
+                            }
+                        }
+                    };
+
+                    size_t task_rows = std::min(queries, s_attention_query_block);
+                    Eigen::TensorOpCost cost(
+                        (task_rows * head_size + keys * (head_size + value_size)) * sizeof(float),
+                        task_rows * value_size * sizeof(float),
+                        task_rows * keys * (head_size + value_size + 2));
+                    ngraph::runtime::cpu::executor::GetCPUExecutor()
+                        .get_device(arena)
+                        .parallelFor(batch * query_blocks, cost, compute);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/reference/generate_mask.hpp"
+#include "ngraph/state/rng_state.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                template <typename T>
+                void generate_mask(
+                    void* output, size_t count, RNGState* rng_state, bool training, int arena)
+                {
+                    auto out = static_cast<T*>(output);
+                    auto seed = rng_state->get_seed();
+                    auto stream = rng_state->next_stream();
+                    auto threshold = rng_state->get_threshold();
+
+                    Eigen::TensorOpCost cost(0, sizeof(T), 4);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        static_cast<Eigen::Index>(count),
+                        cost,
+                        [&](Eigen::Index first, Eigen::Index last) {
+                            reference::generate_mask<T>(
+                                out, first, last, seed, stream, threshold, training);
+                        });
+                }
+            }
+        }
+    }
+}
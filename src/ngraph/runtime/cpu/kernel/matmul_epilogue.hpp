@@ -0,0 +1,219 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
+#include "ngraph/runtime/cpu/op/matmul_epilogue.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                struct EpilogueStep
+                {
+                    op::MatmulEpilogue::Kind kind;
+                    float alpha;
+                    // Index into the operand pointers and the operand's strides over the output
+                    size_t operand;
+                    size_t row_stride;
+                    size_t col_stride;
+                };
+
+                // Output elements per SGEMM panel, small enough for the panel to still be in
+                // cache when its epilogue runs
+                static const size_t s_panel_elements = 256 * 1024;
+                // Fewer rows per SGEMM call leave the BLAS library well below its peak
+                static const size_t s_min_panel_rows = 64;
+                // Output elements per epilogue task within a panel
+                static const size_t s_epilogue_block_elements = 16 * 1024;
+
+                // Rows of the m x n output computed by one SGEMM call before its epilogue runs
+                inline size_t matmul_epilogue_panel_rows(size_t m, size_t n)
+                {
+                    size_t rows = std::max(s_min_panel_rows,
+                                           s_panel_elements / std::max<size_t>(1, n));
+                    return std::max<size_t>(1, std::min(m, rows));
+                }
+
+                template <typename F>
+                void apply_epilogue_binary(float* row,
+                                           const float* operand,
+                                           size_t col_stride,
+                                           size_t n,
+                                           F f)
+                {
+                    if (col_stride == 0)
+                    {
+                        float value = *operand;
+                        for (size_t j = 0; j < n; j++)
+                        {
+                            row[j] = f(row[j], value);
+                        }
+                    }
+                    else
+                    {
+                        for (size_t j = 0; j < n; j++)
+                        {
+                            row[j] = f(row[j], operand[j]);
+                        }
+                    }
+                }
+
+                inline void apply_epilogue(float* row,
+                                           size_t r,
+                                           size_t n,
+                                           const std::vector<EpilogueStep>& steps,
+                                           void* const* operands)
+                {
+                    using Kind = op::MatmulEpilogue::Kind;
+                    for (const EpilogueStep& step : steps)
+                    {
+                        const float* operand = nullptr;
+                        if (op::MatmulEpilogue::takes_operand(step.kind))
+                        {
+                            operand = static_cast<const float*>(operands[step.operand]) +
+                                      r * step.row_stride;
+                        }
+                        float alpha = step.alpha;
+                        switch (step.kind)
+                        {
+                        case Kind::Add:
+                            apply_epilogue_binary(row, operand, step.col_stride, n, [](
+                                float x, float y) { return x + y; });
+                            break;
+                        case Kind::Multiply:
+                            apply_epilogue_binary(row, operand, step.col_stride, n, [](
+                                float x, float y) { return x * y; });
+                            break;
+                        case Kind::Minimum:
+                            apply_epilogue_binary(row, operand, step.col_stride, n, [](
+                                float x, float y) { return x < y ? x : y; });
+                            break;
+                        case Kind::Maximum:
+                            apply_epilogue_binary(row, operand, step.col_stride, n, [](
+                                float x, float y) { return x > y ? x : y; });
+                            break;
+                        case Kind::Relu:
+                            for (size_t j = 0; j < n; j++)
+                            {
+                                row[j] = row[j] > 0.0f ? row[j] : 0.0f;
+                            }
+                            break;
+                        case Kind::BoundedRelu:
+                            for (size_t j = 0; j < n; j++)
+                            {
+                                row[j] = std::min(std::max(row[j], 0.0f), alpha);
+                            }
+                            break;
+                        case Kind::Sigmoid:
+                            for (size_t j = 0; j < n; j++)
+                            {
+                                row[j] = 1.0f / (1.0f + std::exp(-row[j]));
+                            }
+                            break;
+                        case Kind::Tanh:
+                            for (size_t j = 0; j < n; j++)
+                            {
+                                row[j] = std::tanh(row[j]);
+                            }
+                            break;
+                        }
+                    }
+                }
+
+                // out = epilogue(op(a) * op(b)) for an m x k op(a) and a k x n op(b). The rows of
+                // the output are computed in panels, one SGEMM call per panel, and each panel's
+                // epilogue runs in parallel over blocks of its rows while the panel is in cache.
+                inline void matmul_epilogue(void* a,
+                                            void* b,
+                                            void* out,
+                                            size_t m,
+                                            size_t n,
+                                            size_t k,
+                                            size_t lda,
+                                            size_t ldb,
+                                            bool transpose_a,
+                                            bool transpose_b,
+                                            const std::vector<EpilogueStep>& steps,
+                                            void* const* operands,
+                                            int arena)
+                {
+                    const float* a_data = static_cast<const float*>(a);
+                    float* out_data = static_cast<float*>(out);
+                    // Without an epilogue there is nothing to keep in cache
+                    size_t panel_rows = steps.empty() ? std::max<size_t>(1, m)
+                                                      : matmul_epilogue_panel_rows(m, n);
+                    size_t block_rows =
+                        std::max<size_t>(1, s_epilogue_block_elements / std::max<size_t>(1, n));
+                    for (size_t panel = 0; panel < m; panel += panel_rows)
+                    {
+                        size_t rows = std::min(panel_rows, m - panel);
+                        float* panel_out = out_data + panel * n;
+                        // Row r of op(a) starts at row r of a, or at column r if a is transposed
+                        cblas::cblas_sgemm(
+                            cblas::Layout::RowMajor,
+                            transpose_a ? cblas::Transpose::Transpose : cblas::Transpose::None,
+                            transpose_b ? cblas::Transpose::Transpose : cblas::Transpose::None,
+                            rows,
+                            n,
+                            k,
+                            1.0f,
+                            a_data + (transpose_a ? panel : panel * lda),
+                            std::max<size_t>(1, lda),
+                            static_cast<const float*>(b),
+                            std::max<size_t>(1, ldb),
+                            0.0f,
+                            panel_out,
+                            std::max<size_t>(1, n));
+                        if (steps.empty())
+                        {
+                            continue;
+                        }
+
+                        size_t blocks = (rows + block_rows - 1) / block_rows;
+                        auto epilogue = [&](Eigen::Index first, Eigen::Index last) {
+                            size_t end = std::min(rows, static_cast<size_t>(last) * block_rows);
+                            for (size_t r = first * block_rows; r < end; r++)
+                            {
+                                apply_epilogue(
+                                    panel_out + r * n, panel + r, n, steps, operands);
+                            }
+                        };
+                        size_t block_bytes = block_rows * n * sizeof(float);
+                        Eigen::TensorOpCost cost(
+                            block_bytes, block_bytes, block_rows * n * steps.size());
+                        ngraph::runtime::cpu::executor::GetCPUExecutor()
+                            .get_device(arena)
+                            .parallelFor(blocks, cost, epilogue);
+                    }
+                }
+            }
+        }
+    }
+}
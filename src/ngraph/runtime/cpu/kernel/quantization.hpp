@@ -0,0 +1,381 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/axis_set.hpp"
+#include "ngraph/op/quantize.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/reference/dequantize.hpp"
+#include "ngraph/runtime/reference/quantize.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // Rounding functors for each op::Quantize::RoundMode. The expressions are the
+                // ones reference::quantize uses, so both produce the same integers; they are
+                // branch free so the loops below vectorize.
+                struct round_nearest_toward_infinity
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        REAL r = std::floor(std::fabs(q) + 0.5);
+                        return q < 0.0 ? -r : r;
+                    }
+                };
+
+                struct round_nearest_toward_zero
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        REAL r = std::ceil(std::fabs(q) - 0.5);
+                        return q < 0.0 ? -r : r;
+                    }
+                };
+
+                struct round_nearest_upward
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        return std::floor(q + 0.5);
+                    }
+                };
+
+                struct round_nearest_downward
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        return std::ceil(q - 0.5);
+                    }
+                };
+
+                struct round_nearest_toward_even
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        auto up = std::floor(q + 0.5);
+                        auto down = std::ceil(q - 0.5);
+                        // Same as fmod(up, 2.0) == 0 for the integral value up
+                        return (up - 2.0 * std::floor(up * 0.5) == 0.0) ? up : down;
+                    }
+                };
+
+                struct round_toward_infinity
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        REAL r = std::ceil(std::fabs(q));
+                        return q < 0.0 ? -r : r;
+                    }
+                };
+
+                struct round_toward_zero
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        REAL r = std::floor(std::fabs(q));
+                        return q < 0.0 ? -r : r;
+                    }
+                };
+
+                struct round_up
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        return std::ceil(q);
+                    }
+                };
+
+                struct round_down
+                {
+                    template <typename REAL>
+                    static REAL apply(REAL q)
+                    {
+                        return std::floor(q);
+                    }
+                };
+
+                // Views the input as [outer, channels, inner] where channels covers the
+                // quantization axes, which must be contiguous. Returns false otherwise.
+                inline bool quantization_layout(const Shape& input_shape,
+                                                const AxisSet& axes,
+                                                size_t& channels,
+                                                size_t& inner)
+                {
+                    channels = 1;
+                    inner = 1;
+                    if (axes.empty())
+                    {
+                        inner = shape_size(input_shape);
+                        return true;
+                    }
+                    size_t first = *axes.begin();
+                    size_t last = *axes.rbegin();
+                    if (last - first + 1 != axes.size())
+                    {
+                        return false;
+                    }
+                    for (size_t i = first; i <= last; i++)
+                    {
+                        channels *= input_shape[i];
+                    }
+                    for (size_t i = last + 1; i < input_shape.size(); i++)
+                    {
+                        inner *= input_shape[i];
+                    }
+                    return true;
+                }
+
+                // Splits [first, last) into runs that share one scale and offset and hands
+                // each run to segment(begin, end, channel)
+                template <typename SEGMENT>
+                void for_each_quantization_run(
+                    size_t first, size_t last, size_t channels, size_t inner, SEGMENT segment)
+                {
+                    while (first < last)
+                    {
+                        size_t row = first / inner;
+                        size_t end = std::min(last, (row + 1) * inner);
+                        segment(first, end, row % channels);
+                        first = end;
+                    }
+                }
+
+                template <typename REAL, typename QUANT, typename ROUND>
+                void quantize_runs(const REAL* input,
+                                   const REAL* scale,
+                                   const QUANT* offset,
+                                   QUANT* output,
+                                   size_t count,
+                                   size_t channels,
+                                   size_t inner,
+                                   int arena)
+                {
+                    const REAL lowest = static_cast<REAL>(std::numeric_limits<QUANT>::min());
+                    const REAL highest = static_cast<REAL>(std::numeric_limits<QUANT>::max());
+
+                    auto segment = [&](size_t begin, size_t end, size_t channel) {
+                        const REAL s = scale[channel];
+                        const REAL o = static_cast<REAL>(offset[channel]);
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            REAL q = ROUND::apply(static_cast<REAL>(input[i] / s));
+                            q += o;
+                            q = std::max<REAL>(q, lowest);
+                            q = std::min<REAL>(q, highest);
+                            output[i] = static_cast<QUANT>(q);
+                        }
+                    };
+
+                    Eigen::TensorOpCost cost(sizeof(REAL), sizeof(QUANT), 8);
+                    auto& device =
+                        ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena);
+                    auto parallel_runs = [&](size_t begin, size_t end) {
+                        auto runs = [&](Eigen::Index first, Eigen::Index last) {
+                            for_each_quantization_run(
+                                begin + first, begin + last, channels, inner, segment);
+                        };
+                        device.parallelFor(static_cast<Eigen::Index>(end - begin), cost, runs);
+                    };
+
+                    if (static_cast<const void*>(input) != static_cast<const void*>(output) ||
+                        sizeof(QUANT) >= sizeof(REAL))
+                    {
+                        parallel_runs(0, count);
+                        return;
+                    }
+
+                    // In place narrowing: output element i overwrites part of input element
+                    // i / ratio. A range may only run in parallel once every input element it
+                    // overwrites has been read, so convert a short prefix front to back and
+                    // then let each parallel range grow by the ratio.
+                    const size_t ratio = sizeof(REAL) / sizeof(QUANT);
+                    size_t done = std::min<size_t>(count, 4096);
+                    for_each_quantization_run(0, done, channels, inner, segment);
+                    while (done < count)
+                    {
+                        size_t next = std::min(count, done * ratio);
+                        parallel_runs(done, next);
+                        done = next;
+                    }
+                }
+
+                template <typename REAL, typename QUANT>
+                void quantize(void* input,
+                              void* scale,
+                              void* offset,
+                              void* output,
+                              const Shape& input_shape,
+                              const Shape& scale_offset_shape,
+                              const AxisSet& axes,
+                              op::Quantize::RoundMode round_mode,
+                              int arena)
+                {
+                    size_t channels, inner;
+                    if (!quantization_layout(input_shape, axes, channels, inner))
+                    {
+                        reference::quantize<REAL, QUANT>(static_cast<const REAL*>(input),
+                                                         static_cast<const REAL*>(scale),
+                                                         static_cast<const QUANT*>(offset),
+                                                         static_cast<QUANT*>(output),
+                                                         input_shape,
+                                                         scale_offset_shape,
+                                                         axes,
+                                                         round_mode);
+                        return;
+                    }
+
+                    auto in = static_cast<const REAL*>(input);
+                    auto s = static_cast<const REAL*>(scale);
+                    auto o = static_cast<const QUANT*>(offset);
+                    auto out = static_cast<QUANT*>(output);
+                    size_t count = shape_size(input_shape);
+
+                    switch (round_mode)
+                    {
+                    case op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_INFINITY:
+                        quantize_runs<REAL, QUANT, round_nearest_toward_infinity>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    case op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_ZERO:
+                        quantize_runs<REAL, QUANT, round_nearest_toward_zero>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    case op::Quantize::RoundMode::ROUND_NEAREST_UPWARD:
+                        quantize_runs<REAL, QUANT, round_nearest_upward>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    case op::Quantize::RoundMode::ROUND_NEAREST_DOWNWARD:
+                        quantize_runs<REAL, QUANT, round_nearest_downward>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    case op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_EVEN:
+                        quantize_runs<REAL, QUANT, round_nearest_toward_even>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    case op::Quantize::RoundMode::ROUND_TOWARD_INFINITY:
+                        quantize_runs<REAL, QUANT, round_toward_infinity>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    case op::Quantize::RoundMode::ROUND_TOWARD_ZERO:
+                        quantize_runs<REAL, QUANT, round_toward_zero>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    case op::Quantize::RoundMode::ROUND_UP:
+                        quantize_runs<REAL, QUANT, round_up>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    case op::Quantize::RoundMode::ROUND_DOWN:
+                        quantize_runs<REAL, QUANT, round_down>(
+                            in, s, o, out, count, channels, inner, arena);
+                        break;
+                    }
+                }
+
+                template <typename QUANT, typename REAL>
+                void dequantize(void* input,
+                                void* scale,
+                                void* offset,
+                                void* output,
+                                const Shape& input_shape,
+                                const Shape& scale_offset_shape,
+                                const AxisSet& axes,
+                                int arena)
+                {
+                    size_t channels, inner;
+                    if (!quantization_layout(input_shape, axes, channels, inner))
+                    {
+                        reference::dequantize<QUANT, REAL>(static_cast<const QUANT*>(input),
+                                                           static_cast<const REAL*>(scale),
+                                                           static_cast<const QUANT*>(offset),
+                                                           static_cast<REAL*>(output),
+                                                           input_shape,
+                                                           scale_offset_shape,
+                                                           axes);
+                        return;
+                    }
+
+                    auto in = static_cast<const QUANT*>(input);
+                    auto s = static_cast<const REAL*>(scale);
+                    auto o = static_cast<const QUANT*>(offset);
+                    auto out = static_cast<REAL*>(output);
+
+                    auto segment = [&](size_t begin, size_t end, size_t channel) {
+                        const REAL sc = s[channel];
+                        const QUANT zero = o[channel];
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            out[i] = static_cast<REAL>(in[i] - zero) * sc;
+                        }
+                    };
+
+                    Eigen::TensorOpCost cost(sizeof(QUANT), sizeof(REAL), 2);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        static_cast<Eigen::Index>(shape_size(input_shape)),
+                        cost,
+                        [&](Eigen::Index first, Eigen::Index last) {
+                            for_each_quantization_run(first, last, channels, inner, segment);
+                        });
+                }
+
+                // Maps every 8-bit input through a 256 entry table indexed by the input's
+                // unsigned bit pattern offset so that the lowest value lands on entry 0
+                template <typename QUANT, typename OUT>
+                void quantized_lookup(
+                    void* input, void* table, void* output, size_t count, int arena)
+                {
+                    static_assert(sizeof(QUANT) == 1, "lookup tables need 8-bit inputs");
+                    auto in = static_cast<const QUANT*>(input);
+                    auto entries = static_cast<const OUT*>(table);
+                    auto out = static_cast<OUT*>(output);
+                    const int bias = -static_cast<int>(std::numeric_limits<QUANT>::min());
+
+                    Eigen::TensorOpCost cost(sizeof(QUANT), sizeof(OUT), 1);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        static_cast<Eigen::Index>(count),
+                        cost,
+                        [&](Eigen::Index first, Eigen::Index last) {
+                            for (Eigen::Index i = first; i < last; i++)
+                            {
+                                out[i] = entries[static_cast<int>(in[i]) + bias];
+                            }
+                        });
+                }
+            }
+        }
+    }
+}
@@ -31,7 +31,7 @@ namespace ngraph
                                            const Shape& output_shape,
                                            int arena)
                 {
-                    reshape<float, 3, 3>(
+                    reshape<float>(
                         input, output, input_shape, input_axis_order, output_shape, arena);
                 }
 
@@ -42,7 +42,7 @@ namespace ngraph
                                            const Shape& output_shape,
                                            int arena)
                 {
-                    reshape<float, 4, 4>(
+                    reshape<float>(
                         input, output, input_shape, input_axis_order, output_shape, arena);
                 }
             }
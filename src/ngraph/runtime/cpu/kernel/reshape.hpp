@@ -16,12 +16,8 @@
 
 #pragma once
 
-#define EIGEN_USE_THREADS
-#include <unsupported/Eigen/CXX11/Tensor>
-
 #include "ngraph/axis_vector.hpp"
-#include "ngraph/runtime/cpu/cpu_executor.hpp"
-#include "ngraph/runtime/reference/reshape.hpp"
+#include "ngraph/runtime/cpu/kernel/transpose.hpp"
 #include "ngraph/shape.hpp"
 
 namespace ngraph
@@ -32,131 +28,21 @@ namespace ngraph
         {
             namespace kernel
             {
-                template <typename ElementType, unsigned int InRank, unsigned int OutRank>
-                void reshape(ElementType* input,
-                             ElementType* output,
-                             const Shape& input_shape,
-                             const AxisVector& input_axis_order,
-                             const Shape& output_shape,
-                             int arena)
-                {
-                    Eigen::array<Eigen::Index, OutRank> out_dims;
-                    Eigen::array<Eigen::Index, InRank> in_dims;
-                    Eigen::array<Eigen::Index, InRank> axis_order;
-
-                    for (int i = 0; i < OutRank; i++)
-                    {
-                        out_dims[i] = output_shape[i];
-                    }
-
-                    for (int i = 0; i < InRank; i++)
-                    {
-                        in_dims[i] = input_shape[i];
-                        axis_order[i] = input_axis_order[i];
-                    }
-
-                    Eigen::TensorMap<Eigen::Tensor<ElementType, OutRank, Eigen::RowMajor>> out(
-                        output, out_dims);
-                    Eigen::TensorMap<Eigen::Tensor<ElementType, InRank, Eigen::RowMajor>> in(
-                        input, in_dims);
-
-                    out.device(ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena)) =
-                        in.shuffle(axis_order).reshape(out_dims);
-                }
-
-                template <typename ElementType, unsigned int InRank, unsigned int OutRank>
-                void reshape(void* input,
+                // A reshape lays its input out in input_axis_order and then reinterprets the
+                // result in output_shape, so only the transpose moves any data.
+                template <typename ElementType>
+                void reshape(const void* input,
                              void* output,
                              const Shape& input_shape,
                              const AxisVector& input_axis_order,
                              const Shape& output_shape,
                              int arena)
                 {
-                    reshape<ElementType, InRank, OutRank>(static_cast<ElementType*>(input),
-                                                          static_cast<ElementType*>(output),
-                                                          input_shape,
-                                                          input_axis_order,
-                                                          output_shape,
-                                                          arena);
-                }
-
-                template <typename ElementType, unsigned int OutRank>
-                void reshape_1d(void* input,
-                                void* output,
-                                const Shape& input_shape,
-                                const AxisVector& input_axis_order,
-                                const Shape& output_shape,
-                                int arena)
-                {
-                    reshape<ElementType, 1, OutRank>(static_cast<ElementType*>(input),
-                                                     static_cast<ElementType*>(output),
-                                                     input_shape,
-                                                     input_axis_order,
-                                                     output_shape,
-                                                     arena);
-                }
-
-                template <typename ElementType, unsigned int OutRank>
-                void reshape_2d(void* input,
-                                void* output,
-                                const Shape& input_shape,
-                                const AxisVector& input_axis_order,
-                                const Shape& output_shape,
-                                int arena)
-                {
-                    reshape<ElementType, 2, OutRank>(static_cast<ElementType*>(input),
-                                                     static_cast<ElementType*>(output),
-                                                     input_shape,
-                                                     input_axis_order,
-                                                     output_shape,
-                                                     arena);
-                }
-
-                template <typename ElementType, unsigned int OutRank>
-                void reshape_3d(void* input,
-                                void* output,
-                                const Shape& input_shape,
-                                const AxisVector& input_axis_order,
-                                const Shape& output_shape,
-                                int arena)
-                {
-                    reshape<ElementType, 3, OutRank>(static_cast<ElementType*>(input),
-                                                     static_cast<ElementType*>(output),
-                                                     input_shape,
-                                                     input_axis_order,
-                                                     output_shape,
-                                                     arena);
-                }
-
-                template <typename ElementType, unsigned int OutRank>
-                void reshape_4d(void* input,
-                                void* output,
-                                const Shape& input_shape,
-                                const AxisVector& input_axis_order,
-                                const Shape& output_shape,
-                                int arena)
-                {
-                    reshape<ElementType, 4, OutRank>(static_cast<ElementType*>(input),
-                                                     static_cast<ElementType*>(output),
-                                                     input_shape,
-                                                     input_axis_order,
-                                                     output_shape,
-                                                     arena);
-                }
-
-                template <typename ElementType>
-                void reshape_ref(const void* arg,
-                                 void* out,
-                                 const Shape& in_shape,
-                                 const AxisVector& in_axis_order,
-                                 const Shape& out_shape,
-                                 int arena)
-                {
-                    reference::reshape(static_cast<const ElementType*>(arg),
-                                       static_cast<ElementType*>(out),
-                                       in_shape,
-                                       in_axis_order,
-                                       out_shape);
+                    transpose(static_cast<const ElementType*>(input),
+                              static_cast<ElementType*>(output),
+                              input_shape,
+                              input_axis_order,
+                              arena);
                 }
             }
         }
@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include "ngraph/runtime/reference/reverse.hpp"
+#include "ngraph/axis_set.hpp"
+#include "ngraph/runtime/cpu/kernel/transpose.hpp"
 #include "ngraph/shape.hpp"
 
 namespace ngraph
@@ -32,13 +33,39 @@ namespace ngraph
                              void* out,
                              const Shape& arg_shape,
                              const Shape& out_shape,
-                             const AxisSet& reversed_axes)
+                             const AxisSet& reversed_axes,
+                             int arena)
                 {
-                    reference::reverse(static_cast<const ElementType*>(arg),
-                                       static_cast<ElementType*>(out),
-                                       arg_shape,
-                                       out_shape,
-                                       reversed_axes);
+                    Shape shape;
+                    std::vector<bool> reversed;
+                    collapse_reverse(arg_shape, reversed_axes, shape, reversed);
+                    if (shape_size(shape) == 0)
+                    {
+                        return;
+                    }
+
+                    // Every output row is one contiguous input row, copied back to front
+                    // when the innermost axis is reversed.
+                    size_t rank = shape.size();
+                    size_t row_length = rank == 0 ? 1 : shape[rank - 1];
+                    StridedIndex rows;
+                    size_t stride = row_length;
+                    std::vector<size_t> strides(rank, 0);
+                    for (size_t i = rank; i-- > 1;)
+                    {
+                        strides[i - 1] = stride;
+                        stride *= shape[i - 1];
+                    }
+                    for (size_t i = 0; i + 1 < rank; i++)
+                    {
+                        rows.push_back(shape[i], strides[i], reversed[i]);
+                    }
+                    copy_rows(static_cast<const ElementType*>(arg),
+                              static_cast<ElementType*>(out),
+                              rows,
+                              row_length,
+                              rank > 0 && reversed[rank - 1],
+                              arena);
                 }
             }
         }
@@ -0,0 +1,140 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // Batch rows per task of the elementwise part of a time step
+                static const size_t s_lstm_batch_block = 8;
+
+                // Forward LSTM over a whole sequence, without MKLDNN. The weights and bias are
+                // in MKLDNN's layout: [feature_size, 4 * hidden_size] with the gates in the
+                // order input, forget, candidate, output. dst_iter gets the last {ht | ct}.
+                void lstm_forward_float32(const float* src_layer,
+                                          const float* src_iter,
+                                          const float* weights_layer,
+                                          const float* weights_iter,
+                                          const float* bias,
+                                          float* dst_layer,
+                                          float* dst_iter,
+                                          size_t seq_length,
+                                          size_t batch,
+                                          size_t input_size,
+                                          size_t hidden_size,
+                                          int arena)
+                {
+                    const size_t gates_size = 4 * hidden_size;
+                    std::vector<float> gates(seq_length * batch * gates_size);
+
+                    // The input projection does not depend on the recurrence, so the one of
+                    // every time step is a single SGEMM
+                    cblas::cblas_sgemm(cblas::Layout::RowMajor,
+                                       cblas::Transpose::None,
+                                       cblas::Transpose::None,
+                                       seq_length * batch,
+                                       gates_size,
+                                       input_size,
+                                       1.0f,
+                                       src_layer,
+                                       std::max<size_t>(1, input_size),
+                                       weights_layer,
+                                       gates_size,
+                                       0.0f,
+                                       gates.data(),
+                                       gates_size);
+
+                    // dst_iter holds {ht | ct}. The cell state is updated in place.
+                    float* c = dst_iter + batch * hidden_size;
+                    std::memcpy(c,
+                                src_iter + batch * hidden_size,
+                                batch * hidden_size * sizeof(float));
+                    const float* h_prev = src_iter;
+
+                    size_t blocks = (batch + s_lstm_batch_block - 1) / s_lstm_batch_block;
+                    for (size_t t = 0; t < seq_length; t++)
+                    {
+                        float* step_gates = gates.data() + t * batch * gates_size;
+                        float* h = dst_layer + t * batch * hidden_size;
+                        cblas::cblas_sgemm(cblas::Layout::RowMajor,
+                                           cblas::Transpose::None,
+                                           cblas::Transpose::None,
+                                           batch,
+                                           gates_size,
+                                           hidden_size,
+                                           1.0f,
+                                           h_prev,
+                                           hidden_size,
+                                           weights_iter,
+                                           gates_size,
+                                           1.0f,
+                                           step_gates,
+                                           gates_size);
+
+                        auto cell = [&](Eigen::Index first, Eigen::Index last) {
+                            size_t end =
+                                std::min(batch, static_cast<size_t>(last) * s_lstm_batch_block);
+                            for (size_t n = first * s_lstm_batch_block; n < end; n++)
+                            {
+                                const float* g = step_gates + n * gates_size;
+                                float* c_row = c + n * hidden_size;
+                                float* h_row = h + n * hidden_size;
+                                for (size_t j = 0; j < hidden_size; j++)
+                                {
+                                    float i_gate =
+                                        1.0f / (1.0f + std::exp(-(g[j] + bias[j])));
+                                    float f_gate = 1.0f / (1.0f + std::exp(-(
+                                                              g[hidden_size + j] +
+                                                              bias[hidden_size + j])));
+                                    float candidate = std::tanh(g[2 * hidden_size + j] +
+                                                                bias[2 * hidden_size + j]);
+                                    float o_gate = 1.0f / (1.0f + std::exp(-(
+                                                              g[3 * hidden_size + j] +
+                                                              bias[3 * hidden_size + j])));
+                                    c_row[j] = f_gate * c_row[j] + i_gate * candidate;
+                                    h_row[j] = o_gate * std::tanh(c_row[j]);
+                                }
+                            }
+                        };
+                        size_t block_bytes = s_lstm_batch_block * gates_size * sizeof(float);
+                        Eigen::TensorOpCost cost(
+                            block_bytes, block_bytes / 2, s_lstm_batch_block * gates_size * 8);
+                        ngraph::runtime::cpu::executor::GetCPUExecutor()
+                            .get_device(arena)
+                            .parallelFor(blocks, cost, cell);
+                        h_prev = h;
+                    }
+                    std::memcpy(dst_iter, h_prev, batch * hidden_size * sizeof(float));
+                }
+            }
+        }
+    }
+}
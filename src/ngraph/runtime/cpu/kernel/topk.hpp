@@ -0,0 +1,198 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // Orders (value, index) pairs the same way as reference::topk, ties included
+                template <typename T, typename U>
+                struct topk_better
+                {
+                    bool compute_max;
+                    bool operator()(const std::pair<T, U>& a, const std::pair<T, U>& b) const
+                    {
+                        return compute_max ? a > b : a < b;
+                    }
+                };
+
+                // Keeps the k best entries in a heap whose top is the worst of them. Entries
+                // are visited in index order, so a value equal to the top only qualifies when
+                // computing the max, where the larger index wins the tie.
+                template <typename T, typename U>
+                void topk_heap(const T* arg,
+                               size_t n,
+                               size_t stride,
+                               size_t k,
+                               bool compute_max,
+                               std::vector<std::pair<T, U>>& heap)
+                {
+                    topk_better<T, U> better{compute_max};
+                    heap.clear();
+                    size_t i = 0;
+                    for (; i < k; i++)
+                    {
+                        heap.emplace_back(arg[i * stride], static_cast<U>(i));
+                    }
+                    std::make_heap(heap.begin(), heap.end(), better);
+
+                    const size_t block = 16;
+                    while (i < n)
+                    {
+                        T threshold = heap.front().first;
+                        if (stride == 1 && i + block <= n)
+                        {
+                            // Branch free test of a whole block, vectorized by the compiler;
+                            // most blocks hold nothing better than the current k-th entry
+                            bool any = false;
+                            const T* values = arg + i;
+                            if (compute_max)
+                            {
+                                for (size_t j = 0; j < block; j++)
+                                {
+                                    any |= values[j] >= threshold;
+                                }
+                            }
+                            else
+                            {
+                                for (size_t j = 0; j < block; j++)
+                                {
+                                    any |= values[j] < threshold;
+                                }
+                            }
+                            if (!any)
+                            {
+                                i += block;
+                                continue;
+                            }
+                        }
+                        size_t end = (stride == 1 ? std::min(n, i + block) : i + 1);
+                        for (; i < end; i++)
+                        {
+                            std::pair<T, U> entry(arg[i * stride], static_cast<U>(i));
+                            if (better(entry, heap.front()))
+                            {
+                                std::pop_heap(heap.begin(), heap.end(), better);
+                                heap.back() = entry;
+                                std::push_heap(heap.begin(), heap.end(), better);
+                            }
+                        }
+                    }
+                    std::sort_heap(heap.begin(), heap.end(), better);
+                }
+
+                // Partitions around the k-th entry, then sorts the k best
+                template <typename T, typename U>
+                void topk_select(const T* arg,
+                                 size_t n,
+                                 size_t stride,
+                                 size_t k,
+                                 bool compute_max,
+                                 std::vector<std::pair<T, U>>& workspace)
+                {
+                    topk_better<T, U> better{compute_max};
+                    workspace.resize(n);
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        workspace[i] = std::pair<T, U>(arg[i * stride], static_cast<U>(i));
+                    }
+                    if (k < n)
+                    {
+                        std::nth_element(
+                            workspace.begin(), workspace.begin() + k, workspace.end(), better);
+                    }
+                    std::sort(workspace.begin(), workspace.begin() + k, better);
+                }
+
+                template <typename T, typename U>
+                void topk(void* arg,
+                          void* out_indices,
+                          void* out_values,
+                          const Shape& in_shape,
+                          size_t axis,
+                          size_t k,
+                          bool compute_max,
+                          int arena)
+                {
+                    size_t n = in_shape[axis];
+                    size_t outer = 1;
+                    size_t inner = 1;
+                    for (size_t i = 0; i < axis; i++)
+                    {
+                        outer *= in_shape[i];
+                    }
+                    for (size_t i = axis + 1; i < in_shape.size(); i++)
+                    {
+                        inner *= in_shape[i];
+                    }
+                    if (n == 0 || k == 0 || outer * inner == 0)
+                    {
+                        return;
+                    }
+                    // A heap of k entries wins while k is small next to the axis length
+                    bool use_heap = k * 8 <= n;
+
+                    auto slices = [&](Eigen::Index first, Eigen::Index last) {
+                        std::vector<std::pair<T, U>> workspace;
+                        for (Eigen::Index slice = first; slice < last; slice++)
+                        {
+                            size_t o = slice / inner;
+                            size_t i = slice % inner;
+                            const T* in = static_cast<const T*>(arg) + o * n * inner + i;
+                            if (use_heap)
+                            {
+                                topk_heap<T, U>(in, n, inner, k, compute_max, workspace);
+                            }
+                            else
+                            {
+                                topk_select<T, U>(in, n, inner, k, compute_max, workspace);
+                            }
+                            size_t out_index = o * k * inner + i;
+                            for (size_t j = 0; j < k; j++)
+                            {
+                                static_cast<T*>(out_values)[out_index] = workspace[j].first;
+                                static_cast<U*>(out_indices)[out_index] = workspace[j].second;
+                                out_index += inner;
+                            }
+                        }
+                    };
+
+                    Eigen::TensorOpCost cost(static_cast<double>(n * sizeof(T)),
+                                             static_cast<double>(k * (sizeof(T) + sizeof(U))),
+                                             static_cast<double>(n));
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        static_cast<Eigen::Index>(outer * inner), cost, slices);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "transpose.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                void collapse_transpose(const Shape& in_shape,
+                                        const AxisVector& in_axis_order,
+                                        Shape& collapsed_shape,
+                                        AxisVector& collapsed_axis_order)
+                {
+                    // Runs of input axes [first, last] that stay adjacent in the output, in
+                    // output order. Unit axes can go anywhere so they are left out.
+                    std::vector<std::pair<size_t, size_t>> runs;
+                    for (size_t axis : in_axis_order)
+                    {
+                        if (in_shape[axis] == 1)
+                        {
+                            continue;
+                        }
+                        bool extends = false;
+                        if (!runs.empty())
+                        {
+                            extends = true;
+                            for (size_t i = runs.back().second + 1; i < axis; i++)
+                            {
+                                extends = extends && in_shape[i] == 1;
+                            }
+                            extends = extends && axis > runs.back().second;
+                        }
+                        if (extends)
+                        {
+                            runs.back().second = axis;
+                        }
+                        else
+                        {
+                            runs.push_back(std::make_pair(axis, axis));
+                        }
+                    }
+
+                    std::vector<size_t> sorted(runs.size());
+                    for (size_t i = 0; i < runs.size(); i++)
+                    {
+                        sorted[i] = i;
+                    }
+                    std::sort(sorted.begin(), sorted.end(), [&](size_t x, size_t y) {
+                        return runs[x].first < runs[y].first;
+                    });
+
+                    collapsed_shape.assign(runs.size(), 1);
+                    collapsed_axis_order.assign(runs.size(), 0);
+                    for (size_t i = 0; i < sorted.size(); i++)
+                    {
+                        const auto& run = runs[sorted[i]];
+                        for (size_t axis = run.first; axis <= run.second; axis++)
+                        {
+                            collapsed_shape[i] *= in_shape[axis];
+                        }
+                        collapsed_axis_order[sorted[i]] = i;
+                    }
+                }
+
+                void collapse_reverse(const Shape& in_shape,
+                                      const AxisSet& reversed_axes,
+                                      Shape& collapsed_shape,
+                                      std::vector<bool>& collapsed_reversed)
+                {
+                    collapsed_shape.clear();
+                    collapsed_reversed.clear();
+                    for (size_t axis = 0; axis < in_shape.size(); axis++)
+                    {
+                        if (in_shape[axis] == 1)
+                        {
+                            continue;
+                        }
+                        bool reversed = reversed_axes.count(axis) != 0;
+                        if (!collapsed_shape.empty() && collapsed_reversed.back() == reversed)
+                        {
+                            collapsed_shape.back() *= in_shape[axis];
+                        }
+                        else
+                        {
+                            collapsed_shape.push_back(in_shape[axis]);
+                            collapsed_reversed.push_back(reversed);
+                        }
+                    }
+                }
+
+                void StridedIndex::push_back(size_t dim, size_t stride, bool is_reversed)
+                {
+                    dims.push_back(dim);
+                    strides.push_back(stride);
+                    reversed.push_back(is_reversed);
+                }
+
+                size_t StridedIndex::size() const
+                {
+                    size_t count = 1;
+                    for (size_t dim : dims)
+                    {
+                        count *= dim;
+                    }
+                    return count;
+                }
+
+                size_t StridedIndex::offset(size_t index) const
+                {
+                    size_t offset = 0;
+                    for (size_t i = dims.size(); i-- > 0;)
+                    {
+                        size_t coordinate = index % dims[i];
+                        index /= dims[i];
+                        if (reversed[i])
+                        {
+                            coordinate = dims[i] - 1 - coordinate;
+                        }
+                        offset += coordinate * strides[i];
+                    }
+                    return offset;
+                }
+            }
+        }
+    }
+}
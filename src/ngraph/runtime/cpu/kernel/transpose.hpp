@@ -0,0 +1,302 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#define EIGEN_USE_THREADS
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "ngraph/axis_set.hpp"
+#include "ngraph/axis_vector.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // Rewrites a transpose of in_shape by in_axis_order as the smallest equivalent
+                // transpose: unit axes are dropped and input axes that stay adjacent in the
+                // output are merged. An identity transpose collapses to at most one axis.
+                void collapse_transpose(const Shape& in_shape,
+                                        const AxisVector& in_axis_order,
+                                        Shape& collapsed_shape,
+                                        AxisVector& collapsed_axis_order);
+
+                // Rewrites a reverse of in_shape the same way: unit axes are dropped and
+                // adjacent axes that are both reversed or both kept are merged.
+                void collapse_reverse(const Shape& in_shape,
+                                      const AxisSet& reversed_axes,
+                                      Shape& collapsed_shape,
+                                      std::vector<bool>& collapsed_reversed);
+
+                // Maps a row-major index over dims to an element offset through strides,
+                // counting reversed axes from their far end.
+                struct StridedIndex
+                {
+                    std::vector<size_t> dims;
+                    std::vector<size_t> strides;
+                    std::vector<bool> reversed;
+
+                    void push_back(size_t dim, size_t stride, bool is_reversed = false);
+                    size_t size() const;
+                    size_t offset(size_t index) const;
+                };
+
+                // Copies rows of row_length elements in parallel. Output row r is contiguous
+                // at r * row_length and is read from input + rows.offset(r), back to front
+                // if reverse_rows is set. Long rows are split so they spread across threads.
+                template <typename ElementType>
+                void copy_rows(const ElementType* input,
+                               ElementType* output,
+                               const StridedIndex& rows,
+                               size_t row_length,
+                               bool reverse_rows,
+                               int arena)
+                {
+                    const size_t chunk_length =
+                        std::max<size_t>(1, (64 * 1024) / sizeof(ElementType));
+                    const size_t chunks = (row_length + chunk_length - 1) / chunk_length;
+                    const size_t bytes = std::min(row_length, chunk_length) * sizeof(ElementType);
+
+                    auto copy = [&](Eigen::Index first, Eigen::Index last) {
+                        for (size_t item = first; item < static_cast<size_t>(last); item++)
+                        {
+                            size_t row = item / chunks;
+                            size_t begin = (item % chunks) * chunk_length;
+                            size_t end = std::min(row_length, begin + chunk_length);
+                            const ElementType* in = input + rows.offset(row);
+                            ElementType* out = output + row * row_length;
+                            if (!reverse_rows)
+                            {
+                                memcpy(out + begin,
+                                       in + begin,
+                                       (end - begin) * sizeof(ElementType));
+                            }
+                            else
+                            {
+                                for (size_t j = begin; j < end; j++)
+                                {
+                                    out[j] = in[row_length - 1 - j];
+                                }
+                            }
+                        }
+                    };
+
+                    Eigen::TensorOpCost cost(bytes, bytes, 0);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        static_cast<Eigen::Index>(rows.size() * chunks), cost, copy);
+                }
+
+                // Tile edge for transposes: each tile row is one 64 byte cache line.
+                template <typename ElementType>
+                struct TransposeTile
+                {
+                    static constexpr size_t size =
+                        64 / sizeof(ElementType) < 8 ? 8 : 64 / sizeof(ElementType);
+                };
+
+                // Transposes a rows x cols block read with in_stride between rows into a
+                // cols x rows block written with out_stride between rows.
+                template <typename ElementType>
+                void transpose_block(const ElementType* in,
+                                     size_t in_stride,
+                                     ElementType* out,
+                                     size_t out_stride,
+                                     size_t rows,
+                                     size_t cols)
+                {
+                    for (size_t i = 0; i < cols; i++)
+                    {
+                        for (size_t j = 0; j < rows; j++)
+                        {
+                            out[i * out_stride + j] = in[j * in_stride + i];
+                        }
+                    }
+                }
+
+                // Whether full tiles of ElementType are transposed with Eigen packets. Eigen
+                // provides ptranspose for float and double on every vector instruction set.
+                template <typename ElementType>
+                struct TransposeVectorized
+                    : std::integral_constant<
+                          bool,
+                          (std::is_same<ElementType, float>::value ||
+                           std::is_same<ElementType, double>::value) &&
+                              Eigen::internal::packet_traits<ElementType>::Vectorizable &&
+                              (Eigen::internal::packet_traits<ElementType>::size > 1)>
+                {
+                };
+
+                template <typename ElementType>
+                void transpose_tile(const ElementType* in,
+                                    size_t in_stride,
+                                    ElementType* out,
+                                    size_t out_stride,
+                                    std::false_type)
+                {
+                    constexpr size_t tile = TransposeTile<ElementType>::size;
+                    transpose_block(in, in_stride, out, out_stride, tile, tile);
+                }
+
+                // The tile is transposed as square blocks of one packet per row: each block
+                // is loaded as packets, transposed in registers and stored as packets.
+                template <typename ElementType>
+                void transpose_tile(const ElementType* in,
+                                    size_t in_stride,
+                                    ElementType* out,
+                                    size_t out_stride,
+                                    std::true_type)
+                {
+                    using Packet = typename Eigen::internal::packet_traits<ElementType>::type;
+                    constexpr int packet_size = Eigen::internal::unpacket_traits<Packet>::size;
+                    constexpr size_t tile = TransposeTile<ElementType>::size;
+                    static_assert(tile % packet_size == 0, "tile must be a multiple of packets");
+                    for (size_t i = 0; i < tile; i += packet_size)
+                    {
+                        for (size_t j = 0; j < tile; j += packet_size)
+                        {
+                            Eigen::internal::PacketBlock<Packet, packet_size> block;
+                            for (int k = 0; k < packet_size; k++)
+                            {
+                                block.packet[k] = Eigen::internal::ploadu<Packet>(
+                                    in + (j + k) * in_stride + i);
+                            }
+                            Eigen::internal::ptranspose(block);
+                            for (int k = 0; k < packet_size; k++)
+                            {
+                                Eigen::internal::pstoreu(out + (i + k) * out_stride + j,
+                                                         block.packet[k]);
+                            }
+                        }
+                    }
+                }
+
+                template <typename ElementType>
+                void transpose(const ElementType* input,
+                               ElementType* output,
+                               const Shape& input_shape,
+                               const AxisVector& input_axis_order,
+                               int arena)
+                {
+                    Shape shape;
+                    AxisVector order;
+                    collapse_transpose(input_shape, input_axis_order, shape, order);
+
+                    size_t count = shape_size(shape);
+                    size_t rank = shape.size();
+                    if (count == 0)
+                    {
+                        return;
+                    }
+
+                    std::vector<size_t> in_strides(rank, 1);
+                    for (size_t i = rank; i-- > 1;)
+                    {
+                        in_strides[i - 1] = in_strides[i] * shape[i];
+                    }
+                    std::vector<size_t> out_strides(rank, 1);
+                    size_t stride = 1;
+                    for (size_t k = rank; k-- > 0;)
+                    {
+                        out_strides[order[k]] = stride;
+                        stride *= shape[order[k]];
+                    }
+
+                    // Innermost axis of the input already innermost in the output: this is a
+                    // gather of contiguous rows.
+                    if (rank < 2 || order[rank - 1] == rank - 1)
+                    {
+                        size_t row_length = rank == 0 ? 1 : shape[rank - 1];
+                        StridedIndex rows;
+                        for (size_t k = 0; k + 1 < rank; k++)
+                        {
+                            rows.push_back(shape[order[k]], in_strides[order[k]]);
+                        }
+                        copy_rows(input, output, rows, row_length, false, arena);
+                        return;
+                    }
+
+                    // Otherwise axis a (innermost in the output) and axis b (innermost in the
+                    // input) are transposed in cache sized tiles, batched over the other axes.
+                    constexpr size_t tile = TransposeTile<ElementType>::size;
+                    const size_t a = order[rank - 1];
+                    const size_t b = rank - 1;
+                    const size_t in_stride_a = in_strides[a];
+                    const size_t out_stride_b = out_strides[b];
+                    const size_t tiles_a = (shape[a] + tile - 1) / tile;
+                    const size_t tiles_b = (shape[b] + tile - 1) / tile;
+
+                    StridedIndex in_batch;
+                    StridedIndex out_batch;
+                    for (size_t k = 0; k < rank; k++)
+                    {
+                        if (order[k] != a && order[k] != b)
+                        {
+                            in_batch.push_back(shape[order[k]], in_strides[order[k]]);
+                            out_batch.push_back(shape[order[k]], out_strides[order[k]]);
+                        }
+                    }
+
+                    auto transpose_tiles = [&](Eigen::Index first, Eigen::Index last) {
+                        for (size_t item = first; item < static_cast<size_t>(last); item++)
+                        {
+                            size_t ta = item % tiles_a;
+                            size_t tb = (item / tiles_a) % tiles_b;
+                            size_t batch = item / (tiles_a * tiles_b);
+                            size_t begin_a = ta * tile;
+                            size_t begin_b = tb * tile;
+                            const ElementType* in =
+                                input + in_batch.offset(batch) + begin_a * in_stride_a + begin_b;
+                            ElementType* out =
+                                output + out_batch.offset(batch) + begin_b * out_stride_b + begin_a;
+                            size_t rows = std::min(tile, shape[a] - begin_a);
+                            size_t cols = std::min(tile, shape[b] - begin_b);
+                            if (rows == tile && cols == tile)
+                            {
+                                transpose_tile(in,
+                                               in_stride_a,
+                                               out,
+                                               out_stride_b,
+                                               TransposeVectorized<ElementType>());
+                            }
+                            else
+                            {
+                                transpose_block(in, in_stride_a, out, out_stride_b, rows, cols);
+                            }
+                        }
+                    };
+
+                    const size_t bytes = tile * tile * sizeof(ElementType);
+                    Eigen::TensorOpCost cost(bytes, bytes, 0);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        static_cast<Eigen::Index>(in_batch.size() * tiles_b * tiles_a),
+                        cost,
+                        transpose_tiles);
+                }
+            }
+        }
+    }
+}
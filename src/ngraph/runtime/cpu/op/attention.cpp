@@ -0,0 +1,127 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/op/attention.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+op::Attention::Attention(const shared_ptr<Node>& q,
+                         const shared_ptr<Node>& k,
+                         const shared_ptr<Node>& v,
+                         const shared_ptr<Node>& mask,
+                         float scale,
+                         bool transpose_k,
+                         bool transpose_v,
+                         const AxisSet& mask_broadcast_axes)
+    : Op("Attention",
+         check_single_output_args(mask == nullptr ? NodeVector{q, k, v}
+                                                  : NodeVector{q, k, v, mask}))
+    , m_scale(scale)
+    , m_transpose_k(transpose_k)
+    , m_transpose_v(transpose_v)
+    , m_mask_broadcast_axes(mask_broadcast_axes)
+{
+    constructor_validate_and_infer_types();
+}
+
+void op::Attention::validate_and_infer_types()
+{
+    for (size_t i = 0; i < get_input_size(); i++)
+    {
+        NODE_VALIDATION_CHECK(this,
+                              get_input_element_type(i) == element::f32,
+                              "Argument ",
+                              i,
+                              " must be f32.");
+    }
+
+    const Shape& q_shape = get_input_shape(0);
+    const Shape& k_shape = get_input_shape(1);
+    const Shape& v_shape = get_input_shape(2);
+    NODE_VALIDATION_CHECK(this,
+                          q_shape.size() == 3 && k_shape.size() == 3 && v_shape.size() == 3,
+                          "Query, key and value ranks must be 3.");
+
+    size_t batch = q_shape[0];
+    size_t head_size = q_shape[2];
+    size_t keys = m_transpose_k ? k_shape[2] : k_shape[1];
+    size_t value_size = m_transpose_v ? v_shape[1] : v_shape[2];
+    NODE_VALIDATION_CHECK(this,
+                          k_shape[0] == batch && v_shape[0] == batch,
+                          "Batch sizes of query, key and value are not equal (q shape: ",
+                          q_shape,
+                          ", k shape: ",
+                          k_shape,
+                          ", v shape: ",
+                          v_shape,
+                          ").");
+    NODE_VALIDATION_CHECK(this,
+                          (m_transpose_k ? k_shape[1] : k_shape[2]) == head_size,
+                          "Query and key head sizes are not equal (q shape: ",
+                          q_shape,
+                          ", k shape: ",
+                          k_shape,
+                          ").");
+    NODE_VALIDATION_CHECK(this,
+                          (m_transpose_v ? v_shape[2] : v_shape[1]) == keys,
+                          "Key and value lengths are not equal (k shape: ",
+                          k_shape,
+                          ", v shape: ",
+                          v_shape,
+                          ").");
+
+    if (has_mask())
+    {
+        Shape scores_shape{batch, q_shape[1], keys};
+        Shape mask_shape;
+        for (size_t i = 0; i < scores_shape.size(); i++)
+        {
+            if (m_mask_broadcast_axes.count(i) == 0)
+            {
+                mask_shape.push_back(scores_shape[i]);
+            }
+        }
+        NODE_VALIDATION_CHECK(this,
+                              get_input_shape(3) == mask_shape,
+                              "Mask shape must be ",
+                              mask_shape,
+                              " (got ",
+                              get_input_shape(3),
+                              ").");
+    }
+    else
+    {
+        NODE_VALIDATION_CHECK(this,
+                              m_mask_broadcast_axes.empty(),
+                              "Mask broadcast axes given without a mask.");
+    }
+
+    set_output_type(0, element::f32, Shape{batch, q_shape[1], value_size});
+}
+
+shared_ptr<Node> op::Attention::copy_with_new_args(const NodeVector& new_args) const
+{
+    check_new_args_count(this, new_args);
+    return make_shared<Attention>(new_args.at(0),
+                                  new_args.at(1),
+                                  new_args.at(2),
+                                  new_args.size() > 3 ? new_args.at(3) : nullptr,
+                                  m_scale,
+                                  m_transpose_k,
+                                  m_transpose_v,
+                                  m_mask_broadcast_axes);
+}
@@ -0,0 +1,73 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/axis_set.hpp"
+#include "ngraph/op/op.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace op
+    {
+        /// \brief Scaled dot-product attention over a batch of independent heads.
+        ///
+        /// Computes softmax(scale * q * k^T + mask) * v for every batch entry, with the softmax
+        /// taken over the keys. The [queries, keys] scores are never stored as a whole; the
+        /// keys are processed a tile at a time with a running softmax.
+        class Attention : public Op
+        {
+        public:
+            /// \brief Constructs an Attention operation.
+            ///
+            /// \param q Queries, [batch, queries, head_size].
+            /// \param k Keys, [batch, keys, head_size], or [batch, head_size, keys] if
+            ///          transpose_k is set.
+            /// \param v Values, [batch, keys, value_size], or [batch, value_size, keys] if
+            ///          transpose_v is set.
+            /// \param mask Added to the scaled scores; may be null. Its shape is the
+            ///             [batch, queries, keys] shape of the scores without the
+            ///             mask_broadcast_axes.
+            ///
+            /// Output `[batch, queries, value_size]`
+            CPU_BACKEND_API Attention(const std::shared_ptr<Node>& q,
+                                      const std::shared_ptr<Node>& k,
+                                      const std::shared_ptr<Node>& v,
+                                      const std::shared_ptr<Node>& mask,
+                                      float scale,
+                                      bool transpose_k,
+                                      bool transpose_v,
+                                      const AxisSet& mask_broadcast_axes = AxisSet{});
+
+            void validate_and_infer_types() override;
+
+            float get_scale() const { return m_scale; }
+            bool get_is_k_transposed() const { return m_transpose_k; }
+            bool get_is_v_transposed() const { return m_transpose_v; }
+            bool has_mask() const { return get_input_size() > 3; }
+            const AxisSet& get_mask_broadcast_axes() const { return m_mask_broadcast_axes; }
+            virtual std::shared_ptr<Node>
+                copy_with_new_args(const NodeVector& new_args) const override;
+
+        private:
+            float m_scale;
+            bool m_transpose_k;
+            bool m_transpose_v;
+            AxisSet m_mask_broadcast_axes;
+        };
+    }
+}
@@ -0,0 +1,117 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/op/matmul_epilogue.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static NodeVector make_args(const shared_ptr<Node>& W,
+                            const shared_ptr<Node>& x,
+                            const NodeVector& operands)
+{
+    NodeVector args{W, x};
+    args.insert(args.end(), operands.begin(), operands.end());
+    return args;
+}
+
+op::MatmulEpilogue::MatmulEpilogue(const shared_ptr<Node>& W,
+                                   const shared_ptr<Node>& x,
+                                   const NodeVector& operands,
+                                   const Shape& shape_w,
+                                   const Shape& shape_x,
+                                   bool transpose_w,
+                                   bool transpose_x,
+                                   const vector<Step>& steps)
+    : Op("MatmulEpilogue", check_single_output_args(make_args(W, x, operands)))
+    , m_shape_w(shape_w)
+    , m_shape_x(shape_x)
+    , m_transpose_w(transpose_w)
+    , m_transpose_x(transpose_x)
+    , m_steps(steps)
+{
+    constructor_validate_and_infer_types();
+}
+
+void op::MatmulEpilogue::validate_and_infer_types()
+{
+    const element::Type& et = get_input_element_type(0);
+    NODE_VALIDATION_CHECK(this,
+                          et == element::f32 && get_input_element_type(1) == element::f32,
+                          "Matrix element types must be f32.");
+    NODE_VALIDATION_CHECK(this,
+                          m_shape_w.size() == 2 && m_shape_x.size() == 2,
+                          "Matrix ranks must be 2.");
+
+    size_t dot_dimension_w = m_transpose_w ? 0 : 1;
+    size_t dot_dimension_x = m_transpose_x ? 1 : 0;
+    NODE_VALIDATION_CHECK(this,
+                          m_shape_w.at(dot_dimension_w) == m_shape_x.at(dot_dimension_x),
+                          "Product dimensions are not equal (W shape: ",
+                          m_shape_w,
+                          ", x shape: ",
+                          m_shape_x,
+                          ").");
+    Shape dot_shape{m_shape_w.at(1 - dot_dimension_w), m_shape_x.at(1 - dot_dimension_x)};
+
+    size_t operand = 2;
+    for (const Step& step : m_steps)
+    {
+        if (!takes_operand(step.kind))
+        {
+            continue;
+        }
+        NODE_VALIDATION_CHECK(
+            this, operand < get_input_size(), "Not enough operands for the epilogue steps.");
+
+        Shape operand_shape;
+        for (size_t i = 0; i < dot_shape.size(); i++)
+        {
+            if (step.broadcast_axes.count(i) == 0)
+            {
+                operand_shape.push_back(dot_shape[i]);
+            }
+        }
+        NODE_VALIDATION_CHECK(this,
+                              get_input_element_type(operand) == et &&
+                                  get_input_shape(operand) == operand_shape,
+                              "Operand ",
+                              operand,
+                              " must be f32 with shape ",
+                              operand_shape,
+                              ".");
+        operand++;
+    }
+    NODE_VALIDATION_CHECK(
+        this, operand == get_input_size(), "Too many operands for the epilogue steps.");
+
+    set_output_type(0, et, dot_shape);
+}
+
+shared_ptr<Node> op::MatmulEpilogue::copy_with_new_args(const NodeVector& new_args) const
+{
+    check_new_args_count(this, new_args);
+    NodeVector operands;
+    operands.assign(new_args.begin() + 2, new_args.end());
+    return make_shared<MatmulEpilogue>(new_args.at(0),
+                                       new_args.at(1),
+                                       operands,
+                                       m_shape_w,
+                                       m_shape_x,
+                                       m_transpose_w,
+                                       m_transpose_x,
+                                       m_steps);
+}
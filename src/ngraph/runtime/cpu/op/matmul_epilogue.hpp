@@ -0,0 +1,94 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include "ngraph/axis_set.hpp"
+#include "ngraph/op/op.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace op
+    {
+        /// \brief A 2D matrix product followed by a chain of elementwise steps.
+        ///
+        /// The output rows are computed in panels and the steps are applied in order to each
+        /// panel right after it is computed, while it is still in cache, so the elementwise tail
+        /// of a dense layer does not read the output back from memory.
+        /// Steps that take an operand consume the op's inputs after W and x, in order.
+        class MatmulEpilogue : public Op
+        {
+        public:
+            enum class Kind
+            {
+                Add,
+                Multiply,
+                Minimum,
+                Maximum,
+                Relu,
+                BoundedRelu,
+                Sigmoid,
+                Tanh
+            };
+
+            struct Step
+            {
+                Kind kind;
+                /// Output axes the operand is broadcast along; unused for unary steps
+                AxisSet broadcast_axes;
+                /// Upper bound of BoundedRelu
+                float alpha;
+            };
+
+            /// \brief Constructs a MatmulEpilogue operation.
+            ///
+            /// \param W Left matrix, transposed if transpose_w is set.
+            /// \param x Right matrix, transposed if transpose_x is set.
+            /// \param operands One input for each Add, Multiply, Minimum or Maximum step.
+            /// \param steps The elementwise steps, applied in order.
+            CPU_BACKEND_API MatmulEpilogue(const std::shared_ptr<Node>& W,
+                                           const std::shared_ptr<Node>& x,
+                                           const NodeVector& operands,
+                                           const Shape& shape_w,
+                                           const Shape& shape_x,
+                                           bool transpose_w,
+                                           bool transpose_x,
+                                           const std::vector<Step>& steps);
+
+            void validate_and_infer_types() override;
+
+            bool get_is_a_transposed() const { return m_transpose_w; }
+            bool get_is_b_transposed() const { return m_transpose_x; }
+            Shape get_a_shape() const { return m_shape_w; }
+            Shape get_b_shape() const { return m_shape_x; }
+            const std::vector<Step>& get_steps() const { return m_steps; }
+            /// \return true for the steps that consume an operand
+            static bool takes_operand(Kind kind) { return kind <= Kind::Maximum; }
+            virtual std::shared_ptr<Node>
+                copy_with_new_args(const NodeVector& new_args) const override;
+
+        private:
+            Shape m_shape_w;
+            Shape m_shape_x;
+            bool m_transpose_w;
+            bool m_transpose_x;
+            std::vector<Step> m_steps;
+        };
+    }
+}
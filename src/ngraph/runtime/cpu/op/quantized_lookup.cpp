@@ -0,0 +1,50 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/op/quantized_lookup.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+op::QuantizedLookup::QuantizedLookup(const shared_ptr<Node>& arg, const shared_ptr<Node>& table)
+    : Op("QuantizedLookup", check_single_output_args({arg, table}))
+{
+    constructor_validate_and_infer_types();
+}
+
+void op::QuantizedLookup::validate_and_infer_types()
+{
+    const element::Type& arg_et = get_input_element_type(0);
+    NODE_VALIDATION_CHECK(this,
+                          arg_et == element::i8 || arg_et == element::u8,
+                          "Input element type (",
+                          arg_et,
+                          ") must be i8 or u8.");
+
+    NODE_VALIDATION_CHECK(this,
+                          get_input_partial_shape(1).compatible(PartialShape{256}),
+                          "Table shape (",
+                          get_input_partial_shape(1),
+                          ") must be {256}.");
+
+    set_output_type(0, get_input_element_type(1), get_input_partial_shape(0));
+}
+
+shared_ptr<Node> op::QuantizedLookup::copy_with_new_args(const NodeVector& new_args) const
+{
+    check_new_args_count(this, new_args);
+    return make_shared<QuantizedLookup>(new_args.at(0), new_args.at(1));
+}
@@ -0,0 +1,45 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/op/op.hpp"
+
+namespace ngraph
+{
+    namespace op
+    {
+        /// \brief Maps every element of an 8-bit quantized tensor through a 256 entry table.
+        ///
+        /// Replaces a Dequantize, elementwise ops and Quantize chain whose result depends only
+        /// on the quantized input value. Entry i of the table holds the result for the input
+        /// whose value is i plus the lowest value of the input element type.
+        class QuantizedLookup : public Op
+        {
+        public:
+            /// \brief Constructs a QuantizedLookup operation.
+            ///
+            /// \param arg Node producing the i8 or u8 input tensor.
+            /// \param table Node producing the 256 entry table; sets the output element type.
+            QuantizedLookup(const std::shared_ptr<Node>& arg, const std::shared_ptr<Node>& table);
+
+            void validate_and_infer_types() override;
+
+            virtual std::shared_ptr<Node>
+                copy_with_new_args(const NodeVector& new_args) const override;
+        };
+    }
+}
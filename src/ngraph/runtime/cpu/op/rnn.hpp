@@ -75,6 +75,13 @@ namespace ngraph
             size_t get_num_cell_states() const { return m_num_cell_states; }
             size_t get_direction() const { return m_direction; }
             size_t get_num_fused_layers() const { return m_num_fused_layers; }
+            // A single forward LSTM layer, which the CPU backend can also run without MKLDNN
+            bool is_single_lstm_layer() const
+            {
+                return m_rnntype == ngraph::runtime::cpu::rnn_utils::rnntype::vanilla_lstm &&
+                       m_num_gates_per_cell == 4 && m_num_cell_states == 2 &&
+                       m_direction == 1 && m_num_fused_layers == 1;
+            }
         private:
             size_t m_num_timesteps;
             size_t m_num_gates_per_cell;
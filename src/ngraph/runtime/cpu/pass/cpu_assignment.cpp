@@ -74,6 +74,30 @@ namespace ngraph
         {
             namespace pass
             {
+                // Lets an element type conversion write its output over its input when it is
+                // the input's only user, so that CPUMemoryAssignment can reuse the input buffer
+                // instead of keeping both versions of the activation live. Output elements
+                // narrower than the input elements are only safe for kernels that handle the
+                // overlap, see kernel::quantize_runs.
+                static void assign_in_place_conversion(ngraph::op::Op* op, bool allow_narrowing)
+                {
+                    size_t input_size = op->get_input_element_type(0).size();
+                    size_t output_size = op->get_output_element_type(0).size();
+                    if (output_size > input_size ||
+                        (!allow_narrowing && output_size != input_size))
+                    {
+                        return;
+                    }
+                    if (get_user_count(op->get_argument(0).get()) != 1)
+                    {
+                        return;
+                    }
+                    auto op_annotations =
+                        std::make_shared<ngraph::runtime::cpu::CPUOpAnnotations>();
+                    op_annotations->add_in_place_oi_pair({0, 0, true});
+                    op->set_op_annotations(op_annotations);
+                }
+
                 template <>
                 void CPUAssignment::ASSIGN_DECL(ngraph::op::Add)
                 {
@@ -745,87 +769,109 @@ namespace ngraph
                 void CPUAssignment::ASSIGN_DECL(ngraph::op::Dequantize)
                 {
                     auto dequantize = static_cast<op::Dequantize*>(node);
-                    // TODO(nbpatel): Support dynamic offset via mkldnn
-                    // Go through reference if the offset is not a constant
-                    if (!dequantize->get_argument(2)->is_constant())
-                    {
-                        return;
-                    }
-                    auto offset_const_op =
-                        std::static_pointer_cast<ngraph::op::Constant>(dequantize->get_argument(2));
-                    // TODO: MKLDNN only handles float / not double
-                    if (node->get_output_element_type(0) != element::f32)
-                    {
-                        return;
-                    }
-                    if (node->get_input_element_type(0) == element::u8)
-                    {
-                        auto offset = offset_const_op->get_vector<uint8_t>();
-                        if (offset[0] != 0)
-                            return;
-                    }
-                    if (node->get_input_element_type(0) == element::i8)
+                    auto mkldnn_supported = [&]() {
+                        // TODO(nbpatel): Support dynamic offset via mkldnn
+                        // Go through reference if the offset is not a constant
+                        if (!dequantize->get_argument(2)->is_constant())
+                        {
+                            return false;
+                        }
+                        auto offset_const_op = std::static_pointer_cast<ngraph::op::Constant>(
+                            dequantize->get_argument(2));
+                        // TODO: MKLDNN only handles float / not double
+                        if (node->get_output_element_type(0) != element::f32)
+                        {
+                            return false;
+                        }
+                        if (node->get_input_element_type(0) == element::u8)
+                        {
+                            auto offset = offset_const_op->get_vector<uint8_t>();
+                            if (offset[0] != 0)
+                                return false;
+                        }
+                        if (node->get_input_element_type(0) == element::i8)
+                        {
+                            auto offset = offset_const_op->get_vector<int8_t>();
+                            if (offset[0] != 0)
+                                return false;
+                        }
+                        if (node->get_input_element_type(0) == element::i32)
+                        {
+                            auto offset = offset_const_op->get_vector<int32_t>();
+                            if (offset[0] != 0)
+                                return false;
+                        }
+                        return true;
+                    };
+                    if (mkldnn_supported())
                     {
-                        auto offset = offset_const_op->get_vector<int8_t>();
-                        if (offset[0] != 0)
-                            return;
+                        runtime::cpu::mkldnn_utils::assign_mkldnn_kernel(node);
                     }
-                    if (node->get_input_element_type(0) == element::i32)
+                    else
                     {
-                        auto offset = offset_const_op->get_vector<int32_t>();
-                        if (offset[0] != 0)
-                            return;
+                        assign_in_place_conversion(dequantize, false);
                     }
-                    runtime::cpu::mkldnn_utils::assign_mkldnn_kernel(node);
                 }
 
                 template <>
                 void CPUAssignment::ASSIGN_DECL(ngraph::op::Quantize)
                 {
                     auto quantize = static_cast<op::Quantize*>(node);
-                    // TODO(nbpatel): Support dynamic offset via mkldnn
-                    // Go through reference if the offset is not a constant
-                    if (!quantize->get_argument(2)->is_constant())
-                    {
-                        return;
-                    }
-                    auto offset_const_op =
-                        std::static_pointer_cast<ngraph::op::Constant>(quantize->get_argument(2));
-                    op::Quantize::RoundMode round_mode = quantize->get_round_mode();
-                    if (round_mode != op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_EVEN)
-                    {
-                        return;
-                    }
-                    // TODO: MKLDNN only handles float / not double
-                    if (node->get_input_element_type(0) != element::f32)
-                    {
-                        return;
-                    }
-                    if (node->get_output_element_type(0) == element::u8)
-                    {
-                        auto offset = offset_const_op->get_vector<uint8_t>();
-                        if (offset[0] != 0)
+                    auto mkldnn_supported = [&]() {
+                        // TODO(nbpatel): Support dynamic offset via mkldnn
+                        // Go through reference if the offset is not a constant
+                        if (!quantize->get_argument(2)->is_constant())
                         {
-                            return;
+                            return false;
                         }
-                    }
-                    if (node->get_output_element_type(0) == element::i8)
-                    {
-                        auto offset = offset_const_op->get_vector<int8_t>();
-                        if (offset[0] != 0)
+                        auto offset_const_op = std::static_pointer_cast<ngraph::op::Constant>(
+                            quantize->get_argument(2));
+                        op::Quantize::RoundMode round_mode = quantize->get_round_mode();
+                        if (round_mode != op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_EVEN)
                         {
-                            return;
+                            return false;
                         }
-                    }
-                    if (node->get_output_element_type(0) == element::i32)
-                    {
-                        auto offset = offset_const_op->get_vector<int32_t>();
-                        if (offset[0] != 0)
+                        // TODO: MKLDNN only handles float / not double
+                        if (node->get_input_element_type(0) != element::f32)
                         {
-                            return;
+                            return false;
+                        }
+                        if (node->get_output_element_type(0) == element::u8)
+                        {
+                            auto offset = offset_const_op->get_vector<uint8_t>();
+                            if (offset[0] != 0)
+                            {
+                                return false;
+                            }
                         }
+                        if (node->get_output_element_type(0) == element::i8)
+                        {
+                            auto offset = offset_const_op->get_vector<int8_t>();
+                            if (offset[0] != 0)
+                            {
+                                return false;
+                            }
+                        }
+                        if (node->get_output_element_type(0) == element::i32)
+                        {
+                            auto offset = offset_const_op->get_vector<int32_t>();
+                            if (offset[0] != 0)
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    };
+                    if (mkldnn_supported())
+                    {
+                        runtime::cpu::mkldnn_utils::assign_mkldnn_kernel(node);
+                    }
+                    else
+                    {
+                        // The quantize kernels convert in place front to back, so the int8
+                        // result can take over the f32 input buffer
+                        assign_in_place_conversion(quantize, true);
                     }
-                    runtime::cpu::mkldnn_utils::assign_mkldnn_kernel(node);
                 }
 
                 template <>
@@ -842,6 +888,10 @@ namespace ngraph
                         op_annotations->add_in_place_oi_pair({0, 0, false});
                         convert->set_op_annotations(op_annotations);
                     }
+                    else
+                    {
+                        assign_in_place_conversion(convert, false);
+                    }
                 }
             }
         }
@@ -24,11 +24,13 @@
 #include "ngraph/builder/make_constant.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/op/abs.hpp"
 #include "ngraph/op/add.hpp"
 #include "ngraph/op/avg_pool.hpp"
 #include "ngraph/op/batch_norm.hpp"
 #include "ngraph/op/broadcast.hpp"
 #include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/ceiling.hpp"
 #include "ngraph/op/concat.hpp"
 #include "ngraph/op/constant.hpp"
 #include "ngraph/op/convert.hpp"
@@ -43,6 +45,7 @@
 #include "ngraph/op/experimental/quantized_conv_bias.hpp"
 #include "ngraph/op/experimental/quantized_conv_relu.hpp"
 #include "ngraph/op/experimental/quantized_max_pool.hpp"
+#include "ngraph/op/floor.hpp"
 #include "ngraph/op/get_output_element.hpp"
 #include "ngraph/op/max_pool.hpp"
 #include "ngraph/op/maximum.hpp"
@@ -56,7 +59,9 @@
 #include "ngraph/op/replace_slice.hpp"
 #include "ngraph/op/reshape.hpp"
 #include "ngraph/op/sigmoid.hpp"
+#include "ngraph/op/sign.hpp"
 #include "ngraph/op/slice.hpp"
+#include "ngraph/op/softmax.hpp"
 #include "ngraph/op/sqrt.hpp"
 #include "ngraph/op/subtract.hpp"
 #include "ngraph/op/sum.hpp"
@@ -65,6 +70,8 @@
 #include "ngraph/pattern/op/label.hpp"
 #include "ngraph/pattern/op/skip.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
+#include "ngraph/runtime/cpu/op/attention.hpp"
+#include "ngraph/runtime/cpu/op/batch_dot.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
 #include "ngraph/runtime/cpu/op/bounded_relu.hpp"
 #include "ngraph/runtime/cpu/op/conv_add.hpp"
@@ -75,9 +82,13 @@
 #include "ngraph/runtime/cpu/op/leaky_relu.hpp"
 #include "ngraph/runtime/cpu/op/lstm.hpp"
 #include "ngraph/runtime/cpu/op/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/op/matmul_epilogue.hpp"
+#include "ngraph/runtime/cpu/op/quantized_lookup.hpp"
 #include "ngraph/runtime/cpu/op/rnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
 #include "ngraph/runtime/cpu/op/update_slice.hpp"
+#include "ngraph/runtime/reference/dequantize.hpp"
+#include "ngraph/runtime/reference/quantize.hpp"
 #include "ngraph/util.hpp"
 
 extern template ngraph::Shape ngraph::apply_permutation<ngraph::Shape>(ngraph::Shape input,
@@ -1875,6 +1886,124 @@ void ngraph::runtime::cpu::pass::CPUFusion::construct_update_slice()
     this->add_matcher(m);
 }
 
+// BatchDot(Softmax(BatchDot(q, k) * scale [+ mask]), v) -> Attention
+void ngraph::runtime::cpu::pass::CPUFusion::construct_attention(bool with_mask)
+{
+    auto q = std::make_shared<pattern::op::Label>(element::f32, Shape{2, 3, 4});
+    auto k = std::make_shared<pattern::op::Label>(element::f32, Shape{2, 5, 4});
+    auto v = std::make_shared<pattern::op::Label>(element::f32, Shape{2, 5, 6});
+    auto scores = std::make_shared<op::BatchDot>(q, k, false, true);
+    auto scores_label = std::make_shared<pattern::op::Label>(scores, nullptr, NodeVector{scores});
+    auto scale = std::make_shared<pattern::op::Label>(element::f32, scores->get_shape());
+    std::shared_ptr<Node> logits = std::make_shared<op::Multiply>(scores_label, scale);
+    auto mask = std::make_shared<pattern::op::Label>(element::f32, scores->get_shape());
+    if (with_mask)
+    {
+        logits = std::make_shared<op::Add>(logits, mask);
+    }
+    auto softmax = std::make_shared<op::Softmax>(logits, AxisSet{2});
+    auto softmax_label =
+        std::make_shared<pattern::op::Label>(softmax, nullptr, NodeVector{softmax});
+    auto attention = std::make_shared<op::BatchDot>(softmax_label, v, false, false);
+
+    ngraph::pattern::graph_rewrite_callback callback =
+        [q, k, v, scores_label, scale, mask, softmax_label, with_mask](pattern::Matcher& m) {
+            NGRAPH_DEBUG << "In callback for construct_attention against "
+                         << m.get_match_root()->get_name();
+            auto pattern_map = m.get_pattern_map();
+            auto scores_m = std::static_pointer_cast<op::BatchDot>(pattern_map[scores_label]);
+            auto softmax_m = std::static_pointer_cast<op::Softmax>(pattern_map[softmax_label]);
+            auto attention_m = std::static_pointer_cast<op::BatchDot>(m.get_match_root());
+
+            if (attention_m->get_element_type() != element::f32)
+            {
+                NGRAPH_DEBUG << "Only f32 attention is supported";
+                return false;
+            }
+            if (scores_m->get_is_a_transposed() || attention_m->get_is_a_transposed())
+            {
+                NGRAPH_DEBUG << "Queries and attention weights must not be transposed";
+                return false;
+            }
+            if (softmax_m->get_axes() != AxisSet{2})
+            {
+                NGRAPH_DEBUG << "Softmax must be over the keys";
+                return false;
+            }
+
+            // The scores are never materialized, so nothing else may read them
+            NodeVector intermediates{scores_m, softmax_m, softmax_m->get_argument(0)};
+            if (with_mask)
+            {
+                auto add = softmax_m->get_argument(0);
+                intermediates.push_back(add->get_argument(0) == pattern_map[mask]
+                                            ? add->get_argument(1)
+                                            : add->get_argument(0));
+            }
+            for (auto n : intermediates)
+            {
+                if (n->get_users().size() > 1)
+                {
+                    NGRAPH_DEBUG << "Attention cannot be fused, " << n->get_name()
+                                 << " has other users";
+                    return false;
+                }
+            }
+
+            auto scale_m = pattern_map[scale];
+            if (auto broadcast = std::dynamic_pointer_cast<op::Broadcast>(scale_m))
+            {
+                scale_m = broadcast->get_argument(0);
+            }
+            auto scale_const = std::dynamic_pointer_cast<op::Constant>(scale_m);
+            if (!scale_const)
+            {
+                NGRAPH_DEBUG << "Attention scale must be constant";
+                return false;
+            }
+            auto scale_vec = scale_const->get_vector<float>();
+            for (auto val : scale_vec)
+            {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+                if (val != scale_vec[0])
+                {
+                    NGRAPH_DEBUG << "Attention scale is not a singular constant";
+                    return false;
+                }
+#pragma clang diagnostic pop
+            }
+
+            // A broadcast mask, such as a padding mask shared by all queries, is read in place
+            std::shared_ptr<Node> mask_m;
+            AxisSet mask_axes;
+            if (with_mask)
+            {
+                mask_m = pattern_map[mask];
+                if (auto broadcast = std::dynamic_pointer_cast<op::Broadcast>(mask_m))
+                {
+                    mask_axes = broadcast->get_broadcast_axes();
+                    mask_m = broadcast->get_argument(0);
+                }
+            }
+
+            auto fused = std::make_shared<op::Attention>(pattern_map[q],
+                                                         pattern_map[k],
+                                                         pattern_map[v],
+                                                         mask_m,
+                                                         scale_vec[0],
+                                                         !scores_m->get_is_b_transposed(),
+                                                         attention_m->get_is_b_transposed(),
+                                                         mask_axes);
+            ngraph::replace_node(m.get_match_root(), fused);
+            return true;
+        };
+
+    auto m = std::make_shared<ngraph::pattern::Matcher>(
+        attention, callback, with_mask ? "CPUFusion.MaskedAttention" : "CPUFusion.Attention");
+    this->add_matcher(m);
+}
+
 // QuantizedConvolution + Dequantize + Relu -> QuantizedConvolutionRelu + Dequantize
 void ngraph::runtime::cpu::pass::CPUQuantFusion::construct_qconv_relu(bool with_bias)
 {
@@ -2170,6 +2299,223 @@ void ngraph::runtime::cpu::pass::CPUQuantFusion::construct_dq_q()
     this->add_matcher(m);
 }
 
+// Applies one of the unary elementwise ops that can sit between Dequantize and Quantize
+template <typename REAL>
+static bool apply_lookup_op(const std::shared_ptr<ngraph::Node>& node, std::vector<REAL>& values)
+{
+    std::function<REAL(REAL)> f;
+    if (std::dynamic_pointer_cast<ngraph::op::Abs>(node))
+    {
+        f = [](REAL x) { return std::fabs(x); };
+    }
+    else if (std::dynamic_pointer_cast<ngraph::op::Negative>(node))
+    {
+        f = [](REAL x) { return -x; };
+    }
+    else if (std::dynamic_pointer_cast<ngraph::op::Relu>(node))
+    {
+        f = [](REAL x) { return x > 0 ? x : 0; };
+    }
+    else if (auto bounded_relu = std::dynamic_pointer_cast<ngraph::op::BoundedRelu>(node))
+    {
+        REAL alpha = bounded_relu->get_alpha();
+        f = [alpha](REAL x) { return std::min(x > 0 ? x : 0, alpha); };
+    }
+    else if (auto leaky_relu = std::dynamic_pointer_cast<ngraph::op::LeakyRelu>(node))
+    {
+        REAL alpha = leaky_relu->get_alpha();
+        f = [alpha](REAL x) { return x > 0 ? x : alpha * x; };
+    }
+    else if (std::dynamic_pointer_cast<ngraph::op::Sigmoid>(node))
+    {
+        f = [](REAL x) { return 1 / (1 + std::exp(-x)); };
+    }
+    else if (std::dynamic_pointer_cast<ngraph::op::Tanh>(node))
+    {
+        f = [](REAL x) { return std::tanh(x); };
+    }
+    else if (std::dynamic_pointer_cast<ngraph::op::Exp>(node))
+    {
+        f = [](REAL x) { return std::exp(x); };
+    }
+    else if (std::dynamic_pointer_cast<ngraph::op::Floor>(node))
+    {
+        f = [](REAL x) { return std::floor(x); };
+    }
+    else if (std::dynamic_pointer_cast<ngraph::op::Ceiling>(node))
+    {
+        f = [](REAL x) { return std::ceil(x); };
+    }
+    else if (std::dynamic_pointer_cast<ngraph::op::Sign>(node))
+    {
+        f = [](REAL x) { return static_cast<REAL>((0 < x) - (x < 0)); };
+    }
+    else
+    {
+        return false;
+    }
+    std::transform(values.begin(), values.end(), values.begin(), f);
+    return true;
+}
+
+// Tabulates Quantize(chain(Dequantize(x))) for all 256 values of the 8-bit input x
+template <typename REAL, typename QIN, typename QOUT>
+static std::shared_ptr<ngraph::Node>
+    make_lookup_table(const std::shared_ptr<ngraph::op::Dequantize>& dq,
+                      const ngraph::NodeVector& chain,
+                      const std::shared_ptr<ngraph::op::Quantize>& q)
+{
+    std::vector<QIN> inputs(256);
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        inputs[i] = static_cast<QIN>(std::numeric_limits<QIN>::min() + static_cast<int>(i));
+    }
+    auto dq_scale = std::static_pointer_cast<ngraph::op::Constant>(dq->get_argument(1));
+    auto dq_offset = std::static_pointer_cast<ngraph::op::Constant>(dq->get_argument(2));
+    std::vector<REAL> values(inputs.size());
+    ngraph::runtime::reference::dequantize<QIN, REAL>(inputs.data(),
+                                                      dq_scale->get_data_ptr<REAL>(),
+                                                      dq_offset->get_data_ptr<QIN>(),
+                                                      values.data(),
+                                                      ngraph::Shape{inputs.size()},
+                                                      ngraph::Shape{},
+                                                      ngraph::AxisSet{});
+
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+        if (!apply_lookup_op<REAL>(*it, values))
+        {
+            return nullptr;
+        }
+    }
+
+    auto q_scale = std::static_pointer_cast<ngraph::op::Constant>(q->get_argument(1));
+    auto q_offset = std::static_pointer_cast<ngraph::op::Constant>(q->get_argument(2));
+    std::vector<QOUT> table(inputs.size());
+    ngraph::runtime::reference::quantize<REAL, QOUT>(values.data(),
+                                                     q_scale->get_data_ptr<REAL>(),
+                                                     q_offset->get_data_ptr<QOUT>(),
+                                                     table.data(),
+                                                     ngraph::Shape{inputs.size()},
+                                                     ngraph::Shape{},
+                                                     ngraph::AxisSet{},
+                                                     q->get_round_mode());
+    return std::make_shared<ngraph::op::Constant>(
+        q->get_element_type(), ngraph::Shape{table.size()}, table);
+}
+
+template <typename REAL, typename QIN>
+static std::shared_ptr<ngraph::Node>
+    make_lookup_table(const std::shared_ptr<ngraph::op::Dequantize>& dq,
+                      const ngraph::NodeVector& chain,
+                      const std::shared_ptr<ngraph::op::Quantize>& q)
+{
+    auto type = q->get_element_type();
+    if (type == ngraph::element::i8)
+    {
+        return make_lookup_table<REAL, QIN, int8_t>(dq, chain, q);
+    }
+    else if (type == ngraph::element::u8)
+    {
+        return make_lookup_table<REAL, QIN, uint8_t>(dq, chain, q);
+    }
+    else if (type == ngraph::element::i32)
+    {
+        return make_lookup_table<REAL, QIN, int32_t>(dq, chain, q);
+    }
+    return nullptr;
+}
+
+template <typename REAL>
+static std::shared_ptr<ngraph::Node>
+    make_lookup_table(const std::shared_ptr<ngraph::op::Dequantize>& dq,
+                      const ngraph::NodeVector& chain,
+                      const std::shared_ptr<ngraph::op::Quantize>& q)
+{
+    auto type = dq->get_argument(0)->get_element_type();
+    if (type == ngraph::element::i8)
+    {
+        return make_lookup_table<REAL, int8_t>(dq, chain, q);
+    }
+    else if (type == ngraph::element::u8)
+    {
+        return make_lookup_table<REAL, uint8_t>(dq, chain, q);
+    }
+    return nullptr;
+}
+
+// Dequantize + {unary elementwise}* + Quantize -> QuantizedLookup
+// With per-tensor constant scales and offsets the chain is a function of the 8-bit input
+// alone, so it runs as one table lookup instead of three or more passes over f32 data.
+void ngraph::runtime::cpu::pass::CPUQuantFusion::construct_dq_elementwise_q()
+{
+    auto input = std::make_shared<pattern::op::Label>(element::f32, Shape{2, 2});
+    auto q_scale = std::make_shared<pattern::op::Label>(element::f32, Shape{});
+    auto q_zp = std::make_shared<pattern::op::Label>(element::i8, Shape{});
+    op::Quantize::RoundMode round_mode = op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_EVEN;
+    auto q =
+        std::make_shared<op::Quantize>(input, q_scale, q_zp, element::i8, AxisSet{}, round_mode);
+
+    pattern::graph_rewrite_callback callback = [](pattern::Matcher& m) {
+        NGRAPH_DEBUG << "In a callback for construct_dq_elementwise_q against "
+                     << m.get_match_root()->get_name();
+
+        auto q_m = std::static_pointer_cast<op::Quantize>(m.get_match_root());
+        NodeVector chain;
+        auto node = q_m->get_argument(0);
+        auto dq_m = std::dynamic_pointer_cast<op::Dequantize>(node);
+        while (!dq_m)
+        {
+            if (node->get_users().size() != 1 || node->get_arguments().size() != 1)
+            {
+                NGRAPH_DEBUG << "Chain node " << node->get_name() << " is not unary or is shared";
+                return false;
+            }
+            chain.push_back(node);
+            node = node->get_argument(0);
+            dq_m = std::dynamic_pointer_cast<op::Dequantize>(node);
+        }
+
+        if (!q_m->get_axes().empty() || !dq_m->get_axes().empty())
+        {
+            NGRAPH_DEBUG << "Per-axis scales";
+            return false;
+        }
+
+        for (size_t i = 1; i < 3; i++)
+        {
+            if (!std::dynamic_pointer_cast<op::Constant>(q_m->get_argument(i)) ||
+                !std::dynamic_pointer_cast<op::Constant>(dq_m->get_argument(i)))
+            {
+                NGRAPH_DEBUG << "Non-constant scales or zero points";
+                return false;
+            }
+        }
+
+        std::shared_ptr<Node> table;
+        if (dq_m->get_element_type() == element::f32)
+        {
+            table = make_lookup_table<float>(dq_m, chain, q_m);
+        }
+        else if (dq_m->get_element_type() == element::f64)
+        {
+            table = make_lookup_table<double>(dq_m, chain, q_m);
+        }
+        if (!table)
+        {
+            NGRAPH_DEBUG << "Unsupported element types or elementwise ops";
+            return false;
+        }
+
+        auto lookup = std::make_shared<op::QuantizedLookup>(dq_m->get_argument(0), table);
+        ngraph::replace_node(m.get_match_root(), lookup);
+        return true;
+    };
+
+    auto m = std::make_shared<pattern::Matcher>(q, callback, "CPUQuantFusion.DQElementwiseQ");
+    this->add_matcher(m);
+}
+
 // Left Branch(LB): QCONVB + DQ + {Reshape/Broadcast}
 // Right Branch(RB): DQ + {Reshape/Broadcast}
 // Relu(LB + RB) -> QCB{S}A
@@ -2325,3 +2671,131 @@ void ngraph::runtime::cpu::pass::CPUQuantFusion::construct_qconvb_add()
         std::make_shared<pattern::Matcher>(prelu, callback, "CPUQuantFusion.QConvBiasSignedAdd");
     this->add_matcher(m);
 }
+
+void ngraph::runtime::cpu::pass::CPUMatmulEpilogueFusion::construct_matmul_epilogue()
+{
+    auto gemm_pred = [](std::shared_ptr<Node> n) {
+        return std::dynamic_pointer_cast<op::MatmulBias>(n) != nullptr ||
+               std::dynamic_pointer_cast<op::MatmulEpilogue>(n) != nullptr;
+    };
+    auto gemm = std::make_shared<pattern::op::Label>(element::f32, Shape{2, 2}, gemm_pred);
+    auto operand = std::make_shared<pattern::op::Label>(element::f32, Shape{2, 2});
+
+    pattern::graph_rewrite_callback callback = [gemm, operand](pattern::Matcher& m) {
+        NGRAPH_DEBUG << "In a callback for construct_matmul_epilogue against "
+                     << m.get_match_root()->get_name();
+        using Kind = op::MatmulEpilogue::Kind;
+
+        auto root = m.get_match_root();
+        auto pattern_map = m.get_pattern_map();
+        auto gemm_node = pattern_map[gemm];
+        if (root->get_element_type() != element::f32)
+        {
+            NGRAPH_DEBUG << "mpattern = " << root->get_name() << " type is not float!";
+            return false;
+        }
+        if (gemm_node->get_users().size() != 1 || pattern_map[operand] == gemm_node)
+        {
+            NGRAPH_DEBUG << "Matrix product " << gemm_node->get_name() << " has other users";
+            return false;
+        }
+
+        std::shared_ptr<Node> W = gemm_node->get_argument(0);
+        std::shared_ptr<Node> x = gemm_node->get_argument(1);
+        NodeVector operands;
+        std::vector<op::MatmulEpilogue::Step> steps;
+        Shape shape_w, shape_x;
+        bool transpose_w, transpose_x;
+        if (auto mmb = std::dynamic_pointer_cast<op::MatmulBias>(gemm_node))
+        {
+            shape_w = mmb->get_a_shape();
+            shape_x = mmb->get_b_shape();
+            transpose_w = mmb->get_is_a_transposed();
+            transpose_x = mmb->get_is_b_transposed();
+            if (mmb->get_arguments().size() > 2)
+            {
+                steps.push_back({Kind::Add, mmb->get_broadcast_axes(), 0.0f});
+                operands.push_back(mmb->get_argument(2));
+            }
+        }
+        else
+        {
+            auto mme = std::static_pointer_cast<op::MatmulEpilogue>(gemm_node);
+            shape_w = mme->get_a_shape();
+            shape_x = mme->get_b_shape();
+            transpose_w = mme->get_is_a_transposed();
+            transpose_x = mme->get_is_b_transposed();
+            steps = mme->get_steps();
+            auto args = mme->get_arguments();
+            operands.assign(args.begin() + 2, args.end());
+        }
+
+        op::MatmulEpilogue::Step step{Kind::Relu, AxisSet{}, 0.0f};
+        if (std::dynamic_pointer_cast<op::Relu>(root))
+        {
+            step.kind = Kind::Relu;
+        }
+        else if (auto bounded_relu = std::dynamic_pointer_cast<op::BoundedRelu>(root))
+        {
+            step.kind = Kind::BoundedRelu;
+            step.alpha = bounded_relu->get_alpha();
+        }
+        else if (std::dynamic_pointer_cast<op::Sigmoid>(root))
+        {
+            step.kind = Kind::Sigmoid;
+        }
+        else if (std::dynamic_pointer_cast<op::Tanh>(root))
+        {
+            step.kind = Kind::Tanh;
+        }
+        else
+        {
+            if (std::dynamic_pointer_cast<op::Add>(root))
+            {
+                step.kind = Kind::Add;
+            }
+            else if (std::dynamic_pointer_cast<op::Multiply>(root))
+            {
+                step.kind = Kind::Multiply;
+            }
+            else if (std::dynamic_pointer_cast<op::Minimum>(root))
+            {
+                step.kind = Kind::Minimum;
+            }
+            else
+            {
+                step.kind = Kind::Maximum;
+            }
+            // Read a broadcast operand in place instead of materializing it
+            auto operand_node = pattern_map[operand];
+            if (auto broadcast = std::dynamic_pointer_cast<op::Broadcast>(operand_node))
+            {
+                step.broadcast_axes = broadcast->get_broadcast_axes();
+                operand_node = broadcast->get_argument(0);
+            }
+            operands.push_back(operand_node);
+        }
+        steps.push_back(step);
+
+        auto mme = std::make_shared<op::MatmulEpilogue>(
+            W, x, operands, shape_w, shape_x, transpose_w, transpose_x, steps);
+        ngraph::replace_node(root, mme);
+        return true;
+    };
+
+    NodeVector patterns{std::make_shared<op::Relu>(gemm),
+                        std::make_shared<op::BoundedRelu>(gemm, 1.0f),
+                        std::make_shared<op::Sigmoid>(gemm),
+                        std::make_shared<op::Tanh>(gemm),
+                        std::make_shared<op::Add>(gemm, operand),
+                        std::make_shared<op::Multiply>(gemm, operand),
+                        std::make_shared<op::Maximum>(gemm, operand),
+                        std::make_shared<op::Minimum>(gemm, operand),
+                        std::make_shared<op::Minimum>(operand, gemm)};
+    for (const auto& pattern : patterns)
+    {
+        auto m = std::make_shared<ngraph::pattern::Matcher>(
+            pattern, callback, "CPUMatmulEpilogueFusion.MatmulEpilogue");
+        this->add_matcher(m);
+    }
+}
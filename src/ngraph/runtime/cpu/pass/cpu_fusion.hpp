@@ -29,6 +29,7 @@ namespace ngraph
             {
                 class CPUFusion;
                 class CPUQuantFusion;
+                class CPUMatmulEpilogueFusion;
             }
         }
     }
@@ -72,6 +73,8 @@ public:
             construct_conv_add_relu();
             construct_update_slice();
             construct_fuse_lstm_recurrent_state();
+            construct_attention(true);
+            construct_attention(false);
         }
     }
 
@@ -101,6 +104,7 @@ private:
     void construct_groupconv_batchnorm_global_stats_folding_relu();
     void construct_update_slice();
     void construct_fuse_lstm_recurrent_state();
+    void construct_attention(bool with_mask);
 };
 
 class CPU_BACKEND_API ngraph::runtime::cpu::pass::CPUQuantFusion : public ngraph::pass::GraphRewrite
@@ -116,6 +120,7 @@ public:
         construct_qconcat();
         construct_qconvb_add();
         construct_dq_q();
+        construct_dq_elementwise_q();
     }
 
 private:
@@ -124,5 +129,23 @@ private:
     void construct_qmax_pool();
     void construct_qconcat();
     void construct_dq_q();
+    void construct_dq_elementwise_q();
     void construct_qconvb_add();
 };
+
+/// \brief Folds the elementwise ops that follow a MatmulBias into a single MatmulEpilogue.
+///
+/// Runs after CPUFusion so that dot products have already become MatmulBias ops.
+class CPU_BACKEND_API ngraph::runtime::cpu::pass::CPUMatmulEpilogueFusion
+    : public ngraph::pass::GraphRewrite
+{
+public:
+    CPUMatmulEpilogueFusion()
+        : GraphRewrite()
+    {
+        construct_matmul_epilogue();
+    }
+
+private:
+    void construct_matmul_epilogue();
+};
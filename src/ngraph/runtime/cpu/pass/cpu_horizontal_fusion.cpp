@@ -19,6 +19,7 @@
 #include "ngraph/log.hpp"
 #include "ngraph/op/avg_pool.hpp"
 #include "ngraph/op/concat.hpp"
+#include "ngraph/op/constant.hpp"
 #include "ngraph/op/convolution.hpp"
 #include "ngraph/op/slice.hpp"
 #include "ngraph/pass/graph_rewrite.hpp"
@@ -26,6 +27,7 @@
 #include "ngraph/pattern/matcher.hpp"
 #include "ngraph/pattern/op/label.hpp"
 #include "ngraph/runtime/cpu/op/conv_bias.hpp"
+#include "ngraph/runtime/cpu/op/matmul_bias.hpp"
 
 using namespace ngraph;
 using namespace std;
@@ -192,3 +194,192 @@ void ngraph::runtime::cpu::pass::CPUHorizontalFusion::cpu_conv_horizontal_fusion
         conv_bias, callback, "CPUHorizontalFusion.CpuConvHorizontalFusion");
     this->add_matcher(m);
 }
+
+// Concatenates f32 constants of rank 1 or 2 along axis
+static std::shared_ptr<ngraph::op::Constant> concat_constants(const NodeVector& constants,
+                                                              size_t axis)
+{
+    Shape shape = constants.at(0)->get_shape();
+    shape[axis] = 0;
+    for (auto c : constants)
+    {
+        shape[axis] += c->get_shape()[axis];
+    }
+
+    std::vector<float> data(shape_size(shape));
+    size_t rows = (axis == 0) ? 1 : shape[0];
+    size_t offset = 0;
+    for (auto c : constants)
+    {
+        auto constant = std::static_pointer_cast<ngraph::op::Constant>(c);
+        const float* src = constant->get_data_ptr<float>();
+        size_t row_size = shape_size(c->get_shape()) / rows;
+        for (size_t r = 0; r < rows; r++)
+        {
+            std::copy(src + r * row_size,
+                      src + (r + 1) * row_size,
+                      data.begin() + r * (data.size() / rows) + offset);
+        }
+        offset += row_size;
+    }
+    return std::make_shared<ngraph::op::Constant>(element::f32, shape, data);
+}
+
+// Replaces the MatmulBias users of root's argument shared_index that multiply it with a
+// constant in the same way as root by a single MatmulBias over the concatenated constants,
+// followed by a Slice per original user.
+static bool fuse_gemm_siblings(const std::shared_ptr<ngraph::op::MatmulBias>& root,
+                               size_t shared_index)
+{
+    size_t weight_index = 1 - shared_index;
+    auto shared = root->get_argument(shared_index);
+    if (shared->get_users().size() < 2 || !root->get_argument(weight_index)->is_constant())
+    {
+        return false;
+    }
+
+    bool transpose_w = root->get_is_a_transposed();
+    bool transpose_x = root->get_is_b_transposed();
+    // Sharing the left operand makes the users differ in output columns, sharing the right
+    // operand in output rows. Find the matching axis of the stored weights.
+    size_t output_axis = (shared_index == 0) ? 1 : 0;
+    // The fused output is split by Slices, which CPUMemoryOptimization only does in place when
+    // each slice is contiguous: a block of rows, or columns of a single row. Column slices of
+    // several rows would copy the whole output again, which costs more than the fusion saves.
+    if (output_axis == 1 && root->get_shape()[0] != 1)
+    {
+        NGRAPH_DEBUG << "gemm_horizontal_fusion: column slices of " << root->get_name()
+                     << " would not be contiguous";
+        return false;
+    }
+    bool transpose_weights = (weight_index == 0) ? transpose_w : transpose_x;
+    size_t weight_axis = ((weight_index == 1) != transpose_weights) ? 1 : 0;
+
+    // A bias is concatenated along with the weights, so it must be broadcast along the
+    // other output axis
+    bool has_bias = root->get_input_size() > 2;
+    if (has_bias && (root->get_broadcast_axes() != AxisSet{1 - output_axis} ||
+                     !root->get_argument(2)->is_constant()))
+    {
+        NGRAPH_DEBUG << "gemm_horizontal_fusion: bias of " << root->get_name()
+                     << " can not be concatenated";
+        return false;
+    }
+
+    NodeVector siblings;
+    NodeVector weights;
+    NodeVector biases;
+    for (auto u : shared->get_users())
+    {
+        auto mmb = std::dynamic_pointer_cast<ngraph::op::MatmulBias>(u);
+        if (!mmb || !is_used(u.get()) ||
+            std::find(siblings.begin(), siblings.end(), u) != siblings.end())
+        {
+            continue;
+        }
+        if (mmb->get_argument(shared_index) != shared ||
+            !mmb->get_argument(weight_index)->is_constant() ||
+            mmb->get_argument(weight_index)->get_element_type() != element::f32 ||
+            mmb->get_is_a_transposed() != transpose_w ||
+            mmb->get_is_b_transposed() != transpose_x)
+        {
+            NGRAPH_DEBUG << "gemm_horizontal_fusion: " << u->get_name()
+                         << " is not compatible with " << root->get_name();
+            continue;
+        }
+        if ((shared_index == 0 ? mmb->get_a_shape() != root->get_a_shape()
+                               : mmb->get_b_shape() != root->get_b_shape()) ||
+            mmb->get_argument(weight_index)->get_shape()[1 - weight_axis] !=
+                root->get_argument(weight_index)->get_shape()[1 - weight_axis])
+        {
+            NGRAPH_DEBUG << "gemm_horizontal_fusion: " << u->get_name()
+                         << " has a different reduction shape";
+            continue;
+        }
+        if ((mmb->get_input_size() > 2) != has_bias ||
+            (has_bias && (mmb->get_broadcast_axes() != root->get_broadcast_axes() ||
+                          !mmb->get_argument(2)->is_constant())))
+        {
+            NGRAPH_DEBUG << "gemm_horizontal_fusion: " << u->get_name()
+                         << " has an incompatible bias";
+            continue;
+        }
+        siblings.push_back(u);
+        weights.push_back(mmb->get_argument(weight_index));
+        if (has_bias)
+        {
+            biases.push_back(mmb->get_argument(2));
+        }
+    }
+
+    if (siblings.size() <= 1)
+    {
+        NGRAPH_DEBUG << "gemm_horizontal_fusion: need more than one nodes to do fusion";
+        return false;
+    }
+
+    auto fused_weights = concat_constants(weights, weight_axis);
+    Shape shape_w = root->get_a_shape();
+    Shape shape_x = root->get_b_shape();
+    (weight_index == 0 ? shape_w : shape_x) = fused_weights->get_shape();
+    auto w = (weight_index == 0) ? fused_weights : shared;
+    auto x = (weight_index == 0) ? shared : fused_weights;
+    std::shared_ptr<Node> fused;
+    if (has_bias)
+    {
+        fused = std::make_shared<ngraph::op::MatmulBias>(w,
+                                                         x,
+                                                         concat_constants(biases, 0),
+                                                         shape_w,
+                                                         shape_x,
+                                                         transpose_w,
+                                                         transpose_x,
+                                                         root->get_broadcast_axes());
+    }
+    else
+    {
+        fused = std::make_shared<ngraph::op::MatmulBias>(
+            w, x, nullptr, shape_w, shape_x, transpose_w, transpose_x);
+    }
+    NGRAPH_DEBUG << "gemm_horizontal_fusion: fused " << siblings.size() << " GEMMs into "
+                 << fused->get_name() << " of shape " << fused->get_shape();
+
+    // The slices are contiguous and are done in place by CPUMemoryOptimization
+    size_t index = 0;
+    for (auto sibling : siblings)
+    {
+        Shape slice_shape = sibling->get_shape();
+        Coordinate lower_bounds{0, 0};
+        lower_bounds[output_axis] = index;
+        index += slice_shape[output_axis];
+        Coordinate upper_bounds{slice_shape[0], slice_shape[1]};
+        upper_bounds[output_axis] = index;
+        auto slice = std::make_shared<ngraph::op::Slice>(fused, lower_bounds, upper_bounds);
+        ngraph::replace_node(sibling, slice);
+    }
+    return true;
+}
+
+void ngraph::runtime::cpu::pass::CPUHorizontalFusion::cpu_gemm_horizontal_fusion()
+{
+    auto gemm = std::make_shared<pattern::op::Label>(
+        element::f32, Shape{2, 2}, pattern::has_class<ngraph::op::MatmulBias>());
+
+    pattern::graph_rewrite_callback callback = [](pattern::Matcher& m) {
+        NGRAPH_DEBUG << "gemm_horizontal_fusion: In a callback for gemm horizontal fusion for "
+                     << m.get_match_root()->get_name();
+
+        auto root = std::static_pointer_cast<ngraph::op::MatmulBias>(m.get_match_root());
+        if (root->get_element_type() != element::f32 || !is_used(root.get()))
+        {
+            return false;
+        }
+        // Siblings may share the right operand, as in W_q * X, W_k * X, W_v * X, or the left
+        // one when it is a single row
+        return fuse_gemm_siblings(root, 0) || fuse_gemm_siblings(root, 1);
+    };
+
+    auto m = make_shared<pattern::Matcher>(
+        gemm, callback, "CPUHorizontalFusion.CpuGemmHorizontalFusion");
+    this->add_matcher(m);
+}
@@ -39,8 +39,10 @@ public:
         : GraphRewrite()
     {
         cpu_conv_horizontal_fusion();
+        cpu_gemm_horizontal_fusion();
     }
 
 private:
     void cpu_conv_horizontal_fusion();
+    void cpu_gemm_horizontal_fusion();
 };
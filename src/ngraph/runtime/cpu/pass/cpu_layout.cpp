@@ -15,10 +15,12 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
+#include <unordered_map>
 
 #include <mkldnn.hpp>
 
@@ -73,6 +75,14 @@ using namespace mkldnn;
 using namespace ngraph;
 using namespace ngraph::runtime::cpu;
 
+// Reorder bytes downstream of a layout agnostic op for each choice of its output layout
+struct LayoutCost
+{
+    size_t blocked = 0;
+    size_t native = 0;
+};
+using LayoutCosts = std::unordered_map<const Node*, LayoutCost>;
+
 // Check if the input layout matches the layout requested in `required_mds`
 // If not, insert a layout conversion node between the input tensor and
 // the `node`. For now, only MKLDNN nodes/kernels can request specific layouts
@@ -270,60 +280,6 @@ static void set_native_layouts(runtime::cpu::CPU_ExternalFunction* external_func
     }
 }
 
-static void set_layouts_unaryeltwise(ngraph::runtime::cpu::CPU_ExternalFunction* external_function,
-                                     std::shared_ptr<ngraph::Node> node)
-{
-    auto input_md = mkldnn_utils::get_input_mkldnn_md(node.get(), 0);
-    // Non MKLDNN kernels can handle MKLDNN layouts as long as there are not padded
-    bool md_check = input_md.data.format != mkldnn_format_undef &&
-                    !mkldnn_utils::is_mkldnn_padded_layout(
-                        input_md, ngraph::get_default_order(node->get_input_shape(0)));
-    if (mkldnn_utils::use_mkldnn_kernel(node.get()) || md_check)
-    {
-        vector<memory::desc> o_mds;
-        o_mds.push_back(input_md);
-        set_output_layouts(node, o_mds);
-    }
-    else
-    {
-        set_native_layouts(external_function, node);
-    }
-}
-
-void set_layouts_binaryeltwise(ngraph::runtime::cpu::CPU_ExternalFunction* external_function,
-                               std::shared_ptr<ngraph::Node> node)
-{
-    std::vector<mkldnn::memory::desc> arg_mds{mkldnn_utils::get_input_mkldnn_md(node.get(), 0),
-                                              mkldnn_utils::get_input_mkldnn_md(node.get(), 1)};
-    bool md_check = arg_mds[0].data.format != mkldnn_format_undef &&
-                    arg_mds[1].data.format != mkldnn_format_undef &&
-                    !mkldnn_utils::is_mkldnn_padded_layout(
-                        arg_mds[0], ngraph::get_default_order(node->get_input_shape(0))) &&
-                    !mkldnn_utils::is_mkldnn_padded_layout(
-                        arg_mds[1], ngraph::get_default_order(node->get_input_shape(1)));
-    if (mkldnn_utils::use_mkldnn_kernel(node.get()) || md_check)
-    {
-        vector<memory::desc> i_mds;
-        vector<memory::desc> o_mds;
-        int select = 0;
-        char* ngraph_pass_cpu_layout_eltwise = std::getenv("NGRAPH_PASS_CPU_LAYOUT_ELTWISE");
-        if (ngraph_pass_cpu_layout_eltwise != nullptr)
-        {
-            const int user_select = std::atoi(ngraph_pass_cpu_layout_eltwise);
-            select = (user_select == 0 || user_select == 1) ? user_select : select;
-        }
-        i_mds.push_back(arg_mds[select]);
-        i_mds.push_back(arg_mds[select]);
-        o_mds.push_back(arg_mds[select]);
-        node = insert_input_conversions(external_function, node, i_mds);
-        set_output_layouts(node, o_mds);
-    }
-    else
-    {
-        set_native_layouts(external_function, node);
-    }
-}
-
 namespace ngraph
 {
     namespace runtime
@@ -2038,6 +1994,11 @@ namespace ngraph
                         // if the format doesn't matches.
                         set_native_layouts(external_function, node, false);
                     }
+                    else if (static_cast<const ngraph::op::Rnn*>(node.get())
+                                 ->is_single_lstm_layer())
+                    {
+                        set_native_layouts(external_function, node);
+                    }
                     else
                     {
                         throw ngraph_error("RNN fused op is only supported in MKLDNN for now.");
@@ -2168,8 +2129,190 @@ static const runtime::cpu::pass::LayoutOpMap s_dispatcher{
      &runtime::cpu::pass::CPULayout::layout<ngraph::op::QuantizedConcat>},
 };
 
+// Bytes moved by a reorder of the tensor produced by `output`
+static size_t reorder_bytes(const descriptor::Output& output)
+{
+    auto tv = output.get_tensor_ptr();
+    return shape_size(tv->get_shape()) * tv->get_element_type().size();
+}
+
+// True if the tensor already has the default row-major layout, or no MKLDNN layout at all
+static bool has_native_layout(const descriptor::Output& output)
+{
+    auto tv = output.get_tensor_ptr();
+    auto cpu_tvl = dynamic_cast<runtime::cpu::LayoutDescriptor*>(tv->get_tensor_layout().get());
+    if (!cpu_tvl || !cpu_tvl->is_mkldnn_layout())
+    {
+        return true;
+    }
+    auto native_md = mkldnn_utils::create_blocked_mkldnn_md(
+        tv->get_shape(), cpu_tvl->get_strides(), tv->get_element_type());
+    return mkldnn_utils::compare_mkldnn_mds(cpu_tvl->get_mkldnn_md(), native_md);
+}
+
+static bool is_layout_agnostic(const shared_ptr<Node>& node)
+{
+    if (s_dispatcher.find(TI(*node)) != s_dispatcher.end() ||
+        mkldnn_utils::use_mkldnn_kernel(node.get()))
+    {
+        return false;
+    }
+    return dynamic_pointer_cast<ngraph::op::util::UnaryElementwiseArithmetic>(node) ||
+           dynamic_pointer_cast<ngraph::op::util::BinaryElementwiseArithmetic>(node);
+}
+
+// Estimates, for every layout agnostic elementwise op, the reorder bytes its users incur when
+// the op's output stays in a blocked MKLDNN layout and when it is converted to the native
+// layout. The estimate is exact along chains and sums users independently on DAGs.
+static void compute_layout_costs(const std::list<std::shared_ptr<Node>>& nodes,
+                                 LayoutCosts& costs)
+{
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+    {
+        const auto& node = *it;
+        if (!is_layout_agnostic(node))
+        {
+            continue;
+        }
+        size_t bytes = reorder_bytes(node->get_outputs().at(0));
+        LayoutCost cost;
+        for (const auto& user : node->get_users())
+        {
+            auto user_cost = costs.find(user.get());
+            if (user_cost != costs.end())
+            {
+                // The user settles on whichever layout is cheaper given ours
+                cost.blocked += std::min(user_cost->second.blocked,
+                                         user_cost->second.native + bytes);
+                cost.native += std::min(user_cost->second.native,
+                                        user_cost->second.blocked + bytes);
+            }
+            else if (mkldnn_utils::use_mkldnn_kernel(user.get()))
+            {
+                cost.native += bytes;
+            }
+            else if (auto result = dynamic_pointer_cast<ngraph::op::Result>(user))
+            {
+                if (result->needs_default_layout())
+                {
+                    cost.blocked += bytes;
+                }
+            }
+            else if (s_dispatcher.find(TI(*user)) == s_dispatcher.end())
+            {
+                // Reference and Eigen kernels read the native layout
+                cost.blocked += bytes;
+            }
+        }
+        costs[node.get()] = cost;
+    }
+}
+
+static void set_layouts_unaryeltwise(ngraph::runtime::cpu::CPU_ExternalFunction* external_function,
+                                     std::shared_ptr<ngraph::Node> node,
+                                     const LayoutCosts& costs)
+{
+    auto input_md = mkldnn_utils::get_input_mkldnn_md(node.get(), 0);
+    // Non MKLDNN kernels can handle MKLDNN layouts as long as there are not padded
+    bool md_check = input_md.data.format != mkldnn_format_undef &&
+                    !mkldnn_utils::is_mkldnn_padded_layout(
+                        input_md, ngraph::get_default_order(node->get_input_shape(0)));
+    if (md_check && !mkldnn_utils::use_mkldnn_kernel(node.get()))
+    {
+        // Keep a blocked input's layout only if converting it here costs no less than
+        // converting further down the graph
+        const auto& input = node->get_inputs().at(0).get_output();
+        auto cost = costs.find(node.get());
+        if (cost != costs.end() && !has_native_layout(input) &&
+            cost->second.native + reorder_bytes(input) < cost->second.blocked)
+        {
+            md_check = false;
+        }
+    }
+    if (mkldnn_utils::use_mkldnn_kernel(node.get()) || md_check)
+    {
+        vector<memory::desc> o_mds;
+        o_mds.push_back(input_md);
+        set_output_layouts(node, o_mds);
+    }
+    else
+    {
+        set_native_layouts(external_function, node);
+    }
+}
+
+void set_layouts_binaryeltwise(ngraph::runtime::cpu::CPU_ExternalFunction* external_function,
+                               std::shared_ptr<ngraph::Node> node,
+                               const LayoutCosts& costs)
+{
+    std::vector<mkldnn::memory::desc> arg_mds{mkldnn_utils::get_input_mkldnn_md(node.get(), 0),
+                                              mkldnn_utils::get_input_mkldnn_md(node.get(), 1)};
+    bool md_check = arg_mds[0].data.format != mkldnn_format_undef &&
+                    arg_mds[1].data.format != mkldnn_format_undef &&
+                    !mkldnn_utils::is_mkldnn_padded_layout(
+                        arg_mds[0], ngraph::get_default_order(node->get_input_shape(0))) &&
+                    !mkldnn_utils::is_mkldnn_padded_layout(
+                        arg_mds[1], ngraph::get_default_order(node->get_input_shape(1)));
+    if (mkldnn_utils::use_mkldnn_kernel(node.get()) || md_check)
+    {
+        vector<memory::desc> i_mds;
+        vector<memory::desc> o_mds;
+        int select = 0;
+        char* ngraph_pass_cpu_layout_eltwise = std::getenv("NGRAPH_PASS_CPU_LAYOUT_ELTWISE");
+        if (ngraph_pass_cpu_layout_eltwise != nullptr)
+        {
+            const int user_select = std::atoi(ngraph_pass_cpu_layout_eltwise);
+            select = (user_select == 0 || user_select == 1) ? user_select : select;
+        }
+        else if (!mkldnn_utils::use_mkldnn_kernel(node.get()))
+        {
+            // Pick the cheapest of: each argument's layout for both inputs and the output,
+            // or the native layout everywhere
+            auto cost = costs.find(node.get());
+            const auto& arg0 = node->get_inputs().at(0).get_output();
+            const auto& arg1 = node->get_inputs().at(1).get_output();
+            size_t arg_bytes[] = {reorder_bytes(arg0), reorder_bytes(arg1)};
+            bool arg_native[] = {has_native_layout(arg0), has_native_layout(arg1)};
+            bool same_md = mkldnn_utils::compare_mkldnn_mds(arg_mds[0], arg_mds[1]);
+
+            size_t best = std::numeric_limits<size_t>::max();
+            size_t native_choice = (arg_native[0] ? 0 : arg_bytes[0]) +
+                                   (arg_native[1] ? 0 : arg_bytes[1]) +
+                                   (cost != costs.end() ? cost->second.native : 0);
+            for (int i = 0; i < 2; i++)
+            {
+                size_t choice = (same_md ? 0 : arg_bytes[1 - i]) +
+                                (cost == costs.end() ? 0 : arg_native[i] ? cost->second.native
+                                                                         : cost->second.blocked);
+                if (choice < best)
+                {
+                    best = choice;
+                    select = i;
+                }
+            }
+            if (native_choice < best)
+            {
+                set_native_layouts(external_function, node);
+                return;
+            }
+        }
+        i_mds.push_back(arg_mds[select]);
+        i_mds.push_back(arg_mds[select]);
+        o_mds.push_back(arg_mds[select]);
+        node = insert_input_conversions(external_function, node, i_mds);
+        set_output_layouts(node, o_mds);
+    }
+    else
+    {
+        set_native_layouts(external_function, node);
+    }
+}
+
 bool runtime::cpu::pass::CPULayout::run_on_call_graph(const std::list<std::shared_ptr<Node>>& nodes)
 {
+    LayoutCosts costs;
+    compute_layout_costs(nodes, costs);
+
     for (const auto& node : nodes)
     {
         auto& n = *node;
@@ -2181,12 +2324,12 @@ bool runtime::cpu::pass::CPULayout::run_on_call_graph(const std::list<std::share
         else if (dynamic_pointer_cast<ngraph::op::util::UnaryElementwiseArithmetic>(node) !=
                  nullptr)
         {
-            set_layouts_unaryeltwise(m_external_function, node);
+            set_layouts_unaryeltwise(m_external_function, node, costs);
         }
         else if (dynamic_pointer_cast<ngraph::op::util::BinaryElementwiseArithmetic>(node) !=
                  nullptr)
         {
-            set_layouts_binaryeltwise(m_external_function, node);
+            set_layouts_binaryeltwise(m_external_function, node, costs);
         }
         else
         {
@@ -2194,5 +2337,18 @@ bool runtime::cpu::pass::CPULayout::run_on_call_graph(const std::list<std::share
         }
     }
 
+    m_reorder_count = 0;
+    m_reordered_bytes = 0;
+    for (const auto& node : m_external_function->get_function()->get_ops())
+    {
+        if (dynamic_pointer_cast<runtime::cpu::op::ConvertLayout>(node))
+        {
+            m_reorder_count++;
+            m_reordered_bytes += reorder_bytes(node->get_outputs().at(0));
+        }
+    }
+    NGRAPH_DEBUG << "CPULayout: " << m_reorder_count << " reorders moving " << m_reordered_bytes
+                 << " bytes per inference";
+
     return false;
 }
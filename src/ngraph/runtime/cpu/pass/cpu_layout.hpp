@@ -51,8 +51,16 @@ namespace ngraph
                         layout(ngraph::runtime::cpu::CPU_ExternalFunction* external_function,
                                std::shared_ptr<ngraph::Node> node);
 
+                    /// \brief Number of ConvertLayout reorders left in the graph after the
+                    ///        last run, each executed once per inference
+                    size_t get_reorder_count() const { return m_reorder_count; }
+                    /// \brief Bytes those reorders move per inference
+                    size_t get_reordered_bytes() const { return m_reordered_bytes; }
+
                 private:
                     CPU_ExternalFunction* m_external_function;
+                    size_t m_reorder_count = 0;
+                    size_t m_reordered_bytes = 0;
                 };
             }
         }
@@ -0,0 +1,357 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cpu_lstm_sequence_fusion.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/add.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/concat.hpp"
+#include "ngraph/op/dot.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/multiply.hpp"
+#include "ngraph/op/reshape.hpp"
+#include "ngraph/op/sigmoid.hpp"
+#include "ngraph/op/slice.hpp"
+#include "ngraph/op/tanh.hpp"
+#include "ngraph/runtime/cpu/op/rnn.hpp"
+#include "ngraph/runtime/cpu/op/rnn_utils.hpp"
+#include "ngraph/util.hpp"
+
+using namespace ngraph;
+
+namespace
+{
+    struct LSTMCell
+    {
+        std::shared_ptr<Node> h;
+        std::shared_ptr<Node> c;
+        std::shared_ptr<Node> h_prev;
+        std::shared_ptr<Node> c_prev;
+        // Input projection of every time step, and the first row of this step in it
+        std::shared_ptr<op::Dot> x_w;
+        size_t x_w_row;
+        // Transposed recurrent weights and the summed biases
+        std::shared_ptr<Node> r_t;
+        std::shared_ptr<Node> bias;
+        // Nodes of the cell that go away once it is fused
+        NodeVector nodes;
+    };
+}
+
+// Reshape and Broadcast nodes that keep the element count only restate the shape of their
+// argument. The ONNX importer wraps them around the arguments of every elementwise op.
+static bool restates_shape(const std::shared_ptr<Node>& node)
+{
+    auto reshape = std::dynamic_pointer_cast<op::Reshape>(node);
+    if ((!reshape || reshape->get_is_transpose()) &&
+        !std::dynamic_pointer_cast<op::Broadcast>(node))
+    {
+        return false;
+    }
+    return shape_size(node->get_argument(0)->get_shape()) == shape_size(node->get_shape());
+}
+
+// Looks through the nodes that restate the shape of node, recording them in nodes
+static std::shared_ptr<Node> skip_shape_ops(const std::shared_ptr<Node>& node, NodeVector& nodes)
+{
+    auto result = node;
+    NodeVector skipped;
+    for (auto current = node; restates_shape(current);)
+    {
+        skipped.push_back(current);
+        current = current->get_argument(0);
+        if (current->get_shape() == node->get_shape())
+        {
+            nodes.insert(nodes.end(), skipped.begin(), skipped.end());
+            skipped.clear();
+            result = current;
+        }
+    }
+    return result;
+}
+
+template <typename T>
+static std::shared_ptr<T>
+    match_argument(const std::shared_ptr<Node>& node, size_t index, NodeVector& nodes)
+{
+    auto arg = std::dynamic_pointer_cast<T>(skip_shape_ops(node->get_argument(index), nodes));
+    if (arg)
+    {
+        nodes.push_back(arg);
+    }
+    return arg;
+}
+
+// Matches the cell whose hidden state is h, with the gates in the ONNX order i, o, f, c:
+//   gates = Xt*(W^T) + (Ht-1*(R^T) + B)
+//   C = sigmoid(f) * Ct-1 + sigmoid(i) * tanh(c)
+//   H = sigmoid(o) * tanh(C)
+static bool match_lstm_cell(const std::shared_ptr<Node>& h, LSTMCell& cell)
+{
+    NodeVector& nodes = cell.nodes;
+    if (!std::dynamic_pointer_cast<op::Multiply>(h) || h->get_element_type() != element::f32 ||
+        h->get_shape().size() != 2)
+    {
+        return false;
+    }
+    const Shape& state_shape = h->get_shape();
+    const size_t hidden_size = state_shape[1];
+
+    auto o = match_argument<op::Sigmoid>(h, 0, nodes);
+    auto tanh_c = match_argument<op::Tanh>(h, 1, nodes);
+    if (!o || !tanh_c)
+    {
+        return false;
+    }
+    auto c = std::dynamic_pointer_cast<op::Add>(skip_shape_ops(tanh_c->get_argument(0), nodes));
+    if (!c || c->get_shape() != state_shape)
+    {
+        return false;
+    }
+    auto f_c = match_argument<op::Multiply>(c, 0, nodes);
+    auto i_g = match_argument<op::Multiply>(c, 1, nodes);
+    if (!f_c || !i_g)
+    {
+        return false;
+    }
+    auto f = match_argument<op::Sigmoid>(f_c, 0, nodes);
+    auto i = match_argument<op::Sigmoid>(i_g, 0, nodes);
+    auto g = match_argument<op::Tanh>(i_g, 1, nodes);
+    if (!f || !i || !g)
+    {
+        return false;
+    }
+    cell.c_prev = skip_shape_ops(f_c->get_argument(1), nodes);
+
+    std::shared_ptr<Node> gates;
+    const NodeVector activations{i, o, f, g};
+    for (size_t k = 0; k < activations.size(); k++)
+    {
+        auto slice = match_argument<op::Slice>(activations[k], 0, nodes);
+        if (!slice || (gates && slice->get_argument(0) != gates))
+        {
+            return false;
+        }
+        gates = slice->get_argument(0);
+        size_t batch = gates->get_shape()[0];
+        if (gates->get_shape() != Shape{state_shape[0], 4 * hidden_size} ||
+            slice->get_lower_bounds() != Coordinate{0, k * hidden_size} ||
+            slice->get_upper_bounds() != Coordinate{batch, (k + 1) * hidden_size} ||
+            slice->get_strides() != Strides{1, 1})
+        {
+            return false;
+        }
+    }
+
+    auto gates_add = std::dynamic_pointer_cast<op::Add>(gates);
+    if (!gates_add)
+    {
+        return false;
+    }
+    nodes.push_back(gates_add);
+    auto x_w = skip_shape_ops(gates_add->get_argument(0), nodes);
+    auto recurrence = match_argument<op::Add>(gates_add, 1, nodes);
+    if (!recurrence)
+    {
+        return false;
+    }
+    auto h_r = match_argument<op::Dot>(recurrence, 0, nodes);
+    auto bias = match_argument<op::Broadcast>(recurrence, 1, nodes);
+    if (!h_r || h_r->get_reduction_axes_count() != 1 || !bias ||
+        bias->get_broadcast_axes() != AxisSet{0})
+    {
+        return false;
+    }
+    cell.h_prev = skip_shape_ops(h_r->get_argument(0), nodes);
+    cell.r_t = h_r->get_argument(1);
+    cell.bias = skip_shape_ops(bias->get_argument(0), nodes);
+    if (cell.h_prev->get_shape() != state_shape || cell.c_prev->get_shape() != state_shape ||
+        cell.r_t->get_shape() != Shape{hidden_size, 4 * hidden_size} ||
+        cell.bias->get_shape() != Shape{4 * hidden_size})
+    {
+        return false;
+    }
+
+    // Xt*(W^T) is a slice of the rows of the input projection, or all of it for a sequence of
+    // one time step
+    cell.x_w_row = 0;
+    if (auto x_slice = std::dynamic_pointer_cast<op::Slice>(x_w))
+    {
+        if (x_slice->get_lower_bounds()[1] != 0 ||
+            x_slice->get_upper_bounds()[1] != 4 * hidden_size ||
+            x_slice->get_strides() != Strides{1, 1})
+        {
+            return false;
+        }
+        nodes.push_back(x_slice);
+        cell.x_w_row = x_slice->get_lower_bounds()[0];
+        x_w = x_slice->get_argument(0);
+    }
+    cell.x_w = std::dynamic_pointer_cast<op::Dot>(x_w);
+    if (!cell.x_w || cell.x_w->get_reduction_axes_count() != 1 ||
+        cell.x_w->get_argument(0)->get_shape().size() != 2 ||
+        cell.x_w->get_shape()[1] != 4 * hidden_size)
+    {
+        return false;
+    }
+
+    cell.h = h;
+    cell.c = c;
+    return true;
+}
+
+// ONNX orders the gates i, o, f, c along the last axis, and MKLDNN i, f, c, o
+static std::shared_ptr<Node> reorder_gates(const std::shared_ptr<Node>& node, size_t hidden_size)
+{
+    const Shape& shape = node->get_shape();
+    size_t axis = shape.size() - 1;
+    NodeVector gates;
+    for (size_t gate : {0, 2, 3, 1})
+    {
+        Coordinate lower(shape.size(), 0);
+        Coordinate upper(shape);
+        lower[axis] = gate * hidden_size;
+        upper[axis] = (gate + 1) * hidden_size;
+        gates.push_back(std::make_shared<op::Slice>(node, lower, upper));
+    }
+    return std::make_shared<op::Concat>(gates, axis);
+}
+
+static bool fuse_lstm_sequence(std::vector<LSTMCell>& cells)
+{
+    std::sort(cells.begin(), cells.end(), [](const LSTMCell& a, const LSTMCell& b) {
+        return a.x_w_row < b.x_w_row;
+    });
+
+    auto x_w = cells.front().x_w;
+    const size_t batch = cells.front().h->get_shape()[0];
+    const size_t hidden_size = cells.front().h->get_shape()[1];
+    const size_t seq_length = cells.size();
+    if (x_w->get_shape()[0] != seq_length * batch)
+    {
+        NGRAPH_DEBUG << "Not every time step of " << x_w->get_name() << " is an LSTM cell";
+        return false;
+    }
+
+    // The cells have to be chained in the order of their rows of the input projection, and
+    // share their weights
+    std::unordered_set<Node*> fused;
+    for (size_t t = 0; t < seq_length; t++)
+    {
+        const LSTMCell& cell = cells[t];
+        if (cell.x_w_row != t * batch || cell.r_t != cells.front().r_t ||
+            cell.bias != cells.front().bias ||
+            (t > 0 && (cell.h_prev != cells[t - 1].h || cell.c_prev != cells[t - 1].c)))
+        {
+            NGRAPH_DEBUG << "LSTM cells of " << x_w->get_name() << " do not form a sequence";
+            return false;
+        }
+        fused.insert(cell.h.get());
+        fused.insert(cell.c.get());
+        for (auto& node : cell.nodes)
+        {
+            fused.insert(node.get());
+        }
+    }
+
+    // The Rnn node only produces the hidden states and the last cell state
+    for (size_t t = 0; t < seq_length; t++)
+    {
+        NodeVector internal = cells[t].nodes;
+        if (t + 1 < seq_length)
+        {
+            internal.push_back(cells[t].c);
+        }
+        for (auto& node : internal)
+        {
+            for (auto& user : node->get_users())
+            {
+                if (fused.count(user.get()) == 0)
+                {
+                    NGRAPH_DEBUG << node->get_name() << " of an LSTM cell is used by "
+                                 << user->get_name();
+                    return false;
+                }
+            }
+        }
+    }
+
+    auto src_iter = std::make_shared<op::Concat>(
+        NodeVector{cells.front().h_prev, cells.front().c_prev}, 0);
+    auto rnn = std::make_shared<op::Rnn>(x_w->get_argument(0),
+                                         src_iter,
+                                         reorder_gates(x_w->get_argument(1), hidden_size),
+                                         reorder_gates(cells.front().r_t, hidden_size),
+                                         reorder_gates(cells.front().bias, hidden_size),
+                                         seq_length,
+                                         4,
+                                         seq_length,
+                                         2,
+                                         1,
+                                         1,
+                                         runtime::cpu::rnn_utils::rnntype::vanilla_lstm);
+    auto rnn_ht = std::make_shared<op::GetOutputElement>(rnn, 0);
+    auto rnn_ht_ct = std::make_shared<op::GetOutputElement>(rnn, 1);
+
+    for (size_t t = 0; t < seq_length; t++)
+    {
+        ngraph::replace_node(cells[t].h,
+                             std::make_shared<op::Slice>(rnn_ht,
+                                                         Coordinate{t * batch, 0},
+                                                         Coordinate{(t + 1) * batch, hidden_size}));
+    }
+    ngraph::replace_node(
+        cells.back().c,
+        std::make_shared<op::Slice>(
+            rnn_ht_ct, Coordinate{batch, 0}, Coordinate{2 * batch, hidden_size}));
+    return true;
+}
+
+bool runtime::cpu::pass::LSTMSequenceFusion::run_on_function(std::shared_ptr<Function> function)
+{
+    // Cells grouped by their input projection, in the order the projections are found
+    std::vector<std::vector<LSTMCell>> sequences;
+    std::unordered_map<Node*, size_t> sequence_index;
+    for (auto& node : function->get_ordered_ops())
+    {
+        LSTMCell cell;
+        if (!match_lstm_cell(node, cell))
+        {
+            continue;
+        }
+        auto it = sequence_index.find(cell.x_w.get());
+        if (it == sequence_index.end())
+        {
+            it = sequence_index.emplace(cell.x_w.get(), sequences.size()).first;
+            sequences.emplace_back();
+        }
+        sequences[it->second].push_back(cell);
+    }
+
+    bool replaced = false;
+    for (auto& cells : sequences)
+    {
+        replaced |= fuse_lstm_sequence(cells);
+    }
+    return replaced;
+}
@@ -0,0 +1,44 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace pass
+            {
+                // Replaces an unrolled forward LSTM whose input projection is one Dot over all
+                // the time steps, as the ONNX importer builds it, with a single Rnn node. Each
+                // cell is matched by walking back from its hidden state once, so this does not
+                // go through the recurrent pattern matchers of RNNFusion. Sequences with other
+                // activations, clipping, peepholes or coupled gates stay unrolled.
+                class CPU_BACKEND_API LSTMSequenceFusion : public ngraph::pass::FunctionPass
+                {
+                public:
+                    virtual bool
+                        run_on_function(std::shared_ptr<ngraph::Function> function) override;
+                };
+            }
+        }
+    }
+}
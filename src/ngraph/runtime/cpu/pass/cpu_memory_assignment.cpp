@@ -645,8 +645,9 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
 
     // memory assignment using liveness analysis result
 
-    // memory manager for non-cacheable ops, memory allocation will be freed when not longer in use
-    ngraph::pass::MemoryManager mm(m_alignment, m_disable_memory_sharing);
+    // offline packer for non-cacheable ops, buffers are placed once all lifetimes are known
+    ngraph::pass::MemoryPacker packer(m_alignment);
+    unordered_map<descriptor::Tensor*, size_t> packer_buffer_ids;
     // memory manager for cacheable ops, memory allocation will never be freed
     ngraph::pass::MemoryManager mm_caching(m_alignment, true);
 
@@ -676,14 +677,20 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
         }
     }
 
+    // bytes that destructive in-place ops did not need to allocate, and the part of them
+    // saved by element type conversions writing over their inputs
+    size_t in_place_bytes = 0;
+    size_t in_place_conversion_bytes = 0;
+
+    size_t step = 0;
     for (shared_ptr<Node> node : function->get_ordered_ops())
     {
+        step++;
         if (node->is_parameter() || node->is_constant() || node->is_output())
         {
             continue;
         }
         // handle destructive oi pair
-        unordered_set<descriptor::Tensor*> no_free;
         unordered_set<descriptor::Tensor*> no_new;
 
         if (node->is_op())
@@ -757,7 +764,7 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
                         auto output_buffer_it = m_bufferID_to_tensorSets.find(output_bufferID);
                         NGRAPH_ASSERT(output_buffer_it != m_bufferID_to_tensorSets.end());
                         auto output_set = output_buffer_it->second.second;
-                        size_t output_size = input_tensor->size();
+                        size_t output_size = output_tensor->size();
                         // get the largest tensor size, which is the size of memory buffer for the set
                         for (auto e : output_set)
                         {
@@ -774,17 +781,35 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
                                         "destructive oi allowed:";
                         NGRAPH_DEBUG << "input_tensor is " << input_tensor->get_name();
                         NGRAPH_DEBUG << "output_tensor is " << output_tensor->get_name();
-                        no_free.insert(input_tensor);
                         no_new.insert(output_tensor);
+                        in_place_bytes += output_size;
+                        if (node->description() == "Convert" ||
+                            node->description() == "Quantize" ||
+                            node->description() == "Dequantize")
+                        {
+                            in_place_conversion_bytes += output_size;
+                        }
 
                         // set the tensor offset for tensors in the set containing the output tensor to the starting offset
                         // of the set of input tensor.
                         // do not combine those two sets.
                         // change the label of output tensor set to that of input tensor set
                         output_buffer_it->second.first = input_buffer_it->second.first;
+                        auto packer_buffer = packer_buffer_ids.find(input_tensor);
                         for (auto& ele_t : output_set)
                         {
-                            ele_t->set_pool_offset(offset);
+                            if (packer_buffer != packer_buffer_ids.end())
+                            {
+                                packer_buffer_ids[ele_t] = packer_buffer->second;
+                            }
+                            else
+                            {
+                                ele_t->set_pool_offset(offset);
+                            }
+                        }
+                        if (packer_buffer != packer_buffer_ids.end())
+                        {
+                            packer.share_buffer(packer_buffer->second, output_size);
                         }
                     }
                 }
@@ -813,15 +838,21 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
             if (m_tensor_caching.count(tensor) != 0)
             {
                 offset = mm_caching.allocate(size);
+                tensor->set_pool_offset(offset);
+                for (auto& e : tensor_set)
+                {
+                    e->set_pool_offset(offset);
+                }
             }
             else
             {
-                offset = mm.allocate(size);
-            }
-            tensor->set_pool_offset(offset);
-            for (auto& e : tensor_set)
-            {
-                e->set_pool_offset(offset);
+                // offsets are assigned once the packer has seen every lifetime
+                auto id = packer.add_buffer(size, step);
+                packer_buffer_ids[tensor] = id;
+                for (auto& e : tensor_set)
+                {
+                    packer_buffer_ids[e] = id;
+                }
             }
         }
 
@@ -830,19 +861,27 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
         {
             for (descriptor::Tensor* tensor : node->liveness_free_list)
             {
-                if (no_free.find(tensor) != no_free.end())
-                {
-                    continue;
-                }
+                // an input reused in place hands its buffer over to the output, which keeps
+                // the packer buffer live through its own last use
                 if (m_tensor_caching.empty() ||
                     (!m_tensor_caching.empty() && m_tensor_caching.count(tensor) == 0))
                 {
-                    mm.free(tensor->get_pool_offset());
+                    auto packer_buffer = packer_buffer_ids.find(tensor);
+                    if (packer_buffer != packer_buffer_ids.end())
+                    {
+                        packer.release_buffer(packer_buffer->second, step);
+                    }
                 }
             }
         }
     }
 
+    packer.pack();
+    for (auto& tensor_id : packer_buffer_ids)
+    {
+        tensor_id.first->set_pool_offset(packer.get_offset(tensor_id.second));
+    }
+
     // update offsets in concat and slice tensors set.
     // In place concatenation optimization
     process_in_place_concat(ops);
@@ -851,7 +890,7 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
     process_in_place_slice(ops);
 
     //update the offset for intermediate tensors in tensor_caching
-    auto start = mm.max_allocated();
+    auto start = packer.max_allocated();
     for (auto item : m_tensor_caching)
     {
         auto bufferID = get_bufferID(item);
@@ -865,13 +904,17 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
         }
     }
 
-    NGRAPH_DEBUG << "cpu_memory_assignemnt: max allocated for mm is " << mm.max_allocated();
+    NGRAPH_DEBUG << "cpu_memory_assignemnt: max allocated for packer is "
+                 << packer.max_allocated() << ", lower bound " << packer.lower_bound();
     NGRAPH_DEBUG << "cpu_memory_assignment: max allocated for mm_caching is "
                  << mm_caching.max_allocated();
     NGRAPH_DEBUG << "cpu_memory_assignment: max allocated in total is "
-                 << mm.max_allocated() + mm_caching.max_allocated();
+                 << packer.max_allocated() + mm_caching.max_allocated();
+    NGRAPH_DEBUG << "cpu_memory_assignment: destructive in place ops reused " << in_place_bytes
+                 << " bytes, " << in_place_conversion_bytes
+                 << " of them for element type conversions";
 
-    function->set_temporary_pool_size(mm.max_allocated() + mm_caching.max_allocated());
+    function->set_temporary_pool_size(packer.max_allocated() + mm_caching.max_allocated());
 
     return false;
 }
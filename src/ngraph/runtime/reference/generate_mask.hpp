@@ -16,8 +16,10 @@
 
 #pragma once
 
-#include <random>
+#include <algorithm>
+#include <cstdint>
 
+#include "ngraph/state/philox.hpp"
 #include "ngraph/state/rng_state.hpp"
 
 namespace ngraph
@@ -26,16 +28,45 @@ namespace ngraph
     {
         namespace reference
         {
+            /// \brief Writes elements [begin, end) of a mask drawn from Philox stream `stream`.
+            ///
+            /// Element i is 1 when word i % 4 of block i / 4 is below `threshold`. The result
+            /// does not depend on how a mask is split into ranges.
             template <typename T>
-            void generate_mask(T* out, size_t count, ngraph::RNGState* rng_state, bool training)
+            void generate_mask(T* out,
+                               size_t begin,
+                               size_t end,
+                               unsigned int seed,
+                               uint64_t stream,
+                               uint64_t threshold,
+                               bool training)
             {
-                auto& gen = rng_state->get_generator();
-                auto& bd = rng_state->get_distribution();
-
-                for (size_t i = 0; i < count; i++)
+                if (!training)
                 {
-                    out[i] = training ? static_cast<T>(bd(gen)) : static_cast<T>(1);
+                    std::fill(out + begin, out + end, static_cast<T>(1));
+                    return;
                 }
+                size_t i = begin;
+                while (i < end)
+                {
+                    auto words = Philox::generate(i / 4, stream, seed);
+                    for (size_t lane = i % 4; lane < 4 && i < end; lane++, i++)
+                    {
+                        out[i] = static_cast<T>(words[lane] < threshold);
+                    }
+                }
+            }
+
+            template <typename T>
+            void generate_mask(T* out, size_t count, ngraph::RNGState* rng_state, bool training)
+            {
+                generate_mask(out,
+                              0,
+                              count,
+                              rng_state->get_seed(),
+                              rng_state->next_stream(),
+                              rng_state->get_threshold(),
+                              training);
             }
         }
     }
@@ -14,6 +14,8 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+
 #include "ngraph/runtime/tensor.hpp"
 #include "ngraph/assertion.hpp"
 #include "ngraph/descriptor/layout/tensor_layout.hpp"
@@ -72,6 +74,37 @@ bool runtime::Tensor::get_stale() const
 void runtime::Tensor::set_stale(bool val)
 {
     m_stale = val;
+    m_stale_rows = val ? make_pair(size_t(0), numeric_limits<size_t>::max())
+                       : make_pair(size_t(0), size_t(0));
+}
+
+void runtime::Tensor::set_stale_rows(size_t begin, size_t end)
+{
+    if (begin > end)
+    {
+        throw invalid_argument("runtime::Tensor::set_stale_rows begin must not exceed end");
+    }
+    if (!m_stale || m_stale_rows.first == m_stale_rows.second)
+    {
+        m_stale_rows = make_pair(begin, end);
+    }
+    else
+    {
+        m_stale_rows =
+            make_pair(min(m_stale_rows.first, begin), max(m_stale_rows.second, end));
+    }
+    m_stale = true;
+}
+
+pair<size_t, size_t> runtime::Tensor::get_stale_rows() const
+{
+    if (!m_stale)
+    {
+        return make_pair(size_t(0), size_t(0));
+    }
+    const Shape& shape = get_shape();
+    size_t rows = shape.empty() ? 1 : shape[0];
+    return make_pair(min(m_stale_rows.first, rows), min(m_stale_rows.second, rows));
 }
 
 void runtime::Tensor::copy_from(const ngraph::runtime::Tensor& source)
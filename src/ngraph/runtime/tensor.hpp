@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "ngraph/descriptor/layout/tensor_layout.hpp"
@@ -42,6 +44,7 @@ namespace ngraph
                    const Backend* parent)
                 : m_descriptor(descriptor)
                 , m_stale(true)
+                , m_stale_rows(0, std::numeric_limits<size_t>::max())
                 , m_parent(parent)
             {
             }
@@ -91,6 +94,18 @@ namespace ngraph
             /// changed.
             void set_stale(bool val);
 
+            /// \brief Mark rows [begin, end) along the leading axis as changed. The tensor
+            /// becomes stale and backends that support incremental execution may recompute
+            /// only the affected rows of row-wise ops. Repeated calls accumulate the
+            /// smallest range covering all marked rows.
+            /// \param begin First changed row
+            /// \param end One past the last changed row
+            void set_stale_rows(size_t begin, size_t end);
+
+            /// \brief Get the range of changed rows along the leading axis.
+            /// \return Half-open row range, empty if the tensor is not stale
+            std::pair<size_t, size_t> get_stale_rows() const;
+
             /// \brief Write bytes directly into the tensor
             /// \param p Pointer to source of data
             /// \param offset Offset into tensor storage to begin writing. Must be element-aligned.
@@ -111,6 +126,7 @@ namespace ngraph
         protected:
             std::shared_ptr<ngraph::descriptor::Tensor> m_descriptor;
             bool m_stale;
+            std::pair<size_t, size_t> m_stale_rows;
             const Backend* m_parent;
         };
 
@@ -14,9 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <sstream>
 
+#include "ngraph/constant_store.hpp"
 #include "ngraph/cpio.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
@@ -141,20 +144,34 @@ static OP_TYPEID get_typeid(const string& s)
 }
 
 template <typename T>
-T get_or_default(nlohmann::json& j, const std::string& key, const T& default_value)
+T get_or_default(const nlohmann::json& j, const std::string& key, const T& default_value)
 {
     return j.count(key) != 0 ? j.at(key).get<T>() : default_value;
 }
 
-static std::shared_ptr<ngraph::Function>
-    read_function(const json&,
-                  std::unordered_map<std::string, std::shared_ptr<Function>>&,
-                  function<const_data_callback_t>);
+using node_map_t = unordered_map<string, shared_ptr<Node>>;
+using function_map_t = unordered_map<string, shared_ptr<Function>>;
+
+static void read_node(json node_js,
+                      node_map_t& node_map,
+                      function_map_t& function_map,
+                      function<const_data_callback_t> const_data_callback);
+static shared_ptr<Function> make_function(const json& func_js,
+                                          const node_map_t& node_map,
+                                          function_map_t& function_map);
 
-static json write(const ngraph::Function&, bool binary_constant_data);
 static json write(const ngraph::Node&, bool binary_constant_data);
-static string
-    serialize(shared_ptr<ngraph::Function> func, size_t indent, bool binary_constant_data);
+static void write_functions(ostream& out,
+                            shared_ptr<ngraph::Function> func,
+                            size_t indent,
+                            bool binary_constant_data);
+
+// The first file of a binary graph cpio archive starts with this tag, followed by the
+// encoding version. The rest of the file is a sequence of length prefixed CBOR records: for
+// each function a header with its name, parameters, results and op count, followed by one
+// record per op in topological order. Functions are written callees first.
+static const char s_binary_graph_magic[] = {'N', 'G', 'B', 'G'};
+static const uint32_t s_binary_graph_version = 1;
 
 static json write_dimension(Dimension d)
 {
@@ -261,12 +278,8 @@ void ngraph::serialize(const string& path, shared_ptr<ngraph::Function> func, si
     serialize(out, func, indent);
 }
 
-void ngraph::serialize(ostream& out, shared_ptr<ngraph::Function> func, size_t indent)
+static void write_constant_data(cpio::Writer& writer, shared_ptr<ngraph::Function> func)
 {
-    string j = ::serialize(func, indent, true);
-    cpio::Writer writer(out);
-    writer.write(func->get_name(), j.c_str(), static_cast<uint32_t>(j.size()));
-
     traverse_functions(func, [&](shared_ptr<ngraph::Function> f) {
         traverse_nodes(const_cast<Function*>(f.get()),
                        [&](shared_ptr<Node> node) {
@@ -282,33 +295,282 @@ void ngraph::serialize(ostream& out, shared_ptr<ngraph::Function> func, size_t i
     });
 }
 
-static string serialize(shared_ptr<ngraph::Function> func, size_t indent, bool binary_constant_data)
+void ngraph::serialize(ostream& out, shared_ptr<ngraph::Function> func, size_t indent)
 {
-    json j;
-    vector<json> functions;
-    traverse_functions(func, [&](shared_ptr<ngraph::Function> f) {
-        functions.push_back(write(*f, binary_constant_data));
-    });
+    cpio::Writer writer(out);
+    writer.write(func->get_name(),
+                 [&](ostream& model) { write_functions(model, func, indent, true); });
+    write_constant_data(writer, func);
+}
+
+static void write_binary_record(ostream& out, const json& j)
+{
+    vector<uint8_t> data = json::to_cbor(j);
+    uint32_t size = static_cast<uint32_t>(data.size());
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+static void write_binary_functions(ostream& ss, shared_ptr<ngraph::Function> func)
+{
+    vector<shared_ptr<Function>> functions;
+    traverse_functions(func, [&](shared_ptr<ngraph::Function> f) { functions.push_back(f); });
+
+    ss.write(s_binary_graph_magic, sizeof(s_binary_graph_magic));
+    ss.write(reinterpret_cast<const char*>(&s_binary_graph_version),
+             sizeof(s_binary_graph_version));
     for (auto it = functions.rbegin(); it != functions.rend(); it++)
     {
-        j.push_back(*it);
+        const Function& f = **it;
+        list<shared_ptr<Node>> ops = f.get_ordered_ops(true);
+        json header;
+        header["name"] = f.get_name();
+        json parameters = json::array();
+        for (auto param : f.get_parameters())
+        {
+            parameters.push_back(param->get_name());
+        }
+        header["parameters"] = parameters;
+        json results = json::array();
+        for (size_t i = 0; i < f.get_output_size(); ++i)
+        {
+            results.push_back(f.get_output_op(i)->get_name());
+        }
+        header["result"] = results;
+        header["op_count"] = ops.size();
+        write_binary_record(ss, header);
+        for (shared_ptr<Node> node : ops)
+        {
+            write_binary_record(ss, write(*node, true));
+        }
     }
+}
+
+void ngraph::serialize_binary(ostream& out, shared_ptr<ngraph::Function> func)
+{
+    cpio::Writer writer(out);
+    writer.write(func->get_name(), [&](ostream& model) { write_binary_functions(model, func); });
+    write_constant_data(writer, func);
+}
+
+// Writes the functions called by func followed by func itself as a json array. Each node is
+// converted to json and written out on its own so that a json document for the whole graph
+// is never held in memory. With indent 0 the output matches json::dump() of the equivalent
+// document.
+static void write_functions(ostream& out,
+                            shared_ptr<ngraph::Function> func,
+                            size_t indent,
+                            bool binary_constant_data)
+{
+    vector<shared_ptr<Function>> functions;
+    traverse_functions(func, [&](shared_ptr<ngraph::Function> f) { functions.push_back(f); });
+
+    const string newline = indent == 0 ? "" : "\n";
+    const string separator = indent == 0 ? ":" : ": ";
+    auto pad = [&](size_t level) { return string(level * indent, ' '); };
+    auto dump = [&](const json& j, size_t level) {
+        if (indent == 0)
+        {
+            return j.dump();
+        }
+        string rc;
+        for (char c : j.dump(static_cast<int>(indent)))
+        {
+            rc.push_back(c);
+            if (c == '\n')
+            {
+                rc.append(pad(level));
+            }
+        }
+        return rc;
+    };
 
-    string rc;
-    if (indent == 0)
+    out << "[";
+    for (auto it = functions.rbegin(); it != functions.rend(); it++)
     {
-        rc = j.dump();
+        const Function& f = **it;
+        if (it != functions.rbegin())
+        {
+            out << ",";
+        }
+        out << newline << pad(1) << "{" << newline;
+        out << pad(2) << "\"name\"" << separator << json(f.get_name()).dump() << ","
+            << newline;
+
+        out << pad(2) << "\"ops\"" << separator << "[";
+        bool first = true;
+        for (shared_ptr<Node> node : f.get_ordered_ops(true))
+        {
+            out << (first ? "" : ",") << newline << pad(3)
+                << dump(write(*node, binary_constant_data), 3);
+            first = false;
+        }
+        out << (first ? "" : newline + pad(2)) << "]," << newline;
+
+        json parameters = json::array();
+        for (auto param : f.get_parameters())
+        {
+            parameters.push_back(param->get_name());
+        }
+        out << pad(2) << "\"parameters\"" << separator << dump(parameters, 2) << "," << newline;
+
+        // TODO Functions can return multiple results
+        json results = json::array();
+        for (size_t i = 0; i < f.get_output_size(); ++i)
+        {
+            results.push_back(f.get_output_op(i)->get_name());
+        }
+        out << pad(2) << "\"result\"" << separator << dump(results, 2) << newline;
+        out << pad(1) << "}";
     }
-    else
+    out << (functions.empty() ? "" : newline) << "]";
+}
+
+std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t indent)
+{
+    stringstream ss;
+    write_functions(ss, func, indent, false);
+    return ss.str();
+}
+
+// Builds nodes as soon as the parser has read each op, discarding the op's json so that the
+// document for the whole graph is never held in memory.
+template <typename T>
+static shared_ptr<ngraph::Function>
+    read_functions(T&& input, function<const_data_callback_t> const_data_callback)
+{
+    shared_ptr<Function> rc;
+    function_map_t function_map;
+    node_map_t node_map;
+    bool in_ops = false;
+    json::parser_callback_t callback = [&](int depth, json::parse_event_t event, json& parsed) {
+        bool keep = true;
+        if (event == json::parse_event_t::key && depth == 2)
+        {
+            in_ops = (parsed == "ops");
+        }
+        else if (event == json::parse_event_t::object_end && depth == 3 && in_ops)
+        {
+            read_node(move(parsed), node_map, function_map, const_data_callback);
+            keep = false;
+        }
+        else if (event == json::parse_event_t::object_end && depth == 1)
+        {
+            rc = make_function(parsed, node_map, function_map);
+            node_map.clear();
+            keep = false;
+        }
+        return keep;
+    };
+    json::parse(std::forward<T>(input), callback);
+    return rc;
+}
+
+static uint32_t read_binary_uint32(istream& in)
+{
+    uint32_t value;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    if (in.gcount() != sizeof(value))
+    {
+        throw ngraph_error("Binary graph is truncated");
+    }
+    return value;
+}
+
+static json read_binary_record(istream& in)
+{
+    uint32_t size = read_binary_uint32(in);
+    vector<uint8_t> data(size);
+    in.read(reinterpret_cast<char*>(data.data()), size);
+    if (static_cast<size_t>(in.gcount()) != size)
+    {
+        throw ngraph_error("Binary graph is truncated");
+    }
+    return json::from_cbor(data);
+}
+
+// Reads a binary graph whose magic tag has already been consumed from in
+static shared_ptr<ngraph::Function>
+    read_binary_functions(istream& in, function<const_data_callback_t> const_data_callback)
+{
+    uint32_t version = read_binary_uint32(in);
+    if (version != s_binary_graph_version)
+    {
+        throw ngraph_error("Unsupported binary graph version " + to_string(version));
+    }
+    shared_ptr<Function> rc;
+    function_map_t function_map;
+    while (in.peek() != istream::traits_type::eof())
     {
-        rc = j.dump(static_cast<int>(indent));
+        json header = read_binary_record(in);
+        node_map_t node_map;
+        size_t op_count = header.at("op_count").get<size_t>();
+        for (size_t i = 0; i < op_count; i++)
+        {
+            json node_js = read_binary_record(in);
+            read_node(move(node_js), node_map, function_map, const_data_callback);
+        }
+        rc = make_function(header, node_map, function_map);
     }
     return rc;
 }
 
-std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t indent)
+// Reads a cpio archive written by serialize or serialize_binary. If path is not empty it
+// names the file being read, and constant data is left in the file until first used.
+static shared_ptr<ngraph::Function> deserialize_cpio(istream& in, const string& path)
 {
-    return ::serialize(func, indent, false);
+    shared_ptr<Function> rc;
+    cpio::Reader reader(in);
+    vector<cpio::FileInfo> file_info = reader.get_file_info();
+    if (file_info.size() > 0)
+    {
+        // The first file is the model. It is parsed as it is read, so neither the file nor
+        // a json document for it is ever held in memory in full.
+
+        unordered_map<string, const cpio::FileInfo*> const_file_info;
+        for (const cpio::FileInfo& info : file_info)
+        {
+            const_file_info.insert({info.get_name(), &info});
+        }
+        auto const_data_callback =
+            [&](const string& const_name, const element::Type& et, const Shape& shape) {
+                shared_ptr<Node> const_node;
+                auto it = const_file_info.find(const_name);
+                if (it != const_file_info.end())
+                {
+                    const cpio::FileInfo& info = *it->second;
+                    if (!path.empty())
+                    {
+                        auto buffer = ConstantStore::get().from_file(
+                            path, info.get_offset(), info.get_size());
+                        const_node = make_shared<op::Constant>(et, shape, buffer);
+                    }
+                    else
+                    {
+                        void* const_data = ngraph_malloc(info.get_size());
+                        reader.read(info, const_data, info.get_size());
+                        const_node = make_shared<op::Constant>(et, shape, const_data);
+                        ngraph_free(const_data);
+                    }
+                }
+                return const_node;
+            };
+
+        unique_ptr<istream> model = reader.open_stream(file_info[0]);
+        char magic[sizeof(s_binary_graph_magic)];
+        model->read(magic, sizeof(magic));
+        if (model->gcount() == sizeof(magic) &&
+            memcmp(magic, s_binary_graph_magic, sizeof(magic)) == 0)
+        {
+            rc = read_binary_functions(*model, const_data_callback);
+        }
+        else
+        {
+            model = reader.open_stream(file_info[0]);
+            rc = read_functions(*model, const_data_callback);
+        }
+    }
+    return rc;
 }
 
 shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
@@ -316,48 +578,12 @@ shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
     shared_ptr<Function> rc;
     if (cpio::is_cpio(in))
     {
-        cpio::Reader reader(in);
-        vector<cpio::FileInfo> file_info = reader.get_file_info();
-        if (file_info.size() > 0)
-        {
-            // The first file is the model
-            uint32_t size = static_cast<uint32_t>(file_info[0].get_size());
-            char* data = new char[size];
-            reader.read(file_info[0].get_name(), data, size);
-            string jstr(data, size);
-            delete[] data;
-            json js = json::parse(jstr);
-            unordered_map<string, shared_ptr<Function>> function_map;
-            for (json func : js)
-            {
-                shared_ptr<Function> f = read_function(
-                    func,
-                    function_map,
-                    [&](const string& const_name, const element::Type& et, const Shape& shape) {
-                        shared_ptr<Node> const_node;
-                        for (const cpio::FileInfo& info : file_info)
-                        {
-                            if (info.get_name() == const_name)
-                            {
-                                void* const_data = ngraph_malloc(info.get_size());
-                                reader.read(const_name, const_data, info.get_size());
-                                const_node = make_shared<op::Constant>(et, shape, const_data);
-                                ngraph_free(const_data);
-                                break;
-                            }
-                        }
-                        return const_node;
-                    });
-                rc = f;
-            }
-        }
+        rc = deserialize_cpio(in, "");
     }
     else
     {
         // json file?
-        std::stringstream ss;
-        ss << in.rdbuf();
-        rc = deserialize(ss.str());
+        rc = read_functions(in, nullptr);
     }
     return rc;
 }
@@ -373,854 +599,836 @@ shared_ptr<ngraph::Function> ngraph::deserialize(const string& s)
     }
     else
     {
-        json js = json::parse(s);
-        unordered_map<string, shared_ptr<Function>> function_map;
-        for (json func : js)
-        {
-            shared_ptr<Function> f = read_function(func, function_map, nullptr);
-            rc = f;
-        }
+        rc = read_functions(s, nullptr);
     }
 
     return rc;
 }
 
-static json write(const Function& f, bool binary_constant_data)
+shared_ptr<ngraph::Function> ngraph::deserialize(const string& path, bool lazy_constants)
 {
-    json function;
-    function["name"] = f.get_name();
-
-    vector<string> parameter_list;
-    for (auto param : f.get_parameters())
-    {
-        parameter_list.push_back(param->get_name());
-    }
-    function["parameters"] = parameter_list;
-
-    // TODO Functions can return multiple results
-    for (size_t i = 0; i < f.get_output_size(); ++i)
+    shared_ptr<Function> rc;
+    ifstream in(path, ios_base::binary | ios_base::in);
+    if (lazy_constants && cpio::is_cpio(in))
     {
-        function["result"].push_back(f.get_output_op(i)->get_name());
+        rc = deserialize_cpio(in, path);
     }
-
-    Function* pf = const_cast<Function*>(&f);
-    json nodes;
-    for (shared_ptr<Node> node : pf->get_ordered_ops(true))
+    else
     {
-        nodes.push_back(write(*node, binary_constant_data));
+        rc = deserialize(in);
     }
-
-    function["ops"] = nodes;
-    return function;
+    return rc;
 }
 
-static shared_ptr<ngraph::Function>
-    read_function(const json& func_js,
-                  unordered_map<string, shared_ptr<Function>>& function_map,
-                  function<const_data_callback_t> const_data_callback)
+static void read_node(json node_js,
+                      node_map_t& node_map,
+                      function_map_t& function_map,
+                      function<const_data_callback_t> const_data_callback)
 {
-    shared_ptr<ngraph::Function> rc;
-
-    string func_name = func_js.at("name").get<string>();
-    vector<string> func_parameters = func_js.at("parameters").get<vector<string>>();
-    vector<string> func_result = func_js.at("result").get<vector<string>>();
-    unordered_map<string, shared_ptr<Node>> node_map;
-    for (json node_js : func_js.at("ops"))
+    try
     {
-        try
+        string node_name = node_js.at("name").get<string>();
+        string friendly_name;
+        auto it = node_js.find("friendly_name");
+        if (it != node_js.end())
         {
-            string node_name = node_js.at("name").get<string>();
-            string friendly_name;
-            auto it = node_js.find("friendly_name");
-            if (it != node_js.end())
-            {
-                friendly_name = it->get<string>();
-            }
-            string node_op = node_js.at("op").get<string>();
-            vector<string> node_inputs = node_js.at("inputs").get<vector<string>>();
-            vector<string> control_deps_inputs =
-                get_or_default<vector<string>>(node_js, "control_deps", vector<string>{});
-            vector<string> node_outputs = node_js.at("outputs").get<vector<string>>();
-            shared_ptr<Node> node;
-            vector<shared_ptr<Node>> args;
-            vector<shared_ptr<Node>> control_deps;
-            for (const string& name : node_inputs)
-            {
-                args.push_back(node_map.at(name));
-            }
+            friendly_name = it->get<string>();
+        }
+        string node_op = node_js.at("op").get<string>();
+        vector<string> node_inputs = node_js.at("inputs").get<vector<string>>();
+        vector<string> control_deps_inputs =
+            get_or_default<vector<string>>(node_js, "control_deps", vector<string>{});
+        vector<string> node_outputs = node_js.at("outputs").get<vector<string>>();
+        shared_ptr<Node> node;
+        vector<shared_ptr<Node>> args;
+        vector<shared_ptr<Node>> control_deps;
+        for (const string& name : node_inputs)
+        {
+            args.push_back(node_map.at(name));
+        }
 #pragma GCC diagnostic push
 #pragma GCC diagnostic error "-Wswitch"
 #pragma GCC diagnostic error "-Wswitch-enum"
-            // #pragma GCC diagnostic error "-Wimplicit-fallthrough"
-            switch (get_typeid(node_op))
-            {
-            case OP_TYPEID::Abs:
-            {
-                node = make_shared<op::Abs>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Acos:
-            {
-                node = make_shared<op::Acos>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Add:
+        // #pragma GCC diagnostic error "-Wimplicit-fallthrough"
+        switch (get_typeid(node_op))
+        {
+        case OP_TYPEID::Abs:
+        {
+            node = make_shared<op::Abs>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Acos:
+        {
+            node = make_shared<op::Acos>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Add:
+        {
+            node = make_shared<op::Add>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::All:
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::All>(args[0], reduction_axes);
+            break;
+        }
+        case OP_TYPEID::AllReduce:
+        {
+            node = make_shared<op::AllReduce>(args[0]);
+            break;
+        }
+        case OP_TYPEID::And:
+        {
+            node = make_shared<op::And>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Any:
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Any>(args[0], reduction_axes);
+            break;
+        }
+        case OP_TYPEID::ArgMin:
+        {
+            auto axis = node_js.at("axis").get<size_t>();
+            auto target_type = read_element_type(node_js.at("index_element_type"));
+            node = make_shared<op::ArgMin>(args[0], axis, target_type);
+            break;
+        }
+        case OP_TYPEID::ArgMax:
+        {
+            auto axis = node_js.at("axis").get<size_t>();
+            auto target_type = read_element_type(node_js.at("index_element_type"));
+            node = make_shared<op::ArgMax>(args[0], axis, target_type);
+            break;
+        }
+        case OP_TYPEID::Asin:
+        {
+            node = make_shared<op::Asin>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Atan:
+        {
+            node = make_shared<op::Atan>(args[0]);
+            break;
+        }
+        case OP_TYPEID::AvgPool:
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            auto include_padding_in_avg_computation =
+                node_js.at("include_padding_in_avg_computation").get<bool>();
+            node = make_shared<op::AvgPool>(args[0],
+                                            window_shape,
+                                            window_movement_strides,
+                                            padding_below,
+                                            padding_above,
+                                            include_padding_in_avg_computation);
+            break;
+        }
+        case OP_TYPEID::AvgPoolBackprop:
+        {
+            auto forward_arg_shape = node_js.at("forward_arg_shape").get<vector<size_t>>();
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            auto include_padding_in_avg_computation =
+                get_or_default<bool>(node_js, "include_padding_in_avg_computation", false);
+            node = make_shared<op::AvgPoolBackprop>(forward_arg_shape,
+                                                    args[0],
+                                                    window_shape,
+                                                    window_movement_strides,
+                                                    padding_below,
+                                                    padding_above,
+                                                    include_padding_in_avg_computation);
+            break;
+        }
+        case OP_TYPEID::BatchNormTraining:
+        {
+            auto epsilon = node_js.at("eps").get<double>();
+            // Odd order for back-compatibility
+            node = make_shared<op::BatchNormTraining>(args[2], args[0], args[1], epsilon);
+            break;
+        }
+        case OP_TYPEID::BatchNormInference:
+        {
+            auto epsilon = node_js.at("eps").get<double>();
+            // Odd order for back-compatibility
+            node = make_shared<op::BatchNormInference>(
+                args[2], args[0], args[1], args[3], args[4], epsilon);
+            break;
+        }
+        case OP_TYPEID::BatchNormTrainingBackprop:
+        {
+            auto epsilon = node_js.at("eps").get<double>();
+            // Odd order for back-compatibility
+            node = make_shared<op::BatchNormTrainingBackprop>(
+                args[2], args[0], args[1], args[3], args[4], args[5], epsilon);
+            break;
+        }
+        case OP_TYPEID::Broadcast:
+        {
+            auto shape = node_js.at("shape").get<vector<size_t>>();
+            auto axes = node_js.at("axes").get<set<size_t>>();
+            node = make_shared<op::Broadcast>(args[0], shape, axes);
+            break;
+        }
+        case OP_TYPEID::BroadcastLike:
+        {
+            auto initial_axes = node_js.at("initial_axes").get<set<size_t>>();
+            node = make_shared<op::BroadcastLike>(args[0], args[1], initial_axes);
+            break;
+        }
+        case OP_TYPEID::Ceiling:
+        {
+            node = make_shared<op::Ceiling>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Concat:
+        {
+            auto axis = node_js.at("axis").get<size_t>();
+            node = make_shared<op::Concat>(args, axis);
+            break;
+        }
+        case OP_TYPEID::Constant:
+        {
+            auto type_node_js =
+                node_js.count("element_type") == 0 ? node_js.at("value_type") : node_js;
+            auto element_type = read_element_type(type_node_js.at("element_type"));
+            auto shape = type_node_js.at("shape");
+            auto value_it = node_js.find("value");
+            if (value_it != node_js.end())
             {
-                node = make_shared<op::Add>(args[0], args[1]);
-                break;
+                auto value = value_it->get<vector<string>>();
+                node = make_shared<op::Constant>(element_type, shape, value);
             }
-            case OP_TYPEID::All:
+            else
             {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::All>(args[0], reduction_axes);
-                break;
+                node = const_data_callback(node_name, element_type, shape);
             }
-            case OP_TYPEID::AllReduce:
+            break;
+        }
+        case OP_TYPEID::Convert:
+        {
+            auto target_type = read_element_type(node_js.at("target_type"));
+            node = make_shared<op::Convert>(args[0], target_type);
+            break;
+        }
+        case OP_TYPEID::Convolution:
+        {
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto window_dilation_strides =
+                node_js.at("window_dilation_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<std::ptrdiff_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<std::ptrdiff_t>>();
+
+            // For backwards compatibility, we accept "image_dilation_strides" in place of
+            // "data_dilation_strides", and we also allow it to be omitted altogether.
+            auto data_dilation_strides_maybe = node_js["data_dilation_strides"];
+            if (data_dilation_strides_maybe.empty())
             {
-                node = make_shared<op::AllReduce>(args[0]);
-                break;
+                data_dilation_strides_maybe = node_js["image_dilation_strides"];
             }
-            case OP_TYPEID::And:
+
+            if (data_dilation_strides_maybe.empty())
             {
-                node = make_shared<op::And>(args[0], args[1]);
-                break;
+                node = make_shared<op::Convolution>(args[0],
+                                                    args[1],
+                                                    window_movement_strides,
+                                                    window_dilation_strides,
+                                                    padding_below,
+                                                    padding_above);
             }
-            case OP_TYPEID::Any:
+            else
             {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Any>(args[0], reduction_axes);
-                break;
+                node = make_shared<op::Convolution>(
+                    args[0],
+                    args[1],
+                    window_movement_strides,
+                    window_dilation_strides,
+                    padding_below,
+                    padding_above,
+                    data_dilation_strides_maybe.get<std::vector<size_t>>());
             }
-            case OP_TYPEID::ArgMin:
+            break;
+        }
+        case OP_TYPEID::ConvolutionBackpropData:
+        {
+            auto data_batch_shape = node_js.at("data_batch_shape").get<vector<size_t>>();
+            auto window_movement_strides_forward =
+                node_js.at("window_movement_strides_forward").get<vector<size_t>>();
+            auto window_dilation_strides_forward =
+                node_js.at("window_dilation_strides_forward").get<vector<size_t>>();
+            auto padding_below_forward =
+                node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>();
+            auto padding_above_forward =
+                node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>();
+            auto data_dilation_strides_forward =
+                node_js.at("data_dilation_strides_forward").get<vector<size_t>>();
+            node = make_shared<op::ConvolutionBackpropData>(data_batch_shape,
+                                                            args[0],
+                                                            args[1],
+                                                            window_movement_strides_forward,
+                                                            window_dilation_strides_forward,
+                                                            padding_below_forward,
+                                                            padding_above_forward,
+                                                            data_dilation_strides_forward);
+            break;
+        }
+        case OP_TYPEID::ConvolutionBackpropFilters:
+        {
+            auto filters_shape = node_js.at("filters_shape").get<vector<size_t>>();
+            auto window_movement_strides_forward =
+                node_js.at("window_movement_strides_forward").get<vector<size_t>>();
+            auto window_dilation_strides_forward =
+                node_js.at("window_dilation_strides_forward").get<vector<size_t>>();
+            auto padding_below_forward =
+                node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>();
+            auto padding_above_forward =
+                node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>();
+            auto data_dilation_strides_forward =
+                node_js.at("data_dilation_strides_forward").get<vector<size_t>>();
+            node = make_shared<op::ConvolutionBackpropFilters>(args[0],
+                                                               filters_shape,
+                                                               args[1],
+                                                               window_movement_strides_forward,
+                                                               window_dilation_strides_forward,
+                                                               padding_below_forward,
+                                                               padding_above_forward,
+                                                               data_dilation_strides_forward);
+            break;
+        }
+        case OP_TYPEID::Cos:
+        {
+            node = make_shared<op::Cos>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Cosh:
+        {
+            node = make_shared<op::Cosh>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Dequantize:
+        {
+            auto type = read_element_type(node_js.at("type"));
+            auto axes = node_js.at("axes").get<set<size_t>>();
+            node = make_shared<op::Dequantize>(args[0], args[1], args[2], type, axes);
+            break;
+        }
+        case OP_TYPEID::Divide:
+        {
+            node = make_shared<op::Divide>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Dot:
+        {
+            // For backwards compatibility, reduction_axes_count is optional.
+            auto obj = node_js["reduction_axes_count"];
+            if (obj.empty())
             {
-                auto axis = node_js.at("axis").get<size_t>();
-                auto target_type = read_element_type(node_js.at("index_element_type"));
-                node = make_shared<op::ArgMin>(args[0], axis, target_type);
-                break;
+                node = make_shared<op::Dot>(args[0], args[1]);
             }
-            case OP_TYPEID::ArgMax:
+            else
             {
-                auto axis = node_js.at("axis").get<size_t>();
-                auto target_type = read_element_type(node_js.at("index_element_type"));
-                node = make_shared<op::ArgMax>(args[0], axis, target_type);
-                break;
+                size_t reduction_axes_count = obj.get<size_t>();
+                node = make_shared<op::Dot>(args[0], args[1], reduction_axes_count);
             }
-            case OP_TYPEID::Asin:
+            break;
+        }
+        case OP_TYPEID::EmbeddingLookup:
+        {
+            node = make_shared<op::EmbeddingLookup>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Equal:
+        {
+            node = make_shared<op::Equal>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Exp:
+        {
+            node = make_shared<op::Exp>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Floor:
+        {
+            node = make_shared<op::Floor>(args[0]);
+            break;
+        }
+        case OP_TYPEID::GenerateMask:
+        {
+            auto output_shape = node_js.at("output_shape").get<vector<size_t>>();
+            auto type = read_element_type(node_js.at("type"));
+            auto seed = node_js.at("seed").get<unsigned int>();
+            auto probability = node_js.at("probability").get<double>();
+
+            node =
+                make_shared<op::GenerateMask>(args[0], output_shape, type, seed, probability);
+            break;
+        }
+        case OP_TYPEID::GetOutputElement:
+        {
+            node = make_shared<op::GetOutputElement>(args[0], node_js.at("n").get<size_t>());
+            break;
+        }
+        case OP_TYPEID::Greater:
+        {
+            node = make_shared<op::Greater>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::GreaterEq:
+        {
+            node = make_shared<op::GreaterEq>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Less:
+        {
+            node = make_shared<op::Less>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::LessEq:
+        {
+            node = make_shared<op::LessEq>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Log:
+        {
+            node = make_shared<op::Log>(args[0]);
+            break;
+        }
+        case OP_TYPEID::LRN:
+        {
+            auto alpha = node_js.at("alpha").get<double>();
+            auto beta = node_js.at("beta").get<double>();
+            auto bias = node_js.at("bias").get<double>();
+            auto nsize = node_js.at("nsize").get<size_t>();
+            node = make_shared<op::LRN>(args[0], alpha, beta, bias, nsize);
+            break;
+        }
+        case OP_TYPEID::Max:
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Max>(args[0], reduction_axes);
+            break;
+        }
+        case OP_TYPEID::MaxPool:
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            // For backwards compatibility, both (but not just one) of the padding_ fields may be
+            // omitted.
+            auto padding_below_maybe = node_js["padding_below"];
+            auto padding_above_maybe = node_js["padding_above"];
+            if (padding_below_maybe.empty() && !padding_above_maybe.empty())
             {
-                node = make_shared<op::Asin>(args[0]);
-                break;
+                throw runtime_error(
+                    "MaxPool: padding_below is absent but padding_above is present");
             }
-            case OP_TYPEID::Atan:
+            else if (!padding_below_maybe.empty() && padding_above_maybe.empty())
             {
-                node = make_shared<op::Atan>(args[0]);
-                break;
+                throw runtime_error(
+                    "MaxPool: padding_below is present but padding_above is absent");
             }
-            case OP_TYPEID::AvgPool:
+            else if (!padding_below_maybe.empty() && !padding_above_maybe.empty())
             {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                auto include_padding_in_avg_computation =
-                    node_js.at("include_padding_in_avg_computation").get<bool>();
-                node = make_shared<op::AvgPool>(args[0],
+                auto padding_below = padding_below_maybe.get<vector<size_t>>();
+                auto padding_above = padding_above_maybe.get<vector<size_t>>();
+                node = make_shared<op::MaxPool>(args[0],
                                                 window_shape,
                                                 window_movement_strides,
                                                 padding_below,
-                                                padding_above,
-                                                include_padding_in_avg_computation);
-                break;
+                                                padding_above);
             }
-            case OP_TYPEID::AvgPoolBackprop:
+            else
             {
-                auto forward_arg_shape = node_js.at("forward_arg_shape").get<vector<size_t>>();
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                auto include_padding_in_avg_computation =
-                    get_or_default<bool>(node_js, "include_padding_in_avg_computation", false);
-                node = make_shared<op::AvgPoolBackprop>(forward_arg_shape,
-                                                        args[0],
-                                                        window_shape,
-                                                        window_movement_strides,
-                                                        padding_below,
-                                                        padding_above,
-                                                        include_padding_in_avg_computation);
-                break;
-            }
-            case OP_TYPEID::BatchNormTraining:
-            {
-                auto epsilon = node_js.at("eps").get<double>();
-                // Odd order for back-compatibility
-                node = make_shared<op::BatchNormTraining>(args[2], args[0], args[1], epsilon);
-                break;
-            }
-            case OP_TYPEID::BatchNormInference:
-            {
-                auto epsilon = node_js.at("eps").get<double>();
-                // Odd order for back-compatibility
-                node = make_shared<op::BatchNormInference>(
-                    args[2], args[0], args[1], args[3], args[4], epsilon);
-                break;
-            }
-            case OP_TYPEID::BatchNormTrainingBackprop:
-            {
-                auto epsilon = node_js.at("eps").get<double>();
-                // Odd order for back-compatibility
-                node = make_shared<op::BatchNormTrainingBackprop>(
-                    args[2], args[0], args[1], args[3], args[4], args[5], epsilon);
-                break;
-            }
-            case OP_TYPEID::Broadcast:
-            {
-                auto shape = node_js.at("shape").get<vector<size_t>>();
-                auto axes = node_js.at("axes").get<set<size_t>>();
-                node = make_shared<op::Broadcast>(args[0], shape, axes);
-                break;
+                node = make_shared<op::MaxPool>(args[0], window_shape, window_movement_strides);
             }
-            case OP_TYPEID::BroadcastLike:
-            {
-                auto initial_axes = node_js.at("initial_axes").get<set<size_t>>();
-                node = make_shared<op::BroadcastLike>(args[0], args[1], initial_axes);
-                break;
-            }
-            case OP_TYPEID::Ceiling:
-            {
-                node = make_shared<op::Ceiling>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Concat:
-            {
-                auto axis = node_js.at("axis").get<size_t>();
-                node = make_shared<op::Concat>(args, axis);
-                break;
-            }
-            case OP_TYPEID::Constant:
-            {
-                auto type_node_js =
-                    node_js.count("element_type") == 0 ? node_js.at("value_type") : node_js;
-                auto element_type = read_element_type(type_node_js.at("element_type"));
-                auto shape = type_node_js.at("shape");
-                auto value_it = node_js.find("value");
-                if (value_it != node_js.end())
-                {
-                    auto value = value_it->get<vector<string>>();
-                    node = make_shared<op::Constant>(element_type, shape, value);
-                }
-                else
-                {
-                    node = const_data_callback(node_name, element_type, shape);
-                }
-                break;
-            }
-            case OP_TYPEID::Convert:
-            {
-                auto target_type = read_element_type(node_js.at("target_type"));
-                node = make_shared<op::Convert>(args[0], target_type);
-                break;
-            }
-            case OP_TYPEID::Convolution:
-            {
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto window_dilation_strides =
-                    node_js.at("window_dilation_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<std::ptrdiff_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<std::ptrdiff_t>>();
-
-                // For backwards compatibility, we accept "image_dilation_strides" in place of
-                // "data_dilation_strides", and we also allow it to be omitted altogether.
-                auto data_dilation_strides_maybe = node_js["data_dilation_strides"];
-                if (data_dilation_strides_maybe.empty())
-                {
-                    data_dilation_strides_maybe = node_js["image_dilation_strides"];
-                }
-
-                if (data_dilation_strides_maybe.empty())
-                {
-                    node = make_shared<op::Convolution>(args[0],
+            break;
+        }
+        case OP_TYPEID::MaxPoolBackprop:
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            if (args.size() == 3)
+            {
+                node = make_shared<op::MaxPoolBackprop>(args[0],
                                                         args[1],
+                                                        args[2],
+                                                        window_shape,
                                                         window_movement_strides,
-                                                        window_dilation_strides,
                                                         padding_below,
                                                         padding_above);
-                }
-                else
-                {
-                    node = make_shared<op::Convolution>(
-                        args[0],
-                        args[1],
-                        window_movement_strides,
-                        window_dilation_strides,
-                        padding_below,
-                        padding_above,
-                        data_dilation_strides_maybe.get<std::vector<size_t>>());
-                }
-                break;
-            }
-            case OP_TYPEID::ConvolutionBackpropData:
-            {
-                auto data_batch_shape = node_js.at("data_batch_shape").get<vector<size_t>>();
-                auto window_movement_strides_forward =
-                    node_js.at("window_movement_strides_forward").get<vector<size_t>>();
-                auto window_dilation_strides_forward =
-                    node_js.at("window_dilation_strides_forward").get<vector<size_t>>();
-                auto padding_below_forward =
-                    node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>();
-                auto padding_above_forward =
-                    node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>();
-                auto data_dilation_strides_forward =
-                    node_js.at("data_dilation_strides_forward").get<vector<size_t>>();
-                node = make_shared<op::ConvolutionBackpropData>(data_batch_shape,
-                                                                args[0],
-                                                                args[1],
-                                                                window_movement_strides_forward,
-                                                                window_dilation_strides_forward,
-                                                                padding_below_forward,
-                                                                padding_above_forward,
-                                                                data_dilation_strides_forward);
-                break;
-            }
-            case OP_TYPEID::ConvolutionBackpropFilters:
-            {
-                auto filters_shape = node_js.at("filters_shape").get<vector<size_t>>();
-                auto window_movement_strides_forward =
-                    node_js.at("window_movement_strides_forward").get<vector<size_t>>();
-                auto window_dilation_strides_forward =
-                    node_js.at("window_dilation_strides_forward").get<vector<size_t>>();
-                auto padding_below_forward =
-                    node_js.at("padding_below_forward").get<vector<std::ptrdiff_t>>();
-                auto padding_above_forward =
-                    node_js.at("padding_above_forward").get<vector<std::ptrdiff_t>>();
-                auto data_dilation_strides_forward =
-                    node_js.at("data_dilation_strides_forward").get<vector<size_t>>();
-                node = make_shared<op::ConvolutionBackpropFilters>(args[0],
-                                                                   filters_shape,
-                                                                   args[1],
-                                                                   window_movement_strides_forward,
-                                                                   window_dilation_strides_forward,
-                                                                   padding_below_forward,
-                                                                   padding_above_forward,
-                                                                   data_dilation_strides_forward);
-                break;
-            }
-            case OP_TYPEID::Cos:
-            {
-                node = make_shared<op::Cos>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Cosh:
-            {
-                node = make_shared<op::Cosh>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Dequantize:
-            {
-                auto type = read_element_type(node_js.at("type"));
-                auto axes = node_js.at("axes").get<set<size_t>>();
-                node = make_shared<op::Dequantize>(args[0], args[1], args[2], type, axes);
-                break;
-            }
-            case OP_TYPEID::Divide:
-            {
-                node = make_shared<op::Divide>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Dot:
-            {
-                // For backwards compatibility, reduction_axes_count is optional.
-                auto obj = node_js["reduction_axes_count"];
-                if (obj.empty())
-                {
-                    node = make_shared<op::Dot>(args[0], args[1]);
-                }
-                else
-                {
-                    size_t reduction_axes_count = obj.get<size_t>();
-                    node = make_shared<op::Dot>(args[0], args[1], reduction_axes_count);
-                }
-                break;
-            }
-            case OP_TYPEID::EmbeddingLookup:
-            {
-                node = make_shared<op::EmbeddingLookup>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Equal:
-            {
-                node = make_shared<op::Equal>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Exp:
-            {
-                node = make_shared<op::Exp>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Floor:
-            {
-                node = make_shared<op::Floor>(args[0]);
-                break;
-            }
-            case OP_TYPEID::GenerateMask:
-            {
-                auto output_shape = node_js.at("output_shape").get<vector<size_t>>();
-                auto type = read_element_type(node_js.at("type"));
-                auto seed = node_js.at("seed").get<unsigned int>();
-                auto probability = node_js.at("probability").get<double>();
-
-                node =
-                    make_shared<op::GenerateMask>(args[0], output_shape, type, seed, probability);
-                break;
-            }
-            case OP_TYPEID::GetOutputElement:
-            {
-                node = make_shared<op::GetOutputElement>(args[0], node_js.at("n").get<size_t>());
-                break;
-            }
-            case OP_TYPEID::Greater:
-            {
-                node = make_shared<op::Greater>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::GreaterEq:
-            {
-                node = make_shared<op::GreaterEq>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Less:
-            {
-                node = make_shared<op::Less>(args[0], args[1]);
-                break;
             }
-            case OP_TYPEID::LessEq:
-            {
-                node = make_shared<op::LessEq>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Log:
-            {
-                node = make_shared<op::Log>(args[0]);
-                break;
-            }
-            case OP_TYPEID::LRN:
-            {
-                auto alpha = node_js.at("alpha").get<double>();
-                auto beta = node_js.at("beta").get<double>();
-                auto bias = node_js.at("bias").get<double>();
-                auto nsize = node_js.at("nsize").get<size_t>();
-                node = make_shared<op::LRN>(args[0], alpha, beta, bias, nsize);
-                break;
-            }
-            case OP_TYPEID::Max:
-            {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Max>(args[0], reduction_axes);
-                break;
-            }
-            case OP_TYPEID::MaxPool:
-            {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                // For backwards compatibility, both (but not just one) of the padding_ fields may be
-                // omitted.
-                auto padding_below_maybe = node_js["padding_below"];
-                auto padding_above_maybe = node_js["padding_above"];
-                if (padding_below_maybe.empty() && !padding_above_maybe.empty())
-                {
-                    throw runtime_error(
-                        "MaxPool: padding_below is absent but padding_above is present");
-                }
-                else if (!padding_below_maybe.empty() && padding_above_maybe.empty())
-                {
-                    throw runtime_error(
-                        "MaxPool: padding_below is present but padding_above is absent");
-                }
-                else if (!padding_below_maybe.empty() && !padding_above_maybe.empty())
-                {
-                    auto padding_below = padding_below_maybe.get<vector<size_t>>();
-                    auto padding_above = padding_above_maybe.get<vector<size_t>>();
-                    node = make_shared<op::MaxPool>(args[0],
-                                                    window_shape,
-                                                    window_movement_strides,
-                                                    padding_below,
-                                                    padding_above);
-                }
-                else
-                {
-                    node = make_shared<op::MaxPool>(args[0], window_shape, window_movement_strides);
-                }
-                break;
-            }
-            case OP_TYPEID::MaxPoolBackprop:
-            {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                if (args.size() == 3)
-                {
-                    node = make_shared<op::MaxPoolBackprop>(args[0],
-                                                            args[1],
-                                                            args[2],
-                                                            window_shape,
-                                                            window_movement_strides,
-                                                            padding_below,
-                                                            padding_above);
-                }
-                else
-                {
-                    node = make_shared<op::MaxPoolBackprop>(args[0],
-                                                            args[1],
-                                                            window_shape,
-                                                            window_movement_strides,
-                                                            padding_below,
-                                                            padding_above);
-                }
-                break;
-            }
-            case OP_TYPEID::Maximum:
-            {
-                node = make_shared<op::Maximum>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Min:
-            {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Min>(args[0], reduction_axes);
-                break;
-            }
-            case OP_TYPEID::Minimum:
-            {
-                node = make_shared<op::Minimum>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Multiply:
-            {
-                node = make_shared<op::Multiply>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Negative:
-            {
-                node = make_shared<op::Negative>(args[0]);
-                break;
-            }
-            case OP_TYPEID::NotEqual:
-            {
-                node = make_shared<op::NotEqual>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Not:
-            {
-                node = make_shared<op::Not>(args[0]);
-                break;
-            }
-            case OP_TYPEID::OneHot:
-            {
-                auto shape = node_js.at("shape").get<vector<size_t>>();
-                auto one_hot_axis = node_js.at("one_hot_axis").get<size_t>();
-                node = make_shared<op::OneHot>(args[0], read_partial_shape(shape), one_hot_axis);
-                break;
-            }
-            case OP_TYPEID::Or:
-            {
-                node = make_shared<op::Or>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Pad:
-            {
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                auto padding_interior = node_js.at("padding_interior").get<vector<size_t>>();
-                node = make_shared<op::Pad>(
-                    args[0], args[1], padding_below, padding_above, padding_interior);
-                break;
-            }
-            case OP_TYPEID::Parameter:
-            {
-                auto type_node_js =
-                    node_js.count("element_type") == 0 ? node_js.at("value_type") : node_js;
-                auto element_type = read_element_type(type_node_js.at("element_type"));
-                auto shape = type_node_js.at("shape");
-                auto cacheable = get_or_default<bool>(node_js, "cacheable", false);
-                node =
-                    make_shared<op::Parameter>(element_type, read_partial_shape(shape), cacheable);
-                break;
-            }
-            case OP_TYPEID::Passthrough:
-            {
-                std::vector<json> outputs_js = node_js.at("output_shapes");
-                std::vector<std::tuple<element::Type, PartialShape>> outputs;
-                for (auto output_js : outputs_js)
-                {
-                    outputs.emplace_back(read_element_type(output_js.at("element_type")),
-                                         read_partial_shape(output_js.at("shape")));
-                }
-                node = make_shared<op::Passthrough>(node_js.at("logical_type"),
-                                                    node_js.at("language"),
-                                                    node_js.at("function"),
-                                                    args,
-                                                    std::move(outputs));
-                break;
-            }
-            case OP_TYPEID::Power:
-            {
-                node = make_shared<op::Power>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Product:
-            {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Product>(args[0], reduction_axes);
-                break;
-            }
-            case OP_TYPEID::Quantize:
-            {
-                auto type = read_element_type(node_js.at("type"));
-                auto axes = node_js.at("axes").get<set<size_t>>();
-                auto round_mode = node_js.at("round_mode").get<op::Quantize::RoundMode>();
-                node = make_shared<op::Quantize>(args[0], args[1], args[2], type, axes, round_mode);
-                break;
-            }
-            case OP_TYPEID::QuantizedAvgPool:
-            {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
-                auto include_padding_in_avg_computation =
-                    node_js.at("include_padding_in_avg_computation").get<bool>();
-                node = make_shared<op::QuantizedAvgPool>(args[0],
-                                                         window_shape,
-                                                         window_movement_strides,
-                                                         padding_below,
-                                                         padding_above,
-                                                         include_padding_in_avg_computation);
-                break;
-            }
-            case OP_TYPEID::QuantizedConvolutionBias: { break;
-            }
-            case OP_TYPEID::QuantizedConvolutionBiasAdd: { break;
-            }
-            case OP_TYPEID::QuantizedConvolutionBiasSignedAdd: { break;
-            }
-            case OP_TYPEID::QuantizedConvolutionRelu: { break;
-            }
-            case OP_TYPEID::QuantizedConvolution:
+            else
             {
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                auto window_dilation_strides =
-                    node_js.at("window_dilation_strides").get<vector<size_t>>();
-                auto padding_below = node_js.at("padding_below").get<vector<std::ptrdiff_t>>();
-                auto padding_above = node_js.at("padding_above").get<vector<std::ptrdiff_t>>();
-                auto data_dilation_strides = node_js["data_dilation_strides"];
-                node =
-                    make_shared<op::Convolution>(args[0],
-                                                 args[1],
-                                                 window_movement_strides,
-                                                 window_dilation_strides,
-                                                 padding_below,
-                                                 padding_above,
-                                                 data_dilation_strides.get<std::vector<size_t>>());
-                break;
+                node = make_shared<op::MaxPoolBackprop>(args[0],
+                                                        args[1],
+                                                        window_shape,
+                                                        window_movement_strides,
+                                                        padding_below,
+                                                        padding_above);
             }
-            case OP_TYPEID::QuantizedMaxPool:
-            {
-                auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
-                auto window_movement_strides =
-                    node_js.at("window_movement_strides").get<vector<size_t>>();
-                // For backwards compatibility, both (but not just one) of the padding_ fields may be
-                // omitted.
-                auto padding_below_maybe = node_js["padding_below"];
-                auto padding_above_maybe = node_js["padding_above"];
-                auto padding_below = padding_below_maybe.get<vector<size_t>>();
-                auto padding_above = padding_above_maybe.get<vector<size_t>>();
-                node = make_shared<op::QuantizedMaxPool>(
-                    args[0], window_shape, window_movement_strides, padding_below, padding_above);
+            break;
+        }
+        case OP_TYPEID::Maximum:
+        {
+            node = make_shared<op::Maximum>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Min:
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Min>(args[0], reduction_axes);
+            break;
+        }
+        case OP_TYPEID::Minimum:
+        {
+            node = make_shared<op::Minimum>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Multiply:
+        {
+            node = make_shared<op::Multiply>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Negative:
+        {
+            node = make_shared<op::Negative>(args[0]);
+            break;
+        }
+        case OP_TYPEID::NotEqual:
+        {
+            node = make_shared<op::NotEqual>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Not:
+        {
+            node = make_shared<op::Not>(args[0]);
+            break;
+        }
+        case OP_TYPEID::OneHot:
+        {
+            auto shape = node_js.at("shape").get<vector<size_t>>();
+            auto one_hot_axis = node_js.at("one_hot_axis").get<size_t>();
+            node = make_shared<op::OneHot>(args[0], read_partial_shape(shape), one_hot_axis);
+            break;
+        }
+        case OP_TYPEID::Or:
+        {
+            node = make_shared<op::Or>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Pad:
+        {
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            auto padding_interior = node_js.at("padding_interior").get<vector<size_t>>();
+            node = make_shared<op::Pad>(
+                args[0], args[1], padding_below, padding_above, padding_interior);
+            break;
+        }
+        case OP_TYPEID::Parameter:
+        {
+            auto type_node_js =
+                node_js.count("element_type") == 0 ? node_js.at("value_type") : node_js;
+            auto element_type = read_element_type(type_node_js.at("element_type"));
+            auto shape = type_node_js.at("shape");
+            auto cacheable = get_or_default<bool>(node_js, "cacheable", false);
+            node =
+                make_shared<op::Parameter>(element_type, read_partial_shape(shape), cacheable);
+            break;
+        }
+        case OP_TYPEID::Passthrough:
+        {
+            std::vector<json> outputs_js = node_js.at("output_shapes");
+            std::vector<std::tuple<element::Type, PartialShape>> outputs;
+            for (auto output_js : outputs_js)
+            {
+                outputs.emplace_back(read_element_type(output_js.at("element_type")),
+                                     read_partial_shape(output_js.at("shape")));
+            }
+            node = make_shared<op::Passthrough>(node_js.at("logical_type"),
+                                                node_js.at("language"),
+                                                node_js.at("function"),
+                                                args,
+                                                std::move(outputs));
+            break;
+        }
+        case OP_TYPEID::Power:
+        {
+            node = make_shared<op::Power>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Product:
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Product>(args[0], reduction_axes);
+            break;
+        }
+        case OP_TYPEID::Quantize:
+        {
+            auto type = read_element_type(node_js.at("type"));
+            auto axes = node_js.at("axes").get<set<size_t>>();
+            auto round_mode = node_js.at("round_mode").get<op::Quantize::RoundMode>();
+            node = make_shared<op::Quantize>(args[0], args[1], args[2], type, axes, round_mode);
+            break;
+        }
+        case OP_TYPEID::QuantizedAvgPool:
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<size_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<size_t>>();
+            auto include_padding_in_avg_computation =
+                node_js.at("include_padding_in_avg_computation").get<bool>();
+            node = make_shared<op::QuantizedAvgPool>(args[0],
+                                                     window_shape,
+                                                     window_movement_strides,
+                                                     padding_below,
+                                                     padding_above,
+                                                     include_padding_in_avg_computation);
+            break;
+        }
+        case OP_TYPEID::QuantizedConvolutionBias: { break;
+        }
+        case OP_TYPEID::QuantizedConvolutionBiasAdd: { break;
+        }
+        case OP_TYPEID::QuantizedConvolutionBiasSignedAdd: { break;
+        }
+        case OP_TYPEID::QuantizedConvolutionRelu: { break;
+        }
+        case OP_TYPEID::QuantizedConvolution:
+        {
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            auto window_dilation_strides =
+                node_js.at("window_dilation_strides").get<vector<size_t>>();
+            auto padding_below = node_js.at("padding_below").get<vector<std::ptrdiff_t>>();
+            auto padding_above = node_js.at("padding_above").get<vector<std::ptrdiff_t>>();
+            auto data_dilation_strides = node_js["data_dilation_strides"];
+            node =
+                make_shared<op::Convolution>(args[0],
+                                             args[1],
+                                             window_movement_strides,
+                                             window_dilation_strides,
+                                             padding_below,
+                                             padding_above,
+                                             data_dilation_strides.get<std::vector<size_t>>());
+            break;
+        }
+        case OP_TYPEID::QuantizedMaxPool:
+        {
+            auto window_shape = node_js.at("window_shape").get<vector<size_t>>();
+            auto window_movement_strides =
+                node_js.at("window_movement_strides").get<vector<size_t>>();
+            // For backwards compatibility, both (but not just one) of the padding_ fields may be
+            // omitted.
+            auto padding_below_maybe = node_js["padding_below"];
+            auto padding_above_maybe = node_js["padding_above"];
+            auto padding_below = padding_below_maybe.get<vector<size_t>>();
+            auto padding_above = padding_above_maybe.get<vector<size_t>>();
+            node = make_shared<op::QuantizedMaxPool>(
+                args[0], window_shape, window_movement_strides, padding_below, padding_above);
 
-                break;
-            }
-            case OP_TYPEID::Relu:
-            {
-                node = make_shared<op::Relu>(args[0]);
-                break;
-            }
-            case OP_TYPEID::ReluBackprop:
-            {
-                node = make_shared<op::ReluBackprop>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::ReplaceSlice:
-            {
-                auto lower_bounds = node_js.at("lower_bounds").get<vector<size_t>>();
-                auto upper_bounds = node_js.at("upper_bounds").get<vector<size_t>>();
-                auto strides = node_js.at("strides").get<vector<size_t>>();
-                node = make_shared<op::ReplaceSlice>(
-                    args[0], args[1], lower_bounds, upper_bounds, strides);
-                break;
-            }
-            case OP_TYPEID::Reshape:
-            {
-                auto input_order = node_js.at("input_order").get<vector<size_t>>();
-                auto output_shape = node_js.at("output_shape").get<vector<size_t>>();
-                node = make_shared<op::Reshape>(args[0], input_order, output_shape);
-                break;
-            }
-            case OP_TYPEID::Result:
-            {
-                node = make_shared<op::Result>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Reverse:
-            {
-                auto reversed_axes = node_js.at("reversed_axes").get<set<size_t>>();
-                node = make_shared<op::Reverse>(args[0], reversed_axes);
-                break;
-            }
-            case OP_TYPEID::ReverseSequence:
-            {
-                auto batch_axis = node_js.at("batch_axis").get<size_t>();
-                auto sequence_axis = node_js.at("sequence_axis").get<size_t>();
-                node =
-                    make_shared<op::ReverseSequence>(args[0], args[1], batch_axis, sequence_axis);
-                break;
-            }
-            case OP_TYPEID::ScalarConstantLike:
-            {
-                double value = node_js.at("value").get<double>();
-                node = make_shared<op::ScalarConstantLike>(args[0], value);
-                break;
-            }
-            case OP_TYPEID::Select:
-            {
-                node = make_shared<op::Select>(args[0], args[1], args[2]);
-                break;
-            }
-            case OP_TYPEID::ShapeOf:
-            {
-                node = make_shared<op::ShapeOf>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Sigmoid:
-            {
-                node = make_shared<op::Sigmoid>(args[0]);
-                break;
-            }
-            case OP_TYPEID::SigmoidBackprop:
-            {
-                node = make_shared<op::SigmoidBackprop>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Sign:
-            {
-                node = make_shared<op::Sign>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Sin:
-            {
-                node = make_shared<op::Sin>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Sinh:
-            {
-                node = make_shared<op::Sinh>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Slice:
-            {
-                auto lower_bounds = node_js.at("lower_bounds").get<vector<size_t>>();
-                auto upper_bounds = node_js.at("upper_bounds").get<vector<size_t>>();
-                auto strides = node_js.at("strides").get<vector<size_t>>();
-                node = make_shared<op::Slice>(args[0], lower_bounds, upper_bounds, strides);
-                break;
-            }
-            case OP_TYPEID::Softmax:
-            {
-                auto softmax_axes = node_js.at("softmax_axes").get<set<size_t>>();
-                node = make_shared<op::Softmax>(args[0], softmax_axes);
-                break;
-            }
-            case OP_TYPEID::Sqrt:
-            {
-                node = make_shared<op::Sqrt>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Subtract:
-            {
-                node = make_shared<op::Subtract>(args[0], args[1]);
-                break;
-            }
-            case OP_TYPEID::Sum:
-            {
-                auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
-                node = make_shared<op::Sum>(args[0], reduction_axes);
-                break;
-            }
-            case OP_TYPEID::Tan:
-            {
-                node = make_shared<op::Tan>(args[0]);
-                break;
-            }
-            case OP_TYPEID::Tanh:
-            {
-                node = make_shared<op::Tanh>(args[0]);
-                break;
-            }
-            case OP_TYPEID::TopK:
-            {
-                auto top_k_axis = node_js.at("top_k_axis").get<size_t>();
-                auto k = node_js.at("k").get<size_t>();
-                auto compute_max = node_js.at("compute_max").get<bool>();
-                auto target_type = read_element_type(node_js.at("index_element_type"));
-                node = make_shared<op::TopK>(args[0], top_k_axis, target_type, k, compute_max);
-                break;
-            }
-            case OP_TYPEID::StopGradient:
-            {
-                node = make_shared<op::StopGradient>(args[0]);
-                break;
-            }
-            case OP_TYPEID::UnknownOp:
-            {
-                stringstream ss;
-                ss << "unsupported op " << node_op;
-                throw runtime_error(ss.str());
-            }
-            }
+            break;
+        }
+        case OP_TYPEID::Relu:
+        {
+            node = make_shared<op::Relu>(args[0]);
+            break;
+        }
+        case OP_TYPEID::ReluBackprop:
+        {
+            node = make_shared<op::ReluBackprop>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::ReplaceSlice:
+        {
+            auto lower_bounds = node_js.at("lower_bounds").get<vector<size_t>>();
+            auto upper_bounds = node_js.at("upper_bounds").get<vector<size_t>>();
+            auto strides = node_js.at("strides").get<vector<size_t>>();
+            node = make_shared<op::ReplaceSlice>(
+                args[0], args[1], lower_bounds, upper_bounds, strides);
+            break;
+        }
+        case OP_TYPEID::Reshape:
+        {
+            auto input_order = node_js.at("input_order").get<vector<size_t>>();
+            auto output_shape = node_js.at("output_shape").get<vector<size_t>>();
+            node = make_shared<op::Reshape>(args[0], input_order, output_shape);
+            break;
+        }
+        case OP_TYPEID::Result:
+        {
+            node = make_shared<op::Result>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Reverse:
+        {
+            auto reversed_axes = node_js.at("reversed_axes").get<set<size_t>>();
+            node = make_shared<op::Reverse>(args[0], reversed_axes);
+            break;
+        }
+        case OP_TYPEID::ReverseSequence:
+        {
+            auto batch_axis = node_js.at("batch_axis").get<size_t>();
+            auto sequence_axis = node_js.at("sequence_axis").get<size_t>();
+            node =
+                make_shared<op::ReverseSequence>(args[0], args[1], batch_axis, sequence_axis);
+            break;
+        }
+        case OP_TYPEID::ScalarConstantLike:
+        {
+            double value = node_js.at("value").get<double>();
+            node = make_shared<op::ScalarConstantLike>(args[0], value);
+            break;
+        }
+        case OP_TYPEID::Select:
+        {
+            node = make_shared<op::Select>(args[0], args[1], args[2]);
+            break;
+        }
+        case OP_TYPEID::ShapeOf:
+        {
+            node = make_shared<op::ShapeOf>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Sigmoid:
+        {
+            node = make_shared<op::Sigmoid>(args[0]);
+            break;
+        }
+        case OP_TYPEID::SigmoidBackprop:
+        {
+            node = make_shared<op::SigmoidBackprop>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Sign:
+        {
+            node = make_shared<op::Sign>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Sin:
+        {
+            node = make_shared<op::Sin>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Sinh:
+        {
+            node = make_shared<op::Sinh>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Slice:
+        {
+            auto lower_bounds = node_js.at("lower_bounds").get<vector<size_t>>();
+            auto upper_bounds = node_js.at("upper_bounds").get<vector<size_t>>();
+            auto strides = node_js.at("strides").get<vector<size_t>>();
+            node = make_shared<op::Slice>(args[0], lower_bounds, upper_bounds, strides);
+            break;
+        }
+        case OP_TYPEID::Softmax:
+        {
+            auto softmax_axes = node_js.at("softmax_axes").get<set<size_t>>();
+            node = make_shared<op::Softmax>(args[0], softmax_axes);
+            break;
+        }
+        case OP_TYPEID::Sqrt:
+        {
+            node = make_shared<op::Sqrt>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Subtract:
+        {
+            node = make_shared<op::Subtract>(args[0], args[1]);
+            break;
+        }
+        case OP_TYPEID::Sum:
+        {
+            auto reduction_axes = node_js.at("reduction_axes").get<set<size_t>>();
+            node = make_shared<op::Sum>(args[0], reduction_axes);
+            break;
+        }
+        case OP_TYPEID::Tan:
+        {
+            node = make_shared<op::Tan>(args[0]);
+            break;
+        }
+        case OP_TYPEID::Tanh:
+        {
+            node = make_shared<op::Tanh>(args[0]);
+            break;
+        }
+        case OP_TYPEID::TopK:
+        {
+            auto top_k_axis = node_js.at("top_k_axis").get<size_t>();
+            auto k = node_js.at("k").get<size_t>();
+            auto compute_max = node_js.at("compute_max").get<bool>();
+            auto target_type = read_element_type(node_js.at("index_element_type"));
+            node = make_shared<op::TopK>(args[0], top_k_axis, target_type, k, compute_max);
+            break;
+        }
+        case OP_TYPEID::StopGradient:
+        {
+            node = make_shared<op::StopGradient>(args[0]);
+            break;
+        }
+        case OP_TYPEID::UnknownOp:
+        {
+            stringstream ss;
+            ss << "unsupported op " << node_op;
+            throw runtime_error(ss.str());
+        }
+        }
 #pragma GCC diagnostic pop
 
-            for (const string& name : control_deps_inputs)
-            {
-                node->add_control_dependency(node_map.at(name));
-            }
+        for (const string& name : control_deps_inputs)
+        {
+            node->add_control_dependency(node_map.at(name));
+        }
 
-            if (!friendly_name.empty())
-            {
-                node->set_friendly_name(friendly_name);
-            }
-            node_map[node_name] = node;
+        if (!friendly_name.empty())
+        {
+            node->set_friendly_name(friendly_name);
         }
-        catch (...)
+        node_map[node_name] = node;
+    }
+    catch (...)
+    {
+        string node_name;
+        auto it = node_js.find("name");
+        if (it != node_js.end())
         {
-            string node_name;
-            auto it = node_js.find("name");
-            if (it != node_js.end())
-            {
-                node_name = it->get<string>();
-            }
-            else
-            {
-                node_name = "UNKNOWN";
-            }
-            throw runtime_error("Error parsing json at node '" + node_name + "'");
+            node_name = it->get<string>();
+        }
+        else
+        {
+            node_name = "UNKNOWN";
         }
+        throw runtime_error("Error parsing json at node '" + node_name + "'");
     }
+}
+
+static shared_ptr<Function> make_function(const json& func_js,
+                                          const node_map_t& node_map,
+                                          function_map_t& function_map)
+{
+    shared_ptr<ngraph::Function> rc;
+
+    string func_name = func_js.at("name").get<string>();
+    vector<string> func_parameters = func_js.at("parameters").get<vector<string>>();
+    vector<string> func_result = func_js.at("result").get<vector<string>>();
 
     // This handles both graphs w/ `op::Result` and legacy graphs w/o it
     // If we are dealing w/ a legacy graph, add op::Result for each output node
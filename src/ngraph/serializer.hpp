@@ -48,6 +48,13 @@ namespace ngraph
     ///    indent level specified.
     void serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func, size_t indent = 0);
 
+    /// \brief Serialize a Function to a CPIO file with the graph stored in a compact binary
+    ///    encoding instead of json. All constant data is stored as binary. The result is
+    ///    read with deserialize(std::istream&).
+    /// \param out The output stream to which the data is serialized.
+    /// \param func The Function to serialize
+    void serialize_binary(std::ostream& out, std::shared_ptr<ngraph::Function> func);
+
     /// \brief Deserialize a Function
     /// \param in An isteam to the input data
     std::shared_ptr<ngraph::Function> deserialize(std::istream& in);
@@ -55,4 +62,11 @@ namespace ngraph
     /// \brief Deserialize a Function
     /// \param str The json formatted string to deseriailze.
     std::shared_ptr<ngraph::Function> deserialize(const std::string& str);
+
+    /// \brief Deserialize a Function from a file
+    /// \param path The file to read.
+    /// \param lazy_constants If true and the file is a CPIO archive, constant data is not read
+    ///    until first used, and constants loaded from the same file share their data. The
+    ///    file must then stay unchanged for as long as the constants exist.
+    std::shared_ptr<ngraph::Function> deserialize(const std::string& path, bool lazy_constants);
 }
@@ -0,0 +1,266 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ngraph
+{
+    /// \brief A sequence whose elements never move once constructed, for element types that
+    ///        are neither copyable nor movable, such as descriptor::Input and
+    ///        descriptor::Output.
+    ///
+    /// Elements live in segments that are allocated with exactly the capacity requested by
+    /// reserve(), so a sequence whose final size is known up front uses a single allocation.
+    /// Growing past the reserved capacity adds a new segment and leaves existing elements in
+    /// place. Unlike std::deque, an empty StableVector allocates nothing.
+    template <typename T>
+    class StableVector
+    {
+        template <typename V, typename R>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = R*;
+            using reference = R&;
+
+            basic_iterator()
+                : m_vector(nullptr)
+                , m_index(0)
+            {
+            }
+            basic_iterator(V* vector, size_t index)
+                : m_vector(vector)
+                , m_index(index)
+            {
+            }
+            // iterator converts to const_iterator
+            template <typename V2, typename R2>
+            basic_iterator(const basic_iterator<V2, R2>& other)
+                : m_vector(other.m_vector)
+                , m_index(other.m_index)
+            {
+            }
+
+            reference operator*() const { return (*m_vector)[m_index]; }
+            pointer operator->() const { return &(*m_vector)[m_index]; }
+            reference operator[](difference_type n) const { return (*m_vector)[m_index + n]; }
+            basic_iterator& operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+            basic_iterator operator++(int) { return basic_iterator(m_vector, m_index++); }
+            basic_iterator& operator--()
+            {
+                --m_index;
+                return *this;
+            }
+            basic_iterator operator--(int) { return basic_iterator(m_vector, m_index--); }
+            basic_iterator& operator+=(difference_type n)
+            {
+                m_index += n;
+                return *this;
+            }
+            basic_iterator& operator-=(difference_type n)
+            {
+                m_index -= n;
+                return *this;
+            }
+            basic_iterator operator+(difference_type n) const
+            {
+                return basic_iterator(m_vector, m_index + n);
+            }
+            basic_iterator operator-(difference_type n) const
+            {
+                return basic_iterator(m_vector, m_index - n);
+            }
+            difference_type operator-(const basic_iterator& other) const
+            {
+                return static_cast<difference_type>(m_index) -
+                       static_cast<difference_type>(other.m_index);
+            }
+            bool operator==(const basic_iterator& other) const { return m_index == other.m_index; }
+            bool operator!=(const basic_iterator& other) const { return m_index != other.m_index; }
+            bool operator<(const basic_iterator& other) const { return m_index < other.m_index; }
+            bool operator>(const basic_iterator& other) const { return m_index > other.m_index; }
+            bool operator<=(const basic_iterator& other) const { return m_index <= other.m_index; }
+            bool operator>=(const basic_iterator& other) const { return m_index >= other.m_index; }
+        private:
+            template <typename V2, typename R2>
+            friend class basic_iterator;
+
+            V* m_vector;
+            size_t m_index;
+        };
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = basic_iterator<StableVector, T>;
+        using const_iterator = basic_iterator<const StableVector, const T>;
+
+        StableVector() {}
+        StableVector(const StableVector&) = delete;
+        StableVector& operator=(const StableVector&) = delete;
+        ~StableVector()
+        {
+            destroy_segment(m_first);
+            for (Segment& segment : m_overflow)
+            {
+                destroy_segment(segment);
+            }
+        }
+
+        /// \brief Makes room for n elements in total without allocating on emplace_back.
+        void reserve(size_t n)
+        {
+            size_t capacity = m_first.m_capacity;
+            for (const Segment& segment : m_overflow)
+            {
+                capacity += segment.m_capacity;
+            }
+            if (n > capacity)
+            {
+                add_segment(n - capacity);
+            }
+        }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            Segment* segment = &m_first;
+            if (segment->m_size == segment->m_capacity)
+            {
+                segment = nullptr;
+                for (Segment& overflow : m_overflow)
+                {
+                    if (overflow.m_size < overflow.m_capacity)
+                    {
+                        segment = &overflow;
+                        break;
+                    }
+                }
+                if (segment == nullptr)
+                {
+                    // Grow geometrically so that repeated emplace_back stays amortized O(1)
+                    segment = &add_segment(m_size == 0 ? 1 : m_size);
+                }
+            }
+            T* element = new (segment->m_data + segment->m_size) T(std::forward<Args>(args)...);
+            segment->m_size++;
+            m_size++;
+            return *element;
+        }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        T& operator[](size_t i) { return *element(i); }
+        const T& operator[](size_t i) const { return *element(i); }
+        T& at(size_t i)
+        {
+            check_range(i);
+            return *element(i);
+        }
+        const T& at(size_t i) const
+        {
+            check_range(i);
+            return *element(i);
+        }
+        T& front() { return *element(0); }
+        const T& front() const { return *element(0); }
+        T& back() { return *element(m_size - 1); }
+        const T& back() const { return *element(m_size - 1); }
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, m_size); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, m_size); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+    private:
+        struct Segment
+        {
+            T* m_data{nullptr};
+            size_t m_size{0};
+            size_t m_capacity{0};
+        };
+
+        Segment& add_segment(size_t capacity)
+        {
+            Segment segment;
+            segment.m_data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+            segment.m_capacity = capacity;
+            if (m_first.m_capacity == 0)
+            {
+                m_first = segment;
+                return m_first;
+            }
+            m_overflow.push_back(segment);
+            return m_overflow.back();
+        }
+
+        static void destroy_segment(Segment& segment)
+        {
+            for (size_t i = 0; i < segment.m_size; ++i)
+            {
+                segment.m_data[i].~T();
+            }
+            ::operator delete(segment.m_data);
+        }
+
+        // Segments are filled in order, so every segment before the last non-empty one is full
+        T* element(size_t i) const
+        {
+            if (i < m_first.m_size)
+            {
+                return m_first.m_data + i;
+            }
+            i -= m_first.m_size;
+            for (const Segment& segment : m_overflow)
+            {
+                if (i < segment.m_size)
+                {
+                    return segment.m_data + i;
+                }
+                i -= segment.m_size;
+            }
+            return nullptr;
+        }
+
+        void check_range(size_t i) const
+        {
+            if (i >= m_size)
+            {
+                throw std::out_of_range("StableVector index out of range");
+            }
+        }
+
+        Segment m_first;
+        std::vector<Segment> m_overflow;
+        size_t m_size{0};
+    };
+}
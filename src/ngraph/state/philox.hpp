@@ -0,0 +1,71 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ngraph
+{
+    /// \brief Philox4x32-10 counter-based random number generator.
+    ///
+    /// Every call maps a 128-bit counter and a 64-bit key to four independent 32-bit words
+    /// with no state carried between calls. Any range of a random stream can therefore be
+    /// produced on its own, in any order and on any number of threads, and always gives the
+    /// same bits.
+    class Philox
+    {
+    public:
+        using counter_type = std::array<uint32_t, 4>;
+        using key_type = std::array<uint32_t, 2>;
+
+        static counter_type generate(counter_type counter, key_type key)
+        {
+            const uint32_t multiplier0 = 0xD2511F53;
+            const uint32_t multiplier1 = 0xCD9E8D57;
+            const uint32_t weyl0 = 0x9E3779B9;
+            const uint32_t weyl1 = 0xBB67AE85;
+            for (size_t round = 0; round < 10; round++)
+            {
+                if (round > 0)
+                {
+                    key[0] += weyl0;
+                    key[1] += weyl1;
+                }
+                uint64_t product0 = static_cast<uint64_t>(multiplier0) * counter[0];
+                uint64_t product1 = static_cast<uint64_t>(multiplier1) * counter[2];
+                uint32_t hi0 = static_cast<uint32_t>(product0 >> 32);
+                uint32_t lo0 = static_cast<uint32_t>(product0);
+                uint32_t hi1 = static_cast<uint32_t>(product1 >> 32);
+                uint32_t lo1 = static_cast<uint32_t>(product1);
+                counter = {{hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0}};
+            }
+            return counter;
+        }
+
+        /// \brief Returns the four words of block `block` in stream `stream` of key `seed`.
+        static counter_type generate(uint64_t block, uint64_t stream, uint32_t seed)
+        {
+            return generate({{static_cast<uint32_t>(block),
+                              static_cast<uint32_t>(block >> 32),
+                              static_cast<uint32_t>(stream),
+                              static_cast<uint32_t>(stream >> 32)}},
+                            {{seed, 0x6E677261}});
+        }
+    };
+}
@@ -14,7 +14,8 @@
 // limitations under the License.
 //*****************************************************************************
 
-#include <random>
+#include <algorithm>
+#include <cmath>
 
 #include "except.hpp"
 #include "rng_state.hpp"
@@ -22,6 +23,15 @@
 using namespace std;
 using namespace ngraph;
 
+ngraph::RNGState::RNGState(unsigned int seed, double probability)
+    : State()
+    , m_seed(seed)
+    , m_probability(probability)
+{
+    double scaled = std::ldexp(std::min(std::max(probability, 0.0), 1.0), 32);
+    m_threshold = static_cast<uint64_t>(scaled);
+}
+
 void ngraph::RNGState::activate()
 {
 }
@@ -16,9 +16,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
-#include <random>
 
 #include "state.hpp"
 
@@ -34,19 +34,23 @@ namespace ngraph
             return rng;
         }
 
-        RNGState(unsigned int seed, double probability)
-            : State()
-            , m_generator(seed)
-            , m_distribution(probability)
-        {
-        }
+        RNGState(unsigned int seed, double probability);
         virtual void activate() override;
         virtual void deactivate() override;
         virtual ~RNGState() override {}
-        std::mt19937& get_generator() { return m_generator; }
-        std::bernoulli_distribution& get_distribution() { return m_distribution; }
+        unsigned int get_seed() const { return m_seed; }
+        double get_probability() const { return m_probability; }
+        /// \brief A 32-bit random word is a hit when it is below this threshold, which
+        ///        happens with the configured probability
+        uint64_t get_threshold() const { return m_threshold; }
+        /// \brief Returns the stream for the next call and advances the call counter.
+        ///        Each call draws from its own Philox stream, so the elements of one call
+        ///        can be generated in any order.
+        uint64_t next_stream() { return m_stream++; }
     protected:
-        std::mt19937 m_generator;
-        std::bernoulli_distribution m_distribution;
+        unsigned int m_seed;
+        double m_probability;
+        uint64_t m_threshold;
+        uint64_t m_stream = 0;
     };
 }
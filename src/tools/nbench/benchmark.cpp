@@ -106,7 +106,7 @@ void init_real_tv(shared_ptr<runtime::Tensor> tv, T min, T max)
     tv->write(vec.data(), 0, vec.size() * sizeof(T));
 }
 
-static void random_init(shared_ptr<runtime::Tensor> tv)
+void random_init(shared_ptr<runtime::Tensor> tv)
 {
     element::Type et = tv->get_element_type();
     switch (et.get_type_enum())
@@ -23,8 +23,14 @@
 
 #include "ngraph/function.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
+#include "ngraph/runtime/tensor.hpp"
 
 /// performance test utilities
+void set_denormals_flush_to_zero();
+
+/// Fill tv with uniformly distributed values suitable for its element type
+void random_init(std::shared_ptr<ngraph::runtime::Tensor> tv);
+
 std::multimap<size_t, std::string>
     aggregate_timing(const std::vector<ngraph::runtime::PerformanceCounter>& perf_data);
 
@@ -0,0 +1,458 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "benchmark.hpp"
+#include "load_test.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/host_tensor.hpp"
+#include "ngraph/runtime/tensor.hpp"
+#include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace std;
+using namespace ngraph;
+using json = nlohmann::json;
+
+using load_clock = chrono::steady_clock;
+
+namespace
+{
+    // Input and output tensors owned by one client thread
+    struct ClientData
+    {
+        vector<shared_ptr<runtime::HostTensor>> arg_data;
+        vector<shared_ptr<runtime::Tensor>> args;
+        vector<shared_ptr<runtime::HostTensor>> result_data;
+        vector<shared_ptr<runtime::Tensor>> results;
+    };
+
+    // Reads a "<key>: <value> kB" line from /proc/self/status. Returns 0 where that file
+    // does not exist.
+    size_t read_proc_status_bytes(const string& key)
+    {
+        ifstream status("/proc/self/status");
+        string line;
+        while (getline(status, line))
+        {
+            if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() &&
+                line[key.size()] == ':')
+            {
+                istringstream ss(line.substr(key.size() + 1));
+                size_t kb = 0;
+                ss >> kb;
+                return kb * 1024;
+            }
+        }
+        return 0;
+    }
+
+    ClientData make_client_data(runtime::Backend& backend, const shared_ptr<Function>& f)
+    {
+        ClientData data;
+        for (shared_ptr<op::Parameter> param : f->get_parameters())
+        {
+            auto tensor = backend.create_tensor(param->get_element_type(), param->get_shape());
+            auto tensor_data =
+                make_shared<runtime::HostTensor>(param->get_element_type(), param->get_shape());
+            random_init(tensor_data);
+            size_t size =
+                tensor_data->get_element_count() * tensor_data->get_element_type().size();
+            tensor->write(tensor_data->get_data_ptr(), 0, size);
+            if (param->get_cacheable())
+            {
+                tensor->set_stale(false);
+            }
+            data.args.push_back(tensor);
+            data.arg_data.push_back(tensor_data);
+        }
+        for (shared_ptr<Node> out : f->get_results())
+        {
+            data.results.push_back(
+                backend.create_tensor(out->get_element_type(), out->get_shape()));
+            data.result_data.push_back(
+                make_shared<runtime::HostTensor>(out->get_element_type(), out->get_shape()));
+        }
+        return data;
+    }
+
+    void call(runtime::Executable& exec, mutex& exec_mutex, ClientData& data, bool copy_data)
+    {
+        if (copy_data)
+        {
+            for (size_t i = 0; i < data.args.size(); i++)
+            {
+                if (data.args[i]->get_stale())
+                {
+                    const shared_ptr<runtime::HostTensor>& host = data.arg_data[i];
+                    size_t size = host->get_element_count() * host->get_element_type().size();
+                    data.args[i]->write(host->get_data_ptr(), 0, size);
+                }
+            }
+        }
+        {
+            lock_guard<mutex> lock(exec_mutex);
+            exec.call(data.results, data.args);
+        }
+        if (copy_data)
+        {
+            for (size_t i = 0; i < data.results.size(); i++)
+            {
+                const shared_ptr<runtime::HostTensor>& host = data.result_data[i];
+                size_t size = host->get_element_count() * host->get_element_type().size();
+                data.results[i]->read(host->get_data_ptr(), 0, size);
+            }
+        }
+    }
+
+    double to_microseconds(load_clock::duration d)
+    {
+        return chrono::duration<double, micro>(d).count();
+    }
+
+    string format_bytes(size_t bytes)
+    {
+        ostringstream ss;
+        ss << fixed << setprecision(1);
+        if (bytes >= (size_t(1) << 30))
+        {
+            ss << static_cast<double>(bytes) / (size_t(1) << 30) << " GiB";
+        }
+        else if (bytes >= (size_t(1) << 20))
+        {
+            ss << static_cast<double>(bytes) / (size_t(1) << 20) << " MiB";
+        }
+        else if (bytes >= (size_t(1) << 10))
+        {
+            ss << static_cast<double>(bytes) / (size_t(1) << 10) << " KiB";
+        }
+        else
+        {
+            ss << bytes << " B";
+        }
+        return ss.str();
+    }
+}
+
+size_t get_batch_size(shared_ptr<Function> f)
+{
+    // The highest rank parameter is taken to be the data input
+    size_t batch_size = 0;
+    size_t max_rank = 0;
+    for (shared_ptr<op::Parameter> param : f->get_parameters())
+    {
+        const PartialShape& pshape = param->get_output_partial_shape(0);
+        if (pshape.is_static() && static_cast<size_t>(pshape.rank()) > max_rank)
+        {
+            max_rank = static_cast<size_t>(pshape.rank());
+            batch_size = param->get_shape()[0];
+        }
+    }
+    return batch_size;
+}
+
+shared_ptr<Function> set_batch_size(shared_ptr<Function> f, size_t batch_size)
+{
+    size_t current_batch_size = get_batch_size(f);
+    if (current_batch_size == 0)
+    {
+        throw runtime_error("Unable to find a batch dimension in the model parameters");
+    }
+    NodeMap node_map;
+    for (shared_ptr<op::Parameter> param : f->get_parameters())
+    {
+        const PartialShape& pshape = param->get_output_partial_shape(0);
+        if (pshape.is_static() && static_cast<size_t>(pshape.rank()) > 0 &&
+            param->get_shape()[0] == current_batch_size)
+        {
+            Shape shape = param->get_shape();
+            shape[0] = batch_size;
+            auto new_param = make_shared<op::Parameter>(
+                param->get_element_type(), shape, param->get_cacheable());
+            node_map.add(param, new_param);
+        }
+    }
+    try
+    {
+        return clone_function(*f, node_map);
+    }
+    catch (const exception& e)
+    {
+        throw runtime_error("Model does not support batch size " + to_string(batch_size) +
+                            ": " + e.what());
+    }
+}
+
+LatencyStats compute_latency_stats(vector<double> latencies)
+{
+    LatencyStats stats;
+    stats.count = latencies.size();
+    if (latencies.empty())
+    {
+        return stats;
+    }
+    sort(latencies.begin(), latencies.end());
+    // Nearest-rank percentile
+    auto percentile = [&](double p) {
+        size_t rank = static_cast<size_t>(ceil(p * latencies.size()));
+        return latencies[max<size_t>(rank, 1) - 1];
+    };
+    stats.min = latencies.front();
+    stats.max = latencies.back();
+    double sum = 0;
+    for (double l : latencies)
+    {
+        sum += l;
+        size_t bucket = l < 2.0 ? 0 : static_cast<size_t>(log2(l));
+        if (bucket >= stats.histogram.size())
+        {
+            stats.histogram.resize(bucket + 1, 0);
+        }
+        stats.histogram[bucket]++;
+    }
+    stats.mean = sum / latencies.size();
+    stats.p50 = percentile(0.50);
+    stats.p90 = percentile(0.90);
+    stats.p99 = percentile(0.99);
+    stats.p999 = percentile(0.999);
+    return stats;
+}
+
+LoadTestResult run_load_test(shared_ptr<Function> f,
+                             const string& backend_name,
+                             const LoadTestConfig& config)
+{
+    size_t thread_count = max<size_t>(config.threads, 1);
+    size_t exec_count = min(max<size_t>(config.executables, 1), thread_count);
+
+    LoadTestResult result;
+    result.backend = backend_name;
+    result.batch_size = get_batch_size(f);
+    result.threads = thread_count;
+    result.executables = exec_count;
+    result.target_qps = config.qps;
+
+    // Each executable gets its own copy of the graph since compilation may rewrite it
+    auto backend = runtime::Backend::create(backend_name);
+    vector<shared_ptr<runtime::Executable>> executables;
+    vector<unique_ptr<mutex>> exec_mutexes;
+    stopwatch compile_timer;
+    compile_timer.start();
+    for (size_t i = 0; i < exec_count; i++)
+    {
+        shared_ptr<Function> exec_function = clone_function(*f);
+        executables.push_back(backend->compile(exec_function));
+        exec_mutexes.emplace_back(new mutex());
+        result.temporary_pool_bytes += exec_function->get_temporary_pool_size();
+    }
+    compile_timer.stop();
+    result.compile_milliseconds = compile_timer.get_milliseconds();
+
+    vector<ClientData> clients;
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        clients.push_back(make_client_data(*backend, f));
+    }
+
+    for (size_t i = 0; i < exec_count; i++)
+    {
+        for (size_t w = 0; w < config.warmup_iterations; w++)
+        {
+            call(*executables[i], *exec_mutexes[i], clients[i], config.copy_data);
+        }
+    }
+
+    bool open_loop = config.qps > 0;
+    size_t total_calls = open_loop ? config.iterations : config.iterations * thread_count;
+    atomic<size_t> next_call{0};
+    vector<vector<double>> latencies(thread_count);
+    load_clock::time_point start = load_clock::now();
+    auto interval = chrono::duration<double>(open_loop ? 1.0 / config.qps : 0.0);
+
+    auto client = [&](size_t id) {
+        set_denormals_flush_to_zero();
+        size_t exec_index = id % exec_count;
+        runtime::Executable& exec = *executables[exec_index];
+        mutex& exec_mutex = *exec_mutexes[exec_index];
+        vector<double>& client_latencies = latencies[id];
+        if (open_loop)
+        {
+            // Latency is measured from the scheduled issue time so that queueing delay
+            // caused by an overloaded backend is not hidden
+            size_t n;
+            while ((n = next_call++) < total_calls)
+            {
+                auto scheduled =
+                    start + chrono::duration_cast<load_clock::duration>(interval * n);
+                this_thread::sleep_until(scheduled);
+                call(exec, exec_mutex, clients[id], config.copy_data);
+                client_latencies.push_back(to_microseconds(load_clock::now() - scheduled));
+            }
+        }
+        else
+        {
+            for (size_t n = 0; n < config.iterations; n++)
+            {
+                auto issued = load_clock::now();
+                call(exec, exec_mutex, clients[id], config.copy_data);
+                client_latencies.push_back(to_microseconds(load_clock::now() - issued));
+            }
+        }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        threads.emplace_back(client, i);
+    }
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+    load_clock::time_point stop = load_clock::now();
+
+    vector<double> all_latencies;
+    for (const vector<double>& l : latencies)
+    {
+        all_latencies.insert(all_latencies.end(), l.begin(), l.end());
+    }
+    result.latency = compute_latency_stats(move(all_latencies));
+    result.wall_seconds = chrono::duration<double>(stop - start).count();
+    if (result.wall_seconds > 0)
+    {
+        result.throughput = result.latency.count / result.wall_seconds;
+    }
+    result.rss_bytes = read_proc_status_bytes("VmRSS");
+    result.peak_rss_bytes = read_proc_status_bytes("VmHWM");
+    return result;
+}
+
+void print_load_test_result(const LoadTestResult& r, bool histogram)
+{
+    cout << "batch size: " << r.batch_size << ", threads: " << r.threads
+         << ", executables: " << r.executables;
+    if (r.target_qps > 0)
+    {
+        cout << ", target: " << r.target_qps << " calls/s (open loop)";
+    }
+    cout << "\n";
+    cout << "compile time: " << r.compile_milliseconds << "ms\n";
+    cout << "throughput: " << r.throughput << " calls/s (" << r.latency.count << " calls in "
+         << r.wall_seconds << "s)\n";
+    cout << "latency (us): min " << r.latency.min << ", mean " << r.latency.mean << ", p50 "
+         << r.latency.p50 << ", p90 " << r.latency.p90 << ", p99 " << r.latency.p99 << ", p999 "
+         << r.latency.p999 << ", max " << r.latency.max << "\n";
+    cout << "temporary pool: " << format_bytes(r.temporary_pool_bytes)
+         << ", RSS: " << format_bytes(r.rss_bytes)
+         << ", peak RSS: " << format_bytes(r.peak_rss_bytes) << "\n";
+
+    if (histogram && r.latency.count > 0)
+    {
+        const size_t bar_width = 50;
+        size_t peak = *max_element(r.latency.histogram.begin(), r.latency.histogram.end());
+        cout << "latency histogram:\n";
+        for (size_t i = 0; i < r.latency.histogram.size(); i++)
+        {
+            size_t n = r.latency.histogram[i];
+            if (n == 0)
+            {
+                continue;
+            }
+            size_t lo = (i == 0 ? 0 : size_t(1) << i);
+            size_t hi = size_t(1) << (i + 1);
+            ostringstream range;
+            range << "[" << lo << ", " << hi << ")us";
+            cout << "  " << setw(24) << left << range.str() << setw(10) << right << n << " "
+                 << string(max<size_t>(n * bar_width / peak, 1), '#') << "\n";
+        }
+    }
+}
+
+void write_load_test_csv(const string& path, const vector<LoadTestResult>& results)
+{
+    ofstream out(path);
+    if (!out)
+    {
+        throw runtime_error("Unable to open '" + path + "' for writing");
+    }
+    out << fixed << setprecision(3);
+    out << "model,backend,batch_size,threads,executables,target_qps,compile_ms,wall_s,"
+           "throughput,calls,latency_min_us,latency_mean_us,latency_p50_us,latency_p90_us,"
+           "latency_p99_us,latency_p999_us,latency_max_us,temporary_pool_bytes,rss_bytes,"
+           "peak_rss_bytes\n";
+    for (const LoadTestResult& r : results)
+    {
+        out << r.model << "," << r.backend << "," << r.batch_size << "," << r.threads << ","
+            << r.executables << "," << r.target_qps << "," << r.compile_milliseconds << ","
+            << r.wall_seconds << "," << r.throughput << "," << r.latency.count << ","
+            << r.latency.min << "," << r.latency.mean << "," << r.latency.p50 << ","
+            << r.latency.p90 << "," << r.latency.p99 << "," << r.latency.p999 << ","
+            << r.latency.max << "," << r.temporary_pool_bytes << "," << r.rss_bytes << ","
+            << r.peak_rss_bytes << "\n";
+    }
+}
+
+void write_load_test_json(const string& path, const vector<LoadTestResult>& results)
+{
+    json j = json::array();
+    for (const LoadTestResult& r : results)
+    {
+        json latency;
+        latency["count"] = r.latency.count;
+        latency["min_us"] = r.latency.min;
+        latency["mean_us"] = r.latency.mean;
+        latency["p50_us"] = r.latency.p50;
+        latency["p90_us"] = r.latency.p90;
+        latency["p99_us"] = r.latency.p99;
+        latency["p999_us"] = r.latency.p999;
+        latency["max_us"] = r.latency.max;
+        latency["log2_histogram"] = r.latency.histogram;
+
+        json jr;
+        jr["model"] = r.model;
+        jr["backend"] = r.backend;
+        jr["batch_size"] = r.batch_size;
+        jr["threads"] = r.threads;
+        jr["executables"] = r.executables;
+        jr["target_qps"] = r.target_qps;
+        jr["compile_ms"] = r.compile_milliseconds;
+        jr["wall_s"] = r.wall_seconds;
+        jr["throughput"] = r.throughput;
+        jr["latency"] = latency;
+        jr["temporary_pool_bytes"] = r.temporary_pool_bytes;
+        jr["rss_bytes"] = r.rss_bytes;
+        jr["peak_rss_bytes"] = r.peak_rss_bytes;
+        j.push_back(jr);
+    }
+    ofstream out(path);
+    if (!out)
+    {
+        throw runtime_error("Unable to open '" + path + "' for writing");
+    }
+    out << setw(4) << json{{"results", j}} << endl;
+}
@@ -0,0 +1,99 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ngraph/function.hpp"
+
+/// Settings for a multi-client load test of a single model.
+struct LoadTestConfig
+{
+    /// Number of concurrent client threads issuing calls.
+    size_t threads = 1;
+    /// Number of independently compiled executables the clients are spread over. Calls on
+    /// the same executable are serialized.
+    size_t executables = 1;
+    /// Calls issued by each client in closed-loop mode, or the total number of calls in
+    /// open-loop mode.
+    size_t iterations = 10;
+    /// Untimed calls made on every executable before measurement starts.
+    size_t warmup_iterations = 1;
+    /// Target request rate in calls per second. Zero selects closed-loop mode, where each
+    /// client issues its next call as soon as the previous one returns.
+    double qps = 0;
+    bool copy_data = true;
+};
+
+/// Latency distribution of all timed calls, in microseconds.
+struct LatencyStats
+{
+    size_t count = 0;
+    double min = 0;
+    double max = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double p999 = 0;
+    /// Number of calls with a latency in [2^i, 2^(i+1)) microseconds.
+    std::vector<size_t> histogram;
+};
+
+struct LoadTestResult
+{
+    std::string model;
+    std::string backend;
+    size_t batch_size = 0;
+    size_t threads = 0;
+    size_t executables = 0;
+    double target_qps = 0;
+    double compile_milliseconds = 0;
+    double wall_seconds = 0;
+    /// Completed calls per second over the timed region.
+    double throughput = 0;
+    LatencyStats latency;
+    /// Sum of the intermediate memory pools of all executables.
+    size_t temporary_pool_bytes = 0;
+    /// Resident set size of the process after the run, and its high-water mark.
+    size_t rss_bytes = 0;
+    size_t peak_rss_bytes = 0;
+};
+
+/// \brief Returns a copy of f with the batch dimension of its parameters set to batch_size.
+///        Only parameters whose leading dimension matches get_batch_size(f) are changed.
+///        Throws if the graph does not type check with the new shapes, for example when it
+///        contains Reshapes with a hard-coded batch dimension.
+std::shared_ptr<ngraph::Function> set_batch_size(std::shared_ptr<ngraph::Function> f,
+                                                 size_t batch_size);
+
+/// \brief Returns the leading dimension of the highest rank parameter of f, or 0 if f has no
+///        static non-scalar parameters.
+size_t get_batch_size(std::shared_ptr<ngraph::Function> f);
+
+LoadTestResult run_load_test(std::shared_ptr<ngraph::Function> f,
+                             const std::string& backend_name,
+                             const LoadTestConfig& config);
+
+LatencyStats compute_latency_stats(std::vector<double> latencies);
+
+void print_load_test_result(const LoadTestResult& result, bool histogram);
+void write_load_test_csv(const std::string& path, const std::vector<LoadTestResult>& results);
+void write_load_test_json(const std::string& path, const std::vector<LoadTestResult>& results);
@@ -24,6 +24,7 @@
 #include <iomanip>
 
 #include "benchmark.hpp"
+#include "load_test.hpp"
 #include "ngraph/except.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
@@ -162,6 +163,16 @@ void print_results(vector<PerfShape> perf_data, bool timing_detail)
     }
 }
 
+vector<size_t> parse_size_list(const string& s)
+{
+    vector<size_t> values;
+    for (const string& value : split(s, ',', true))
+    {
+        values.push_back(stoul(value));
+    }
+    return values;
+}
+
 element::Type get_op_element_type(const Node& op)
 {
     element::Type type;
@@ -197,6 +208,13 @@ int main(int argc, char** argv)
     bool visualize = false;
     int warmup_iterations = 1;
     bool copy_data = true;
+    bool load_test = false;
+    bool latency_histogram = false;
+    LoadTestConfig load_config;
+    vector<size_t> batch_sweep;
+    vector<size_t> thread_sweep;
+    string csv_file;
+    string json_file;
 
     for (size_t i = 1; i < argc; i++)
     {
@@ -253,6 +271,55 @@ int main(int argc, char** argv)
                 failed = true;
             }
         }
+        else if (arg == "-t" || arg == "--threads" || arg == "--executables" || arg == "--qps" ||
+                 arg == "--batch_sweep" || arg == "--thread_sweep")
+        {
+            try
+            {
+                string value = argv[++i];
+                if (arg == "--qps")
+                {
+                    load_config.qps = stod(value);
+                }
+                else if (arg == "--executables")
+                {
+                    load_config.executables = stoul(value);
+                }
+                else if (arg == "--batch_sweep")
+                {
+                    batch_sweep = parse_size_list(value);
+                }
+                else if (arg == "--thread_sweep")
+                {
+                    thread_sweep = parse_size_list(value);
+                }
+                else
+                {
+                    load_config.threads = stoul(value);
+                }
+                load_test = true;
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--latency")
+        {
+            latency_histogram = true;
+            load_test = true;
+        }
+        else if (arg == "--csv")
+        {
+            csv_file = argv[++i];
+            load_test = true;
+        }
+        else if (arg == "--json")
+        {
+            json_file = argv[++i];
+            load_test = true;
+        }
         else
         {
             cout << "Unknown option: " << arg << endl;
@@ -282,7 +349,7 @@ DESCRIPTION
     Benchmark ngraph json model with given backend.
 
 SYNOPSIS
-        nbench [-f <filename>] [-b <backend>] [-i <iterations>]
+        nbench [-f <filename>] [-b <backend>] [-i <iterations>] [-t <threads>] [--qps <rate>]
 
 OPTIONS
         -f|--file                 Serialized model file
@@ -294,10 +361,34 @@ OPTIONS
         --timing_detail           Gather detailed timing
         -w|--warmup_iterations    Number of warm-up iterations
         --no_copy_data            Disable copy of input/result data every iteration
+
+LOAD TEST OPTIONS
+    Any of these options replaces the sequential benchmark with a multi-client load test
+    reporting throughput, latency percentiles and memory high-water marks.
+        -t|--threads              Number of concurrent client threads (default: 1)
+        --executables             Number of compiled executables shared by the clients;
+                                  0 compiles one per client (default: 1)
+        --qps                     Issue calls at a fixed rate (open loop). Iterations is the
+                                  total number of calls. Latency includes queueing delay.
+        --batch_sweep             Comma separated batch sizes to run, e.g. 1,8,32
+        --thread_sweep            Comma separated client thread counts to run, e.g. 1,2,4
+        --latency                 Print a latency histogram
+        --csv                     Write results to a CSV file
+        --json                    Write results to a JSON file
 )###";
         return 1;
     }
 
+    if (batch_sweep.empty())
+    {
+        // Batch size 0 keeps the shapes the model was serialized with
+        batch_sweep.push_back(0);
+    }
+    if (thread_sweep.empty())
+    {
+        thread_sweep.push_back(load_config.threads);
+    }
+
 #if defined NGRAPH_DISTRIBUTED_ENABLE
     unique_ptr<ngraph::Distributed> dist(new ngraph::Distributed());
     if (dist->get_size() == 1)
@@ -326,6 +417,7 @@ OPTIONS
     }
 
     vector<PerfShape> aggregate_perf_data;
+    vector<LoadTestResult> load_results;
     int rc = 0;
     for (const string& model : models)
     {
@@ -395,7 +487,35 @@ OPTIONS
                 }
             }
 
-            if (!backend.empty())
+            if (!backend.empty() && load_test)
+            {
+                cout << "\n---- Load Test ----\n";
+                shared_ptr<Function> model_function = deserialize(model);
+                for (size_t batch_size : batch_sweep)
+                {
+                    shared_ptr<Function> f = batch_size == 0
+                                                 ? model_function
+                                                 : set_batch_size(model_function, batch_size);
+                    for (size_t threads : thread_sweep)
+                    {
+                        LoadTestConfig config = load_config;
+                        config.threads = threads;
+                        config.iterations = iterations;
+                        config.warmup_iterations = warmup_iterations;
+                        config.copy_data = copy_data;
+                        if (load_config.executables == 0)
+                        {
+                            config.executables = threads;
+                        }
+                        LoadTestResult result = run_load_test(f, backend, config);
+                        result.model = model;
+                        cout << "--\n";
+                        print_load_test_result(result, latency_histogram);
+                        load_results.push_back(result);
+                    }
+                }
+            }
+            else if (!backend.empty())
             {
                 cout << "\n---- Benchmark ----\n";
                 shared_ptr<Function> f = deserialize(model);
@@ -428,6 +548,15 @@ OPTIONS
         print_results(aggregate_perf_data, timing_detail);
     }
 
+    if (!csv_file.empty())
+    {
+        write_load_test_csv(csv_file, load_results);
+    }
+    if (!json_file.empty())
+    {
+        write_load_test_json(json_file, load_results);
+    }
+
 #if defined NGRAPH_DISTRIBUTED_ENABLE
     if (dist)
     {
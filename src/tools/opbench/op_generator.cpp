@@ -0,0 +1,346 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <functional>
+#include <unordered_map>
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/op/embedding_lookup.hpp"
+#include "ngraph/op/experimental/generate_mask.hpp"
+#include "op_generator.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+using UnaryBuilder = function<shared_ptr<Node>(const shared_ptr<Node>&)>;
+using BinaryBuilder = function<shared_ptr<Node>(const shared_ptr<Node>&, const shared_ptr<Node>&)>;
+
+#define UNARY(OP)                                                                                  \
+    {                                                                                              \
+        #OP, [](const shared_ptr<Node>& arg) -> shared_ptr<Node> {                                 \
+            return make_shared<op::OP>(arg);                                                       \
+        }                                                                                          \
+    }
+
+#define BINARY(OP)                                                                                 \
+    {                                                                                              \
+        #OP, [](const shared_ptr<Node>& arg0, const shared_ptr<Node>& arg1) -> shared_ptr<Node> {  \
+            return make_shared<op::OP>(arg0, arg1);                                                \
+        }                                                                                          \
+    }
+
+#define REDUCTION(OP)                                                                              \
+    {                                                                                              \
+        #OP, [](const shared_ptr<Node>& arg) -> shared_ptr<Node> {                                 \
+            return make_shared<op::OP>(arg, AxisSet{arg->get_shape().size() - 1});                 \
+        }                                                                                          \
+    }
+
+static const unordered_map<string, UnaryBuilder> s_unary_ops{
+    UNARY(Abs),      UNARY(Acos),    UNARY(Asin), UNARY(Atan),    UNARY(Ceiling),
+    UNARY(Cos),      UNARY(Cosh),    UNARY(Exp),  UNARY(Floor),   UNARY(Log),
+    UNARY(Negative), UNARY(Not),     UNARY(Relu), UNARY(Sigmoid), UNARY(Sign),
+    UNARY(Sin),      UNARY(Sinh),    UNARY(Sqrt), UNARY(Tan),     UNARY(Tanh),
+    UNARY(StopGradient)};
+
+static const unordered_map<string, BinaryBuilder> s_binary_ops{
+    BINARY(Add),     BINARY(And),      BINARY(Divide),   BINARY(Equal),   BINARY(Greater),
+    BINARY(GreaterEq), BINARY(Less),   BINARY(LessEq),   BINARY(Maximum), BINARY(Minimum),
+    BINARY(Multiply),  BINARY(NotEqual), BINARY(Or),     BINARY(Power),   BINARY(Subtract)};
+
+// Reductions run over the innermost axis
+static const unordered_map<string, UnaryBuilder> s_reduction_ops{REDUCTION(All),
+                                                                 REDUCTION(Any),
+                                                                 REDUCTION(Max),
+                                                                 REDUCTION(Min),
+                                                                 REDUCTION(Product),
+                                                                 REDUCTION(Softmax),
+                                                                 REDUCTION(Sum)};
+
+#undef UNARY
+#undef BINARY
+#undef REDUCTION
+
+const vector<string>& get_op_names()
+{
+#define NGRAPH_OP(a, b) #a,
+    static const vector<string> op_names{
+#include "ngraph/op/op_tbl.hpp"
+    };
+#undef NGRAPH_OP
+    return op_names;
+}
+
+static size_t tensor_bytes(const descriptor::Tensor& tensor)
+{
+    return shape_size(tensor.get_shape()) * tensor.get_element_type().size();
+}
+
+static shared_ptr<Node> make_op(const string& op_name,
+                                const Shape& shape,
+                                const element::Type& type,
+                                ParameterVector& params,
+                                double& flops)
+{
+    auto A = make_shared<op::Parameter>(type, shape);
+    params.push_back(A);
+    size_t rank = shape.size();
+    double n = static_cast<double>(shape_size(shape));
+    shared_ptr<Node> node;
+
+    auto unary = s_unary_ops.find(op_name);
+    auto binary = s_binary_ops.find(op_name);
+    auto reduction = s_reduction_ops.find(op_name);
+    if (unary != s_unary_ops.end())
+    {
+        node = unary->second(A);
+        flops = n;
+    }
+    else if (binary != s_binary_ops.end())
+    {
+        auto B = make_shared<op::Parameter>(type, shape);
+        params.push_back(B);
+        node = binary->second(A, B);
+        flops = n;
+    }
+    else if (reduction != s_reduction_ops.end() && rank > 0)
+    {
+        node = reduction->second(A);
+        flops = op_name == "Softmax" ? 3 * n : n;
+    }
+    else if ((op_name == "ArgMax" || op_name == "ArgMin") && rank > 0)
+    {
+        if (op_name == "ArgMax")
+        {
+            node = make_shared<op::ArgMax>(A, rank - 1, element::i32);
+        }
+        else
+        {
+            node = make_shared<op::ArgMin>(A, rank - 1, element::i32);
+        }
+        flops = n;
+    }
+    else if (op_name == "TopK" && rank > 0)
+    {
+        node = make_shared<op::TopK>(A, rank - 1, element::i32, min(shape.back(), size_t(10)));
+        flops = n;
+    }
+    else if (op_name == "Dot" && rank == 2)
+    {
+        auto B = make_shared<op::Parameter>(type, Shape{shape[1], shape[1]});
+        params.push_back(B);
+        node = make_shared<op::Dot>(A, B);
+        flops = 2 * n * shape[1];
+    }
+    else if (op_name == "Broadcast" && rank > 1)
+    {
+        // Broadcast a vector along all outer axes
+        params.clear();
+        A = make_shared<op::Parameter>(type, Shape{shape.back()});
+        params.push_back(A);
+        AxisSet axes;
+        for (size_t i = 0; i < rank - 1; i++)
+        {
+            axes.insert(i);
+        }
+        node = make_shared<op::Broadcast>(A, shape, axes);
+    }
+    else if (op_name == "Concat" && rank > 0)
+    {
+        auto B = make_shared<op::Parameter>(type, shape);
+        params.push_back(B);
+        node = make_shared<op::Concat>(NodeVector{A, B}, 0);
+    }
+    else if (op_name == "Slice" && rank > 0)
+    {
+        Coordinate lower(rank, 0);
+        Coordinate upper(shape);
+        upper[0] = (shape[0] + 1) / 2;
+        node = make_shared<op::Slice>(A, lower, upper);
+    }
+    else if (op_name == "ReplaceSlice" && rank > 0)
+    {
+        Coordinate lower(rank, 0);
+        Coordinate upper(shape);
+        upper[0] = (shape[0] + 1) / 2;
+        Shape slice_shape(shape);
+        slice_shape[0] = upper[0];
+        auto B = make_shared<op::Parameter>(type, slice_shape);
+        params.push_back(B);
+        node = make_shared<op::ReplaceSlice>(A, B, lower, upper);
+    }
+    else if (op_name == "Reshape" && rank > 1)
+    {
+        // Full transpose, the most expensive permutation
+        AxisVector order;
+        Shape out_shape;
+        for (size_t i = rank; i > 0; i--)
+        {
+            order.push_back(i - 1);
+            out_shape.push_back(shape[i - 1]);
+        }
+        node = make_shared<op::Reshape>(A, order, out_shape);
+    }
+    else if (op_name == "Reverse" && rank > 0)
+    {
+        node = make_shared<op::Reverse>(A, AxisSet{rank - 1});
+    }
+    else if (op_name == "Pad" && rank > 0)
+    {
+        auto pad_value = make_shared<op::Parameter>(type, Shape{});
+        params.push_back(pad_value);
+        node = make_shared<op::Pad>(A, pad_value, Shape(rank, 1), Shape(rank, 1), Shape(rank, 0));
+    }
+    else if (op_name == "Convert")
+    {
+        node = make_shared<op::Convert>(A, type == element::f64 ? element::f32 : element::f64);
+    }
+    else if (op_name == "Select")
+    {
+        auto C = make_shared<op::Parameter>(element::boolean, shape);
+        auto B = make_shared<op::Parameter>(type, shape);
+        params = ParameterVector{C, A, B};
+        node = make_shared<op::Select>(C, A, B);
+        flops = n;
+    }
+    else if (op_name == "OneHot")
+    {
+        // The indices are integral whatever the benchmarked type, since fractional indices
+        // are not valid one-hot positions
+        auto indices = make_shared<op::Parameter>(element::i32, shape);
+        params = ParameterVector{indices};
+        Shape out_shape(shape);
+        out_shape.push_back(16);
+        node = make_shared<op::OneHot>(indices, out_shape, rank);
+    }
+    else if (op_name == "Convolution" && rank == 4)
+    {
+        auto filters = make_shared<op::Parameter>(type, Shape{shape[1], shape[1], 3, 3});
+        params.push_back(filters);
+        node = make_shared<op::Convolution>(A,
+                                            filters,
+                                            Strides{1, 1},
+                                            Strides{1, 1},
+                                            CoordinateDiff{1, 1},
+                                            CoordinateDiff{1, 1});
+        flops = 2 * n * shape[1] * 9;
+    }
+    else if (op_name == "MaxPool" && rank == 4)
+    {
+        node = make_shared<op::MaxPool>(A, Shape{3, 3}, Strides{1, 1});
+        flops = static_cast<double>(shape_size(node->get_shape())) * 9;
+    }
+    else if (op_name == "AvgPool" && rank == 4)
+    {
+        node = make_shared<op::AvgPool>(A, Shape{3, 3}, Strides{1, 1});
+        flops = static_cast<double>(shape_size(node->get_shape())) * 9;
+    }
+    else if (op_name == "BatchNormInference" && rank == 4)
+    {
+        Shape channel_shape{shape[1]};
+        auto gamma = make_shared<op::Parameter>(type, channel_shape);
+        auto beta = make_shared<op::Parameter>(type, channel_shape);
+        auto mean = make_shared<op::Parameter>(type, channel_shape);
+        auto variance = make_shared<op::Parameter>(type, channel_shape);
+        params.insert(params.end(), {gamma, beta, mean, variance});
+        node = make_shared<op::BatchNormInference>(A, gamma, beta, mean, variance, 0.001);
+        flops = 2 * n;
+    }
+    else if (op_name == "LRN" && rank == 4)
+    {
+        node = make_shared<op::LRN>(A, 0.0001, 0.75, 1.0, 5);
+        flops = 5 * n;
+    }
+    else if (op_name == "Quantize" && type.is_real())
+    {
+        auto scale = op::Constant::create(type, Shape{}, {0.05});
+        auto offset = op::Constant::create(element::u8, Shape{}, {128});
+        node = make_shared<op::Quantize>(A,
+                                         scale,
+                                         offset,
+                                         element::u8,
+                                         AxisSet{},
+                                         op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_EVEN);
+        flops = 2 * n;
+    }
+    else if (op_name == "Dequantize" && type.is_real())
+    {
+        params.clear();
+        A = make_shared<op::Parameter>(element::u8, shape);
+        params.push_back(A);
+        auto scale = op::Constant::create(type, Shape{}, {0.05});
+        auto offset = op::Constant::create(element::u8, Shape{}, {128});
+        node = make_shared<op::Dequantize>(A, scale, offset, type, AxisSet{});
+        flops = 2 * n;
+    }
+    else if (op_name == "GenerateMask")
+    {
+        params.clear();
+        auto training = op::Constant::create(type, Shape{}, {1});
+        node = make_shared<op::GenerateMask>(training, shape, type, 0, 0.5);
+        flops = n;
+    }
+    return node;
+}
+
+shared_ptr<OpBenchCase>
+    make_op_bench_case(const string& op_name, const Shape& shape, const element::Type& type)
+{
+    auto bench_case = make_shared<OpBenchCase>();
+    bench_case->op_name = op_name;
+    bench_case->flops = 0;
+    bench_case->bytes = 0;
+
+    ParameterVector params;
+    shared_ptr<Node> node;
+    try
+    {
+        node = make_op(op_name, shape, type, params, bench_case->flops);
+    }
+    catch (const ngraph_error&)
+    {
+        // The op rejected this shape or element type
+        return nullptr;
+    }
+    if (node == nullptr)
+    {
+        return nullptr;
+    }
+
+    NodeVector outputs;
+    if (node->get_output_size() == 1)
+    {
+        outputs.push_back(node);
+    }
+    else
+    {
+        for (size_t i = 0; i < node->get_output_size(); i++)
+        {
+            outputs.push_back(make_shared<op::GetOutputElement>(node, i));
+        }
+    }
+    bench_case->function = make_shared<Function>(outputs, params);
+
+    for (const descriptor::Input& input : node->get_inputs())
+    {
+        bench_case->bytes += tensor_bytes(input.get_output().get_tensor());
+    }
+    for (const descriptor::Output& output : node->get_outputs())
+    {
+        bench_case->bytes += tensor_bytes(output.get_tensor());
+    }
+    return bench_case;
+}
@@ -0,0 +1,49 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ngraph/function.hpp"
+#include "ngraph/shape.hpp"
+#include "ngraph/type/element_type.hpp"
+
+/// \brief A single-op function plus the work it performs per call.
+struct OpBenchCase
+{
+    std::string op_name;
+    std::shared_ptr<ngraph::Function> function;
+    // arithmetic operations per call, zero for pure data movement ops
+    double flops;
+    // bytes read from inputs plus bytes written to outputs per call
+    double bytes;
+};
+
+/// \brief Names of every op listed in op_tbl.hpp, in table order.
+const std::vector<std::string>& get_op_names();
+
+/// \brief Build a benchmark function around one op.
+/// \param op_name Op name as it appears in op_tbl.hpp
+/// \param shape Shape of the primary input
+/// \param type Element type of the primary input
+/// \return nullptr if there is no generator for the op or the op cannot be built for the
+///         given shape and type
+std::shared_ptr<OpBenchCase> make_op_bench_case(const std::string& op_name,
+                                                const ngraph::Shape& shape,
+                                                const ngraph::element::Type& type);
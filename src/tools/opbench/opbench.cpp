@@ -0,0 +1,471 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+// Microbenchmarks for every op in op_tbl.hpp across shapes, element types and backends.
+// Each case compiles a single-op function and reports time per call, achieved GFLOP/s
+// and GB/s, and the fraction of machine peak. Results can be saved as JSON and compared
+// against a previous run to catch kernel regressions.
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+
+#include "ngraph/file_util.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/tensor.hpp"
+#include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
+#include "op_generator.hpp"
+
+using namespace std;
+using namespace ngraph;
+using json = nlohmann::json;
+
+struct OpBenchResult
+{
+    string backend;
+    string op_name;
+    string type;
+    string shape;
+    string status;
+    double min_us = 0;
+    double mean_us = 0;
+    double flops = 0;
+    double bytes = 0;
+
+    string key() const { return backend + "/" + op_name + "/" + type + "/" + shape; }
+};
+
+static default_random_engine s_random_engine;
+
+static void random_init(const shared_ptr<runtime::Tensor>& tv)
+{
+    // Integer inputs are 0 or 1, which keeps index inputs (OneHot) in range
+    size_t count = tv->get_element_count();
+    element::Type et = tv->get_element_type();
+    vector<char> data(count * et.size());
+    uniform_real_distribution<double> real_dist(0.1, 1.0);
+    uniform_int_distribution<int> int_dist(0, 1);
+    for (size_t i = 0; i < count; i++)
+    {
+        void* p = data.data() + i * et.size();
+        switch (et.get_type_enum())
+        {
+        case element::Type_t::boolean: *static_cast<char*>(p) = int_dist(s_random_engine); break;
+        case element::Type_t::f32:
+            *static_cast<float*>(p) = static_cast<float>(real_dist(s_random_engine));
+            break;
+        case element::Type_t::f64: *static_cast<double*>(p) = real_dist(s_random_engine); break;
+        case element::Type_t::i8: *static_cast<int8_t*>(p) = int_dist(s_random_engine); break;
+        case element::Type_t::i16: *static_cast<int16_t*>(p) = int_dist(s_random_engine); break;
+        case element::Type_t::i32: *static_cast<int32_t*>(p) = int_dist(s_random_engine); break;
+        case element::Type_t::i64: *static_cast<int64_t*>(p) = int_dist(s_random_engine); break;
+        case element::Type_t::u8: *static_cast<uint8_t*>(p) = int_dist(s_random_engine); break;
+        case element::Type_t::u16: *static_cast<uint16_t*>(p) = int_dist(s_random_engine); break;
+        case element::Type_t::u32: *static_cast<uint32_t*>(p) = int_dist(s_random_engine); break;
+        case element::Type_t::u64: *static_cast<uint64_t*>(p) = int_dist(s_random_engine); break;
+        default: throw runtime_error("unsupported type");
+        }
+    }
+    tv->write(data.data(), 0, data.size());
+}
+
+static Shape parse_shape(const string& s)
+{
+    Shape shape;
+    for (const string& dim : split(s, 'x', true))
+    {
+        shape.push_back(stoul(dim));
+    }
+    return shape;
+}
+
+static element::Type parse_type(const string& s)
+{
+    for (const element::Type* type : element::Type::get_known_types())
+    {
+        if (type->c_type_string() == s)
+        {
+            return *type;
+        }
+    }
+    throw runtime_error("unknown element type '" + s + "'");
+}
+
+// Best-of-N memcpy throughput, counting bytes read and written
+static double measure_memcpy_gbps()
+{
+    const size_t size = 64 * 1024 * 1024;
+    vector<char> src(size, 1);
+    vector<char> dst(size, 0);
+    double best_ns = 0;
+    for (size_t i = 0; i < 5; i++)
+    {
+        stopwatch timer;
+        timer.start();
+        memcpy(dst.data(), src.data(), size);
+        timer.stop();
+        double ns = static_cast<double>(timer.get_nanoseconds());
+        best_ns = (i == 0 || ns < best_ns) ? ns : best_ns;
+    }
+    return 2.0 * size / best_ns;
+}
+
+static void run_case(OpBenchResult& result,
+                     const OpBenchCase& bench_case,
+                     runtime::Backend& backend,
+                     size_t iterations,
+                     size_t warmup_iterations)
+{
+    auto exec = backend.compile(bench_case.function);
+
+    vector<shared_ptr<runtime::Tensor>> args;
+    for (const auto& param : bench_case.function->get_parameters())
+    {
+        auto tv = backend.create_tensor(param->get_element_type(), param->get_shape());
+        random_init(tv);
+        args.push_back(tv);
+    }
+    vector<shared_ptr<runtime::Tensor>> results;
+    for (const auto& out : bench_case.function->get_results())
+    {
+        results.push_back(backend.create_tensor(out->get_element_type(), out->get_shape()));
+    }
+
+    for (size_t i = 0; i < warmup_iterations; i++)
+    {
+        exec->call(results, args);
+    }
+
+    stopwatch timer;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        timer.start();
+        exec->call(results, args);
+        timer.stop();
+        double us = static_cast<double>(timer.get_nanoseconds()) / 1000.0;
+        result.min_us = (i == 0 || us < result.min_us) ? us : result.min_us;
+    }
+    result.mean_us =
+        static_cast<double>(timer.get_total_nanoseconds()) / 1000.0 / max(iterations, size_t(1));
+    result.status = "ok";
+}
+
+static json to_json(const OpBenchResult& r, double peak_gflops, double peak_gbps)
+{
+    json j;
+    j["backend"] = r.backend;
+    j["op"] = r.op_name;
+    j["type"] = r.type;
+    j["shape"] = r.shape;
+    j["status"] = r.status;
+    if (r.status == "ok")
+    {
+        // GFLOP/s and GB/s are computed from the fastest iteration
+        double gflops = r.min_us > 0 ? r.flops / (r.min_us * 1000.0) : 0;
+        double gbps = r.min_us > 0 ? r.bytes / (r.min_us * 1000.0) : 0;
+        j["min_us"] = r.min_us;
+        j["mean_us"] = r.mean_us;
+        j["flops"] = r.flops;
+        j["bytes"] = r.bytes;
+        j["gflops"] = gflops;
+        j["gbps"] = gbps;
+        if (peak_gflops > 0)
+        {
+            j["gflops_fraction_of_peak"] = gflops / peak_gflops;
+        }
+        if (peak_gbps > 0)
+        {
+            j["gbps_fraction_of_peak"] = gbps / peak_gbps;
+        }
+    }
+    return j;
+}
+
+// Returns the number of cases that got slower than the baseline by more than tolerance
+static size_t compare_to_baseline(const vector<OpBenchResult>& results,
+                                  const string& baseline_file,
+                                  double tolerance)
+{
+    ifstream f(baseline_file);
+    if (!f)
+    {
+        throw runtime_error("unable to open baseline file " + baseline_file);
+    }
+    json baseline = json::parse(f);
+    unordered_map<string, double> baseline_us;
+    for (const json& j : baseline.at("results"))
+    {
+        if (j.at("status") == "ok")
+        {
+            string key = j.at("backend").get<string>() + "/" + j.at("op").get<string>() + "/" +
+                         j.at("type").get<string>() + "/" + j.at("shape").get<string>();
+            baseline_us[key] = j.at("min_us").get<double>();
+        }
+    }
+
+    size_t regressions = 0;
+    cout << "\n---- Comparison with baseline (tolerance " << tolerance * 100 << "%) ----\n";
+    for (const OpBenchResult& r : results)
+    {
+        auto it = baseline_us.find(r.key());
+        if (r.status != "ok" || it == baseline_us.end() || it->second <= 0)
+        {
+            continue;
+        }
+        double ratio = r.min_us / it->second;
+        if (ratio > 1 + tolerance)
+        {
+            cout << "REGRESSION  ";
+            regressions++;
+        }
+        else if (ratio < 1 - tolerance)
+        {
+            cout << "IMPROVEMENT ";
+        }
+        else
+        {
+            continue;
+        }
+        cout << r.key() << " " << it->second << "us -> " << r.min_us << "us (x" << ratio
+             << ")\n";
+    }
+    cout << regressions << " regression(s)\n";
+    return regressions;
+}
+
+int main(int argc, char** argv)
+{
+    vector<string> backends;
+    vector<string> ops;
+    vector<Shape> shapes;
+    vector<element::Type> types;
+    size_t iterations = 100;
+    size_t warmup_iterations = 10;
+    string json_file;
+    string baseline_file;
+    double tolerance = 0.1;
+    double peak_gflops = 0;
+    double peak_gbps = 0;
+    bool failed = false;
+
+    for (size_t i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        try
+        {
+            if ((arg == "-b" || arg == "--backend") && i + 1 < argc)
+            {
+                for (const string& b : split(argv[++i], ',', true))
+                {
+                    backends.push_back(b);
+                }
+            }
+            else if ((arg == "-o" || arg == "--op") && i + 1 < argc)
+            {
+                for (const string& op : split(argv[++i], ',', true))
+                {
+                    ops.push_back(op);
+                }
+            }
+            else if ((arg == "-s" || arg == "--shape") && i + 1 < argc)
+            {
+                shapes.push_back(parse_shape(argv[++i]));
+            }
+            else if ((arg == "-t" || arg == "--type") && i + 1 < argc)
+            {
+                for (const string& t : split(argv[++i], ',', true))
+                {
+                    types.push_back(parse_type(t));
+                }
+            }
+            else if ((arg == "-i" || arg == "--iterations") && i + 1 < argc)
+            {
+                iterations = stoul(argv[++i]);
+            }
+            else if ((arg == "-w" || arg == "--warmup_iterations") && i + 1 < argc)
+            {
+                warmup_iterations = stoul(argv[++i]);
+            }
+            else if (arg == "--json" && i + 1 < argc)
+            {
+                json_file = argv[++i];
+            }
+            else if (arg == "--baseline" && i + 1 < argc)
+            {
+                baseline_file = argv[++i];
+            }
+            else if (arg == "--tolerance" && i + 1 < argc)
+            {
+                tolerance = stod(argv[++i]) / 100.0;
+            }
+            else if (arg == "--peak_gflops" && i + 1 < argc)
+            {
+                peak_gflops = stod(argv[++i]);
+            }
+            else if (arg == "--peak_gbps" && i + 1 < argc)
+            {
+                peak_gbps = stod(argv[++i]);
+            }
+            else
+            {
+                cout << "Unknown option: " << arg << endl;
+                failed = true;
+            }
+        }
+        catch (...)
+        {
+            cout << "Invalid Argument\n";
+            failed = true;
+        }
+    }
+    if (!baseline_file.empty() && !file_util::exists(baseline_file))
+    {
+        cout << "Baseline " << baseline_file << " not found\n";
+        failed = true;
+    }
+
+    if (failed)
+    {
+        cout << R"###(
+DESCRIPTION
+    Benchmark individual ops on one or more backends.
+
+SYNOPSIS
+        opbench [-b <backends>] [-o <ops>] [-s <shape>]... [-t <types>] [--json <file>]
+                [--baseline <file>]
+
+OPTIONS
+        -b|--backend              Comma separated backends (default: CPU)
+        -o|--op                   Comma separated ops from op_tbl.hpp (default: all)
+        -s|--shape                Input shape such as 1024x1024, may be repeated
+                                  (default: 1048576, 1024x1024 and 8x64x56x56)
+        -t|--type                 Comma separated element types (default: float)
+        -i|--iterations           Iterations (default: 100)
+        -w|--warmup_iterations    Number of warm-up iterations (default: 10)
+        --json                    Write results to a JSON file
+        --baseline                Compare against results saved with --json
+        --tolerance               Allowed slowdown against the baseline in percent (default: 10)
+        --peak_gflops             Machine peak GFLOP/s used for efficiency (default: not reported)
+        --peak_gbps               Machine peak GB/s used for efficiency (default: measured memcpy)
+
+    Set NGRAPH_CODEGEN=1 to benchmark the CPU backend in codegen mode.
+)###";
+        return 1;
+    }
+
+    if (backends.empty())
+    {
+        backends.push_back("CPU");
+    }
+    if (ops.empty())
+    {
+        ops = get_op_names();
+    }
+    if (shapes.empty())
+    {
+        shapes = {Shape{1048576}, Shape{1024, 1024}, Shape{8, 64, 56, 56}};
+    }
+    if (types.empty())
+    {
+        types.push_back(element::f32);
+    }
+    if (peak_gbps == 0)
+    {
+        peak_gbps = measure_memcpy_gbps();
+        cout << "memcpy bandwidth: " << peak_gbps << " GB/s\n";
+    }
+
+    vector<OpBenchResult> results;
+    for (const string& backend_name : backends)
+    {
+        auto backend = runtime::Backend::create(backend_name);
+        for (const string& op_name : ops)
+        {
+            for (const element::Type& type : types)
+            {
+                for (const Shape& shape : shapes)
+                {
+                    OpBenchResult result;
+                    result.backend = backend_name;
+                    result.op_name = op_name;
+                    result.type = type.c_type_string();
+                    result.shape = join(shape, "x");
+                    auto bench_case = make_op_bench_case(op_name, shape, type);
+                    try
+                    {
+                        if (bench_case == nullptr)
+                        {
+                            result.status = "no generator";
+                        }
+                        else
+                        {
+                            result.flops = bench_case->flops;
+                            result.bytes = bench_case->bytes;
+                            run_case(
+                                result, *bench_case, *backend, iterations, warmup_iterations);
+                        }
+                    }
+                    catch (const unsupported_op&)
+                    {
+                        result.status = "unsupported";
+                    }
+                    catch (const exception& e)
+                    {
+                        result.status = string("error: ") + e.what();
+                    }
+
+                    cout << setw(48) << left << result.key() << " ";
+                    if (result.status == "ok")
+                    {
+                        cout << setw(12) << right << fixed << setprecision(2) << result.min_us
+                             << "us " << setw(10) << result.flops / (result.min_us * 1000.0)
+                             << " GFLOP/s " << setw(10) << result.bytes / (result.min_us * 1000.0)
+                             << " GB/s\n";
+                    }
+                    else
+                    {
+                        cout << result.status << "\n";
+                    }
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    if (!json_file.empty())
+    {
+        json j;
+        j["iterations"] = iterations;
+        j["peak_gflops"] = peak_gflops;
+        j["peak_gbps"] = peak_gbps;
+        j["results"] = json::array();
+        for (const OpBenchResult& r : results)
+        {
+            j["results"].push_back(to_json(r, peak_gflops, peak_gbps));
+        }
+        ofstream out(json_file);
+        out << setw(4) << j << endl;
+    }
+
+    int rc = 0;
+    if (!baseline_file.empty())
+    {
+        rc = compare_to_baseline(results, baseline_file, tolerance) == 0 ? 0 : 1;
+    }
+    return rc;
+}
@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -25,6 +26,8 @@
 #include "ngraph/file_util.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/op/concat.hpp"
+#include "ngraph/op/reshape.hpp"
+#include "ngraph/op/reverse.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
@@ -140,3 +143,63 @@ TEST(benchmark, concat_32x1x200_axis1_6)
         }
     }
 }
+
+//
+// Reports the bandwidth of transposes and reverses of a 16x64x56x56 float tensor on the CPU
+// backend, counting the bytes read and written, next to a memcpy of the same tensor.
+//
+TEST(benchmark, transpose_reverse_bandwidth)
+{
+    Shape shape{16, 64, 56, 56};
+    size_t bytes = shape_size(shape) * sizeof(float);
+    const int n_runs = 20;
+
+    vector<float> data(shape_size(shape));
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    rng.initialize(data);
+
+    auto report = [&](const string& name, const std::function<void()>& cb) {
+        cb();
+        stopwatch sw;
+        sw.start();
+        for (int i = 0; i < n_runs; i++)
+        {
+            cb();
+        }
+        sw.stop();
+        double seconds = sw.get_microseconds() / 1.0e6 / n_runs;
+        std::cout << name << ": " << (2.0 * bytes / seconds / 1.0e9) << " GB/s" << std::endl;
+    };
+
+    vector<float> copy(data.size());
+    report("memcpy", [&]() { memcpy(copy.data(), data.data(), bytes); });
+
+    auto backend = runtime::Backend::create("CPU");
+    auto arg = backend->create_tensor(element::f32, shape);
+    copy_data(arg, data);
+
+    vector<pair<string, AxisVector>> transposes{{"NCHW to NHWC", AxisVector{0, 2, 3, 1}},
+                                                {"NHWC to NCHW", AxisVector{0, 3, 1, 2}},
+                                                {"split heads", AxisVector{0, 2, 1, 3}}};
+    for (auto& transpose : transposes)
+    {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        Shape out_shape;
+        for (size_t axis : transpose.second)
+        {
+            out_shape.push_back(shape[axis]);
+        }
+        auto f = make_shared<Function>(make_shared<op::Reshape>(A, transpose.second, out_shape),
+                                       ParameterVector{A});
+        auto handle = backend->compile(f);
+        auto result = backend->create_tensor(element::f32, out_shape);
+        report(transpose.first, [&]() { handle->call_with_validate({result}, {arg}); });
+    }
+
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f =
+        make_shared<Function>(make_shared<op::Reverse>(A, AxisSet{1, 3}), ParameterVector{A});
+    auto handle = backend->compile(f);
+    auto result = backend->create_tensor(element::f32, shape);
+    report("reverse", [&]() { handle->call_with_validate({result}, {arg}); });
+}
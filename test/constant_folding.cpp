@@ -17,6 +17,8 @@
 #include "ngraph/pass/constant_folding.hpp"
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/op/experimental/generate_mask.hpp"
+#include "ngraph/pass/constant_evaluation.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "util/test_tools.hpp"
 
@@ -285,3 +287,105 @@ TEST(constant_folding, const_quantize)
     vector<output_c_type> values_quantize{2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5};
     ASSERT_EQ(values_quantize, values_out);
 }
+
+#if defined(NGRAPH_INTERPRETER_ENABLE)
+TEST(constant_evaluation, constant_subgraph)
+{
+    // Concat, Convert and Dot are not handled by ConstantFolding
+    auto a = op::Constant::create(element::i32, Shape{1, 2}, {1, 2});
+    auto b = op::Constant::create(element::i32, Shape{1, 2}, {3, 4});
+    auto concat = make_shared<op::Concat>(NodeVector{a, b}, 0);
+    auto convert = make_shared<op::Convert>(concat, element::f32);
+    auto weights = op::Constant::create(element::f32, Shape{2, 2}, {1, 0, 0, 2});
+    auto dot = make_shared<op::Dot>(convert, weights);
+    auto X = make_shared<op::Parameter>(element::f32, Shape{2, 2});
+    auto f = make_shared<Function>(X + dot, ParameterVector{X});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantEvaluation>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Concat>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Convert>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Dot>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Add>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+
+    auto add = f->get_results().at(0)->get_argument(0);
+    auto new_const = std::dynamic_pointer_cast<op::Constant>(add->get_argument(1));
+    ASSERT_TRUE(new_const);
+    ASSERT_EQ((vector<float>{1, 4, 3, 8}), new_const->get_vector<float>());
+}
+
+TEST(constant_evaluation, size_limit)
+{
+    auto scalar = op::Constant::create(element::f32, Shape{}, {1});
+    auto broadcast = make_shared<op::Broadcast>(scalar, Shape{64, 64}, AxisSet{0, 1});
+    auto sum = make_shared<op::Sum>(broadcast, AxisSet{0, 1});
+    auto f = make_shared<Function>(NodeVector{broadcast, sum}, ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantEvaluation>(1024);
+    pass_manager.run_passes(f);
+
+    // The broadcast is too large to be folded, so is everything computed from it
+    ASSERT_EQ(count_ops_of_type<op::Broadcast>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Sum>(f), 1);
+
+    pass::Manager unlimited_manager;
+    unlimited_manager.register_pass<pass::ConstantEvaluation>();
+    unlimited_manager.run_passes(f);
+    ASSERT_EQ(count_ops_of_type<op::Broadcast>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Sum>(f), 0);
+    auto new_const =
+        std::dynamic_pointer_cast<op::Constant>(f->get_results().at(1)->get_argument(0));
+    ASSERT_TRUE(new_const);
+    ASSERT_EQ((vector<float>{4096}), new_const->get_vector<float>());
+}
+
+TEST(constant_evaluation, unknown_backend)
+{
+    auto a = op::Constant::create(element::f32, Shape{2}, {1, 2});
+    auto f = make_shared<Function>(make_shared<op::Negative>(a), ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantEvaluation>(1024, "NOT_A_BACKEND");
+    pass_manager.run_passes(f);
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 1);
+}
+
+TEST(constant_evaluation, failing_op)
+{
+    // Integer division by zero throws, so only the Divide fails to evaluate
+    auto x = op::Constant::create(element::i32, Shape{1}, {1});
+    auto zero = op::Constant::create(element::i32, Shape{1}, {0});
+    auto divide = make_shared<op::Divide>(x, zero);
+    auto a = op::Constant::create(element::f32, Shape{2}, {1, 2});
+    auto f = make_shared<Function>(NodeVector{divide, make_shared<op::Negative>(a)},
+                                   ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantEvaluation>();
+    pass_manager.run_passes(f);
+    ASSERT_EQ(count_ops_of_type<op::Divide>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+
+    auto new_const =
+        std::dynamic_pointer_cast<op::Constant>(f->get_results().at(1)->get_argument(0));
+    ASSERT_TRUE(new_const);
+    ASSERT_EQ((vector<float>{-1, -2}), new_const->get_vector<float>());
+}
+
+TEST(constant_evaluation, nondeterministic)
+{
+    auto training = op::Constant::create(element::f32, Shape{}, {1});
+    auto mask = make_shared<op::GenerateMask>(training, Shape{4}, element::f32, 7, 0.5);
+    auto f = make_shared<Function>(make_shared<op::Negative>(mask), ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantEvaluation>();
+    pass_manager.run_passes(f);
+    ASSERT_EQ(count_ops_of_type<op::GenerateMask>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 1);
+}
+#endif
@@ -0,0 +1,158 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "ngraph/constant_store.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/serializer.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(constant_store, identical_data_is_shared)
+{
+    auto A = op::Constant::create(element::f32, Shape{2, 2}, {1, 2, 3, 4});
+    auto B = op::Constant::create(element::f32, Shape{2, 2}, {1, 2, 3, 4});
+    auto C = op::Constant::create(element::f32, Shape{2, 2}, {1, 2, 3, 5});
+    EXPECT_EQ(A->get_buffer(), B->get_buffer());
+    EXPECT_EQ(A->get_data_ptr(), B->get_data_ptr());
+    EXPECT_NE(A->get_buffer(), C->get_buffer());
+    EXPECT_EQ((vector<float>{1, 2, 3, 5}), C->get_vector<float>());
+}
+
+TEST(constant_store, clone_shares_buffer)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{4});
+    auto W = op::Constant::create(element::f32, Shape{4}, {7, 8, 9, 10});
+    auto f = make_shared<Function>(A * W, ParameterVector{A});
+    auto g = clone_function(*f);
+    for (shared_ptr<Node> node : g->get_ops())
+    {
+        if (auto c = dynamic_pointer_cast<op::Constant>(node))
+        {
+            EXPECT_EQ(W->get_data_ptr(), c->get_data_ptr());
+        }
+    }
+}
+
+TEST(constant_store, buffer_released_with_last_constant)
+{
+    vector<int32_t> values{17, 23, 31, 47, 59};
+    weak_ptr<ConstantBuffer> buffer;
+    {
+        auto A = op::Constant::create(element::i32, Shape{5}, values);
+        buffer = A->get_buffer();
+        EXPECT_FALSE(buffer.expired());
+    }
+    EXPECT_TRUE(buffer.expired());
+}
+
+TEST(constant_store, lazy_generator)
+{
+    size_t calls = 0;
+    auto generator = [&](void* target, size_t size) {
+        calls++;
+        float* p = static_cast<float*>(target);
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            p[i] = static_cast<float>(i);
+        }
+    };
+    auto buffer =
+        ConstantStore::get().from_generator("constant_store.lazy_generator", 16, generator);
+    auto A = make_shared<op::Constant>(element::f32, Shape{4}, buffer);
+    auto B = make_shared<op::Constant>(
+        element::f32,
+        Shape{4},
+        ConstantStore::get().from_generator("constant_store.lazy_generator", 16, generator));
+    EXPECT_EQ(A->get_buffer(), B->get_buffer());
+    EXPECT_FALSE(buffer->is_materialized());
+    EXPECT_EQ(0, calls);
+    EXPECT_EQ((vector<float>{0, 1, 2, 3}), B->get_vector<float>());
+    EXPECT_TRUE(buffer->is_materialized());
+    A->get_vector<float>();
+    EXPECT_EQ(1, calls);
+}
+
+TEST(constant_store, lazy_buffer_size_mismatch)
+{
+    auto buffer = ConstantStore::get().from_generator(
+        "constant_store.lazy_buffer_size_mismatch", 8, [](void*, size_t) {});
+    EXPECT_ANY_THROW(make_shared<op::Constant>(element::f32, Shape{4}, buffer));
+}
+
+TEST(constant_store, lazy_deserialize)
+{
+    const string tmp_file = "constant_store_lazy_deserialize.cpio";
+    auto A = make_shared<op::Parameter>(element::f32, Shape{3});
+    auto W = op::Constant::create(element::f32, Shape{3}, {0.5f, 1.5f, 2.5f});
+    auto f = make_shared<Function>(A + W, ParameterVector{A});
+    serialize(tmp_file, f);
+
+    auto g = deserialize(tmp_file, true);
+    auto h = deserialize(tmp_file, true);
+    shared_ptr<op::Constant> g_const;
+    shared_ptr<op::Constant> h_const;
+    for (shared_ptr<Node> node : g->get_ops())
+    {
+        if (auto c = dynamic_pointer_cast<op::Constant>(node))
+        {
+            g_const = c;
+        }
+    }
+    for (shared_ptr<Node> node : h->get_ops())
+    {
+        if (auto c = dynamic_pointer_cast<op::Constant>(node))
+        {
+            h_const = c;
+        }
+    }
+    ASSERT_NE(g_const, nullptr);
+    ASSERT_NE(h_const, nullptr);
+    EXPECT_EQ(g_const->get_buffer(), h_const->get_buffer());
+    EXPECT_FALSE(g_const->get_buffer()->is_materialized());
+    EXPECT_EQ((vector<float>{0.5f, 1.5f, 2.5f}), h_const->get_vector<float>());
+    file_util::remove_file(tmp_file);
+}
+
+TEST(constant_store, mapped_file)
+{
+    const string tmp_file = "constant_store_mapped_file.bin";
+    vector<float> values{1.0f, 2.0f, 3.0f, 4.0f};
+    {
+        ofstream out(tmp_file, ios::binary);
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+    }
+    {
+        auto buffer = ConstantStore::get().from_mapped_file(tmp_file, 0, 4 * sizeof(float));
+        auto A = make_shared<op::Constant>(element::f32, Shape{4}, buffer);
+        auto B = make_shared<op::Constant>(
+            element::f32,
+            Shape{2},
+            ConstantStore::get().from_mapped_file(tmp_file, 2 * sizeof(float), 2 * sizeof(float)));
+        EXPECT_EQ(buffer, ConstantStore::get().from_mapped_file(tmp_file, 0, 4 * sizeof(float)));
+        EXPECT_TRUE(buffer->is_materialized());
+        EXPECT_EQ(values, A->get_vector<float>());
+        EXPECT_EQ((vector<float>{3.0f, 4.0f}), B->get_vector<float>());
+        EXPECT_ANY_THROW(ConstantStore::get().from_mapped_file(tmp_file, 8, 16));
+    }
+    file_util::remove_file(tmp_file);
+}
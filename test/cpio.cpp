@@ -14,6 +14,8 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <sstream>
+
 #include <gtest/gtest.h>
 
 #include "ngraph/cpio.hpp"
@@ -105,3 +107,71 @@ TEST(cpio, write)
         }
     }
 }
+
+TEST(cpio, stream)
+{
+    string s1 = "this is a test";
+    string s2 = "the quick brown fox jumps over the lazy dog";
+    stringstream archive;
+    {
+        cpio::Writer writer(archive);
+        size_t calls = 0;
+        writer.write("file1.txt", [&](ostream& out) {
+            calls++;
+            out << s1;
+        });
+        EXPECT_EQ(calls, 1);
+        writer.write("file2.txt", s2.data(), static_cast<uint32_t>(s2.size()));
+    }
+
+    cpio::Reader reader(archive);
+    auto file_info = reader.get_file_info();
+    ASSERT_EQ(2, file_info.size());
+    EXPECT_EQ(file_info[0].get_size(), s1.size());
+
+    // Reads of other files may be interleaved with reads from the stream
+    auto in = reader.open_stream(file_info[0]);
+    string first;
+    *in >> first;
+    string content(file_info[1].get_size(), '\0');
+    reader.read(file_info[1], &content[0], content.size());
+    EXPECT_EQ(content, s2);
+    string rest((istreambuf_iterator<char>(*in)), istreambuf_iterator<char>());
+    EXPECT_EQ(first + rest, s1);
+}
+
+TEST(cpio, stream_unseekable)
+{
+    // Appends to a string and does not support seeking
+    class AppendBuffer : public streambuf
+    {
+    public:
+        string data;
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                data.push_back(traits_type::to_char_type(ch));
+            }
+            return traits_type::not_eof(ch);
+        }
+    };
+
+    string s1 = "odd length";
+    AppendBuffer buffer;
+    {
+        ostream out(&buffer);
+        cpio::Writer writer(out);
+        writer.write("file1.txt", [&](ostream& record) { record << s1 << "!"; });
+    }
+
+    stringstream archive(buffer.data);
+    cpio::Reader reader(archive);
+    auto file_info = reader.get_file_info();
+    ASSERT_EQ(1, file_info.size());
+    string content(file_info[0].get_size(), '\0');
+    reader.read(file_info[0], &content[0], content.size());
+    EXPECT_EQ(content, s1 + "!");
+}
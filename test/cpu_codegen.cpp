@@ -15,6 +15,9 @@
 //*****************************************************************************
 
 #include "gtest/gtest.h"
+#include "misc.hpp"
+#include "ngraph/codegen/code_cache.hpp"
+#include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
 #include "util/all_close.hpp"
 #include "util/ndarray.hpp"
@@ -56,3 +59,52 @@ TEST(cpu_codegen, abc)
     EXPECT_EQ(read_vector<float>(result),
               (test::NDArray<float, 2>({{50, 72}, {98, 128}})).get_vector());
 }
+
+TEST(cpu_codegen, code_cache)
+{
+    string cache_dir = file_util::path_join(file_util::get_temp_directory_path(),
+                                            "ngraph_codegen_cache_test");
+    file_util::remove_directory(cache_dir);
+    set_environment("NGRAPH_CODEGEN_CACHE_DIR", cache_dir.c_str(), 1);
+
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    auto f = make_shared<Function>(A * B, ParameterVector{A});
+
+    auto backend = runtime::Backend::create("CPU");
+    shared_ptr<runtime::Tensor> a = backend->create_tensor(element::f32, shape);
+    shared_ptr<runtime::Tensor> result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{5, 6, 7, 8});
+
+    ngraph::pass::PassConfig pass_config{ngraph::pass::CompilationMode::CODEGEN};
+    auto handle = backend->compile(f, pass_config);
+    handle->call_with_validate({result}, {a});
+    EXPECT_EQ(read_vector<float>(result), (vector<float>{5, 12, 21, 32}));
+
+    size_t bitcode_files = 0;
+    size_t object_files = 0;
+    file_util::iterate_files(cache_dir, [&](const string& file, bool is_dir) {
+        string ext = file_util::get_file_ext(file);
+        bitcode_files += (ext == ".bc");
+        object_files += (ext == ".o");
+    });
+    EXPECT_EQ(bitcode_files, 1);
+    EXPECT_EQ(object_files, 1);
+
+    codegen::CodeCache* cache = codegen::CodeCache::get_instance();
+    ASSERT_NE(cache, nullptr);
+    size_t hit_count = cache->get_hit_count();
+
+    // Compiling again loads the cached code and binds the constant in the new executable
+    backend->remove_compiled_function(handle);
+    handle = backend->compile(f, pass_config);
+    // Both the bitcode and the object code were loaded from the cache
+    EXPECT_EQ(cache->get_hit_count(), hit_count + 2);
+    copy_data(a, vector<float>{1, 1, 1, 1});
+    handle->call_with_validate({result}, {a});
+    EXPECT_EQ(read_vector<float>(result), (vector<float>{1, 2, 3, 4}));
+
+    unset_environment("NGRAPH_CODEGEN_CACHE_DIR");
+    file_util::remove_directory(cache_dir);
+}
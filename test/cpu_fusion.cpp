@@ -54,6 +54,7 @@
 #include "ngraph/pattern/op/skip.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
+#include "ngraph/runtime/cpu/op/attention.hpp"
 #include "ngraph/runtime/cpu/op/batch_dot.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
 #include "ngraph/runtime/cpu/op/bounded_relu.hpp"
@@ -67,12 +68,15 @@
 #include "ngraph/runtime/cpu/op/loop_kernel.hpp"
 #include "ngraph/runtime/cpu/op/lstm.hpp"
 #include "ngraph/runtime/cpu/op/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/op/matmul_epilogue.hpp"
+#include "ngraph/runtime/cpu/op/quantized_lookup.hpp"
 #include "ngraph/runtime/cpu/op/rnn.hpp"
 #include "ngraph/runtime/cpu/op/rnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
 #include "ngraph/runtime/cpu/op/update_slice.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_loop_kernel_fusion.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_lstm_sequence_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_mat_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_post_layout_optimizations.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_rnn_fusion.hpp"
@@ -999,6 +1003,159 @@ TEST(cpu_fusion, conv_horizontal_fusion)
     ASSERT_EQ(cpu_cb, 1);
 }
 
+TEST(cpu_fusion, gemm_horizontal_fusion)
+{
+    Shape shape_x{4, 2};
+
+    auto make_function = [shape_x]() {
+        auto X = std::make_shared<op::Parameter>(element::f32, shape_x);
+        auto weights1 = op::Constant::create(
+            element::f32, Shape{3, 4}, {1., 2., 3., 4., 5., 6., -1., -2., -3., .5, .25, .125});
+        auto bias1 = op::Constant::create(element::f32, Shape{3}, {0.1f, 0.2f, 0.3f});
+        auto dot1 = std::make_shared<op::Dot>(weights1, X);
+        auto out1 = dot1 + std::make_shared<op::Broadcast>(bias1, dot1->get_shape(), AxisSet{1});
+
+        auto weights2 = op::Constant::create(element::f32,
+                                             Shape{5, 4},
+                                             {1, 0, 1, 0, 1, 2, 2, 2, 2, 2, -1, 1, -1, 1, -1,
+                                              3, 0, 0, 0, 3});
+        auto bias2 = op::Constant::create(element::f32, Shape{5}, {1, 2, 3, 4, 5});
+        auto dot2 = std::make_shared<op::Dot>(weights2, X);
+        auto out2 = dot2 + std::make_shared<op::Broadcast>(bias2, dot2->get_shape(), AxisSet{1});
+
+        return make_shared<Function>(NodeVector{out1, out2}, ParameterVector{X});
+    };
+    auto int_f = make_function();
+    auto cpu_f = make_function();
+
+    vector<vector<float>> args{{1.25f, -2.25f, 5.25f, 6.25f, 0.f, 1.f, -1.f, 2.f}};
+
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    EXPECT_TRUE(test::all_close(cpu_results.at(0), int_results.at(0)));
+    EXPECT_TRUE(test::all_close(cpu_results.at(1), int_results.at(1)));
+
+    size_t cpu_mmb = count_ops_of_type<op::MatmulBias>(cpu_f);
+    ASSERT_EQ(cpu_mmb, 1);
+}
+
+TEST(cpu_fusion, gemm_horizontal_fusion_activation)
+{
+    Shape shape_x{4, 2};
+
+    auto make_function = [shape_x]() {
+        auto X = std::make_shared<op::Parameter>(element::f32, shape_x);
+        auto weights1 = op::Constant::create(
+            element::f32, Shape{3, 4}, {1., 2., 3., 4., 5., 6., -1., -2., -3., .5, .25, .125});
+        auto bias1 = op::Constant::create(element::f32, Shape{3}, {0.1f, 0.2f, -0.3f});
+        auto dot1 = std::make_shared<op::Dot>(weights1, X);
+        auto out1 = std::make_shared<op::Relu>(
+            dot1 + std::make_shared<op::Broadcast>(bias1, dot1->get_shape(), AxisSet{1}));
+
+        auto weights2 = op::Constant::create(element::f32,
+                                             Shape{5, 4},
+                                             {1, 0, 1, 0, 1, 2, 2, 2, 2, 2, -1, 1, -1, 1, -1,
+                                              3, 0, 0, 0, 3});
+        auto bias2 = op::Constant::create(element::f32, Shape{5}, {1, -2, 3, -4, 5});
+        auto dot2 = std::make_shared<op::Dot>(weights2, X);
+        auto out2 = std::make_shared<op::Tanh>(
+            dot2 + std::make_shared<op::Broadcast>(bias2, dot2->get_shape(), AxisSet{1}));
+
+        return make_shared<Function>(NodeVector{out1, out2}, ParameterVector{X});
+    };
+    auto int_f = make_function();
+    auto cpu_f = make_function();
+
+    vector<vector<float>> args{{1.25f, -2.25f, 5.25f, 6.25f, 0.f, 1.f, -1.f, 2.f}};
+
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    EXPECT_TRUE(test::all_close(cpu_results.at(0), int_results.at(0)));
+    EXPECT_TRUE(test::all_close(cpu_results.at(1), int_results.at(1)));
+
+    // Fused horizontally before the activations could be folded into MatmulEpilogue nodes
+    EXPECT_EQ(count_ops_of_type<op::MatmulBias>(cpu_f), 1);
+    EXPECT_EQ(count_ops_of_type<op::MatmulEpilogue>(cpu_f), 0);
+}
+
+TEST(cpu_fusion, gemm_horizontal_fusion_columns)
+{
+    // Sharing the left operand splits the fused output by columns, which is only contiguous
+    // for a single row
+    auto make_function = [](const Shape& shape_x) {
+        auto X = std::make_shared<op::Parameter>(element::f32, shape_x);
+        auto weights1 = op::Constant::create(
+            element::f32, Shape{4, 3}, {1., 2., 3., 4., 5., 6., -1., -2., -3., .5, .25, .125});
+        auto weights2 = op::Constant::create(element::f32,
+                                             Shape{4, 5},
+                                             {1, 0, 1, 0, 1, 2, 2, 2, 2, 2, -1, 1, -1, 1, -1,
+                                              3, 0, 0, 0, 3});
+        auto dot1 = std::make_shared<op::Dot>(X, weights1);
+        auto dot2 = std::make_shared<op::Dot>(X, weights2);
+        return make_shared<Function>(NodeVector{dot1, dot2}, ParameterVector{X});
+    };
+
+    for (size_t rows : {1, 2})
+    {
+        auto int_f = make_function(Shape{rows, 4});
+        auto cpu_f = make_function(Shape{rows, 4});
+
+        vector<vector<float>> args{{1.25f, -2.25f, 5.25f, 6.25f, 0.f, 1.f, -1.f, 2.f}};
+        args[0].resize(rows * 4);
+
+        auto int_results = execute(int_f, args, "INTERPRETER");
+        auto cpu_results = execute(cpu_f, args, "CPU");
+        EXPECT_TRUE(test::all_close(cpu_results.at(0), int_results.at(0)));
+        EXPECT_TRUE(test::all_close(cpu_results.at(1), int_results.at(1)));
+        EXPECT_EQ(count_ops_of_type<op::MatmulBias>(cpu_f), rows == 1 ? 1 : 2);
+    }
+}
+
+TEST(cpu_fusion, attention)
+{
+    // More keys than fit in one tile, so the running softmax is rescaled
+    Shape shape_q{2, 5, 8};
+    Shape shape_k{2, 70, 8};
+    Shape shape_v{2, 70, 4};
+    Shape shape_mask{2, 70};
+
+    auto make_function = [shape_q, shape_k, shape_v, shape_mask]() {
+        auto Q = std::make_shared<op::Parameter>(element::f32, shape_q);
+        auto K = std::make_shared<op::Parameter>(element::f32, shape_k);
+        auto V = std::make_shared<op::Parameter>(element::f32, shape_v);
+        auto mask = std::make_shared<op::Parameter>(element::f32, shape_mask);
+        auto scores = std::make_shared<op::BatchDot>(Q, K, false, true);
+        auto scale = std::make_shared<op::Broadcast>(
+            op::Constant::create(element::f32, Shape{}, {0.35f}),
+            scores->get_shape(),
+            AxisSet{0, 1, 2});
+        auto logits = scores * scale +
+                      std::make_shared<op::Broadcast>(mask, scores->get_shape(), AxisSet{1});
+        auto softmax = std::make_shared<op::Softmax>(logits, AxisSet{2});
+        auto attention = std::make_shared<op::BatchDot>(softmax, V, false, false);
+        return make_shared<Function>(NodeVector{attention}, ParameterVector{Q, K, V, mask});
+    };
+    auto cpu_f1 = make_function();
+    auto cpu_f2 = make_function();
+
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : cpu_f1->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+
+    set_environment("NGRAPH_PASS_ENABLES", "CPUFusion:0", 1);
+    auto cpu1_results = execute(cpu_f1, args, "CPU");
+    set_environment("NGRAPH_PASS_ENABLES", "CPUFusion:1", 1);
+    auto cpu2_results = execute(cpu_f2, args, "CPU");
+    EXPECT_TRUE(test::all_close(cpu1_results.at(0), cpu2_results.at(0)));
+    ASSERT_EQ(count_ops_of_type<op::Attention>(cpu_f2), 1);
+    ASSERT_EQ(count_ops_of_type<op::Softmax>(cpu_f2), 0);
+}
+
 // ConvolutionBiasAdd relies on an in-place fused MKLDNN kernel.
 // Need to ensure that it is fused only when in-place buffer allocation is feasible
 shared_ptr<Function> gen_conv_bias_add(bool param_input, bool result_output)
@@ -3465,6 +3622,142 @@ TEST(cpu_fusion, rnn_input_fusion_inter_vs_cpu)
     }
 }
 
+// Builds an LSTM unrolled the way the ONNX importer does: one Dot for the input projection of
+// every time step, gates in the order i, o, f, c, and the arguments of every elementwise op
+// wrapped in a Reshape and a Broadcast
+static std::shared_ptr<Function> create_unrolled_lstm_function(
+    size_t seq_length, size_t batch, size_t input_size, size_t hidden_size, bool clip = false)
+{
+    auto X = make_shared<op::Parameter>(element::f32, Shape{seq_length, batch, input_size});
+    auto W = make_shared<op::Parameter>(element::f32, Shape{4 * hidden_size, input_size});
+    auto R = make_shared<op::Parameter>(element::f32, Shape{4 * hidden_size, hidden_size});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{8 * hidden_size});
+    auto H0 = make_shared<op::Parameter>(element::f32, Shape{1, batch, hidden_size});
+    auto C0 = make_shared<op::Parameter>(element::f32, Shape{1, batch, hidden_size});
+
+    auto broadcast = [](const shared_ptr<Node>& node, const Shape& shape) -> shared_ptr<Node> {
+        Shape squeezed;
+        AxisSet axes;
+        size_t offset = shape.size() - node->get_shape().size();
+        for (size_t i = 0; i < shape.size(); i++)
+        {
+            if (i < offset || node->get_shape()[i - offset] == 1)
+            {
+                axes.insert(i);
+            }
+            else
+            {
+                squeezed.push_back(shape[i]);
+            }
+        }
+        auto reshape = make_shared<op::Reshape>(
+            node, get_default_order(node->get_shape().size()), squeezed);
+        return make_shared<op::Broadcast>(reshape, shape, axes);
+    };
+    auto add = [&](const shared_ptr<Node>& a, const shared_ptr<Node>& b) -> shared_ptr<Node> {
+        return make_shared<op::Add>(broadcast(a, a->get_shape()), broadcast(b, a->get_shape()));
+    };
+    auto mul = [&](const shared_ptr<Node>& a, const shared_ptr<Node>& b) -> shared_ptr<Node> {
+        return make_shared<op::Multiply>(broadcast(a, a->get_shape()),
+                                         broadcast(b, a->get_shape()));
+    };
+    auto gate = [hidden_size](const shared_ptr<Node>& gates, size_t index) -> shared_ptr<Node> {
+        return make_shared<op::Slice>(gates,
+                                      Coordinate{0, index * hidden_size},
+                                      Coordinate{gates->get_shape()[0], (index + 1) * hidden_size});
+    };
+
+    auto bias = make_shared<op::Slice>(B, Coordinate{0}, Coordinate{4 * hidden_size}) +
+                make_shared<op::Slice>(B, Coordinate{4 * hidden_size}, Coordinate{8 * hidden_size});
+    auto x_w = make_shared<op::Dot>(
+        make_shared<op::Reshape>(X, AxisVector{0, 1, 2}, Shape{seq_length * batch, input_size}),
+        make_shared<op::Reshape>(W, AxisVector{1, 0}, Shape{input_size, 4 * hidden_size}));
+    auto r_t = make_shared<op::Reshape>(R, AxisVector{1, 0}, Shape{hidden_size, 4 * hidden_size});
+    shared_ptr<Node> h_t =
+        make_shared<op::Reshape>(H0, AxisVector{0, 1, 2}, Shape{batch, hidden_size});
+    shared_ptr<Node> c_t =
+        make_shared<op::Reshape>(C0, AxisVector{0, 1, 2}, Shape{batch, hidden_size});
+
+    NodeVector h_list;
+    for (size_t t = 0; t < seq_length; t++)
+    {
+        auto x_t = make_shared<op::Slice>(
+            x_w, Coordinate{t * batch, 0}, Coordinate{(t + 1) * batch, 4 * hidden_size});
+        auto gates = add(x_t, add(make_shared<op::Dot>(h_t, r_t), bias));
+        shared_ptr<Node> c = gate(gates, 3);
+        if (clip)
+        {
+            auto threshold = op::Constant::create(
+                element::f32, c->get_shape(), vector<float>(shape_size(c->get_shape()), 0.5f));
+            c = make_shared<op::Minimum>(c, threshold);
+        }
+        auto i = make_shared<op::Sigmoid>(gate(gates, 0));
+        auto f = make_shared<op::Sigmoid>(gate(gates, 2));
+        c_t = add(mul(f, c_t), mul(i, make_shared<op::Tanh>(c)));
+        auto o = make_shared<op::Sigmoid>(gate(gates, 1));
+        h_t = mul(o, make_shared<op::Tanh>(c_t));
+        h_list.push_back(
+            make_shared<op::Reshape>(h_t, AxisVector{0, 1}, Shape{1, batch, hidden_size}));
+    }
+    auto Y = make_shared<op::Concat>(h_list, 0);
+    auto Y_c = make_shared<op::Reshape>(c_t, AxisVector{0, 1}, Shape{1, batch, hidden_size});
+    return make_shared<Function>(NodeVector{Y, Y_c}, ParameterVector{X, W, R, B, H0, C0});
+}
+
+TEST(cpu_fusion, lstm_sequence_fusion)
+{
+    auto func = create_unrolled_lstm_function(5, 3, 10, 4);
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::LSTMSequenceFusion>();
+    pass_manager.run_passes(func);
+    auto rnn_ops = get_ops_of_type<op::Rnn>(func);
+    ASSERT_EQ(rnn_ops.size(), 1);
+    EXPECT_EQ(rnn_ops[0]->get_src_sequence_length(), 5);
+    EXPECT_EQ(rnn_ops[0]->get_batch_size(), 3);
+    EXPECT_EQ(count_ops_of_type<op::Dot>(func), 0);
+    EXPECT_EQ(count_ops_of_type<op::Sigmoid>(func), 0);
+}
+
+TEST(cpu_fusion, lstm_sequence_fusion_clip)
+{
+    // Clipping has no Rnn counterpart, so the cells stay unrolled
+    auto func = create_unrolled_lstm_function(5, 3, 10, 4, true);
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::LSTMSequenceFusion>();
+    pass_manager.run_passes(func);
+    EXPECT_EQ(count_ops_of_type<op::Rnn>(func), 0);
+    EXPECT_EQ(count_ops_of_type<op::Dot>(func), 6);
+}
+
+TEST(cpu_fusion, lstm_sequence_fusion_inter_vs_cpu)
+{
+    auto int_f = create_unrolled_lstm_function(5, 3, 10, 4);
+    auto cpu_f = create_unrolled_lstm_function(5, 3, 10, 4);
+    auto cpu_fallback_f = create_unrolled_lstm_function(5, 3, 10, 4);
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : int_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    EXPECT_EQ(count_ops_of_type<op::Rnn>(cpu_f), 1);
+    // Without MKLDNN the Rnn node runs on the batched CPU kernel
+    set_environment("NGRAPH_PASS_ENABLES", "CPUAssignment:0", 1);
+    auto cpu_fallback_results = execute(cpu_fallback_f, args, "CPU");
+    set_environment("NGRAPH_PASS_ENABLES", "CPUAssignment:1", 1);
+    EXPECT_EQ(count_ops_of_type<op::Rnn>(cpu_fallback_f), 1);
+    for (size_t i = 0; i < int_results.size(); i++)
+    {
+        EXPECT_TRUE(test::all_close(cpu_results.at(i), int_results.at(i), 1.0e-4f, 1.0e-4f));
+        EXPECT_TRUE(
+            test::all_close(cpu_fallback_results.at(i), int_results.at(i), 1.0e-4f, 1.0e-4f));
+    }
+}
+
 TEST(cpu_fusion, validate_fuse_gru_inputs)
 {
     const std::string file_name("mxnet/gru_debug.json");
@@ -3944,6 +4237,50 @@ TEST(cpu_quant_fusion, qconvba)
     EXPECT_TRUE(test::all_close(cpu1_results.at(0), cpu2_results.at(0)));
 }
 
+TEST(cpu_quant_fusion, dq_elementwise_q)
+{
+    auto make_function = []() {
+        Shape shape_input{2, 3, 4, 4};
+        auto input = std::make_shared<op::Parameter>(element::f32, shape_input);
+        auto input_scale = op::Constant::create(element::f32, Shape{}, {0.25f});
+        auto output_scale = op::Constant::create(element::f32, Shape{}, {0.5f});
+        auto int8_offset = op::Constant::create(element::i8, Shape{}, {3});
+        auto uint8_zero = op::Constant::create(element::u8, Shape{}, {0});
+
+        op::Quantize::RoundMode round_mode = op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_EVEN;
+        auto q_input = std::make_shared<op::Quantize>(
+            input, input_scale, int8_offset, element::i8, AxisSet{}, round_mode);
+        auto dq = std::make_shared<op::Dequantize>(
+            q_input, input_scale, int8_offset, element::f32, AxisSet{});
+        auto relu = std::make_shared<op::Relu>(std::make_shared<op::Negative>(dq));
+        auto q = std::make_shared<op::Quantize>(
+            relu, output_scale, uint8_zero, element::u8, AxisSet{}, round_mode);
+        auto dq_out = std::make_shared<op::Dequantize>(
+            q, output_scale, uint8_zero, element::f32, AxisSet{});
+        return make_shared<Function>(NodeVector{dq_out}, ParameterVector{input});
+    };
+
+    auto cpu_f1 = make_function();
+    auto cpu_f2 = make_function();
+
+    test::Uniform<float> rng(-40.0f, 40.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : cpu_f1->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+
+    set_environment("NGRAPH_PASS_ENABLES", "CPUQuantFusion:0", 1);
+    auto cpu1_results = execute(cpu_f1, args, "CPU");
+    set_environment("NGRAPH_PASS_ENABLES", "CPUQuantFusion:1", 1);
+    auto cpu2_results = execute(cpu_f2, args, "CPU");
+    EXPECT_TRUE(test::all_close(cpu1_results.at(0), cpu2_results.at(0)));
+    EXPECT_EQ(count_ops_of_type<op::QuantizedLookup>(cpu_f2), 1);
+    EXPECT_EQ(count_ops_of_type<op::Relu>(cpu_f2), 0);
+}
+
 TEST(cpu_fusion, fuse_bi_directional_rnn)
 {
     pass::Manager pass_manager;
@@ -3986,3 +4323,46 @@ TEST(cpu_fusion, bi_rnn_interpreter_vs_cpu)
         EXPECT_TRUE(test::all_close(cpu_results.at(i), int_results.at(i), 1.0e-4f, 1.0e-4f));
     }
 }
+
+TEST(cpu_fusion, matmul_epilogue)
+{
+    auto make_function = []() {
+        auto W = make_shared<op::Parameter>(element::f32, Shape{4, 3});
+        auto x = make_shared<op::Parameter>(element::f32, Shape{3, 5});
+        auto b = make_shared<op::Parameter>(element::f32, Shape{5});
+        auto residual = make_shared<op::Parameter>(element::f32, Shape{4, 5});
+        auto dot = make_shared<op::Dot>(W, x);
+        auto bias = make_shared<op::Broadcast>(b, dot->get_shape(), AxisSet{0});
+        auto relu = make_shared<op::Relu>(dot + bias);
+        auto scale = make_shared<op::Broadcast>(
+            op::Constant::create(element::f32, Shape{}, {0.5f}), dot->get_shape(), AxisSet{0, 1});
+        auto tanh = make_shared<op::Tanh>((relu + residual) * scale);
+        return make_shared<Function>(NodeVector{tanh}, ParameterVector{W, x, b, residual});
+    };
+
+    auto func = make_function();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUFusion>(pass::REGULAR_FUSIONS);
+    pass_manager.register_pass<runtime::cpu::pass::CPUMatmulEpilogueFusion>();
+    pass_manager.run_passes(func);
+    auto mmes = get_ops_of_type<op::MatmulEpilogue>(func);
+    ASSERT_EQ(mmes.size(), 1);
+    // Bias, Relu, residual Add, scaling and Tanh
+    EXPECT_EQ(mmes[0]->get_steps().size(), 5);
+    EXPECT_EQ(count_ops_of_type<op::Broadcast>(func), 0);
+
+    auto int_f = make_function();
+    auto cpu_f = make_function();
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : cpu_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    EXPECT_EQ(count_ops_of_type<op::MatmulEpilogue>(cpu_f), 1);
+    EXPECT_TRUE(test::all_close(cpu_results.at(0), int_results.at(0), 1.0e-4f, 1.0e-4f));
+}
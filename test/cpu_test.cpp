@@ -33,6 +33,7 @@
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
+#include "ngraph/runtime/cpu/cpu_resource_manager.hpp"
 #include "ngraph/runtime/cpu/op/convert_layout.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
@@ -813,6 +814,48 @@ TEST(cpu_test, memory_reuse_cacheable_no_destructive_oi_relu)
     EXPECT_EQ(read_vector<float>(result), expected);
 }
 
+TEST(cpu_test, incremental_execution_stale_rows)
+{
+    Shape shape{4, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape, true);
+    auto B = make_shared<op::Parameter>(element::f32, shape, true);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto relu = make_shared<op::Relu>(A + B);
+    auto f = make_shared<Function>(relu * C, ParameterVector{A, B, C});
+
+    auto backend = runtime::Backend::create("CPU");
+
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    auto b = backend->create_tensor(element::f32, shape);
+    copy_data(b, vector<float>(12, 0));
+    auto c = backend->create_tensor(element::f32, shape);
+    copy_data(c, vector<float>(12, 1));
+    auto result = backend->create_tensor(element::f32, shape);
+
+    shared_ptr<runtime::Executable> handle = backend->compile(f);
+    ASSERT_NE(handle, nullptr);
+    handle->call_with_validate({result}, {a, b, c});
+    EXPECT_EQ((vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}), read_vector<float>(result));
+
+    // Rows that are not marked stale keep their previously computed values
+    copy_data(a, vector<float>{-1, -2, -3, 40, 50, 60, -7, -8, -9, -10, -11, -12});
+    a->set_stale(false);
+    a->set_stale_rows(1, 2);
+    b->set_stale(false);
+    handle->call_with_validate({result}, {a, b, c});
+    EXPECT_EQ((vector<float>{1, 2, 3, 40, 50, 60, 7, 8, 9, 10, 11, 12}),
+              read_vector<float>(result));
+
+    // Marked ranges accumulate
+    a->set_stale(false);
+    a->set_stale_rows(3, 4);
+    a->set_stale_rows(0, 1);
+    EXPECT_EQ(a->get_stale_rows(), make_pair(size_t(0), size_t(4)));
+    handle->call_with_validate({result}, {a, b, c});
+    EXPECT_EQ((vector<float>{0, 0, 0, 40, 50, 60, 0, 0, 0, 0, 0, 0}), read_vector<float>(result));
+}
+
 TEST(cpu_test, memory_reuse_in_place_concat_after_in_place_slice)
 {
     Shape shape_a{4, 4};
@@ -919,3 +962,290 @@ TEST(cpu_test, rotated_pooling)
     compare_backends(
         make_f(false, false), make_f(false, false), "INTERPRETER", "CPU"); // 5D MaxPool
 }
+
+TEST(cpu_test, topk_partial_selection)
+{
+    auto make_f = [&](const Shape& shape,
+                      size_t axis,
+                      size_t k,
+                      bool compute_max,
+                      const element::Type& index_type) {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto topk = make_shared<op::TopK>(A, axis, index_type, k, compute_max);
+        auto indices = make_shared<op::GetOutputElement>(topk, 0);
+        auto values = make_shared<op::GetOutputElement>(topk, 1);
+        return make_shared<Function>(
+            NodeVector{make_shared<op::Convert>(indices, element::f32), values},
+            ParameterVector{A});
+    };
+
+    // Heap selection: k is small next to the axis length
+    compare_backends(make_f(Shape{4, 1000}, 1, 5, true, element::i64),
+                     make_f(Shape{4, 1000}, 1, 5, true, element::i64),
+                     "INTERPRETER",
+                     "CPU");
+    compare_backends(make_f(Shape{4, 1000}, 1, 7, false, element::i32),
+                     make_f(Shape{4, 1000}, 1, 7, false, element::i32),
+                     "INTERPRETER",
+                     "CPU");
+    // Strided slices along a middle axis
+    compare_backends(make_f(Shape{3, 200, 5}, 1, 10, true, element::i32),
+                     make_f(Shape{3, 200, 5}, 1, 10, true, element::i32),
+                     "INTERPRETER",
+                     "CPU");
+    // Partition and sort: k is a large fraction of the axis
+    compare_backends(make_f(Shape{6, 40}, 1, 30, true, element::i64),
+                     make_f(Shape{6, 40}, 1, 30, true, element::i64),
+                     "INTERPRETER",
+                     "CPU");
+    compare_backends(make_f(Shape{40, 6}, 0, 40, false, element::i64),
+                     make_f(Shape{40, 6}, 0, 40, false, element::i64),
+                     "INTERPRETER",
+                     "CPU");
+}
+
+TEST(cpu_test, quantize_dequantize_per_channel)
+{
+    auto make_f = [&](op::Quantize::RoundMode round_mode, const element::Type& type) {
+        Shape shape{2, 3, 5, 4};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto scale = op::Constant::create(element::f32, Shape{3}, {0.01f, 0.02f, 0.05f});
+        auto offset = op::Constant::create(type, Shape{3}, {0, 2, 1});
+        auto q = make_shared<op::Quantize>(A, scale, offset, type, AxisSet{1}, round_mode);
+        auto dq = make_shared<op::Dequantize>(q, scale, offset, element::f32, AxisSet{1});
+        return make_shared<Function>(dq, ParameterVector{A});
+    };
+
+    for (auto round_mode : {op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_INFINITY,
+                            op::Quantize::RoundMode::ROUND_NEAREST_TOWARD_EVEN,
+                            op::Quantize::RoundMode::ROUND_TOWARD_ZERO,
+                            op::Quantize::RoundMode::ROUND_DOWN})
+    {
+        compare_backends(make_f(round_mode, element::i8),
+                         make_f(round_mode, element::i8),
+                         "INTERPRETER",
+                         "CPU");
+        compare_backends(make_f(round_mode, element::u8),
+                         make_f(round_mode, element::u8),
+                         "INTERPRETER",
+                         "CPU");
+    }
+}
+
+TEST(cpu_test, quantize_in_place)
+{
+    // The Quantize is the only user of the Multiply and does not go through MKLDNN, so its i8
+    // result is written over the f32 product. The shape is large enough for the kernel to
+    // reach its parallel in-place ranges.
+    auto make_f = []() {
+        Shape shape{100, 100};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto scale = op::Constant::create(element::f32, Shape{}, {0.5f});
+        auto offset = op::Constant::create(element::i8, Shape{}, {0});
+        auto q = make_shared<op::Quantize>(A * B,
+                                           scale,
+                                           offset,
+                                           element::i8,
+                                           AxisSet{},
+                                           op::Quantize::RoundMode::ROUND_NEAREST_UPWARD);
+        auto dq = make_shared<op::Dequantize>(q, scale, offset, element::f32, AxisSet{});
+        return make_shared<Function>(dq, ParameterVector{A, B});
+    };
+
+    auto cpu_f = make_f();
+    auto int_f = make_f();
+
+    test::Uniform<float> rng(-7.0f, 7.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : cpu_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    EXPECT_TRUE(test::all_close(cpu_results.at(0), int_results.at(0)));
+
+    size_t in_place = 0;
+    for (auto node : cpu_f->get_ordered_ops())
+    {
+        if (node->description() == "Quantize")
+        {
+            EXPECT_EQ(node->get_output_tensor().get_pool_offset(),
+                      node->get_inputs().at(0).get_tensor().get_pool_offset());
+            in_place++;
+        }
+    }
+    EXPECT_EQ(in_place, 1);
+}
+
+TEST(cpu_test, eltwise_layout_cost_model)
+{
+    // The Add feeds a layout-agnostic Sum, so keeping it in the convolution's blocked layout
+    // would need a reorder of C on the way in and of the sum on the way out.
+    auto make_function = []() -> std::shared_ptr<Function> {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{1, 16, 2, 2});
+        auto B = make_shared<op::Parameter>(element::f32, Shape{32, 16, 1, 1});
+        auto C = make_shared<op::Parameter>(element::f32, Shape{1, 32, 2, 2});
+        auto conv = make_shared<op::Convolution>(A,
+                                                 B,
+                                                 Strides{1, 1},
+                                                 Strides{1, 1},
+                                                 CoordinateDiff{0, 0},
+                                                 CoordinateDiff{0, 0},
+                                                 Strides{1, 1});
+        auto add = make_shared<op::Add>(conv, C);
+        auto sum = make_shared<op::Sum>(add, AxisSet{2, 3});
+        return make_shared<Function>(NodeVector{sum}, ParameterVector{A, B, C});
+    };
+
+    auto cpu_f = make_function();
+    auto int_f = make_function();
+
+    test::Uniform<float> rng(-100.0f, 100.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : cpu_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    // Two convert layouts for the convolution inputs and one for its output.
+    EXPECT_EQ(count_ops_of_type<runtime::cpu::op::ConvertLayout>(cpu_f), 3);
+    for (size_t i = 0; i < cpu_results.size(); i++)
+    {
+        EXPECT_TRUE(test::all_close(cpu_results.at(i), int_results.at(i), 1.0e-4f, 1.0e-4f));
+    }
+}
+
+TEST(cpu_test, resource_manager_memory_budget)
+{
+    Shape shape{2, 3};
+    auto make_function = [&]() -> std::shared_ptr<Function> {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        return make_shared<Function>((A + B) * (A - B), ParameterVector{A, B});
+    };
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle1 = backend->compile(make_function());
+    auto handle2 = backend->compile(make_function());
+    auto call_frame1 =
+        static_pointer_cast<runtime::cpu::CPU_Executable>(handle1)->get_call_frame().get();
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4, 5, 6});
+    copy_data(b, vector<float>{1, 1, 1, 2, 2, 2});
+    vector<float> expected{0, 3, 8, 12, 21, 32};
+
+    auto& manager = runtime::cpu::GetCPUResourceManager();
+    for (bool share : {false, true})
+    {
+        // A one byte budget leaves room for only one model's intermediates at a time
+        manager.set_share_intermediates(share);
+        manager.set_memory_budget(1);
+        for (size_t i = 0; i < 3; i++)
+        {
+            handle1->call_with_validate({result}, {a, b});
+            EXPECT_EQ(expected, read_vector<float>(result));
+            handle2->call_with_validate({result}, {a, b});
+            EXPECT_EQ(expected, read_vector<float>(result));
+        }
+    }
+    manager.set_memory_budget(0);
+    manager.set_share_intermediates(false);
+
+    auto usage = manager.get_usage(call_frame1);
+    EXPECT_EQ(usage.m_call_count, 6);
+    EXPECT_GE(usage.m_evictions, 2);
+}
+
+TEST(cpu_test, resource_manager_evicted_constant_subgraph)
+{
+    // The transposed constant is cached in the intermediate pool and has to be recomputed
+    // after the pool is evicted, although none of its inputs changed
+    Shape shape{2, 3};
+    auto make_function = [&]() -> std::shared_ptr<Function> {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto C = op::Constant::create(element::f32, Shape{3, 2}, {1, 2, 3, 4, 5, 6});
+        auto transpose = make_shared<op::Reshape>(C, AxisVector{1, 0}, shape);
+        return make_shared<Function>(A + transpose, ParameterVector{A});
+    };
+
+    set_environment("NGRAPH_PASS_ENABLES", "ConstantEvaluation:0", 1);
+    auto backend = runtime::Backend::create("CPU");
+    auto handle1 = backend->compile(make_function());
+    auto handle2 = backend->compile(make_function());
+    unset_environment("NGRAPH_PASS_ENABLES");
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 1, 1, 1, 1, 1});
+    vector<float> expected{2, 4, 6, 3, 5, 7};
+
+    auto& manager = runtime::cpu::GetCPUResourceManager();
+    for (bool share : {false, true})
+    {
+        manager.set_share_intermediates(share);
+        manager.set_memory_budget(1);
+        for (size_t i = 0; i < 3; i++)
+        {
+            a->set_stale(i == 0);
+            handle1->call_with_validate({result}, {a});
+            EXPECT_EQ(expected, read_vector<float>(result));
+            handle2->call_with_validate({result}, {a});
+            EXPECT_EQ(expected, read_vector<float>(result));
+        }
+    }
+    manager.set_memory_budget(0);
+    manager.set_share_intermediates(false);
+}
+
+TEST(cpu_test, tiled_transpose_reverse)
+{
+    vector<pair<Shape, AxisVector>> transposes{
+        {Shape{2, 3, 4, 5}, AxisVector{0, 2, 3, 1}},
+        {Shape{2, 17, 33}, AxisVector{2, 1, 0}},
+        {Shape{40, 40}, AxisVector{1, 0}},
+        {Shape{2, 3, 4, 5}, AxisVector{1, 0, 2, 3}},
+        {Shape{3, 1, 5, 2, 7, 4}, AxisVector{5, 3, 1, 0, 4, 2}}};
+    vector<pair<Shape, AxisSet>> reverses{{Shape{2, 17, 33}, AxisSet{0, 2}},
+                                          {Shape{4, 1, 5, 6}, AxisSet{1, 3}},
+                                          {Shape{7, 9}, AxisSet{0}},
+                                          {Shape{100000}, AxisSet{0}}};
+
+    vector<shared_ptr<Function>> functions;
+    for (auto& transpose : transposes)
+    {
+        auto A = make_shared<op::Parameter>(element::f32, transpose.first);
+        Shape out_shape;
+        for (size_t axis : transpose.second)
+        {
+            out_shape.push_back(transpose.first[axis]);
+        }
+        auto reshape = make_shared<op::Reshape>(A, transpose.second, out_shape);
+        functions.push_back(make_shared<Function>(reshape, ParameterVector{A}));
+    }
+    for (auto& reverse : reverses)
+    {
+        auto A = make_shared<op::Parameter>(element::f32, reverse.first);
+        auto rev = make_shared<op::Reverse>(A, reverse.second);
+        functions.push_back(make_shared<Function>(rev, ParameterVector{A}));
+    }
+
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    for (auto& f : functions)
+    {
+        vector<float> arg(shape_size(f->get_parameters().at(0)->get_shape()));
+        rng.initialize(arg);
+        auto cpu_results = execute(f, vector<vector<float>>{arg}, "CPU");
+        auto int_results = execute(f, vector<vector<float>>{arg}, "INTERPRETER");
+        EXPECT_EQ(cpu_results.at(0), int_results.at(0));
+    }
+}
@@ -76,6 +76,41 @@ TEST(onnx_${BACKEND_NAME}, model_add_abc_initializers)
     EXPECT_TRUE(test::all_close_f(expected_outputs.front(), outputs.front()));
 }
 
+TEST(onnx_${BACKEND_NAME}, model_external_data)
+{
+    // Initializer B is stored in external_data.bin next to the model
+    auto function = onnx_import::import_onnx_model(
+        file_util::path_join(SERIALIZED_ZOO, "onnx/external_data.onnx"));
+
+    Inputs inputs{{5, 6, 7, 8}};
+    Outputs expected_outputs{{6, 8, 10, 12}};
+
+    Outputs outputs{execute(function, inputs, "${BACKEND_NAME}")};
+    EXPECT_TRUE(test::all_close_f(expected_outputs.front(), outputs.front()));
+}
+
+TEST(onnx_${BACKEND_NAME}, model_external_data_f16)
+{
+    // Initializer B is stored as packed float16 values in external_data_f16.bin
+    auto function = onnx_import::import_onnx_model(
+        file_util::path_join(SERIALIZED_ZOO, "onnx/external_data_f16.onnx"));
+
+    Inputs inputs{{5, 6, 7, 8}};
+    Outputs expected_outputs{{6, 8, 10, 12}};
+
+    Outputs outputs{execute(function, inputs, "${BACKEND_NAME}")};
+    EXPECT_TRUE(test::all_close_f(expected_outputs.front(), outputs.front()));
+}
+
+TEST(onnx_${BACKEND_NAME}, model_external_data_outside)
+{
+    // This model fails to import since the location of B has a .. segment, even though it
+    // leads back to the model directory.
+    EXPECT_THROW(onnx_import::import_onnx_model(file_util::path_join(
+                     SERIALIZED_ZOO, "onnx/external_data_outside.onnx")),
+                 std::runtime_error);
+}
+
 TEST(onnx_${BACKEND_NAME}, model_addmul_abc)
 {
     auto function = onnx_import::import_onnx_model(
@@ -1950,6 +1985,51 @@ TEST(onnx_${BACKEND_NAME}, model_lstm_fwd_with_clip)
     }
 }
 
+TEST(onnx_${BACKEND_NAME}, model_lstm_bidirectional)
+{
+    auto function = onnx_import::import_onnx_model(
+        file_util::path_join(SERIALIZED_ZOO, "onnx/lstm_bidirectional.onnx"));
+
+    Inputs inputs{};
+    // X
+    inputs.emplace_back(std::vector<float>{0.68172926f, 1.1405563f, -0.03931177f, -0.03759607f});
+    // W, the reverse direction has its own weights
+    inputs.emplace_back(std::vector<float>{
+        -0.5f, 0.2f, -0.2f, 0.5f,  0.1f, -0.3f, 0.4f, 0.0f,  -0.4f, 0.3f,  -0.1f,
+        -0.5f, 0.2f, -0.2f, 0.5f,  0.1f, -0.3f, 0.4f, 0.0f,  -0.4f, 0.3f,  -0.1f,
+        -0.5f, 0.2f, -0.2f, 0.5f,  0.1f, -0.3f, 0.4f, 0.0f,  -0.4f, 0.3f});
+    // R
+    inputs.emplace_back(std::vector<float>{
+        -0.6f, -0.3f, -0.1f, 0.2f, 0.4f,  -0.6f, -0.4f, -0.1f, 0.1f,  0.4f, 0.6f,
+        -0.4f, -0.2f, 0.1f,  0.3f, 0.6f,  -0.5f, -0.2f, 0.0f,  0.3f,  0.5f, -0.5f,
+        -0.3f, 0.0f,  0.2f,  0.5f, -0.6f, -0.3f, -0.1f, 0.2f,  0.4f,  -0.6f});
+
+    Outputs expected_output{};
+    // Y_data
+    expected_output.emplace_back(std::vector<float>{-0.01863798f,
+                                                    0.14356047f,
+                                                    0.07536207f,
+                                                    0.01275121f,
+                                                    -0.00643699f,
+                                                    0.07605473f,
+                                                    -0.00390863f,
+                                                    0.00112662f});
+    // Y_h_data
+    expected_output.emplace_back(
+        std::vector<float>{-0.00643699f, 0.07605473f, 0.07536207f, 0.01275121f});
+    // Y_c_data
+    expected_output.emplace_back(
+        std::vector<float>{-0.01345459f, 0.15508126f, 0.14539541f, 0.02701419f});
+
+    Outputs outputs{execute(function, inputs, "${BACKEND_NAME}")};
+
+    EXPECT_TRUE(outputs.size() == expected_output.size());
+    for (std::size_t i{0}; i < expected_output.size(); ++i)
+    {
+        EXPECT_TRUE(test::all_close(expected_output.at(i), outputs.at(i), 1.0e-5f, 1.0e-6f));
+    }
+}
+
 TEST(onnx_${BACKEND_NAME}, model_missing_input)
 {
     onnx_import::register_operator(
@@ -0,0 +1,174 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/op/batch_norm.hpp"
+#include "ngraph/op/experimental/generate_mask.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/stop_gradient.hpp"
+#include "ngraph/pass/freeze_for_inference.hpp"
+#include "util/all_close.hpp"
+#include "util/random.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+static shared_ptr<op::Constant> make_constant(const Shape& shape, float low, float high)
+{
+    test::Uniform<float> rng(low, high);
+    vector<float> values(shape_size(shape));
+    rng.initialize(values);
+    return op::Constant::create(element::f32, shape, values);
+}
+
+static vector<vector<float>> make_args(const shared_ptr<Function>& f)
+{
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<vector<float>> args;
+    for (shared_ptr<op::Parameter> param : f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    return args;
+}
+
+TEST(freeze_for_inference, training_convolution)
+{
+    auto W = make_constant(Shape{4, 3, 3, 3}, -1.0f, 1.0f);
+    auto bias = make_constant(Shape{4}, -1.0f, 1.0f);
+    auto gamma = make_constant(Shape{4}, 0.5f, 1.5f);
+    auto beta = make_constant(Shape{4}, -1.0f, 1.0f);
+    auto mean = make_constant(Shape{4}, -0.5f, 0.5f);
+    auto variance = make_constant(Shape{4}, 0.5f, 2.0f);
+    double eps = 0.001;
+
+    auto make_conv = [&](const shared_ptr<Node>& X) {
+        auto conv = make_shared<op::Convolution>(X, W);
+        auto b = make_shared<op::Broadcast>(bias, conv->get_shape(), AxisSet{0, 2, 3});
+        return conv + b;
+    };
+
+    // What training exported: batch statistics, dropout, a stop gradient and the batch
+    // statistics as extra outputs
+    auto X = make_shared<op::Parameter>(element::f32, Shape{2, 3, 6, 6});
+    auto bn = make_shared<op::BatchNormTraining>(make_conv(X), gamma, beta, eps);
+    bn->set_friendly_name("bn");
+    auto normalized = make_shared<op::GetOutputElement>(bn, 0);
+    auto relu = make_shared<op::Relu>(normalized);
+    auto training = op::Constant::create(element::f32, Shape{}, {1});
+    auto mask = make_shared<op::GenerateMask>(training, relu->get_shape(), element::f32, 1, 0.5);
+    auto dropout = make_shared<op::StopGradient>(relu * mask);
+    auto f = make_shared<Function>(NodeVector{dropout,
+                                              make_shared<op::GetOutputElement>(bn, 1),
+                                              make_shared<op::GetOutputElement>(bn, 2)},
+                                   ParameterVector{X});
+
+    // The inference function it should become
+    auto X_ref = make_shared<op::Parameter>(element::f32, Shape{2, 3, 6, 6});
+    auto bn_ref =
+        make_shared<op::BatchNormInference>(make_conv(X_ref), gamma, beta, mean, variance, eps);
+    auto f_ref = make_shared<Function>(make_shared<op::Relu>(bn_ref), ParameterVector{X_ref});
+
+    map<string, pass::FreezeForInference::Statistics> statistics;
+    statistics["bn"] = {mean, variance};
+    pass::FreezeForInference freeze(statistics);
+    freeze.run_on_function(f);
+
+    EXPECT_EQ(freeze.get_folded_count(), 1);
+    ASSERT_EQ(f->get_output_size(), 1);
+    EXPECT_EQ(count_ops_of_type<op::BatchNormTraining>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::BatchNormInference>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::GenerateMask>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::StopGradient>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Multiply>(f), 0);
+
+    auto args = make_args(f);
+    auto results = execute(f, args, "INTERPRETER");
+    auto ref_results = execute(f_ref, args, "INTERPRETER");
+    EXPECT_TRUE(test::all_close(results.at(0), ref_results.at(0), 1.0e-4f, 1.0e-4f));
+}
+
+TEST(freeze_for_inference, dot_inference_outputs)
+{
+    auto W = make_constant(Shape{8, 5}, -1.0f, 1.0f);
+    auto gamma = make_constant(Shape{5}, 0.5f, 1.5f);
+    auto beta = make_constant(Shape{5}, -1.0f, 1.0f);
+    auto mean = make_constant(Shape{5}, -0.5f, 0.5f);
+    auto variance = make_constant(Shape{5}, 0.5f, 2.0f);
+    double eps = 0.001;
+
+    auto make_f = [&]() {
+        auto X = make_shared<op::Parameter>(element::f32, Shape{4, 8});
+        auto dot = make_shared<op::Dot>(X, W);
+        auto bn = make_shared<op::BatchNormInference>(dot, gamma, beta, mean, variance, eps);
+        auto loss = make_shared<op::Sum>(bn, AxisSet{0, 1});
+        return make_shared<Function>(NodeVector{bn, loss}, ParameterVector{X});
+    };
+    auto f = make_f();
+    auto f_ref = make_f();
+
+    pass::FreezeForInference freeze({}, NodeVector{f->get_results().at(0)->get_argument(0)});
+    freeze.run_on_function(f);
+
+    EXPECT_EQ(freeze.get_folded_count(), 1);
+    ASSERT_EQ(f->get_output_size(), 1);
+    EXPECT_EQ(count_ops_of_type<op::BatchNormInference>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Sum>(f), 0);
+
+    auto args = make_args(f);
+    auto results = execute(f, args, "INTERPRETER");
+    auto ref_results = execute(f_ref, args, "INTERPRETER");
+    EXPECT_TRUE(test::all_close(results.at(0), ref_results.at(0), 1.0e-4f, 1.0e-4f));
+}
+
+TEST(freeze_for_inference, parameter_bias)
+{
+    auto W = make_constant(Shape{8, 5}, -1.0f, 1.0f);
+    auto gamma = make_constant(Shape{5}, 0.5f, 1.5f);
+    auto beta = make_constant(Shape{5}, -1.0f, 1.0f);
+    auto mean = make_constant(Shape{5}, -0.5f, 0.5f);
+    auto variance = make_constant(Shape{5}, 0.5f, 2.0f);
+
+    auto make_f = [&]() {
+        auto X = make_shared<op::Parameter>(element::f32, Shape{4, 8});
+        auto bias = make_shared<op::Parameter>(element::f32, Shape{5});
+        auto dot = make_shared<op::Dot>(X, W);
+        auto b = make_shared<op::Broadcast>(bias, dot->get_shape(), AxisSet{0});
+        auto bn = make_shared<op::BatchNormInference>(dot + b, gamma, beta, mean, variance, 0.001);
+        return make_shared<Function>(bn, ParameterVector{X, bias});
+    };
+    auto f = make_f();
+    auto f_ref = make_f();
+
+    // A bias only known at run time cannot be scaled into a constant shift
+    pass::FreezeForInference freeze;
+    freeze.run_on_function(f);
+    EXPECT_EQ(freeze.get_folded_count(), 0);
+    EXPECT_EQ(count_ops_of_type<op::BatchNormInference>(f), 1);
+
+    auto args = make_args(f);
+    auto results = execute(f, args, "INTERPRETER");
+    auto ref_results = execute(f_ref, args, "INTERPRETER");
+    EXPECT_TRUE(test::all_close(results.at(0), ref_results.at(0), 1.0e-4f, 1.0e-4f));
+}
@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <fstream>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -21,12 +22,14 @@
 
 #include "gtest/gtest.h"
 
+#include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/pass/dump_sorted.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
+#include "ngraph/pass/memory_visualize.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
 #include "util/test_tools.hpp"
 
@@ -236,3 +239,139 @@ TEST(memory_layout, constant)
     size_t temporary_pool_size = f->get_temporary_pool_size();
     EXPECT_EQ(4, temporary_pool_size);
 }
+
+TEST(memory_packer, disjoint_lifetimes_share)
+{
+    pass::MemoryPacker packer{1};
+    size_t a = packer.add_buffer(10, 0);
+    packer.release_buffer(a, 1);
+    size_t b = packer.add_buffer(20, 2);
+    packer.release_buffer(b, 3);
+
+    EXPECT_EQ(20, packer.pack());
+    EXPECT_EQ(0, packer.get_offset(a));
+    EXPECT_EQ(0, packer.get_offset(b));
+    EXPECT_EQ(20, packer.lower_bound());
+}
+
+TEST(memory_packer, beats_first_fit)
+{
+    // First fit in allocation order leaves a 10 byte hole below b that c does not fit in
+    pass::MemoryManager mm{1};
+    size_t a_offset = mm.allocate(10);
+    mm.allocate(30);
+    mm.free(a_offset);
+    mm.allocate(20);
+    EXPECT_EQ(60, mm.max_allocated());
+
+    pass::MemoryPacker packer{1};
+    size_t a = packer.add_buffer(10, 0);
+    size_t b = packer.add_buffer(30, 1);
+    packer.release_buffer(a, 1);
+    size_t c = packer.add_buffer(20, 2);
+    packer.release_buffer(b, 3);
+    packer.release_buffer(c, 3);
+
+    EXPECT_EQ(50, packer.pack());
+    EXPECT_EQ(50, packer.lower_bound());
+    EXPECT_NE(packer.get_offset(a), packer.get_offset(b));
+    EXPECT_NE(packer.get_offset(b), packer.get_offset(c));
+}
+
+TEST(memory_packer, shared_buffer_lives_until_last_release)
+{
+    pass::MemoryPacker packer{8};
+    size_t a = packer.add_buffer(4, 0);
+    packer.share_buffer(a, 12);
+    packer.release_buffer(a, 1);
+    size_t b = packer.add_buffer(8, 2);
+    packer.release_buffer(b, 2);
+    packer.release_buffer(a, 3);
+    // never released, live to the end
+    size_t c = packer.add_buffer(1, 3);
+
+    EXPECT_EQ(24, packer.pack());
+    EXPECT_EQ(24, packer.lower_bound());
+    EXPECT_NE(packer.get_offset(a), packer.get_offset(b));
+    EXPECT_NE(packer.get_offset(a), packer.get_offset(c));
+    EXPECT_EQ(0, packer.get_offset(a) % 8);
+    EXPECT_THROW(packer.release_buffer(b, 4), std::runtime_error);
+}
+
+TEST(memory_packer, many_buffers)
+{
+    // A long chain of short lived buffers, as in a large graph. Each buffer only conflicts
+    // with its neighbours, so packing must not compare every pair of buffers.
+    const size_t count = 100000;
+    const size_t lifetime = 4;
+    pass::MemoryPacker packer{1};
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t id = packer.add_buffer((i % 7 + 1) * 64, i);
+        packer.release_buffer(id, i + lifetime - 1);
+    }
+
+    size_t pool_size = packer.pack();
+    EXPECT_GE(pool_size, packer.lower_bound());
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t offset = packer.get_offset(i);
+        EXPECT_LE(offset + (i % 7 + 1) * 64, pool_size);
+        for (size_t j = i + 1; j < min(count, i + lifetime); j++)
+        {
+            size_t other = packer.get_offset(j);
+            ASSERT_TRUE(offset + (i % 7 + 1) * 64 <= other || other + (j % 7 + 1) * 64 <= offset);
+        }
+    }
+}
+
+TEST(memory_layout, packed_tensors_do_not_overlap)
+{
+    // Mixed tensor sizes that fragment an online first fit allocator
+    auto A = make_shared<op::Parameter>(element::f32, Shape{16});
+    auto small = make_shared<op::Negative>(make_shared<op::Slice>(A, Coordinate{0}, Coordinate{4}));
+    auto large =
+        make_shared<op::Broadcast>(make_shared<op::Sum>(A, AxisSet{0}), Shape{64}, AxisSet{0});
+    auto medium =
+        make_shared<op::Broadcast>(make_shared<op::Sum>(small, AxisSet{0}), Shape{32}, AxisSet{0});
+    auto f = make_shared<Function>(NodeVector{make_shared<op::Sum>(large, AxisSet{0}) +
+                                              make_shared<op::Sum>(medium, AxisSet{0})},
+                                   ParameterVector{A});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>();
+    pass_manager.run_passes(f);
+
+    // Live tensors never overlap in the pool
+    unordered_set<descriptor::Tensor*> live;
+    for (auto node : f->get_ordered_ops())
+    {
+        live.insert(node->liveness_new_list.begin(), node->liveness_new_list.end());
+        for (auto t1 : live)
+        {
+            for (auto t2 : live)
+            {
+                if (t1 != t2)
+                {
+                    EXPECT_TRUE(t1->get_pool_offset() + t1->size() <= t2->get_pool_offset() ||
+                                t2->get_pool_offset() + t2->size() <= t1->get_pool_offset());
+                }
+            }
+        }
+        for (auto tensor : node->liveness_free_list)
+        {
+            live.erase(tensor);
+        }
+    }
+
+    string report_file = file_util::tmp_filename(".html");
+    pass::Manager visualize_manager;
+    visualize_manager.register_pass<pass::MemoryVisualize>(report_file);
+    visualize_manager.run_passes(f);
+    ifstream report(report_file);
+    stringstream contents;
+    contents << report.rdbuf();
+    EXPECT_NE(contents.str().find("Fragmentation"), string::npos);
+    file_util::remove_file(report_file);
+}
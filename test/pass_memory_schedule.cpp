@@ -0,0 +1,125 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/liveness.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_layout.hpp"
+#include "ngraph/pass/memory_schedule.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+// Each branch broadcasts the input to a large tensor and reduces it back to a scalar. Running
+// the branches one after the other keeps only one large tensor live.
+static shared_ptr<Function> make_wide_function(size_t branches, size_t width)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{});
+    NodeVector large;
+    for (size_t i = 0; i < branches; i++)
+    {
+        large.push_back(make_shared<op::Broadcast>(A, Shape{width}, AxisSet{0}));
+    }
+    shared_ptr<Node> sum;
+    for (auto& node : large)
+    {
+        auto reduced = make_shared<op::Sum>(node, AxisSet{0});
+        sum = sum ? sum + reduced : reduced;
+    }
+    return make_shared<Function>(sum, ParameterVector{A});
+}
+
+TEST(memory_schedule, reduces_peak)
+{
+    const size_t branches = 4;
+    const size_t width = 1024;
+    auto f = make_wide_function(branches, width);
+
+    pass::MemorySchedule schedule;
+    schedule.run_on_function(f);
+
+    size_t large_bytes = width * sizeof(float);
+    EXPECT_LE(schedule.get_peak_after(), schedule.get_peak_before());
+    EXPECT_LT(schedule.get_peak_after(), 2 * large_bytes);
+
+    // Running it again on the pinned order finds nothing better
+    pass::MemorySchedule second;
+    second.run_on_function(f);
+    EXPECT_EQ(schedule.get_peak_after(), second.get_peak_before());
+    EXPECT_EQ(second.get_peak_before(), second.get_peak_after());
+}
+
+TEST(memory_schedule, pool_size_follows_schedule)
+{
+    const size_t width = 1024;
+    auto f = make_wide_function(4, width);
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::MemorySchedule>();
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>();
+    pass_manager.run_passes(f);
+
+    EXPECT_LT(f->get_temporary_pool_size(), 2 * width * sizeof(float));
+}
+
+TEST(memory_schedule, pinned_order_dropped_after_rewrite)
+{
+    auto f = make_wide_function(2, 16);
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::MemorySchedule>();
+    pass_manager.run_passes(f);
+
+    list<shared_ptr<Node>> order = f->get_ordered_ops();
+    order.reverse();
+    EXPECT_ANY_THROW(f->set_ordered_ops(order));
+
+    // Rewriting the graph makes the pinned order stale
+    auto result = f->get_results().at(0);
+    auto add = result->get_argument(0);
+    auto subtract = make_shared<op::Subtract>(add->get_argument(0), add->get_argument(1));
+    f->replace_node(add, subtract);
+    list<shared_ptr<Node>> ops = f->get_ordered_ops();
+    EXPECT_EQ(ops.size(), f->get_ops().size());
+    EXPECT_NE(find(ops.begin(), ops.end(), subtract), ops.end());
+    EXPECT_EQ(ops.back(), result);
+}
+
+#if defined(NGRAPH_INTERPRETER_ENABLE)
+TEST(memory_schedule, results_unchanged)
+{
+    auto f = make_wide_function(3, 8);
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto a = backend->create_tensor(element::f32, Shape{});
+    copy_data(a, vector<float>{2});
+    auto result = backend->create_tensor(element::f32, Shape{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::MemorySchedule>();
+    pass_manager.run_passes(f);
+
+    auto handle = backend->compile(f);
+    handle->call_with_validate({result}, {a});
+    EXPECT_EQ((vector<float>{48}), read_vector<float>(result));
+}
+#endif
@@ -0,0 +1,167 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/autodiff/adjoints.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/liveness.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_layout.hpp"
+#include "ngraph/pass/recompute_activations.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+// A chain of tanh layers with the gradient of the input. The adjoint of every tanh reads its
+// output, so without recomputation all activations stay live until the backward pass.
+static shared_ptr<Function> make_training_function(size_t depth,
+                                                   size_t width,
+                                                   shared_ptr<op::Parameter>& seed)
+{
+    auto X = make_shared<op::Parameter>(element::f32, Shape{width});
+    shared_ptr<Node> y = X;
+    for (size_t i = 0; i < depth; i++)
+    {
+        y = make_shared<op::Tanh>(y);
+    }
+    seed = make_shared<op::Parameter>(element::f32, Shape{width});
+    autodiff::Adjoints adjoints(NodeVector{y}, NodeVector{seed});
+    return make_shared<Function>(NodeVector{y, adjoints.backprop_node(X)},
+                                 ParameterVector{X, seed});
+}
+
+static size_t get_pool_size(shared_ptr<Function> f)
+{
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>();
+    pass_manager.run_passes(f);
+    return f->get_temporary_pool_size();
+}
+
+TEST(recompute_activations, every_k_lowers_pool_size)
+{
+    shared_ptr<op::Parameter> seed;
+    auto f = make_training_function(8, 1024, seed);
+    size_t pool_before = get_pool_size(clone_function(*f));
+
+    auto y = f->get_results().at(0)->get_argument(0);
+    pass::RecomputeActivations recompute(
+        NodeVector{y}, NodeVector{seed}, pass::RecomputeActivations::checkpoint_policy::EVERY_K, 2);
+    EXPECT_TRUE(recompute.run_on_function(f));
+    EXPECT_EQ(recompute.get_recomputed_count(), 4);
+    EXPECT_LT(recompute.get_peak_after(), recompute.get_peak_before());
+    EXPECT_LT(get_pool_size(f), pool_before);
+
+    // Every clone is scheduled after the forward pass finished
+    list<shared_ptr<Node>> ops = f->get_ordered_ops();
+    vector<shared_ptr<Node>> order(ops.begin(), ops.end());
+    size_t forward_end = find(order.begin(), order.end(), y) - order.begin();
+    size_t tanh_count = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        if (order[i]->description() == "Tanh")
+        {
+            tanh_count++;
+            if (!order[i]->get_control_dependencies().empty())
+            {
+                EXPECT_GT(i, forward_end);
+            }
+        }
+    }
+    EXPECT_EQ(tanh_count, 12);
+}
+
+TEST(recompute_activations, every_k_one_keeps_graph)
+{
+    shared_ptr<op::Parameter> seed;
+    auto f = make_training_function(4, 16, seed);
+    size_t op_count = f->get_ops().size();
+
+    auto y = f->get_results().at(0)->get_argument(0);
+    pass::RecomputeActivations recompute(
+        NodeVector{y}, NodeVector{seed}, pass::RecomputeActivations::checkpoint_policy::EVERY_K, 1);
+    EXPECT_FALSE(recompute.run_on_function(f));
+    EXPECT_EQ(f->get_ops().size(), op_count);
+}
+
+TEST(recompute_activations, memory_budget)
+{
+    shared_ptr<op::Parameter> seed;
+    auto f = make_training_function(8, 1024, seed);
+    size_t peak = pass::RecomputeActivations::get_live_peak(clone_function(*f));
+
+    auto y = f->get_results().at(0)->get_argument(0);
+    auto policy = pass::RecomputeActivations::checkpoint_policy::MEMORY_BUDGET;
+    size_t budget = peak * 3 / 4;
+    pass::RecomputeActivations recompute(NodeVector{y}, NodeVector{seed}, policy, budget);
+    EXPECT_TRUE(recompute.run_on_function(f));
+    EXPECT_EQ(recompute.get_peak_before(), peak);
+    EXPECT_LE(recompute.get_peak_after(), budget);
+    EXPECT_EQ(recompute.get_peak_after(), pass::RecomputeActivations::get_live_peak(f));
+}
+
+TEST(recompute_activations, memory_budget_deep)
+{
+    shared_ptr<op::Parameter> seed;
+    auto f = make_training_function(2000, 16, seed);
+    size_t peak = pass::RecomputeActivations::get_live_peak(clone_function(*f));
+
+    auto y = f->get_results().at(0)->get_argument(0);
+    auto policy = pass::RecomputeActivations::checkpoint_policy::MEMORY_BUDGET;
+    size_t budget = peak * 3 / 4;
+    pass::RecomputeActivations recompute(NodeVector{y}, NodeVector{seed}, policy, budget);
+    EXPECT_TRUE(recompute.run_on_function(f));
+    EXPECT_LE(recompute.get_peak_after(), budget);
+    EXPECT_EQ(recompute.get_peak_after(), pass::RecomputeActivations::get_live_peak(f));
+}
+
+#if defined(NGRAPH_INTERPRETER_ENABLE)
+TEST(recompute_activations, results_unchanged)
+{
+    shared_ptr<op::Parameter> seed;
+    auto f = make_training_function(6, 4, seed);
+    auto g = clone_function(*f);
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto x = backend->create_tensor(element::f32, Shape{4});
+    copy_data(x, vector<float>{-1.0f, -0.25f, 0.5f, 2.0f});
+    auto c = backend->create_tensor(element::f32, Shape{4});
+    copy_data(c, vector<float>{1.0f, 2.0f, 3.0f, 4.0f});
+
+    auto expected_y = backend->create_tensor(element::f32, Shape{4});
+    auto expected_dx = backend->create_tensor(element::f32, Shape{4});
+    backend->compile(g)->call_with_validate({expected_y, expected_dx}, {x, c});
+
+    pass::RecomputeActivations recompute(NodeVector{f->get_results().at(0)->get_argument(0)},
+                                         NodeVector{seed},
+                                         pass::RecomputeActivations::checkpoint_policy::EVERY_K,
+                                         3);
+    EXPECT_TRUE(recompute.run_on_function(f));
+    auto y = backend->create_tensor(element::f32, Shape{4});
+    auto dx = backend->create_tensor(element::f32, Shape{4});
+    backend->compile(f)->call_with_validate({y, dx}, {x, c});
+
+    EXPECT_EQ(read_vector<float>(expected_y), read_vector<float>(y));
+    EXPECT_EQ(read_vector<float>(expected_dx), read_vector<float>(dx));
+}
+#endif
@@ -0,0 +1,80 @@
+//*****************************************************************************
+// Copyright 2017-2019 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <numeric>
+
+#include "gtest/gtest.h"
+#include "ngraph/runtime/reference/generate_mask.hpp"
+#include "ngraph/state/philox.hpp"
+#include "ngraph/state/rng_state.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(rng_state, philox_known_answers)
+{
+    // Known answer tests for Philox4x32-10 from the Random123 distribution
+    EXPECT_EQ((Philox::counter_type{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}),
+              Philox::generate({{0, 0, 0, 0}}, {{0, 0}}));
+    EXPECT_EQ((Philox::counter_type{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}),
+              Philox::generate({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                               {{0xffffffff, 0xffffffff}}));
+    EXPECT_EQ((Philox::counter_type{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}),
+              Philox::generate({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                               {{0xa4093822, 0x299f31d0}}));
+}
+
+TEST(rng_state, mask_does_not_depend_on_ranges)
+{
+    RNGState state(777, 0.3);
+    uint64_t stream = state.next_stream();
+    size_t count = 1001;
+
+    vector<float> whole(count);
+    runtime::reference::generate_mask(
+        whole.data(), 0, count, state.get_seed(), stream, state.get_threshold(), true);
+
+    vector<float> pieces(count);
+    for (size_t begin : {size_t{500}, size_t{3}, size_t{0}, size_t{999}, size_t{77}, size_t{578}})
+    {
+        size_t end = min(count, begin + 423);
+        runtime::reference::generate_mask(
+            pieces.data(), begin, end, state.get_seed(), stream, state.get_threshold(), true);
+    }
+    EXPECT_EQ(whole, pieces);
+
+    // About 30% of the elements are set
+    float hits = accumulate(whole.begin(), whole.end(), 0.0f);
+    EXPECT_GT(hits, 0.2 * count);
+    EXPECT_LT(hits, 0.4 * count);
+}
+
+TEST(rng_state, calls_draw_new_streams)
+{
+    RNGState state_a(7, 0.5);
+    RNGState state_b(7, 0.5);
+    vector<double> a1(64), a2(64), b1(64);
+    runtime::reference::generate_mask(a1.data(), a1.size(), &state_a, true);
+    runtime::reference::generate_mask(a2.data(), a2.size(), &state_a, true);
+    runtime::reference::generate_mask(b1.data(), b1.size(), &state_b, true);
+    EXPECT_EQ(a1, b1);
+    EXPECT_NE(a1, a2);
+
+    vector<double> inference(16, 0);
+    runtime::reference::generate_mask(inference.data(), inference.size(), &state_a, false);
+    EXPECT_EQ(vector<double>(16, 1), inference);
+}
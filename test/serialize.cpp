@@ -20,6 +20,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "ngraph/cpio.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/op/get_output_element.hpp"
@@ -190,6 +191,59 @@ TEST(serialize, constant)
     EXPECT_TRUE(found);
 }
 
+static vector<string> get_ordered_descriptions(shared_ptr<Function> f)
+{
+    vector<string> rc;
+    for (shared_ptr<Node> node : f->get_ordered_ops())
+    {
+        rc.push_back(node->description());
+    }
+    return rc;
+}
+
+TEST(serialize, binary_graph)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    auto f = make_shared<Function>(make_shared<op::Multiply>(A + B, B), ParameterVector{A});
+
+    stringstream ss;
+    serialize_binary(ss, f);
+    ASSERT_TRUE(cpio::is_cpio(ss));
+    auto g = deserialize(ss);
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(get_ordered_descriptions(f), get_ordered_descriptions(g));
+    bool found = false;
+    for (shared_ptr<Node> node : g->get_ops())
+    {
+        if (auto c = dynamic_pointer_cast<op::Constant>(node))
+        {
+            found = true;
+            EXPECT_EQ((vector<float>{1, 2, 3, 4}), c->get_vector<float>());
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST(serialize, streaming_matches_json_dump)
+{
+    const string json_path = file_util::path_join(SERIALIZED_ZOO, "mxnet/mnist_mlp_forward.json");
+    shared_ptr<Function> f = deserialize(json_path);
+    ASSERT_NE(f, nullptr);
+
+    string compact = serialize(f);
+    json js = json::parse(compact);
+    EXPECT_EQ(js.dump(), compact);
+
+    string pretty = serialize(f, 4);
+    EXPECT_EQ(js, json::parse(pretty));
+    EXPECT_EQ(get_ordered_descriptions(f), get_ordered_descriptions(deserialize(pretty)));
+
+    stringstream ss(compact);
+    EXPECT_EQ(get_ordered_descriptions(f), get_ordered_descriptions(deserialize(ss)));
+}
+
 TEST(benchmark, serialize)
 {
     stopwatch timer;
@@ -14,7 +14,11 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
+#include <list>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -28,6 +32,7 @@
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
 #include "ngraph/serializer.hpp"
+#include "ngraph/stable_vector.hpp"
 #include "util/all_close.hpp"
 #include "util/autodiff/backprop_function.hpp"
 #include "util/ndarray.hpp"
@@ -394,6 +399,115 @@ TEST(graph_util, test_subgraph_topological_sort_control_dependencies)
     ASSERT_EQ(expected, sorted);
 }
 
+TEST(graph_util, cached_ordered_ops)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto add = A + B;
+    auto abs = make_shared<op::Abs>(add);
+    auto f = make_shared<Function>(NodeVector{abs}, ParameterVector{A, B});
+
+    auto get_list = [](const OrderedOps& ops) -> const list<shared_ptr<Node>>* {
+        return &static_cast<const list<shared_ptr<Node>>&>(ops);
+    };
+    {
+        // Repeated calls share the cached order
+        auto ops = f->get_ordered_ops();
+        EXPECT_EQ(get_list(ops), get_list(f->get_ordered_ops()));
+        EXPECT_LT(f->get_ordered_op_index(A.get()), f->get_ordered_op_index(add.get()));
+        EXPECT_EQ(f->get_ordered_op_index(add.get()) + 1, f->get_ordered_op_index(abs.get()));
+
+        // Editing another function sharing a parameter leaves the cache alone
+        auto neg = make_shared<op::Negative>(A);
+        auto g = make_shared<Function>(NodeVector{neg}, ParameterVector{A});
+        g->get_ordered_ops();
+        g->replace_node(neg, make_shared<op::Abs>(A));
+        EXPECT_EQ(get_list(ops), get_list(f->get_ordered_ops()));
+    }
+
+    // Rewiring an input invalidates the cached order and releases the replaced op
+    auto mul = A * B;
+    weak_ptr<Node> replaced = add;
+    f->replace_node(add, mul);
+    add.reset();
+    EXPECT_TRUE(replaced.expired());
+    auto new_ops = f->get_ordered_ops();
+    EXPECT_EQ(new_ops.size(), 5);
+    EXPECT_EQ(f->get_ordered_op_index(mul.get()) + 1, f->get_ordered_op_index(abs.get()));
+
+    // So does adding a control dependency
+    auto neg = make_shared<op::Negative>(B);
+    mul->add_control_dependency(neg);
+    EXPECT_EQ(f->get_ordered_ops().size(), 6);
+    EXPECT_LT(f->get_ordered_op_index(neg.get()), f->get_ordered_op_index(mul.get()));
+    EXPECT_EQ(f->get_ordered_ops(false).size(), 5);
+
+    mul->remove_control_dependency(neg);
+    EXPECT_EQ(f->get_ordered_ops().size(), 5);
+}
+
+TEST(graph_util, argument_and_user_ranges)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto add = A + A;
+    auto mul = A * B;
+
+    NodeVector args;
+    for (const shared_ptr<Node>& arg : add->get_argument_range())
+    {
+        args.push_back(arg);
+    }
+    EXPECT_EQ(args, add->get_arguments());
+
+    multiset<Node*> users;
+    for (Node* user : A->get_user_range())
+    {
+        users.insert(user);
+    }
+    EXPECT_EQ(users, (multiset<Node*>{add.get(), add.get(), mul.get()}));
+    EXPECT_EQ(distance(B->get_user_range().begin(), B->get_user_range().end()), 1);
+    EXPECT_TRUE(mul->get_user_range().begin() == mul->get_user_range().end());
+}
+
+TEST(util, stable_vector)
+{
+    // Elements are neither copyable nor movable, like descriptor::Input
+    struct Element
+    {
+        Element(int v)
+            : value(v)
+        {
+        }
+        Element(const Element&) = delete;
+        Element& operator=(const Element&) = delete;
+        int value;
+    };
+
+    StableVector<Element> elements;
+    EXPECT_TRUE(elements.empty());
+    elements.reserve(2);
+    Element* first = &elements.emplace_back(0);
+    elements.emplace_back(1);
+    for (int i = 2; i < 20; i++)
+    {
+        elements.emplace_back(i);
+    }
+    EXPECT_EQ(first, &elements.at(0));
+    EXPECT_EQ(elements.size(), 20);
+    int expected = 0;
+    for (const Element& element : elements)
+    {
+        EXPECT_EQ(element.value, expected++);
+    }
+    EXPECT_EQ(elements[13].value, 13);
+    EXPECT_EQ(elements.back().value, 19);
+    EXPECT_EQ(elements.end() - elements.begin(), 20);
+    EXPECT_THROW(elements.at(20), std::out_of_range);
+}
+
 TEST(pass, visualize_tree)
 {
     Shape shape{2, 2};